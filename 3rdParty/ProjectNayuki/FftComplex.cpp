@@ -21,8 +21,6 @@
  *   Software.
  */
 
-#include "pch.h"
-
 #include <cstddef>
 #include <cstdint>
 #include <stdexcept>
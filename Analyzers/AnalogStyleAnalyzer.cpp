@@ -1,18 +1,15 @@
 
-/** $VER: AnalogStyleAnalyzer.cpp (2025.10.05) P. Stuer - Based on TF3RDL's Analog-style spectrum analyzer, https://codepen.io/TF3RDL/pen/MWLzPoO **/
-
-#include "pch.h"
+/** $VER: AnalogStyleAnalyzer.cpp (2026.10.18) P. Stuer - Based on TF3RDL's Analog-style spectrum analyzer, https://codepen.io/TF3RDL/pen/MWLzPoO **/
 
 #include "AnalogStyleAnalyzer.h"
 
-#include "Support.h"
-
-#pragma hdrstop
+#include <algorithm>
+#include <cassert>
 
 /// <summary>
 /// Initializes a new instance.
 /// </summary>
-analog_style_analyzer_t::analog_style_analyzer_t(const state_t * state, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction) : analyzer_t(state, sampleRate, channelCount, channelSetup, windowFunction)
+analog_style_analyzer_t::analog_style_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction) : analyzer_t(config, sampleRate, channelCount, channelSetup, windowFunction)
 {
 }
 
@@ -23,7 +20,7 @@ bool analog_style_analyzer_t::Initialize(const vector<frequency_band_t> & freque
 {
     assert(_SampleRate != 0);
 
-    const double TimeResolution =  _State->_ConstantQ ? std::numeric_limits<double>::infinity() : _State->_TimeResolution;
+    const double TimeResolution =  _Config->ConstantQ ? std::numeric_limits<double>::infinity() : _Config->TimeResolution;
 
     for (const frequency_band_t & fb : frequencyBands)
     {
@@ -31,10 +28,10 @@ bool analog_style_analyzer_t::Initialize(const vector<frequency_band_t> & freque
         const double rad = M_PI * fb.Center / (double) _SampleRate;
 
         const double K = std::tan(rad);
-        const double Bandwidth = std::abs(fb.Hi - fb.Lo) * _State->_IIRBandwidth + (1. / (TimeResolution / 1000.));
+        const double Bandwidth = std::abs(fb.Hi - fb.Lo) * _Config->IIRBandwidth + (1. / (TimeResolution / 1000.));
 
-        const double QCompensationFactor = _State->_PreWarpQ ? rad / K : 1.;
-        const double Q = fb.Center / Bandwidth * QCompensationFactor / (_State->_CompensateBW ? ::sqrt(_State->_FilterBankOrder) : 1.);
+        const double QCompensationFactor = _Config->PreWarpQ ? rad / K : 1.;
+        const double Q = fb.Center / Bandwidth * QCompensationFactor / (_Config->CompensateBW ? ::sqrt(_Config->FilterBankOrder) : 1.);
         const double Norm = 1 / (1 + K / Q + K * K);
 
         coef_t c = { };
@@ -45,7 +42,7 @@ bool analog_style_analyzer_t::Initialize(const vector<frequency_band_t> & freque
         c.b1 = 2. * (K * K - 1.)    * Norm;
         c.b2 = (1. - K / Q + K * K) * Norm;
 
-        for (uint32_t i = 0; i < _State->_FilterBankOrder; ++i)
+        for (uint32_t i = 0; i < _Config->FilterBankOrder; ++i)
             c.z1[i] = c.z2[i] = c.Out[i] = 0.f;
 
         _Coefs.push_back(c);
@@ -76,7 +73,7 @@ bool analog_style_analyzer_t::AnalyzeSamples(const audio_sample * frames, size_t
         {
             double Value = (double) Sample;
 
-            for (uint32_t j = 0; j < _State->_FilterBankOrder;)
+            for (uint32_t j = 0; j < _Config->FilterBankOrder;)
             {
                 Coef.Out[j] = (Value * Coef.a0) + Coef.z1[j];
                 Coef.z1[j]  = (Value * Coef.a1) + Coef.z2[j] - (Coef.b1 * Coef.Out[j]);
@@ -87,7 +84,7 @@ bool analog_style_analyzer_t::AnalyzeSamples(const audio_sample * frames, size_t
                 Value = Coef.Out[j - 1];
             }
 
-            frequencyBands[k].RawValue = std::max(frequencyBands[k].RawValue, ::abs(Value));
+            frequencyBands[k].RawValue = std::max(frequencyBands[k].RawValue, std::abs(Value));
             ++k;
         }
     }
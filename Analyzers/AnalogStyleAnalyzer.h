@@ -1,5 +1,5 @@
 
-/** $VER: AnalogStyleAnalyzer.h (2024.03.09) P. Stuer **/
+/** $VER: AnalogStyleAnalyzer.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -7,10 +7,6 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <WinSock2.h>
-#include <Windows.h>
-
 #include "Analyzer.h"
 #include "FrequencyBand.h"
 
@@ -30,7 +26,7 @@ public:
 
     virtual ~analog_style_analyzer_t() { }
 
-    analog_style_analyzer_t(const state_t * configuration, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction);
+    analog_style_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction);
 
     bool Initialize(const vector<frequency_band_t> & frequencyBands);
     bool AnalyzeSamples(const audio_sample * sampleData, size_t sampleCount, uint32_t channels, frequency_bands_t & frequencyBands) noexcept;
@@ -1,5 +1,5 @@
 
-/** $VER: Analysis.cpp (2026.03.11) P. Stuer **/
+/** $VER: Analysis.cpp (2026.10.18) P. Stuer **/
 
 #include "pch.h"
 
@@ -7,13 +7,11 @@
 #include "Log.h"
 
 #include "Support.h"
+#include "StageTimings.h"
+#include "TraceRecorder.h"
 
 #pragma hdrstop
 
-inline double GetFrequencyTilt(double x, double amount, double offset) noexcept;
-inline double Equalize(double x, double amount, double depth, double offset) noexcept;
-inline double GetAcousticWeight(double x, WeightingType weightingType, double weightAmount) noexcept;
-
 /// <summary>
 /// Initializes this instance.
 /// </summary>
@@ -22,24 +20,47 @@ void analysis_t::Initialize(const state_t * state, const graph_description_t * g
     _State = state;
     _GraphDescription = graphDescription;
 
-    switch (_State->_FrequencyDistribution)
+    _AnalysisConfig = _State->GetAnalysisConfig();
+    _BandConfig = _State->GetBandConfig();
+
+    band_processor_t::Generate(_BandConfig, _FrequencyBands);
+
+    Reset();
+}
+
+/// <summary>
+/// Regenerates the frequency bands and recreates the spectrum analyzers with the current settings. The bands keep their values and their peak indicators.
+/// Only used when the number and the position of the bands did not change.
+/// </summary>
+void analysis_t::InitializeBands() noexcept
+{
+    _AnalysisConfig = _State->GetAnalysisConfig();
+    _BandConfig = _State->GetBandConfig();
+
+    frequency_bands_t Bands;
+
+    band_processor_t::Generate(_BandConfig, Bands);
+
+    // Only the bounds and the labels change. The visualizations keep referring to the same bands.
+    if (Bands.size() == _FrequencyBands.size())
     {
-        default:
+        for (size_t i = 0; i < Bands.size(); ++i)
+        {
+            frequency_band_t & fb = _FrequencyBands[i];
 
-        case FrequencyDistribution::Linear:
-            GenerateLinearFrequencyBands();
-            break;
+            fb.Lo     = Bands[i].Lo;
+            fb.Center = Bands[i].Center;
+            fb.Hi     = Bands[i].Hi;
 
-        case FrequencyDistribution::Octaves:
-            GenerateOctaveFrequencyBands();
-            break;
+            ::memcpy(fb.Label, Bands[i].Label, sizeof(fb.Label));
 
-        case FrequencyDistribution::AveePlayer:
-            GenerateAveePlayerFrequencyBands();
-            break;
+            fb.HasDarkBackground = Bands[i].HasDarkBackground;
+        }
     }
+    else
+        _FrequencyBands = Bands;
 
-    Reset();
+    DeleteAnalyzers();
 }
 
 /// <summary>
@@ -48,9 +69,46 @@ void analysis_t::Initialize(const state_t * state, const graph_description_t * g
 void analysis_t::Reset() noexcept
 {
     _SampleRate    = 0;
+    _BinCount      = 0;
     _ChannelCount  = 0;
     _ChannelConfig = 0;
 
+    DeleteAnalyzers();
+
+    // FFT-based visualizations
+    for (auto & fb : _FrequencyBands)
+        fb.Value = 0.;
+
+    // Peak Meter
+    {
+        _TruePeakMeter.Reset();
+        _LoudnessMeter.Reset();
+
+        _PeakKind = PeakMeasurementKind::Channels;
+        _PeakMeasuredChannels = 0;
+        InitializePeakMeasurements((uint32_t) Channels::ConfigStereo);
+
+        ResetRMSDependentValues();
+    }
+
+    // Level Meter
+    {
+        _Balance = 0.5;
+        _Phase   = 0.5;
+    }
+
+    // Bit Meter
+    {
+        _BitMeasuredChannels = 0;
+        InitializeBitMeasurements((uint32_t) Channels::ConfigStereo, bit_meter_kernel_t::GetBitCount(_State->_BitMeterView));
+    }
+}
+
+/// <summary>
+/// Deletes the spectrum analyzers and their window functions. They are created again with the current settings when the next chunk is processed.
+/// </summary>
+void analysis_t::DeleteAnalyzers() noexcept
+{
     if (_AnalogStyleAnalyzer != nullptr)
     {
         delete _AnalogStyleAnalyzer;
@@ -86,50 +144,29 @@ void analysis_t::Reset() noexcept
         delete _WindowFunction;
         _WindowFunction = nullptr;
     }
-
-    // FFT-based visualizations
-    for (auto & fb : _FrequencyBands)
-        fb.Value = 0.;
-
-    // Peak Meter
-    {
-        _PeakMeasuredChannels = 0;
-        InitializePeakMeasurements((uint32_t) Channels::ConfigStereo);
-
-        ResetRMSDependentValues();
-    }
-
-    // Level Meter
-    {
-        _Balance = 0.5;
-        _Phase   = 0.5;
-    }
-
-    // Bit Meter
-    {
-        _BitMeasuredChannels = 0;
-        InitializeBitMeasurements((uint32_t) Channels::ConfigStereo);
-    }
 }
 
 /// <summary>
-/// Processes an audio chunk.
+/// Processes an audio chunk. The position is the absolute index of the frame that follows the last frame of the chunk.
 /// </summary>
-void analysis_t::Process(const audio_chunk & chunk) noexcept
+void analysis_t::Process(const std::shared_ptr<const audio_chunk> & chunk, int64_t position) noexcept
 {
-    if ((_SampleRate != chunk.get_sample_rate()) || (_ChannelCount != chunk.get_channel_count()) || (_ChannelConfig != chunk.get_channel_config()))
+    if ((_SampleRate != chunk->get_sample_rate()) || (_ChannelCount != chunk->get_channel_count()) || (_ChannelConfig != chunk->get_channel_config()))
         Reset();
 
-    _SampleRate       = chunk.get_sample_rate();
-    _ChannelCount     = chunk.get_channel_count();
-    _ChannelConfig    = chunk.get_channel_config();
+    _SampleRate       = chunk->get_sample_rate();
+    _ChannelCount     = chunk->get_channel_count();
+    _ChannelConfig    = chunk->get_channel_config();
 
+    _BinCount         = _State->GetBinCount(_SampleRate);
     _NyquistFrequency = (double) _SampleRate / 2.;
     _ChannelMask      = _ChannelConfig & _GraphDescription->_SelectedChannels;
 
     if (_ChannelMask == 0)
         return; // None of the selected channels are present in this chunk.
 
+    scoped_trace_t Trace(_TraceRecorder, "Analysis", (double) position / (double) _SampleRate);
+
     switch (_State->_VisualizationType)
     {
         default:
@@ -140,14 +177,14 @@ void analysis_t::Process(const audio_chunk & chunk) noexcept
         case VisualizationType::RadialBars:
         case VisualizationType::RadialCurve:
         {
-            SpectrumProcessing(chunk);
+            SpectrumProcessing(*chunk, position);
             break;
         }
   
         case VisualizationType::PeakMeter:
         case VisualizationType::LevelMeter:
         {
-            MeterProcessing(chunk);
+            MeterProcessing(*chunk);
             break;
         }
 
@@ -159,7 +196,7 @@ void analysis_t::Process(const audio_chunk & chunk) noexcept
 
         case VisualizationType::BitMeter:
         {
-            BitMeterProcessing(chunk);
+            BitMeterProcessing(*chunk);
             break;
         }
 
@@ -170,6 +207,134 @@ void analysis_t::Process(const audio_chunk & chunk) noexcept
     }
 }
 
+/// <summary>
+/// Copies the result of the last analysis pass to the specified frame. The buffers of the frame are reused. The min/max pyramids are swapped with the ones of the frame:
+/// they are rebuilt from scratch by the next analysis pass.
+/// </summary>
+void analysis_t::GetFrame(analysis_frame_t & frame) noexcept
+{
+    frame.SampleRate       = _SampleRate;
+    frame.BinCount         = _BinCount;
+    frame.NyquistFrequency = _NyquistFrequency;
+
+    frame.Values.resize(_FrequencyBands.size());
+
+    for (size_t i = 0; i < _FrequencyBands.size(); ++i)
+        frame.Values[i] = _FrequencyBands[i].Value;
+
+    frame.PeakKind             = _PeakKind;
+    frame.PeakMeasuredChannels = _PeakMeasuredChannels;
+    frame.PeakValues.resize(_PeakMeasurements.size());
+
+    for (size_t i = 0; i < _PeakMeasurements.size(); ++i)
+    {
+        const peak_measurement_t & m = _PeakMeasurements[i];
+
+        frame.PeakValues[i] = { m.RMSTotal, m.Peak, m.PeakNormalized, m.RMS, m.RMSNormalized };
+    }
+
+    frame.Balance = _Balance;
+    frame.Phase   = _Phase;
+
+    frame.BitMeasuredChannels = _BitMeasuredChannels;
+    frame.BitCount            = !_BitMeasurements.empty() ? _BitMeasurements.front().BitCounts.size() : 0;
+    frame.BitCounts.resize(_BitMeasurements.size() * frame.BitCount);
+
+    for (size_t i = 0; i < _BitMeasurements.size(); ++i)
+        std::copy(_BitMeasurements[i].BitCounts.begin(), _BitMeasurements[i].BitCounts.end(), frame.BitCounts.begin() + (ptrdiff_t) (i * frame.BitCount));
+
+    frame.Chunk = _Chunk;
+    frame.Pyramids.swap(_Pyramids);
+}
+
+/// <summary>
+/// Makes the result of an analysis pass on another thread the current result. The state of the peak indicators is kept. The min/max pyramids are swapped with the ones of the frame.
+/// Returns the largest change of a rendered value (0.0 .. 1.0). The frame rate governor uses it to detect that the visualization stopped changing.
+/// </summary>
+double analysis_t::SetFrame(analysis_frame_t & frame) noexcept
+{
+    double Change = 0.;
+
+    _SampleRate       = frame.SampleRate;
+    _BinCount         = frame.BinCount;
+    _NyquistFrequency = frame.NyquistFrequency;
+
+    if (_FrequencyBands.size() == frame.Values.size())
+    {
+        for (size_t i = 0; i < _FrequencyBands.size(); ++i)
+        {
+            Change = std::max(Change, std::abs(frame.Values[i] - _FrequencyBands[i].Value));
+
+            _FrequencyBands[i].Value = frame.Values[i];
+        }
+    }
+
+    // Recreate the peak measurements when their kind or the measured channels changed. Otherwise only update the measured values.
+    if ((_PeakKind != frame.PeakKind) || (_PeakMeasuredChannels != frame.PeakMeasuredChannels))
+    {
+        if (frame.PeakKind == PeakMeasurementKind::Loudness)
+            InitializeLoudnessMeasurements();
+        else
+            InitializePeakMeasurements(frame.PeakMeasuredChannels);
+
+        Change = 1.;
+    }
+
+    for (size_t i = 0; (i < _PeakMeasurements.size()) && (i < frame.PeakValues.size()); ++i)
+    {
+        peak_measurement_t & m = _PeakMeasurements[i];
+        const peak_values_t & Source = frame.PeakValues[i];
+
+        Change = std::max({ Change, std::abs(Source.PeakNormalized - m.PeakNormalized), std::abs(Source.RMSNormalized - m.RMSNormalized) });
+
+        m.RMSTotal       = Source.RMSTotal;
+        m.Peak           = Source.Peak;
+        m.PeakNormalized = Source.PeakNormalized;
+        m.RMS            = Source.RMS;
+        m.RMSNormalized  = Source.RMSNormalized;
+    }
+
+    Change = std::max({ Change, std::abs(frame.Balance - _Balance), std::abs(frame.Phase - _Phase) });
+
+    _Balance = frame.Balance;
+    _Phase   = frame.Phase;
+
+    // Recreate the bit measurements when the measured channels or the view changed. Otherwise only update the bit counts.
+    if ((_BitMeasuredChannels != frame.BitMeasuredChannels) || (!_BitMeasurements.empty() && (_BitMeasurements.front().BitCounts.size() != frame.BitCount)))
+    {
+        InitializeBitMeasurements(frame.BitMeasuredChannels, frame.BitCount);
+
+        Change = 1.;
+    }
+
+    for (size_t i = 0; (i < _BitMeasurements.size()) && ((i + 1) * frame.BitCount <= frame.BitCounts.size()); ++i)
+    {
+        auto & BitCounts = _BitMeasurements[i].BitCounts;
+
+        const double * New = frame.BitCounts.data() + i * frame.BitCount;
+
+        for (size_t j = 0; j < BitCounts.size(); ++j)
+        {
+            Change = std::max(Change, std::abs(New[j] - BitCounts[j]));
+
+            BitCounts[j] = New[j];
+        }
+    }
+
+    // The oscilloscope shows the waveform of every new chunk. It only stands still when the chunk is silent.
+    if ((frame.Chunk != nullptr) && (frame.Chunk != _Chunk))
+        Change = std::max(Change, std::min((double) frame.Chunk->get_peak(), 1.));
+
+    _Chunk = frame.Chunk;
+    _Pyramids.swap(frame.Pyramids);
+
+    // The spectrogram advances one column per frame, even when the spectrum does not change.
+    if (_State->_VisualizationType == VisualizationType::Spectrogram)
+        Change = 1.;
+
+    return Change;
+}
+
 /// <summary>
 /// Resets the peak measurements.
 /// </summary>
@@ -198,12 +363,14 @@ void analysis_t::ResetRMSDependentValues() noexcept
 }
 
 /// <summary>
-/// Updates the peak values.
+/// Updates the peak values. Returns true while the peak indicators are still moving.
 /// </summary>
-void analysis_t::UpdatePeakValues(bool isStopped) noexcept
+bool analysis_t::UpdatePeakValues(bool isStopped) noexcept
 {
     const double Acceleration = _State->_Acceleration / 256.;
 
+    bool IsAnimating = false;
+
     switch (_State->_VisualizationType)
     {
         default:
@@ -288,6 +455,9 @@ void analysis_t::UpdatePeakValues(bool isStopped) noexcept
 
                     fb.MaxValue = std::clamp(fb.MaxValue, 0., 1.);
                 }
+
+                if (fb.MaxValue > fb.Value)
+                    IsAnimating = true;
             }
             break;
         }
@@ -371,6 +541,9 @@ void analysis_t::UpdatePeakValues(bool isStopped) noexcept
                         }
                     }
                 }
+
+                if (m.MaxPeakNormalized > m.PeakNormalized)
+                    IsAnimating = true;
             }
             break;
         }
@@ -392,6 +565,8 @@ void analysis_t::UpdatePeakValues(bool isStopped) noexcept
                 else
                 if (_Phase < 0.5)
                     _Phase = std::clamp(_Phase + Delta, 0.0, 0.5);
+
+                IsAnimating = (_Balance != 0.5) || (_Phase != 0.5);
             }
             break;
         }
@@ -409,11 +584,13 @@ void analysis_t::UpdatePeakValues(bool isStopped) noexcept
             break;
         }
     }
+
+    return IsAnimating;
 }
 
 #pragma region Spectrum
 
-void analysis_t::SpectrumProcessing(const audio_chunk & chunk) noexcept
+void analysis_t::SpectrumProcessing(const audio_chunk & chunk, int64_t position) noexcept
 {
     const audio_sample * Frames = chunk.get_data();
     const size_t FrameCount = chunk.get_sample_count(); // get_sample_count() actually returns the number of frames.
@@ -433,17 +610,27 @@ void analysis_t::SpectrumProcessing(const audio_chunk & chunk) noexcept
                 if (_BrownPucketteKernel == nullptr)
                     _BrownPucketteKernel = window_function_t::Create(_State->_KernelShape, _State->_KernelShapeParameter, _State->_KernelAsymmetry, _State->_Truncate);
 
-                _FFTAnalyzer = new fft_analyzer_t(_State, _SampleRate, _ChannelCount, _ChannelConfig, *_WindowFunction, *_BrownPucketteKernel, _State->_BinCount);
+                _FFTAnalyzer = new fft_analyzer_t(&_AnalysisConfig, _SampleRate, _ChannelCount, _ChannelConfig, *_WindowFunction, *_BrownPucketteKernel, _BinCount);
+
+                _FFTPosition = position - (int64_t) FrameCount;
             }
 
-            _FFTAnalyzer->AnalyzeSamples(Frames, FrameCount, _GraphDescription->_SelectedChannels, _FrequencyBands);
+            // Only add the frames that are not in the ring of the analyzer yet when the chunk continues the frames that were added before.
+            const int64_t First = position - (int64_t) FrameCount;
+            const size_t Offset = ((_FFTPosition > First) && (_FFTPosition <= position)) ? (size_t) (_FFTPosition - First) : 0;
+
+            _FFTPosition = position;
+
+            _FFTAnalyzer->AnalyzeSamples(Frames + (Offset * _ChannelCount), FrameCount - Offset, _GraphDescription->_SelectedChannels, _FrequencyBands);
             break;
         }
 
         case Transform::CQT:
         {
             if (_CQTAnalyzer == nullptr)
-                _CQTAnalyzer = new cqt_analyzer_t(_State, _SampleRate, _ChannelCount, _ChannelConfig, *_WindowFunction);
+                _CQTAnalyzer = new cqt_analyzer_t(&_AnalysisConfig, _SampleRate, _ChannelCount, _ChannelConfig, *_WindowFunction);
+
+            scoped_stage_timer_t Timer(Stage::Transform);
 
             _CQTAnalyzer->AnalyzeSamples(Frames, FrameCount, _GraphDescription->_SelectedChannels, _FrequencyBands);
             break;
@@ -453,11 +640,13 @@ void analysis_t::SpectrumProcessing(const audio_chunk & chunk) noexcept
         {
             if (_SWIFTAnalyzer == nullptr)
             {
-                _SWIFTAnalyzer = new swift_analyzer_t(_State, _SampleRate, _ChannelCount, _ChannelConfig);
+                _SWIFTAnalyzer = new swift_analyzer_t(&_AnalysisConfig, _SampleRate, _ChannelCount, _ChannelConfig);
 
                 _SWIFTAnalyzer->Initialize(_FrequencyBands);
             }
 
+            scoped_stage_timer_t Timer(Stage::Transform);
+
             _SWIFTAnalyzer->AnalyzeSamples(Frames, FrameCount, _GraphDescription->_SelectedChannels, _FrequencyBands);
             break;
         }
@@ -466,43 +655,25 @@ void analysis_t::SpectrumProcessing(const audio_chunk & chunk) noexcept
         {
             if (_AnalogStyleAnalyzer == nullptr)
             {
-                _AnalogStyleAnalyzer = new analog_style_analyzer_t(_State, _SampleRate, _ChannelCount, _ChannelConfig, *_WindowFunction);
+                _AnalogStyleAnalyzer = new analog_style_analyzer_t(&_AnalysisConfig, _SampleRate, _ChannelCount, _ChannelConfig, *_WindowFunction);
 
                 _AnalogStyleAnalyzer->Initialize(_FrequencyBands);
             }
 
+            scoped_stage_timer_t Timer(Stage::Transform);
+
             _AnalogStyleAnalyzer->AnalyzeSamples(Frames, FrameCount, _GraphDescription->_SelectedChannels, _FrequencyBands);
             break;
         }
     }
 
-    // Filter the spectrum.
-    if (_State->_WeightingType != WeightingType::None)
-        ApplyAcousticWeighting();
-
-    // Smooth the spectrum.
-    switch (_State->_SmoothingMethod)
-    {
-        default:
-
-        case SmoothingMethod::None:
-        {
-            Normalize();
-            break;
-        }
+    scoped_stage_timer_t Timer(Stage::Normalization);
 
-        case SmoothingMethod::Average:
-        {
-            NormalizeWithAverageSmoothing(_State->_SmoothingFactor);
-            break;
-        }
+    // Filter the spectrum.
+    band_processor_t::ApplyWeighting(_BandConfig, _SampleRate, _BinCount, _FrequencyBands);
 
-        case SmoothingMethod::Peak:
-        {
-            NormalizeWithPeakSmoothing(_State->_SmoothingFactor);
-            break;
-        }
-    }
+    // Smooth the spectrum. The smoothing settings are read every frame.
+    band_processor_t::Normalize(_GraphDescription->GetAmplitudeScale(), _State->_SmoothingMethod, _State->_SmoothingFactor, _FrequencyBands);
 
     // From here on frequency_band_t::CurValue is guaranteed to be in the range [0, 1].
 /*
@@ -520,248 +691,6 @@ void analysis_t::SpectrumProcessing(const audio_chunk & chunk) noexcept
 */
 }
 
-#pragma region Frequencies
-
-/// <summary>
-/// Generates frequency bands using a linear distribution.
-/// </summary>
-void analysis_t::GenerateLinearFrequencyBands()
-{
-    const double MinScale = ScaleFrequency(_State->_LoFrequency, _State->_ScalingFunction, _State->_SkewFactor);
-    const double MaxScale = ScaleFrequency(_State->_HiFrequency, _State->_ScalingFunction, _State->_SkewFactor);
-
-    const double Bandwidth = (((_State->_Transform == Transform::FFT) && (_State->_MappingMethod == Mapping::TriangularFilterBank)) || (_State->_Transform == Transform::CQT)) ? _State->_Bandwidth : 0.5;
-
-    _FrequencyBands.resize(_State->_BandCount);
-
-    double i = 0.;
-
-    for (frequency_band_t & fb: _FrequencyBands)
-    {
-        fb.Lo     = DeScaleF(msc::Map(i - Bandwidth, 0., (double)(_State->_BandCount - 1), MinScale, MaxScale), _State->_ScalingFunction, _State->_SkewFactor);
-        fb.Center = DeScaleF(msc::Map(i,             0., (double)(_State->_BandCount - 1), MinScale, MaxScale), _State->_ScalingFunction, _State->_SkewFactor);
-        fb.Hi     = DeScaleF(msc::Map(i + Bandwidth, 0., (double)(_State->_BandCount - 1), MinScale, MaxScale), _State->_ScalingFunction, _State->_SkewFactor);
-
-        ::swprintf_s(fb.Label, _countof(fb.Label), L"%.2fHz", fb.Center);
-
-        fb.HasDarkBackground = true;
-
-        ++i;
-    }
-}
-
-/// <summary>
-/// Returns the MIDI note nearest to the specified frequency.
-/// </summary>
-static int FrequencyToNote(double frequency) noexcept
-{
-    const int A4 = 69;
-
-    return A4 + (int) ::round(12. * ::log2(frequency / 440.));
-}
-
-/// <summary>
-/// Returns the frequency of the specified MIDI note.
-/// </summary>
-static double NoteToFrequency(int note) noexcept
-{
-    const int A4 = 69;
-
-    return 440. * ::pow(2., (note - A4) / 12.);
-}
-
-/// <summary>
-/// Generates frequency bands based on the frequencies of musical notes.
-/// </summary>
-void analysis_t::GenerateOctaveFrequencyBands()
-{
-    const double Root24 = ::exp2(1. / 24.); // 24 quarter tones (https://en.wikipedia.org/wiki/Quarter_tone)
-
-    const double TuningNote  = (_State->_TuningPitch > 0.) ? ::round(12.* (::log2(_State->_TuningPitch) - 4.)) * 2. : 0.;   // Nearest MIDI note of the tuning frequency.
-    const double C0Frequency =  _State->_TuningPitch * ::pow(Root24, -TuningNote);                                          // Frequency of C0 tuned with the specified frequency (~16.35 Hz)
-
-    const double NoteGroup = 24. / _State->_BandsPerOctave;
-
-    const double LoIndex = ::round(_State->_MinNote * 2. / NoteGroup);
-    const double HiIndex = ::round(_State->_MaxNote * 2. / NoteGroup);
-
-    const double Bandwidth = (((_State->_Transform == Transform::FFT) && (_State->_MappingMethod == Mapping::TriangularFilterBank)) || (_State->_Transform == Transform::CQT)) ? _State->_Bandwidth : 0.5;
-
-    _FrequencyBands.clear();
-
-    static const WCHAR * NoteNames[] = { L"C", L"C#", L"D", L"D#", L"E", L"F", L"F#", L"G", L"G#", L"A", L"A#", L"B" };
-
-    for (double i = LoIndex; i <= HiIndex; ++i)
-    {
-        frequency_band_t fb = 
-        {
-            C0Frequency * ::pow(Root24, (i - Bandwidth) * NoteGroup + _State->_Transpose),
-            C0Frequency * ::pow(Root24,  i              * NoteGroup + _State->_Transpose),
-            C0Frequency * ::pow(Root24, (i + Bandwidth) * NoteGroup + _State->_Transpose),
-        };
-
-        double f = NoteToFrequency(FrequencyToNote(fb.Center));
-
-        // Pre-calculate the tooltip text and the band background color.
-        {
-            const uint32_t Note = (uint32_t) (i * (NoteGroup / 2.));
-
-            const uint32_t n      = Note % (uint32_t) _countof(NoteNames);
-            const uint32_t Octave = Note / (uint32_t) _countof(NoteNames);
-
-            if (msc::InRange(f, fb.Lo, fb.Hi))
-                ::swprintf_s(fb.Label, _countof(fb.Label), L"%s%d\n%.2fHz", NoteNames[n], Octave, fb.Center);
-            else
-                ::swprintf_s(fb.Label, _countof(fb.Label), L"%.2fHz", fb.Center);
-
-            fb.HasDarkBackground = (n == 1 || n == 3 || n == 6 || n == 8 || n == 10);
-        }
-
-        _FrequencyBands.push_back(fb);
-    }
-}
-
-/// <summary>
-/// Generates frequency bands like AveePlayer.
-/// </summary>
-void analysis_t::GenerateAveePlayerFrequencyBands()
-{
-    const double Bandwidth = (((_State->_Transform == Transform::FFT) && (_State->_MappingMethod == Mapping::TriangularFilterBank)) || (_State->_Transform == Transform::CQT)) ? _State->_Bandwidth : 0.5;
-
-    _FrequencyBands.resize(_State->_BandCount);
-
-    const size_t n = _State->_BandCount - 1;
-
-    double i = 0.;
-
-    for (frequency_band_t & fb : _FrequencyBands)
-    {
-        fb.Lo  = LogSpace(_State->_LoFrequency, _State->_HiFrequency, i - Bandwidth, n, _State->_SkewFactor);
-        fb.Center = LogSpace(_State->_LoFrequency, _State->_HiFrequency, i,             n, _State->_SkewFactor);
-        fb.Hi  = LogSpace(_State->_LoFrequency, _State->_HiFrequency, i + Bandwidth, n, _State->_SkewFactor);
-
-        fb.HasDarkBackground = true;
-        ::swprintf_s(fb.Label, _countof(fb.Label), L"%.2fHz", fb.Center);
-
-        ++i;
-    }
-}
-
-#pragma endregion
-
-#pragma region Acoustic Weighting
-
-/// <summary>
-/// Applies acoustic weighting to the spectrum.
-/// </summary>
-void analysis_t::ApplyAcousticWeighting()
-{
-    const double Offset = ((_State->_SlopeFunctionOffset * (double) _SampleRate) / (double) _State->_BinCount);
-
-    for (frequency_band_t & fb : _FrequencyBands)
-        fb.RawValue *= GetWeight(fb.Center + Offset);
-}
-
-/// <summary>
-/// Gets the total weight.
-/// </summary>
-double analysis_t::GetWeight(double x) const noexcept
-{
-    const double a = GetFrequencyTilt(x, _State->_Slope, _State->_SlopeOffset);
-    const double b = Equalize(x, _State->_EqualizeAmount, _State->_EqualizeDepth, _State->_EqualizeOffset);
-    const double c = GetAcousticWeight(x, _State->_WeightingType, _State->_WeightingAmount);
-
-    return a * b * c;
-}
-
-/// <summary>
-/// Gets the frequency tilt.
-/// </summary>
-double GetFrequencyTilt(double x, double amount, double offset) noexcept
-{
-    return ::pow(x / offset, amount / 6.);
-}
-
-/// <summary>
-/// Equalizes the weight.
-/// </summary>
-double Equalize(double x, double amount, double depth, double offset) noexcept
-{
-    const double pos = x * depth / offset;
-    const double bias = ::pow(1.0025, -pos) * 0.04;
-
-    return ::pow((10. * ::log10(1. + bias + (pos + 1.) * (9. - bias) / depth)), amount / 6.);
-}
-
-/// <summary>
-/// Gets the weight for the specified frequency.
-/// </summary>
-double GetAcousticWeight(double x, WeightingType weightType, double weightAmount) noexcept
-{
-    const double f2 = x * x;
-
-    switch (weightType)
-    {
-        default:
-
-        case WeightingType::None:
-            return 1.;
-
-        case WeightingType::AWeighting:
-            return ::pow(1.2588966          * 148840000 * (f2 * f2)    / ((f2 + 424.36) * ::sqrt((f2 + 11599.29) * (f2 + 544496.41)) * (f2 + 148840000.)), weightAmount);
-
-        case WeightingType::BWeighting:
-            return ::pow(1.019764760044717  * 148840000 * ::pow(x, 3.) / ((f2 + 424.36) * ::sqrt(f2 + 25122.25)                      * (f2 + 148840000.)), weightAmount);
-
-        case WeightingType::CWeighting:
-            return ::pow(1.0069316688518042 * 148840000 * f2           / ((f2 + 424.36)                                              * (f2 + 148840000.)), weightAmount);
-
-        case WeightingType::DWeighting:
-            return ::pow(x / 6.8966888496476e-5 * ::sqrt(((1037918.48 - f2) * (1037918.48 - f2) + 1080768.16 * f2) / ((9837328. - f2) * (9837328. - f2) + 11723776. * f2) / ((f2 + 79919.29) * (f2 + 1345600.))), weightAmount);
-
-        case WeightingType::MWeighting:
-        {
-            const double h1 = -4.737338981378384e-24 * ::pow(f2, 3.) + 2.043828333606125e-15 * (f2 * f2)    - 1.363894795463638e-7 * f2 + 1;
-            const double h2 =  1.306612257412824e-19 * ::pow( x, 5.) - 2.118150887518656e-11 * ::pow(x, 3.) + 5.559488023498642e-4 * x;
-
-            return ::pow(8.128305161640991 * 1.246332637532143e-4 * x / ::hypot(h1, h2), weightAmount);
-        }
-    }
-}
-
-#pragma endregion
-
-#pragma region Normalization
-
-/// <summary>
-/// Normalizes the amplitude.
-/// </summary>
-void analysis_t::Normalize() noexcept
-{
-    for (frequency_band_t & fb : _FrequencyBands)
-        fb.Value = std::clamp(_GraphDescription->ScaleAmplitude(fb.RawValue), 0.0, 1.0);
-}
-
-/// <summary>
-/// Normalizes the amplitude and applies average smoothing.
-/// </summary>
-void analysis_t::NormalizeWithAverageSmoothing(double factor) noexcept
-{
-    for (frequency_band_t & fb : _FrequencyBands)
-        fb.Value = std::clamp((fb.Value * factor) + (::isfinite(fb.RawValue) ? _GraphDescription->ScaleAmplitude(fb.RawValue) * (1.0 - factor) : 0.0), 0.0, 1.0);
-}
-
-/// <summary>
-/// Normalizes the amplitude and applies peak smoothing.
-/// </summary>
-void analysis_t::NormalizeWithPeakSmoothing(double factor) noexcept
-{
-    for (frequency_band_t & fb : _FrequencyBands)
-        fb.Value = std::clamp(std::max(fb.Value * factor, ::isfinite(fb.RawValue) ? _GraphDescription->ScaleAmplitude(fb.RawValue) : 0.0), 0.0, 1.0);
-}
-
-#pragma endregion
-
 #pragma endregion
 
 #pragma region Peak Meter / Level Meter
@@ -777,57 +706,38 @@ void analysis_t::MeterProcessing(const audio_chunk & chunk) noexcept
     if ((Frames == nullptr) || (FrameCount == 0))
         return;
 
-    InitializePeakMeasurements(_ChannelMask);
-
-    audio_sample BalanceSamples[2] = { };
-
-    const audio_sample * EndOfChunk = Frames + (FrameCount * _ChannelCount);
-
-    for (const audio_sample * Frame = Frames; Frame < EndOfChunk; Frame += _ChannelCount)
+    if (_State->_IsLoudnessMeter && (_State->_VisualizationType == VisualizationType::PeakMeter))
     {
-        const audio_sample * Sample = Frame;    // First sample of the current frame.
-
-        size_t i = 0;
-        size_t j = 0;
-
-        uint32_t ChunkChannels    = chunk.get_channel_config();                     // Mask containing the channels in the audio chunk.
-        uint32_t SelectedChannels = _GraphDescription->_SelectedChannels;           // Mask containing the channels selected by the user for the level measuring.
-        uint32_t BalanceChannels  = ChannelPairs[(size_t) _State->_ChannelPair];    // Mask containing the channels selected by the user for the balance measuring.
+        LoudnessProcessing(chunk);
+        return;
+    }
 
-        while ((ChunkChannels & SelectedChannels) != 0)
-        {
-            if (ChunkChannels & 1)
-            {
-                if ((SelectedChannels & 1) && (i < _PeakMeasurements.size()))
-                {
-                    auto m = &_PeakMeasurements[i++];
+    InitializePeakMeasurements(_ChannelMask);
 
-                    const double Value = std::abs((double) *Sample);
+    // Recompile the channel plan only when the channel layout or the channel selection changes.
+    if (_MeterPlan.Build(_ChannelCount, chunk.get_channel_config(), _GraphDescription->_SelectedChannels, ChannelPairs[(size_t) _State->_ChannelPair]))
+        _TruePeakMeter.Reset();
 
-                    m->Peak = std::max(Value, m->Peak);
-                    m->RMSTotal += Value * Value;
-                }
+    meter_kernel_t::Process(Frames, FrameCount, _MeterPlan, _MeterBlock);
 
-                if ((BalanceChannels & 1) && (j < _countof(BalanceSamples)))
-                    BalanceSamples[j++] = *Sample;
+    if (_State->_TruePeak)
+        _TruePeakMeter.Process(Frames, FrameCount, _MeterPlan, _MeterBlock);
 
-                Sample++;
-            }
+    for (size_t i = 0; (i < _MeterPlan.MeasuredCount) && (i < _PeakMeasurements.size()); ++i)
+    {
+        auto & m = _PeakMeasurements[i];
 
-            ChunkChannels    >>= 1;
-            SelectedChannels >>= 1;
-            BalanceChannels  >>= 1;
-        }
+        const uint32_t Offset = _MeterPlan.MeasuredOffsets[i];
 
-        _Left  += BalanceSamples[0] * BalanceSamples[0];
-        _Right += BalanceSamples[1] * BalanceSamples[1];
+        m.Peak = std::max(_State->_TruePeak ? _MeterBlock.TruePeak[Offset] : _MeterBlock.Peak[Offset], m.Peak);
+        m.RMSTotal += _MeterBlock.SumOfSquares[Offset];
+    }
 
-        const double Mid  = (BalanceSamples[0] + BalanceSamples[1]) / 2.;
-        const double Side = (BalanceSamples[0] - BalanceSamples[1]) / 2.;
+    _Left  += _MeterBlock.Left;
+    _Right += _MeterBlock.Right;
 
-        _Mid  += Mid  * Mid;
-        _Side += Side * Side;
-    }
+    _Mid   += _MeterBlock.Mid;
+    _Side  += _MeterBlock.Side;
 
     _RMSFrameCount  += FrameCount;
     _RMSTimeElapsed += chunk.get_duration();
@@ -884,9 +794,9 @@ void analysis_t::MeterProcessing(const audio_chunk & chunk) noexcept
 /// </summary>
 void analysis_t::InitializePeakMeasurements(uint32_t measuredChannels) noexcept
 {
-    if (_PeakMeasuredChannels != measuredChannels)
+    if ((_PeakKind != PeakMeasurementKind::Channels) || (_PeakMeasuredChannels != measuredChannels))
     {
-        // The chunk configuration has changed. Recreate the measurements.
+        // The chunk configuration or the mode has changed. Recreate the measurements.
         static const WCHAR * ChannelNames[] =
         {
             L"FL", L"FR", L"FC",
@@ -907,6 +817,7 @@ void analysis_t::InitializePeakMeasurements(uint32_t measuredChannels) noexcept
                 _PeakMeasurements.push_back({ ChannelNames[i], _State->_HoldTime });
         }
 
+        _PeakKind = PeakMeasurementKind::Channels;
         _PeakMeasuredChannels = measuredChannels;
     }
     else
@@ -919,14 +830,84 @@ void analysis_t::InitializePeakMeasurements(uint32_t measuredChannels) noexcept
 
 #pragma endregion
 
+#pragma region Loudness Meter
+
+/// <summary>
+/// Process the chunk data for the loudness meter. The loudness measurements are presented as peak measurements so the peak meter can render them.
+/// </summary>
+void analysis_t::LoudnessProcessing(const audio_chunk & chunk) noexcept
+{
+    InitializeLoudnessMeasurements();
+
+    // Loudness is measured over all channels of the chunk (ITU-R BS.1770-4), not only the selected channels.
+    _LoudnessMeter.Process(chunk.get_data(), chunk.get_sample_count(), _ChannelCount, _ChannelConfig, _SampleRate);
+
+    // The bar of the loudness range spans the 10th (RMS) to the 95th (Peak) percentile of the short-term loudness.
+    const double Values[][2] =
+    {
+        { _LoudnessMeter.GetMomentaryLoudness(),  _LoudnessMeter.GetMomentaryLoudness() },
+        { _LoudnessMeter.GetShortTermLoudness(),  _LoudnessMeter.GetShortTermLoudness() },
+        { _LoudnessMeter.GetIntegratedLoudness(), _LoudnessMeter.GetIntegratedLoudness() },
+        { _LoudnessMeter.GetLoudnessRangeHi(),    _LoudnessMeter.GetLoudnessRangeLo() },
+    };
+
+    for (size_t i = 0; (i < _countof(Values)) && (i < _PeakMeasurements.size()); ++i)
+    {
+        auto & m = _PeakMeasurements[i];
+
+        m.Peak           = Values[i][0];
+        m.PeakNormalized = SmoothValue(NormalizeValue(m.Peak), m.PeakNormalized);
+
+        m.RMS            = Values[i][1];
+        m.RMSNormalized  = SmoothValue(NormalizeValue(m.RMS), m.RMSNormalized);
+    }
+}
+
+/// <summary>
+/// Initializes the loudness measurements before processing an audio chunk.
+/// </summary>
+void analysis_t::InitializeLoudnessMeasurements() noexcept
+{
+    if (_PeakKind == PeakMeasurementKind::Loudness)
+        return;
+
+    _PeakMeasurements.clear();
+
+    for (const WCHAR * Name : { L"M", L"S", L"I", L"LRA" })
+        _PeakMeasurements.push_back({ Name, _State->_HoldTime });
+
+    _PeakKind = PeakMeasurementKind::Loudness;
+    _PeakMeasuredChannels = 0;
+}
+
+#pragma endregion
+
 #pragma region Oscilloscope
 
 /// <summary>
 /// Process the chunk data for the oscilloscope.
 /// </summary>
-void analysis_t::OscilloscopeProcessing(const audio_chunk & chunk) noexcept
+void analysis_t::OscilloscopeProcessing(const std::shared_ptr<const audio_chunk> & chunk) noexcept
 {
-    _Chunk.copy(chunk);
+    _Chunk = chunk;
+
+    if (_State->_XYMode)
+    {
+        _Pyramids.clear(); // They would refer to the samples of a previous chunk.
+
+        return;
+    }
+
+    // Build a min/max pyramid for each selected channel so the renderer can reduce the samples to one min/max pair per pixel column.
+    _MeterPlan.Build(_ChannelCount, chunk->get_channel_config(), _GraphDescription->_SelectedChannels, 0);
+
+    _Pyramids.resize(_MeterPlan.MeasuredCount);
+
+    const audio_sample * Frames = chunk->get_data();
+    const size_t FrameCount = chunk->get_sample_count(); // get_sample_count() actually returns the number of frames.
+
+    for (size_t i = 0; i < _MeterPlan.MeasuredCount; ++i)
+        _Pyramids[i].Build(Frames + _MeterPlan.MeasuredOffsets[i], FrameCount, _ChannelCount);
 }
 
 #pragma endregion
@@ -944,70 +925,35 @@ void analysis_t::BitMeterProcessing(const audio_chunk & chunk) noexcept
     if ((Frames == nullptr) || (FrameCount == 0))
         return;
 
-    InitializeBitMeasurements(_ChannelMask);
+    InitializeBitMeasurements(_ChannelMask, bit_meter_kernel_t::GetBitCount(_State->_BitMeterView));
 
-    const audio_sample * EndOfChunk = Frames + (FrameCount * _ChannelCount);
+    _MeterPlan.Build(_ChannelCount, chunk.get_channel_config(), _GraphDescription->_SelectedChannels, 0);
 
-    for (const audio_sample * Frame = Frames; Frame < EndOfChunk; Frame += _ChannelCount)
-    {
-        const audio_sample * Sample = Frame;    // First sample of the current frame.
-
-        size_t i = 0;
-
-        uint32_t ChunkChannels    = chunk.get_channel_config();             // Mask containing the channels in the audio chunk.
-        uint32_t SelectedChannels = _GraphDescription->_SelectedChannels;   // Mask containing the channels selected by the user for processing.
-
-        while ((ChunkChannels & SelectedChannels) != 0)
-        {
-            if (ChunkChannels & 1)
-            {
-                if ((SelectedChannels & 1) && (i < _BitMeasurements.size()))
-                {
-                    #if (audio_sample_size == 64)
-                    uint64_t Value = *(uint64_t *) Sample; // Value = 0b1101010101011001111111111111111111111111111111111111111111111001; // Test pattern
-                    #else
-                    uint32_t Value = *(uint32_t *) Sample; // Value = 0b11010101010000000000000000000001; // Test pattern
-                    #endif
-
-                    for (auto & BitCount : _BitMeasurements[i].BitCounts)
-                    {
-                        if (Value == 0)
-                            break;
-
-                        if (Value & 1)
-                            ++BitCount;
+    for (size_t i = 0; i < _MeterPlan.MeasuredCount; ++i)
+        std::fill(std::begin(_BitCounters[i]), std::end(_BitCounters[i]), 0U);
 
-                        Value >>= 1;
-                    }
-
-                    ++i;
-                }
+    bit_meter_kernel_t::Process(Frames, FrameCount, _MeterPlan, _State->_BitMeterView, _BitCounters);
 
-                Sample++;
-            }
+    // Scale the bit counters to range [0, 1] and reverse them in one pass to get: Index 0 = Sign bit, Index 1 - 11 = Exponent bits, Index 12 - 63 = Mantissa bits (64-bit floating point)
+    const double Scale = 1. / (double) FrameCount;
 
-            ChunkChannels    >>= 1;
-            SelectedChannels >>= 1;
-        }
-    }
-
-    // Scale the bit counters to range [0, 1].
-    for (auto & m : _BitMeasurements)
+    for (size_t i = 0; (i < _MeterPlan.MeasuredCount) && (i < _BitMeasurements.size()); ++i)
     {
-        for (auto & BitCount : m.BitCounts)
-            BitCount /= (double) FrameCount;
+        auto & BitCounts = _BitMeasurements[i].BitCounts;
+
+        const size_t BitCount = BitCounts.size();
 
-        // Reverse the array to get: Index 0 = Sign bit, Index 1 - 11 = Exponent bits, Index 12 - 63 = Mantissa bits
-        std::reverse(m.BitCounts.begin(), m.BitCounts.end());
+        for (size_t j = 0; j < BitCount; ++j)
+            BitCounts[BitCount - 1 - j] = (double) _BitCounters[i][j] * Scale;
     }
 }
 
 /// <summary>
 /// Initializes the bit measurements before processing an audio chunk.
 /// </summary>
-void analysis_t::InitializeBitMeasurements(uint32_t measuredChannels) noexcept
+void analysis_t::InitializeBitMeasurements(uint32_t measuredChannels, size_t bitCount) noexcept
 {
-    if (_BitMeasuredChannels != measuredChannels)
+    if ((_BitMeasuredChannels != measuredChannels) || (!_BitMeasurements.empty() && (_BitMeasurements.front().BitCounts.size() != bitCount)))
     {
         // The chunk configuration has changed. Recreate the measurements.
         static const WCHAR * ChannelNames[] =
@@ -1027,16 +973,11 @@ void analysis_t::InitializeBitMeasurements(uint32_t measuredChannels) noexcept
         for (uint32_t SelectedChannels = measuredChannels; (SelectedChannels != 0) && (i < _countof(ChannelNames)); SelectedChannels >>= 1, ++i)
         {
             if (SelectedChannels & 1)
-                _BitMeasurements.push_back({ ChannelNames[i], audio_sample_size });
+                _BitMeasurements.push_back({ ChannelNames[i], bitCount });
         }
 
         _BitMeasuredChannels = measuredChannels;
     }
-    else
-    {
-        for (auto & m : _BitMeasurements)
-            std::fill(m.BitCounts.begin(), m.BitCounts.end(), 0.);
-    }
 }
 
 #pragma endregion
@@ -1,5 +1,5 @@
 
-/** $VER: Analysis.h (2026.03.11) P. Stuer **/
+/** $VER: Analysis.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -21,6 +21,14 @@
 #include "AnalogStyleAnalyzer.h"
 
 #include "FrequencyBand.h"
+#include "BandProcessor.h"
+#include "MeterKernel.h"
+#include "TruePeakMeter.h"
+#include "LoudnessMeter.h"
+#include "BitMeterKernel.h"
+#include "MinMaxPyramid.h"
+
+#include <memory>
 
 /// <summary>
 /// Represents a meter measurement.
@@ -74,10 +82,64 @@ struct bit_measurement_t : measurement_t
 {
     bit_measurement_t(const WCHAR * channelName, size_t bitCount) noexcept : measurement_t(channelName)
     {
-        BitCounts.resize(audio_sample_size, 0.);
+        BitCounts.resize(bitCount, 0.);
     }
 
-    std::vector<double> BitCounts;
+    std::vector<double> BitCounts;  // Index 0 = Most significant bit
+};
+
+/// <summary>
+/// Identifies what the peak measurements represent.
+/// </summary>
+enum class PeakMeasurementKind : uint32_t
+{
+    Channels = 0,                                       // One measurement per measured channel.
+    Loudness,                                           // The loudness measurements M, S, I and LRA.
+};
+
+/// <summary>
+/// Represents the measured values of a peak measurement in an analysis frame.
+/// </summary>
+struct peak_values_t
+{
+    double RMSTotal;
+    double Peak;
+    double PeakNormalized;
+    double RMS;
+    double RMSNormalized;
+};
+
+/// <summary>
+/// Represents the result of one analysis pass of a graph. Produced by the analysis thread and handed to the render thread.
+/// Only contains the measured values. The render thread creates the measurements, and their channel names, itself when the measured channels change.
+/// The buffers circulate between both threads and are reused; the min/max pyramids are swapped instead of copied.
+/// </summary>
+struct analysis_frame_t
+{
+    analysis_frame_t() noexcept : Generation(), PlaybackTime(), SampleRate(), BinCount(), NyquistFrequency(), PeakKind(), PeakMeasuredChannels(), Balance(0.5), Phase(0.5), BitMeasuredChannels(), BitCount() { }
+
+    uint64_t Generation;                                // Frames of a previous generation are dropped by the render thread.
+    double PlaybackTime;                                // Playback time of the analyzed chunk (in seconds).
+
+    uint32_t SampleRate;
+    size_t BinCount;
+    double NyquistFrequency;
+
+    std::vector<double> Values;                         // Value of each frequency band.
+
+    PeakMeasurementKind PeakKind;
+    uint32_t PeakMeasuredChannels;                      // Only used by channel measurements.
+    std::vector<peak_values_t> PeakValues;              // Values of each peak measurement.
+
+    double Balance;
+    double Phase;
+
+    uint32_t BitMeasuredChannels;
+    size_t BitCount;                                    // Number of bits per bit measurement. Depends on the bit meter view.
+    std::vector<double> BitCounts;                      // Bit counts of all bit measurements, one measurement after the other.
+
+    std::shared_ptr<const audio_chunk> Chunk;           // Only used by the oscilloscope.
+    std::vector<min_max_pyramid_t> Pyramids;            // Only used by the oscilloscope.
 };
 
 /// <summary>
@@ -86,7 +148,7 @@ struct bit_measurement_t : measurement_t
 class analysis_t
 {
 public:
-    analysis_t() noexcept : _SampleRate(), _ChannelCount(), _ChannelConfig(), _RMSTimeElapsed(), _RMSFrameCount(), _Left(), _Right(), _Mid(), _Side(), _Balance(0.5), _Phase(0.5) { };
+    analysis_t() noexcept : _SampleRate(), _BinCount(), _ChannelCount(), _ChannelConfig(), _PeakKind(), _PeakMeasuredChannels(), _RMSTimeElapsed(), _RMSFrameCount(), _Left(), _Right(), _Mid(), _Side(), _Balance(0.5), _Phase(0.5), _FFTPosition() { };
 
     analysis_t(const analysis_t &) = delete;
     analysis_t & operator=(const analysis_t &) = delete;
@@ -96,41 +158,41 @@ public:
     virtual ~analysis_t() noexcept { Reset(); };
 
     void Initialize(const state_t * state, const graph_description_t * settings) noexcept;
-    void Process(const audio_chunk & chunk) noexcept;
+    void InitializeBands() noexcept;
+    void Process(const std::shared_ptr<const audio_chunk> & chunk, int64_t position) noexcept;
+
+    void GetFrame(analysis_frame_t & frame) noexcept;
+    double SetFrame(analysis_frame_t & frame) noexcept;
 
     void Reset() noexcept;
     void ResetPeakMeasurements() noexcept;
     void ResetRMSDependentValues() noexcept;
 
-    void UpdatePeakValues(bool isStopped) noexcept;
+    bool UpdatePeakValues(bool isStopped) noexcept;
 
 private:
-    // Spectrum
-    void SpectrumProcessing(const audio_chunk & chunk) noexcept;
+    void DeleteAnalyzers() noexcept;
 
-    void GenerateLinearFrequencyBands();
-    void GenerateOctaveFrequencyBands();
-    void GenerateAveePlayerFrequencyBands();
-
-    void ApplyAcousticWeighting();
-    double GetWeight(double x) const noexcept;
-
-    void Normalize() noexcept;
-    void NormalizeWithAverageSmoothing(double factor) noexcept;
-    void NormalizeWithPeakSmoothing(double factor) noexcept;
+    // Spectrum
+    void SpectrumProcessing(const audio_chunk & chunk, int64_t position) noexcept;
 
     // Peak Meter / Level Meter
     void MeterProcessing(const audio_chunk & chunk) noexcept;
 
     void InitializePeakMeasurements(uint32_t channelMask) noexcept;
 
+    // Loudness Meter
+    void LoudnessProcessing(const audio_chunk & chunk) noexcept;
+
+    void InitializeLoudnessMeasurements() noexcept;
+
     // Oscilloscope
-    void OscilloscopeProcessing(const audio_chunk & chunk) noexcept;
+    void OscilloscopeProcessing(const std::shared_ptr<const audio_chunk> & chunk) noexcept;
 
     // Bit Meter
     void BitMeterProcessing(const audio_chunk & chunk) noexcept;
 
-    void InitializeBitMeasurements(uint32_t channelMask) noexcept;
+    void InitializeBitMeasurements(uint32_t channelMask, size_t bitCount) noexcept;
 
     double NormalizeValue(double amplitude) const noexcept
     {
@@ -164,9 +226,14 @@ public:
     const state_t * _State;
     const graph_description_t * _GraphDescription;
 
-    audio_chunk_impl _Chunk;    // Only used by oscilloscope
+    analysis_config_t _AnalysisConfig;          // Settings of the spectrum analyzers. Taken from the state when the instance is initialized.
+    band_config_t _BandConfig;                  // Settings of the frequency bands and the weighting. Taken from the state when the instance is initialized.
+
+    std::shared_ptr<const audio_chunk> _Chunk;  // Only used by the oscilloscope. Shared with the UI element instead of copied.
+    std::vector<min_max_pyramid_t> _Pyramids;   // Only used by the oscilloscope. One per selected channel in the chunk.
 
     uint32_t _SampleRate;
+    size_t _BinCount;                               // Size of the FFT. Depends on the sample rate.
     uint32_t _ChannelCount;
     uint32_t _ChannelConfig;
     uint32_t _ChannelMask;
@@ -177,6 +244,7 @@ public:
     const window_function_t * _BrownPucketteKernel;
 
     fft_analyzer_t * _FFTAnalyzer;
+    int64_t _FFTPosition;                           // Absolute index of the frame that follows the last frame added to the FFT analyzer.
     cqt_analyzer_t * _CQTAnalyzer;
     swift_analyzer_t * _SWIFTAnalyzer;
     analog_style_analyzer_t * _AnalogStyleAnalyzer;
@@ -184,9 +252,15 @@ public:
     frequency_bands_t _FrequencyBands;
 
     // Peak meter
-    uint32_t _PeakMeasuredChannels;
+    PeakMeasurementKind _PeakKind;
+    uint32_t _PeakMeasuredChannels;     // Only used by channel measurements.
     std::vector<peak_measurement_t> _PeakMeasurements;
 
+    meter_plan_t _MeterPlan;    // Channel layout compiled into frame offsets.
+    meter_block_t _MeterBlock;  // Result of the meter kernel for the current chunk.
+    true_peak_meter_t _TruePeakMeter;
+    loudness_meter_t _LoudnessMeter;
+
     double _RMSTimeElapsed; // Elapsed time in the current RMS window (in seconds).
     size_t _RMSFrameCount;  // Number of frames used in the current RMS window.
 
@@ -204,6 +278,8 @@ public:
     uint32_t _BitMeasuredChannels;
     std::vector<bit_measurement_t> _BitMeasurements;
 
+    uint32_t _BitCounters[meter_plan_t::MaxChannels][bit_meter_kernel_t::MaxBits]; // Number of times each bit is set per measured channel, least significant bit first.
+
     static const uint32_t ChannelPairs[6];
 
 private:
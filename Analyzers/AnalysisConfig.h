@@ -0,0 +1,48 @@
+
+/** $VER: AnalysisConfig.h (2026.10.18) P. Stuer - Represents the settings of the spectrum analyzers. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+
+#include <stddef.h>
+
+/// <summary>
+/// Represents the settings of the spectrum analyzers. The analyzers only depend on this structure so they can be created and run without the state of the user interface element.
+/// </summary>
+#pragma warning(disable: 4820)
+struct analysis_config_t
+{
+    // FFT
+    int KernelSize = 32;                        // Lanczos interpolation kernel size, 1 .. 64
+    SummationMethod Summation = SummationMethod::Maximum;
+    bool SmoothLowerFrequencies = true;
+    bool SmoothGainTransition = true;
+
+    Mapping MappingMethod = Mapping::Standard;
+
+    // Brown-Puckette CQT-specific
+    double BandwidthOffset = 1.;                // 0.0 .. 1.0, Transition smoothness
+    double BandwidthCap = 1.;                   // 0.0 .. 1.0, Minimum Brown-Puckette kernel size
+    double BandwidthAmount = 6.;                // 0 .. 256, Brown-Puckette kernel size
+    bool UseGranularBandwidth = true;           // True: Don't constrain bandwidth to powers of 2.
+
+    // CQT
+    double CQTBandwidthOffset = 1.;
+    double CQTAlignment = 1.;
+    double CQTDownSample = 0.;
+
+    // IIR (SWIFT / Analog-style analysis)
+    size_t FilterBankOrder = 4;                 // 1 .. 8, Filter bank order
+    double TimeResolution = 600.;               // 0 .. 2000, Max. time resolution (in ms)
+    double IIRBandwidth = 1.;                   // 0 .. 8, SWIFT Bandwidth
+    bool ConstantQ = true;                      // True, Use constant-Q instead of variable-Q.
+    bool CompensateBW = true;                   // True, Compensate bandwidth for narrowing on higher order filters (IIR filter banks only)
+    bool PreWarpQ = false;                      // True, Use prewarped Q (analog-style analyzer only)
+
+    bool operator==(const analysis_config_t &) const noexcept = default;
+};
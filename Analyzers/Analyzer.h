@@ -1,5 +1,5 @@
 
-/** $VER: Analyzer.h (2025.11.02) P. Stuer **/
+/** $VER: Analyzer.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -7,12 +7,11 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <Windows.h>
+#include <audio_math.h>
 
 using namespace std;
 
-#include "State.h"
+#include "AnalysisConfig.h"
 #include "WindowFunctions.h"
 
 /// <summary>
@@ -34,7 +33,7 @@ public:
     /// <summary>
     /// Initializes a new instance.
     /// </summary>
-    analyzer_t(const state_t * state, uint32_t sampleRate, uint32_t channelCount, uint32_t channelConfig, const window_function_t & windowFunction) : _State(state), _SampleRate(sampleRate), _ChannelCount(channelCount), _ChannelConfig(channelConfig), _WindowFunction(windowFunction)
+    analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelConfig, const window_function_t & windowFunction) : _Config(config), _SampleRate(sampleRate), _ChannelCount(channelCount), _ChannelConfig(channelConfig), _WindowFunction(windowFunction)
     {
         _NyquistFrequency = (double) _SampleRate / 2.;
     }
@@ -65,7 +64,7 @@ public:
     }
 
 protected:
-    const state_t * _State;
+    const analysis_config_t * _Config;
     uint32_t _SampleRate;
     uint32_t _ChannelCount; // Number of channels per frame.
     uint32_t _ChannelConfig; // Mask representing the channels present in the frame.
@@ -0,0 +1,168 @@
+
+/** $VER: AudioSource.cpp (2026.10.18) P. Stuer - Implements an audio source that fetches only the samples that were not fetched before. **/
+
+#include "AudioSource.h"
+
+#include <algorithm>
+#include <cmath>
+
+#pragma region sample_history_t
+
+/// <summary>
+/// Empties the ring and sets its format and capacity (in frames).
+/// </summary>
+void sample_history_t::Reset(uint32_t channelCount, size_t capacity) noexcept
+{
+    _ChannelCount = channelCount;
+    _Capacity     = capacity;
+    _Head         = 0;
+    _FrameCount   = 0;
+
+    _Data.resize(capacity * channelCount);
+}
+
+/// <summary>
+/// Appends frames to the ring. The oldest frames are overwritten when the ring is full.
+/// </summary>
+void sample_history_t::Append(const audio_sample * frames, size_t frameCount) noexcept
+{
+    if ((frames == nullptr) || (frameCount == 0) || (_Capacity == 0))
+        return;
+
+    // Only the last frames that fit in the ring are kept.
+    if (frameCount > _Capacity)
+    {
+        frames     += (frameCount - _Capacity) * _ChannelCount;
+        frameCount  = _Capacity;
+    }
+
+    const size_t Count = std::min(frameCount, _Capacity - _Head); // Number of frames until the end of the ring.
+
+    std::copy_n(frames, Count * _ChannelCount, _Data.data() + (_Head * _ChannelCount));
+    std::copy_n(frames + (Count * _ChannelCount), (frameCount - Count) * _ChannelCount, _Data.data());
+
+    _Head       = (_Head + frameCount) % _Capacity;
+    _FrameCount = std::min(_FrameCount + frameCount, _Capacity);
+}
+
+/// <summary>
+/// Copies the last frames of the ring to the specified buffer in chronological order.
+/// </summary>
+void sample_history_t::CopyLast(size_t frameCount, audio_sample * frames) const noexcept
+{
+    frameCount = std::min(frameCount, _FrameCount);
+
+    if ((frames == nullptr) || (frameCount == 0))
+        return;
+
+    const size_t First = (_Head + _Capacity - frameCount) % _Capacity;
+    const size_t Count = std::min(frameCount, _Capacity - First); // Number of frames until the end of the ring.
+
+    std::copy_n(_Data.data() + (First * _ChannelCount), Count * _ChannelCount, frames);
+    std::copy_n(_Data.data(), (frameCount - Count) * _ChannelCount, frames + (Count * _ChannelCount));
+}
+
+#pragma endregion
+
+#pragma region audio_source_t
+
+/// <summary>
+/// Forgets the history. The next update refills it completely.
+/// </summary>
+void audio_source_t::Reset() noexcept
+{
+    _History.Reset(0, 0);
+
+    _ChannelCount  = 0;
+    _ChannelConfig = 0;
+    _SampleRate    = 0;
+
+    _Position      = 0;
+    _WindowSize    = 0;
+    _NewFrameCount = 0;
+}
+
+/// <summary>
+/// Makes the window [offset, offset + length), in seconds, the current window. Only the frames after the last fetched frame are requested from the stream.
+/// Returns false if no audio is available.
+/// </summary>
+bool audio_source_t::Update(audio_stream_t & stream, double offset, double length) noexcept
+{
+    _NewFrameCount = 0;
+
+    if ((_SampleRate == 0) || (_History.GetFrameCount() == 0))
+        return Refill(stream, offset, length);
+
+    const int64_t First = std::llround(offset * (double) _SampleRate);
+    const int64_t Last  = First + std::llround(length * (double) _SampleRate);
+
+    if (Last <= First)
+        return false;
+
+    // Refill the history when the window does not continue from the history: after a seek, when the window grew or when it moved backwards.
+    const int64_t HistoryFirst = _Position - (int64_t) _History.GetFrameCount();
+
+    if ((First < HistoryFirst) || (First > _Position) || (Last < _Position) || ((size_t) (Last - First) > _History.GetCapacity()))
+        return Refill(stream, offset, length);
+
+    if (Last > _Position)
+    {
+        audio_frames_t Frames = { };
+
+        if (!stream.GetFrames((double) _Position / (double) _SampleRate, (double) (Last - _Position) / (double) _SampleRate, Frames))
+            return false;
+
+        if ((Frames.ChannelCount != _ChannelCount) || (Frames.ChannelConfig != _ChannelConfig) || (Frames.SampleRate != _SampleRate))
+            return Refill(stream, offset, length);
+
+        _History.Append(Frames.Data, Frames.FrameCount);
+
+        _Position     += (int64_t) Frames.FrameCount;
+        _NewFrameCount = Frames.FrameCount;
+    }
+
+    _WindowSize = (size_t) std::clamp(_Position - First, (int64_t) 0, (int64_t) _History.GetFrameCount());
+
+    return (_WindowSize != 0);
+}
+
+/// <summary>
+/// Copies the frames of the current window to the specified buffer. The buffer must be able to hold GetFrameCount() frames.
+/// </summary>
+void audio_source_t::CopyWindow(audio_sample * frames) const noexcept
+{
+    _History.CopyLast(_WindowSize, frames);
+}
+
+/// <summary>
+/// Fetches the complete window from the stream and replaces the history with it.
+/// </summary>
+bool audio_source_t::Refill(audio_stream_t & stream, double offset, double length) noexcept
+{
+    audio_frames_t Frames = { };
+
+    if (!stream.GetFrames(offset, length, Frames) || (Frames.Data == nullptr) || (Frames.FrameCount == 0) || (Frames.ChannelCount == 0) || (Frames.SampleRate == 0))
+    {
+        Reset();
+
+        return false;
+    }
+
+    _ChannelCount  = Frames.ChannelCount;
+    _ChannelConfig = Frames.ChannelConfig;
+    _SampleRate    = Frames.SampleRate;
+
+    // The capacity only grows so a window that shrinks and grows again does not cause a refill. The stream may return less than the window; the rest is fetched by the next update.
+    const size_t WindowSize = (size_t) std::max(std::llround(length * (double) _SampleRate), (long long) 0);
+
+    _History.Reset(_ChannelCount, std::max({ Frames.FrameCount, WindowSize, _History.GetCapacity() }));
+    _History.Append(Frames.Data, Frames.FrameCount);
+
+    _Position      = std::llround(offset * (double) _SampleRate) + (int64_t) Frames.FrameCount;
+    _WindowSize    = Frames.FrameCount;
+    _NewFrameCount = Frames.FrameCount;
+
+    return true;
+}
+
+#pragma endregion
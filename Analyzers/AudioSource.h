@@ -0,0 +1,111 @@
+
+/** $VER: AudioSource.h (2026.10.18) P. Stuer - Implements an audio source that fetches only the samples that were not fetched before. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <audio_math.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Represents a block of interleaved frames returned by an audio stream.
+/// </summary>
+#pragma warning(disable: 4820)
+struct audio_frames_t
+{
+    const audio_sample * Data;      // Interleaved frames. Only valid until the next request to the stream.
+    size_t FrameCount;
+    uint32_t ChannelCount;
+    uint32_t ChannelConfig;
+    uint32_t SampleRate;
+};
+
+/// <summary>
+/// Represents a stream of audio that can be queried by time. Implemented by the visualisation stream of the player and by stand-in streams.
+/// </summary>
+class audio_stream_t
+{
+public:
+    virtual ~audio_stream_t() noexcept { }
+
+    /// <summary>
+    /// Gets the frames in the window [offset, offset + length), in seconds. Returns false if no audio is available.
+    /// </summary>
+    virtual bool GetFrames(double offset, double length, audio_frames_t & frames) noexcept = 0;
+};
+
+/// <summary>
+/// Implements a ring of interleaved frames.
+/// </summary>
+class sample_history_t
+{
+public:
+    sample_history_t() noexcept : _ChannelCount(), _Capacity(), _Head(), _FrameCount() { }
+
+    void Reset(uint32_t channelCount, size_t capacity) noexcept;
+    void Append(const audio_sample * frames, size_t frameCount) noexcept;
+    void CopyLast(size_t frameCount, audio_sample * frames) const noexcept;
+
+    size_t GetFrameCount() const noexcept { return _FrameCount; }
+    size_t GetCapacity() const noexcept { return _Capacity; }
+
+private:
+    std::vector<audio_sample> _Data;
+    uint32_t _ChannelCount;
+    size_t _Capacity;               // Max. number of frames in the ring.
+    size_t _Head;                   // Index of the frame that will be written next.
+    size_t _FrameCount;             // Number of valid frames in the ring.
+};
+
+/// <summary>
+/// Implements an audio source that keeps track of the last fetched position and only requests the frames that were not fetched before.
+/// The history is refilled completely when the window jumps (seek, new track) or when the format of the stream changes.
+/// </summary>
+class audio_source_t
+{
+public:
+    audio_source_t() noexcept : _ChannelCount(), _ChannelConfig(), _SampleRate(), _Position(), _WindowSize(), _NewFrameCount() { }
+
+    void Reset() noexcept;
+    bool Update(audio_stream_t & stream, double offset, double length) noexcept;
+    void CopyWindow(audio_sample * frames) const noexcept;
+
+    /// <summary>
+    /// Gets the number of frames in the current window.
+    /// </summary>
+    size_t GetFrameCount() const noexcept { return _WindowSize; }
+
+    /// <summary>
+    /// Gets the number of frames at the end of the current window that were not part of the previous window.
+    /// </summary>
+    size_t GetNewFrameCount() const noexcept { return _NewFrameCount; }
+
+    /// <summary>
+    /// Gets the absolute index of the frame that follows the last frame of the current window.
+    /// </summary>
+    int64_t GetPosition() const noexcept { return _Position; }
+
+    uint32_t GetChannelCount() const noexcept { return _ChannelCount; }
+    uint32_t GetChannelConfig() const noexcept { return _ChannelConfig; }
+    uint32_t GetSampleRate() const noexcept { return _SampleRate; }
+
+private:
+    bool Refill(audio_stream_t & stream, double offset, double length) noexcept;
+
+private:
+    sample_history_t _History;
+
+    uint32_t _ChannelCount;
+    uint32_t _ChannelConfig;
+    uint32_t _SampleRate;
+
+    int64_t _Position;              // Absolute index of the frame that follows the last frame in the history.
+    size_t _WindowSize;             // Number of frames in the current window.
+    size_t _NewFrameCount;          // Number of frames fetched during the last update.
+};
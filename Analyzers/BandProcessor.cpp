@@ -0,0 +1,309 @@
+
+/** $VER: BandProcessor.cpp (2026.10.18) P. Stuer - Generates the frequency bands and weights and normalizes their values. **/
+
+#include "BandProcessor.h"
+#include "FrequencyScale.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cwchar>
+#include <iterator>
+
+static double GetFrequencyTilt(double x, double amount, double offset) noexcept;
+static double Equalize(double x, double amount, double depth, double offset) noexcept;
+static double GetAcousticWeight(double x, WeightingType weightingType, double weightAmount) noexcept;
+
+/// <summary>
+/// Scales the specified value to a relative amplitude between 0.0 and 1.0. The result is not clamped.
+/// </summary>
+double amplitude_scale_t::Scale(double value) const noexcept
+{
+    switch (Mode)
+    {
+        default:
+
+        case YAxisMode::None:
+
+        case YAxisMode::Decibels:
+            return (20. * std::log10(value) - AmplitudeLo) / (AmplitudeHi - AmplitudeLo);
+
+        case YAxisMode::Linear:
+        {
+            const double Exponent = 1. / Gamma;
+
+            const double RootLo = UseAbsolute ? 0. : std::pow(std::pow(10., AmplitudeLo / 20.), Exponent);
+            const double RootHi = std::pow(std::pow(10., AmplitudeHi / 20.), Exponent);
+
+            return (std::pow(value, Exponent) - RootLo) / (RootHi - RootLo);
+        }
+    }
+}
+
+#pragma region Frequencies
+
+/// <summary>
+/// Generates the frequency bands of the configured distribution.
+/// </summary>
+void band_processor_t::Generate(const band_config_t & config, frequency_bands_t & bands)
+{
+    switch (config.Distribution)
+    {
+        default:
+
+        case FrequencyDistribution::Linear:
+            GenerateLinear(config, bands);
+            break;
+
+        case FrequencyDistribution::Octaves:
+            GenerateOctaves(config, bands);
+            break;
+
+        case FrequencyDistribution::AveePlayer:
+            GenerateAveePlayer(config, bands);
+            break;
+    }
+}
+
+/// <summary>
+/// Generates frequency bands using a linear distribution of the scaled frequencies.
+/// </summary>
+void band_processor_t::GenerateLinear(const band_config_t & config, frequency_bands_t & bands)
+{
+    const double MinScale = ScaleFrequency(config.LoFrequency, config.Scaling, config.SkewFactor);
+    const double MaxScale = ScaleFrequency(config.HiFrequency, config.Scaling, config.SkewFactor);
+
+    const double n = (double) (config.BandCount - 1);
+
+    bands.resize(config.BandCount);
+
+    double i = 0.;
+
+    for (frequency_band_t & fb : bands)
+    {
+        fb.Lo     = DeScaleF(MinScale + ((i - config.Bandwidth) * (MaxScale - MinScale)) / n, config.Scaling, config.SkewFactor);
+        fb.Center = DeScaleF(MinScale + ( i                     * (MaxScale - MinScale)) / n, config.Scaling, config.SkewFactor);
+        fb.Hi     = DeScaleF(MinScale + ((i + config.Bandwidth) * (MaxScale - MinScale)) / n, config.Scaling, config.SkewFactor);
+
+        std::swprintf(fb.Label, std::size(fb.Label), L"%.2fHz", fb.Center);
+
+        fb.HasDarkBackground = true;
+
+        ++i;
+    }
+}
+
+/// <summary>
+/// Returns the MIDI note nearest to the specified frequency.
+/// </summary>
+static int FrequencyToNote(double frequency) noexcept
+{
+    const int A4 = 69;
+
+    return A4 + (int) std::round(12. * std::log2(frequency / 440.));
+}
+
+/// <summary>
+/// Returns the frequency of the specified MIDI note.
+/// </summary>
+static double NoteToFrequency(int note) noexcept
+{
+    const int A4 = 69;
+
+    return 440. * std::pow(2., (note - A4) / 12.);
+}
+
+/// <summary>
+/// Generates frequency bands based on the frequencies of musical notes.
+/// </summary>
+void band_processor_t::GenerateOctaves(const band_config_t & config, frequency_bands_t & bands)
+{
+    const double Root24 = std::exp2(1. / 24.); // 24 quarter tones (https://en.wikipedia.org/wiki/Quarter_tone)
+
+    const double TuningNote  = (config.TuningPitch > 0.) ? std::round(12.* (std::log2(config.TuningPitch) - 4.)) * 2. : 0.;  // Nearest MIDI note of the tuning frequency.
+    const double C0Frequency =  config.TuningPitch * std::pow(Root24, -TuningNote);                                         // Frequency of C0 tuned with the specified frequency (~16.35 Hz)
+
+    const double NoteGroup = 24. / config.BandsPerOctave;
+
+    const double LoIndex = std::round(config.MinNote * 2. / NoteGroup);
+    const double HiIndex = std::round(config.MaxNote * 2. / NoteGroup);
+
+    bands.clear();
+
+    static const wchar_t * NoteNames[] = { L"C", L"C#", L"D", L"D#", L"E", L"F", L"F#", L"G", L"G#", L"A", L"A#", L"B" };
+
+    for (double i = LoIndex; i <= HiIndex; ++i)
+    {
+        frequency_band_t fb
+        (
+            C0Frequency * std::pow(Root24, (i - config.Bandwidth) * NoteGroup + config.Transpose),
+            C0Frequency * std::pow(Root24,  i                     * NoteGroup + config.Transpose),
+            C0Frequency * std::pow(Root24, (i + config.Bandwidth) * NoteGroup + config.Transpose)
+        );
+
+        const double f = NoteToFrequency(FrequencyToNote(fb.Center));
+
+        // Pre-calculate the tooltip text and the band background color.
+        {
+            const uint32_t Note = (uint32_t) (i * (NoteGroup / 2.));
+
+            const uint32_t n      = Note % (uint32_t) std::size(NoteNames);
+            const uint32_t Octave = Note / (uint32_t) std::size(NoteNames);
+
+            if ((fb.Lo <= f) && (f <= fb.Hi))
+                std::swprintf(fb.Label, std::size(fb.Label), L"%ls%u\n%.2fHz", NoteNames[n], Octave, fb.Center);
+            else
+                std::swprintf(fb.Label, std::size(fb.Label), L"%.2fHz", fb.Center);
+
+            fb.HasDarkBackground = (n == 1 || n == 3 || n == 6 || n == 8 || n == 10);
+        }
+
+        bands.push_back(fb);
+    }
+}
+
+/// <summary>
+/// Generates frequency bands like AveePlayer.
+/// </summary>
+void band_processor_t::GenerateAveePlayer(const band_config_t & config, frequency_bands_t & bands)
+{
+    bands.resize(config.BandCount);
+
+    const size_t n = config.BandCount - 1;
+
+    double i = 0.;
+
+    for (frequency_band_t & fb : bands)
+    {
+        fb.Lo     = LogSpace(config.LoFrequency, config.HiFrequency, i - config.Bandwidth, n, config.SkewFactor);
+        fb.Center = LogSpace(config.LoFrequency, config.HiFrequency, i,                    n, config.SkewFactor);
+        fb.Hi     = LogSpace(config.LoFrequency, config.HiFrequency, i + config.Bandwidth, n, config.SkewFactor);
+
+        fb.HasDarkBackground = true;
+        std::swprintf(fb.Label, std::size(fb.Label), L"%.2fHz", fb.Center);
+
+        ++i;
+    }
+}
+
+#pragma endregion
+
+#pragma region Acoustic Weighting
+
+/// <summary>
+/// Applies the frequency tilt, the equalization and the acoustic weighting to the raw values of the bands. Does nothing when no weighting is selected.
+/// </summary>
+void band_processor_t::ApplyWeighting(const band_config_t & config, uint32_t sampleRate, size_t binCount, frequency_bands_t & bands) noexcept
+{
+    if (config.Weighting == WeightingType::None)
+        return;
+
+    const double Offset = ((config.SlopeFunctionOffset * (double) sampleRate) / (double) binCount);
+
+    for (frequency_band_t & fb : bands)
+        fb.RawValue *= GetWeight(config, fb.Center + Offset);
+}
+
+/// <summary>
+/// Gets the total weight of the specified frequency.
+/// </summary>
+double band_processor_t::GetWeight(const band_config_t & config, double frequency) noexcept
+{
+    const double a = GetFrequencyTilt(frequency, config.Slope, config.SlopeOffset);
+    const double b = Equalize(frequency, config.EqualizeAmount, config.EqualizeDepth, config.EqualizeOffset);
+    const double c = GetAcousticWeight(frequency, config.Weighting, config.WeightingAmount);
+
+    return a * b * c;
+}
+
+/// <summary>
+/// Gets the frequency tilt.
+/// </summary>
+static double GetFrequencyTilt(double x, double amount, double offset) noexcept
+{
+    return std::pow(x / offset, amount / 6.);
+}
+
+/// <summary>
+/// Equalizes the weight.
+/// </summary>
+static double Equalize(double x, double amount, double depth, double offset) noexcept
+{
+    const double pos = x * depth / offset;
+    const double bias = std::pow(1.0025, -pos) * 0.04;
+
+    return std::pow((10. * std::log10(1. + bias + (pos + 1.) * (9. - bias) / depth)), amount / 6.);
+}
+
+/// <summary>
+/// Gets the weight for the specified frequency.
+/// </summary>
+static double GetAcousticWeight(double x, WeightingType weightType, double weightAmount) noexcept
+{
+    const double f2 = x * x;
+
+    switch (weightType)
+    {
+        default:
+
+        case WeightingType::None:
+            return 1.;
+
+        case WeightingType::AWeighting:
+            return std::pow(1.2588966          * 148840000 * (f2 * f2)       / ((f2 + 424.36) * std::sqrt((f2 + 11599.29) * (f2 + 544496.41)) * (f2 + 148840000.)), weightAmount);
+
+        case WeightingType::BWeighting:
+            return std::pow(1.019764760044717  * 148840000 * std::pow(x, 3.) / ((f2 + 424.36) * std::sqrt(f2 + 25122.25)                       * (f2 + 148840000.)), weightAmount);
+
+        case WeightingType::CWeighting:
+            return std::pow(1.0069316688518042 * 148840000 * f2              / ((f2 + 424.36)                                                  * (f2 + 148840000.)), weightAmount);
+
+        case WeightingType::DWeighting:
+            return std::pow(x / 6.8966888496476e-5 * std::sqrt(((1037918.48 - f2) * (1037918.48 - f2) + 1080768.16 * f2) / ((9837328. - f2) * (9837328. - f2) + 11723776. * f2) / ((f2 + 79919.29) * (f2 + 1345600.))), weightAmount);
+
+        case WeightingType::MWeighting:
+        {
+            const double h1 = -4.737338981378384e-24 * std::pow(f2, 3.) + 2.043828333606125e-15 * (f2 * f2)       - 1.363894795463638e-7 * f2 + 1;
+            const double h2 =  1.306612257412824e-19 * std::pow( x, 5.) - 2.118150887518656e-11 * std::pow(x, 3.) + 5.559488023498642e-4 * x;
+
+            return std::pow(8.128305161640991 * 1.246332637532143e-4 * x / std::hypot(h1, h2), weightAmount);
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma region Normalization
+
+/// <summary>
+/// Normalizes the raw values of the bands to the range [0, 1] and smooths them with the previous values.
+/// </summary>
+void band_processor_t::Normalize(const amplitude_scale_t & scale, SmoothingMethod method, double factor, frequency_bands_t & bands) noexcept
+{
+    switch (method)
+    {
+        default:
+
+        case SmoothingMethod::None:
+        {
+            for (frequency_band_t & fb : bands)
+                fb.Value = std::clamp(scale.Scale(fb.RawValue), 0., 1.);
+            break;
+        }
+
+        case SmoothingMethod::Average:
+        {
+            for (frequency_band_t & fb : bands)
+                fb.Value = std::clamp((fb.Value * factor) + (std::isfinite(fb.RawValue) ? scale.Scale(fb.RawValue) * (1. - factor) : 0.), 0., 1.);
+            break;
+        }
+
+        case SmoothingMethod::Peak:
+        {
+            for (frequency_band_t & fb : bands)
+                fb.Value = std::clamp(std::max(fb.Value * factor, std::isfinite(fb.RawValue) ? scale.Scale(fb.RawValue) : 0.), 0., 1.);
+            break;
+        }
+    }
+}
+
+#pragma endregion
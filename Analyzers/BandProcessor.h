@@ -0,0 +1,87 @@
+
+/** $VER: BandProcessor.h (2026.10.18) P. Stuer - Generates the frequency bands and weights and normalizes their values. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+#include "FrequencyBand.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// <summary>
+/// Represents the settings of the frequency bands and of the weighting of their values. The defaults are the defaults of the component.
+/// </summary>
+#pragma warning(disable: 4820)
+struct band_config_t
+{
+    FrequencyDistribution Distribution = FrequencyDistribution::Octaves;
+
+    // Linear and AveePlayer distribution
+    size_t BandCount = 320;                     // Number of frequency bands, 2 .. 512
+    double LoFrequency = 20.;                   // Hz
+    double HiFrequency = 20000.;                // Hz
+
+    ScalingFunction Scaling = ScalingFunction::Logarithmic;
+    double SkewFactor = 0.;                     // 0.0 .. 1.0
+
+    // Octaves distribution
+    double MinNote = 0.;                        // C0
+    double MaxNote = 126.;                      // F#10
+    double BandsPerOctave = 12.;                // 1 .. 48
+    double TuningPitch = 440.;                  // Hz
+    int Transpose = 0;                          // -24 .. 24 quarter tones
+
+    double Bandwidth = 0.5;                     // Distance between the center and the bounds of a band (in bands). Only wider than 0.5 for the triangular filter bank and the CQT.
+
+    // Weighting
+    WeightingType Weighting = WeightingType::None;
+    double WeightingAmount = 0.;                // -1 .. 1
+
+    double SlopeFunctionOffset = 1.;            // 0 .. 8, Slope function offset expressed in sample rate / FFT size in samples.
+    double Slope = 0.;                          // -12 .. 12, Frequency slope (dB per octave)
+    double SlopeOffset = 1000.;                 // Hz = 0 dB
+
+    double EqualizeAmount = 0.;                 // -12 .. 12
+    double EqualizeOffset = 44100.;
+    double EqualizeDepth = 1024.;
+
+    bool operator==(const band_config_t &) const noexcept = default;
+};
+
+/// <summary>
+/// Represents the scale of the amplitude axis. Maps amplitudes to relative values between 0.0 and 1.0.
+/// </summary>
+struct amplitude_scale_t
+{
+    YAxisMode Mode = YAxisMode::Decibels;
+    double AmplitudeLo = -90.;                  // dBFS
+    double AmplitudeHi = 0.;                    // dBFS
+    double Gamma = 1.;                          // Linear/n-th root scaling: Index n of the n-th root calculation, 0.5 .. 10.0
+    bool UseAbsolute = true;                    // Linear/n-th root scaling: Maps the lower amplitude to -∞ dB.
+
+    double Scale(double value) const noexcept;
+};
+
+/// <summary>
+/// Generates the frequency bands and weights and normalizes their values. Shared by the analysis of the component and the offline tools. Portable: does not depend on Windows.
+/// </summary>
+class band_processor_t
+{
+public:
+    static void Generate(const band_config_t & config, frequency_bands_t & bands);
+
+    static void ApplyWeighting(const band_config_t & config, uint32_t sampleRate, size_t binCount, frequency_bands_t & bands) noexcept;
+    static double GetWeight(const band_config_t & config, double frequency) noexcept;
+
+    static void Normalize(const amplitude_scale_t & scale, SmoothingMethod method, double factor, frequency_bands_t & bands) noexcept;
+
+private:
+    static void GenerateLinear(const band_config_t & config, frequency_bands_t & bands);
+    static void GenerateOctaves(const band_config_t & config, frequency_bands_t & bands);
+    static void GenerateAveePlayer(const band_config_t & config, frequency_bands_t & bands);
+};
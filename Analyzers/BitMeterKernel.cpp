@@ -0,0 +1,155 @@
+
+/** $VER: BitMeterKernel.cpp (2026.10.18) P. Stuer - Implements the bit-plane counting kernel of the bit meter. **/
+
+#include "BitMeterKernel.h"
+#include "SIMD.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+/// <summary>
+/// Gets the number of bits of a sample in the specified view.
+/// </summary>
+size_t bit_meter_kernel_t::GetBitCount(BitMeterView view) noexcept
+{
+    switch (view)
+    {
+        default:
+
+        case BitMeterView::Native: return audio_sample_size;
+        case BitMeterView::Int16:  return 16;
+        case BitMeterView::Int24:  return 24;
+        case BitMeterView::Int32:  return 32;
+    }
+}
+
+/// <summary>
+/// Adds the number of times each bit is set in the samples of each measured channel to the counters. Bit 0 is the least significant bit.
+/// </summary>
+void bit_meter_kernel_t::Process(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, BitMeterView view, uint32_t (* counts)[MaxBits]) noexcept
+{
+    static const count_fn Implementation = SelectImplementation();
+
+    if ((frames == nullptr) || (frameCount == 0) || (plan.ChannelCount == 0) || (plan.ChannelCount > meter_plan_t::MaxChannels))
+        return;
+
+    const size_t BitCount  = GetBitCount(view);
+    const size_t ByteCount = std::min(BitCount, (size_t) 32) / 8; // Number of significant bytes in each 32-bit value.
+
+    const double Scale = (view == BitMeterView::Native) ? 0. : (double) (1ULL << (BitCount - 1));
+    const double Min   = -Scale;
+    const double Max   =  Scale - 1.;
+
+    const uint32_t Mask = (BitCount < 32) ? (uint32_t) ((1ULL << BitCount) - 1) : ~0U;
+
+    alignas(16) uint32_t Lo[GroupSize]; // The value of the sample or the least significant 32 bits of a 64-bit value.
+    alignas(16) uint32_t Hi[GroupSize]; // The most significant 32 bits of a 64-bit value.
+
+    for (size_t i = 0; i < plan.MeasuredCount; ++i)
+    {
+        const audio_sample * Sample = frames + plan.MeasuredOffsets[i];
+
+        for (size_t j = 0; j < frameCount; j += GroupSize)
+        {
+            const size_t n = std::min(frameCount - j, GroupSize);
+
+            // Gather the samples of the channel and convert them to the requested view.
+            for (size_t k = 0; k < n; ++k, Sample += plan.ChannelCount)
+            {
+                if (view == BitMeterView::Native)
+                {
+                #if (audio_sample_size == 64)
+                    const uint64_t Value = std::bit_cast<uint64_t>(*Sample);
+
+                    Lo[k] = (uint32_t) Value;
+                    Hi[k] = (uint32_t) (Value >> 32);
+                #else
+                    Lo[k] = std::bit_cast<uint32_t>(*Sample);
+                #endif
+                }
+                else
+                    Lo[k] = (uint32_t) (int32_t) std::floor(std::clamp((double) *Sample * Scale, Min, Max) + 0.5) & Mask;
+            }
+
+            // Pad the last group with zeroes. They don't contribute to the counts.
+            for (size_t k = n; k < GroupSize; ++k)
+                Lo[k] = Hi[k] = 0;
+
+            Implementation(Lo, ByteCount, counts[i]);
+
+        #if (audio_sample_size == 64)
+            if (view == BitMeterView::Native)
+                Implementation(Hi, 4, counts[i] + 32);
+        #endif
+        }
+    }
+}
+
+/// <summary>
+/// Selects the fastest implementation supported by the CPU.
+/// </summary>
+bit_meter_kernel_t::count_fn bit_meter_kernel_t::SelectImplementation() noexcept
+{
+#if defined(SIMD_SSE2_BASELINE)
+    return CountSSE2; // SSE2 is part of the baseline of the target.
+#elif defined(SIMD_SSE2)
+    return ::IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) ? CountSSE2 : CountScalar;
+#else
+    return CountScalar;
+#endif
+}
+
+/// <summary>
+/// Counts the set bits of a group of values by visiting only the bits that are set.
+/// </summary>
+void bit_meter_kernel_t::CountScalar(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept
+{
+    for (size_t i = 0; i < GroupSize; ++i)
+    {
+        for (uint32_t Value = values[i]; Value != 0; Value &= Value - 1)
+            ++counts[std::countr_zero(Value)];
+    }
+}
+
+#if defined(SIMD_SSE2)
+
+/// <summary>
+/// Counts the set bits of a group of values using SSE2. The values are transposed one byte at a time into a 16-lane byte vector.
+/// Each bit plane is then extracted with a single movemask and counted with a popcount.
+/// </summary>
+void bit_meter_kernel_t::CountSSE2(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept
+{
+    const __m128i v0 = _mm_load_si128((const __m128i *) values);
+    const __m128i v1 = _mm_load_si128((const __m128i *) values + 1);
+    const __m128i v2 = _mm_load_si128((const __m128i *) values + 2);
+    const __m128i v3 = _mm_load_si128((const __m128i *) values + 3);
+
+    const __m128i ByteMask = _mm_set1_epi32(0xFF);
+
+    for (size_t i = 0; i < byteCount; ++i, counts += 8)
+    {
+        const __m128i Shift = _mm_cvtsi32_si128((int) (i * 8));
+
+        // Extract byte i of the 16 values into one vector.
+        const __m128i b0 = _mm_and_si128(_mm_srl_epi32(v0, Shift), ByteMask);
+        const __m128i b1 = _mm_and_si128(_mm_srl_epi32(v1, Shift), ByteMask);
+        const __m128i b2 = _mm_and_si128(_mm_srl_epi32(v2, Shift), ByteMask);
+        const __m128i b3 = _mm_and_si128(_mm_srl_epi32(v3, Shift), ByteMask);
+
+        __m128i Plane = _mm_packus_epi16(_mm_packs_epi32(b0, b1), _mm_packs_epi32(b2, b3));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(Plane, _mm_setzero_si128())) == 0xFFFF)
+            continue; // None of the bits in this byte are set.
+
+        // Shift each bit into the most significant bit of its byte, starting with bit 7.
+        for (size_t j = 8; j-- > 0; )
+        {
+            counts[j] += (uint32_t) std::popcount((uint32_t) _mm_movemask_epi8(Plane));
+
+            Plane = _mm_add_epi8(Plane, Plane);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,38 @@
+
+/** $VER: BitMeterKernel.h (2026.10.18) P. Stuer - Implements the bit-plane counting kernel of the bit meter. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+#include "MeterKernel.h"
+#include "SIMD.h"
+
+/// <summary>
+/// Implements the bit-plane counting kernel of the bit meter. Dispatches to a vectorized implementation when the CPU supports it.
+/// </summary>
+class bit_meter_kernel_t
+{
+public:
+    static const size_t MaxBits = 64;
+    static const size_t GroupSize = 16; // Number of samples of a channel that are counted at once.
+
+    static size_t GetBitCount(BitMeterView view) noexcept;
+
+    static void Process(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, BitMeterView view, uint32_t (* counts)[MaxBits]) noexcept;
+
+private:
+    friend struct bit_meter_kernel_test_t; // Compares the implementations with each other.
+
+    using count_fn = void (*)(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept;
+
+    static count_fn SelectImplementation() noexcept;
+
+    static void CountScalar(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept;
+#if defined(SIMD_SSE2)
+    static void CountSSE2(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept;
+#endif
+};
@@ -1,17 +1,12 @@
 
-/** $VER: CQTAnalyzer.cpp (2025.10.19) P. Stuer - Based on TF3RDL's Constant-Q analyzer, https://codepen.io/TF3RDL/pen/poQJwRW **/
+/** $VER: CQTAnalyzer.cpp (2026.10.18) P. Stuer - Based on TF3RDL's Constant-Q analyzer, https://codepen.io/TF3RDL/pen/poQJwRW **/
 
-#include "pch.h"
 #include "CQTAnalyzer.h"
 
-#include "Support.h"
-
-#pragma hdrstop
-
 /// <summary>
 /// Initializes a new instance.
 /// </summary>
-cqt_analyzer_t::cqt_analyzer_t(const state_t * state, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction) : analyzer_t(state, sampleRate, channelCount, channelSetup, windowFunction)
+cqt_analyzer_t::cqt_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction) : analyzer_t(config, sampleRate, channelCount, channelSetup, windowFunction)
 {
 }
 
@@ -28,10 +23,10 @@ bool cqt_analyzer_t::AnalyzeSamples(const audio_sample * frames, size_t frameCou
 
     for (frequency_band_t & fb : frequencyBands)
     {
-        const double Bandwidth  = std::abs(fb.Hi - fb.Lo) + (SampleDuration * _State->_CQTBandwidthOffset);
+        const double Bandwidth  = std::abs(fb.Hi - fb.Lo) + (SampleDuration * _Config->CQTBandwidthOffset);
         const double TimeLength = std::min(1. / Bandwidth, 1. / SampleDuration);
 
-        double SamplingPeriod = std::max(1., std::trunc(((double) _SampleRate * _State->_CQTDownSample) / (fb.Center + TimeLength)));
+        double SamplingPeriod = std::max(1., std::trunc(((double) _SampleRate * _Config->CQTDownSample) / (fb.Center + TimeLength)));
 
         if (!UseGranularSamplingPeriod)
             SamplingPeriod = std::pow(2., std::trunc(std::log2(SamplingPeriod)));
@@ -45,7 +40,7 @@ bool cqt_analyzer_t::AnalyzeSamples(const audio_sample * frames, size_t frameCou
         if (!UseGranularBandwidth)
             BandSampleCount = std::min(std::trunc(std::pow(2., std::round(std::log2(BandSampleCount)))), (double) SampleCount);
 
-        const double Offset = std::trunc(((double) SampleCount - BandSampleCount) * (0.5 + _State->_CQTAlignment / 2.));
+        const double Offset = std::trunc(((double) SampleCount - BandSampleCount) * (0.5 + _Config->CQTAlignment / 2.));
 
         const double LoIdx = Offset;
         const double HiIdx = LoIdx + std::trunc(BandSampleCount) - 1.;
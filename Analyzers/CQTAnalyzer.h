@@ -1,5 +1,5 @@
 
-/** $VER: CQTAnalyzer.h (2025.10.05) P. Stuer **/
+/** $VER: CQTAnalyzer.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -7,10 +7,6 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <WinSock2.h>
-#include <Windows.h>
-
 #include "Analyzer.h"
 #include "FrequencyBand.h"
 
@@ -30,6 +26,6 @@ public:
 
     virtual ~cqt_analyzer_t() { }
 
-    cqt_analyzer_t(const state_t * configuration, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction);
+    cqt_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction);
     bool AnalyzeSamples(const audio_sample * frames, size_t frameCount, uint32_t selectedChannels, frequency_bands_t & frequencyBands) noexcept;
 };
@@ -1,14 +1,32 @@
 
-/** $VER: FFTAnalyzer.cpp (2026.02.11) P. Stuer - Based on TF3RDL's FFT analyzer, https://codepen.io/TF3RDL/pen/poQJwRW **/
+/** $VER: FFTAnalyzer.cpp (2026.10.18) P. Stuer - Based on TF3RDL's FFT analyzer, https://codepen.io/TF3RDL/pen/poQJwRW **/
 
-#include "pch.h"
 #include "FFTAnalyzer.h"
 
-#include "Log.h"
+#include <cfloat>
 
+#include "StageTimings.h"
+
+#include <algorithm>
 #include <execution>
+#include <limits>
 
-#pragma hdrstop
+/// <summary>
+/// Maps a value from one range to another. Same as Map() which is not available without Windows.
+/// </summary>
+template<class T, class U>
+static inline U Map(T value, T srcMin, T srcMax, U dstMin, U dstMax) noexcept
+{
+    return dstMin + (U) (((double) (value - srcMin) * (double) (dstMax - dstMin)) / (double) (srcMax - srcMin));
+}
+
+/// <summary>
+/// Wraps an index around the specified size. Same as Wrap() which is not available without Windows.
+/// </summary>
+static inline size_t Wrap(size_t value, size_t size) noexcept
+{
+    return (size + (value % size)) % size;
+}
 
 /// <summary>
 /// Destroys this instance.
@@ -20,7 +38,7 @@ fft_analyzer_t::~fft_analyzer_t()
 /// <summary>
 /// Initializes an instance of the class.
 /// </summary>
-fft_analyzer_t::fft_analyzer_t(const state_t * state, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction, const window_function_t & brownPucketteKernel, size_t fftSize) : analyzer_t(state, sampleRate, channelCount, channelSetup, windowFunction), _BrownPucketteKernel(brownPucketteKernel)
+fft_analyzer_t::fft_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction, const window_function_t & brownPucketteKernel, size_t fftSize) : analyzer_t(config, sampleRate, channelCount, channelSetup, windowFunction), _BrownPucketteKernel(brownPucketteKernel)
 {
     _FFTSize = fftSize;
 
@@ -39,13 +57,21 @@ fft_analyzer_t::fft_analyzer_t(const state_t * state, uint32_t sampleRate, uint3
 /// </summary>
 bool fft_analyzer_t::AnalyzeSamples(const audio_sample * frameData, size_t frameCount, uint32_t selectedChannels, frequency_bands_t & frequencyBands) noexcept
 {
-//  const auto Start = std::chrono::steady_clock::now();
+    {
+        scoped_stage_timer_t Timer(Stage::Downmix);
 
-    Add(frameData, frameCount, selectedChannels);
+        Add(frameData, frameCount, selectedChannels);
+    }
 
-    Transform();
+    {
+        scoped_stage_timer_t Timer(Stage::Transform);
 
-    switch (_State->_MappingMethod)
+        Transform();
+    }
+
+    scoped_stage_timer_t Timer(Stage::Mapping);
+
+    switch (_Config->MappingMethod)
     {
         default:
 
@@ -62,10 +88,6 @@ bool fft_analyzer_t::AnalyzeSamples(const audio_sample * frameData, size_t frame
             break;
     }
 
-//  const auto Finish = std::chrono::steady_clock::now();
-
-//  Log.AtInfo().Write("%6d ms", std::chrono::duration_cast<std::chrono::milliseconds>(Finish - Start));
-
     return true;
 }
 
@@ -108,7 +130,7 @@ void fft_analyzer_t::Transform() noexcept
 
         for (auto & Iter : _TimeData)
         {
-            const double WindowFactor = _WindowFunction(msc::Map(j, (size_t) 0, _FFTSize - 1, -1., 1.));
+            const double WindowFactor = _WindowFunction(Map(j, (size_t) 0, _FFTSize - 1, -1., 1.));
 
             Iter = std::complex<double>(p[i] * WindowFactor, 0.);
 
@@ -148,10 +170,10 @@ void fft_analyzer_t::Transform() noexcept
 /// </summary>
 void fft_analyzer_t::AnalyzeSamples(uint32_t sampleRate, frequency_bands_t & freqBands) const noexcept
 {
-    const bool IsRMS       =  (_State->_SummationMethod == SummationMethod::RMS || _State->_SummationMethod == SummationMethod::RMSSum);
-    const bool IsMedian    =   _State->_SummationMethod == SummationMethod::Median;
-    const bool UseBandGain =  (_State->_SmoothGainTransition && (_State->_SummationMethod == SummationMethod::Sum || _State->_SummationMethod == SummationMethod::RMSSum));
-    const bool IsAverage   = ((_State->_SummationMethod == SummationMethod::Average || _State->_SummationMethod == SummationMethod::RMS) || UseBandGain);
+    const bool IsRMS       =  (_Config->Summation == SummationMethod::RMS || _Config->Summation == SummationMethod::RMSSum);
+    const bool IsMedian    =   _Config->Summation == SummationMethod::Median;
+    const bool UseBandGain =  (_Config->SmoothGainTransition && (_Config->Summation == SummationMethod::Sum || _Config->Summation == SummationMethod::RMSSum));
+    const bool IsAverage   = ((_Config->Summation == SummationMethod::Average || _Config->Summation == SummationMethod::RMS) || UseBandGain);
 
     std::vector<double> Values;
 
@@ -162,14 +184,14 @@ void fft_analyzer_t::AnalyzeSamples(uint32_t sampleRate, frequency_bands_t & fre
         double LoIdx = HzToBinIndex(fb.Lo, _FreqData.size(), sampleRate);
         double HiIdx = HzToBinIndex(fb.Hi, _FreqData.size(), sampleRate);
 
-        LoIdx = (_State->_SmoothLowerFrequencies ? std::round(LoIdx) + 1. : std::ceil(LoIdx));
-        HiIdx = (_State->_SmoothLowerFrequencies ? std::round(HiIdx) - 1. : std::floor(HiIdx));
+        LoIdx = (_Config->SmoothLowerFrequencies ? std::round(LoIdx) + 1. : std::ceil(LoIdx));
+        HiIdx = (_Config->SmoothLowerFrequencies ? std::round(HiIdx) - 1. : std::floor(HiIdx));
 
         if (LoIdx <= HiIdx)
         {
             HiIdx -= std::max(HiIdx - LoIdx - (double) _FreqData.size(), 0.);
 
-            double Value = (_State->_SummationMethod == SummationMethod::Minimum) ? DBL_MAX : 0.;
+            double Value = (_Config->Summation == SummationMethod::Minimum) ? std::numeric_limits<double>::max() : 0.;
 
             Values.clear();
 
@@ -177,11 +199,11 @@ void fft_analyzer_t::AnalyzeSamples(uint32_t sampleRate, frequency_bands_t & fre
 
             for (auto Idx = LoIdx; Idx <= HiIdx; ++Idx)
             {
-                const size_t BinIdx = msc::Wrap((size_t) Idx, _FreqData.size());
+                const size_t BinIdx = Wrap((size_t) Idx, _FreqData.size());
 
                 const double Magnitude = std::abs(_FreqData[BinIdx]);
 
-                switch (_State->_SummationMethod)
+                switch (_Config->Summation)
                 {
                     case SummationMethod::Minimum:
                         Value = std::min(Magnitude, Value);
@@ -224,7 +246,7 @@ void fft_analyzer_t::AnalyzeSamples(uint32_t sampleRate, frequency_bands_t & fre
         {
             const double Index = HzToBinIndex(fb.Center, _FreqData.size(), sampleRate);
 
-            fb.RawValue = std::fabs(Interpolate(_FreqData, Index, _State->_KernelSize)) * BandGain;
+            fb.RawValue = std::fabs(Interpolate(_FreqData, Index, _Config->KernelSize)) * BandGain;
         }
     }
 }
@@ -248,10 +270,10 @@ void fft_analyzer_t::AnalyzeSamplesUsingTFB(uint32_t sampleRate, frequency_bands
         const double OverflowCompensation = std::max(0., MaxBin - MinBin - (double) _FreqData.size());
 
         for (double i = std::floor(MidBin); i >= std::floor(MinBin + OverflowCompensation); --i)
-            Sum += std::pow(std::abs(_FreqData[msc::Wrap((size_t) i, _FreqData.size())]) * std::max(msc::Map(i, MinBin, MidBin, 0., 1.), 0.), 2.);
+            Sum += std::pow(std::abs(_FreqData[Wrap((size_t) i, _FreqData.size())]) * std::max(Map(i, MinBin, MidBin, 0., 1.), 0.), 2.);
 
         for (double i = std::ceil(MidBin); i <= std::ceil(MaxBin - OverflowCompensation); ++i)
-            Sum += std::pow(std::abs(_FreqData[msc::Wrap((size_t) i, _FreqData.size())]) * std::max(msc::Map(i, MaxBin, MidBin, 0., 1.), 0.), 2.);
+            Sum += std::pow(std::abs(_FreqData[Wrap((size_t) i, _FreqData.size())]) * std::max(Map(i, MaxBin, MidBin, 0., 1.), 0.), 2.);
 
         fb.RawValue = std::sqrt(Sum);
     }
@@ -272,10 +294,10 @@ void fft_analyzer_t::AnalyzeSamplesUsingBP(uint32_t sampleRate, frequency_bands_
 
         const double Center      = fb.Center * HzToBin;
 
-        const double Bandwidth    = std::abs(fb.Hi - fb.Lo) + (double) sampleRate / (double) _FreqData.size() * _State->_BandwidthOffset;
-        const double tlen         = std::min(1. / Bandwidth, HzToBin / _State->_BandwidthCap);
-        const double actualLength = _State->_UseGranularBandwidth ? tlen * sampleRate : std::min(std::trunc(std::pow(2., std::round(std::log2(tlen * sampleRate)))), (double) _FreqData.size() / _State->_BandwidthCap);
-        const double flen         = std::min(_State->_BandwidthAmount * (double) _FreqData.size() / actualLength, (double) _FreqData.size());
+        const double Bandwidth    = std::abs(fb.Hi - fb.Lo) + (double) sampleRate / (double) _FreqData.size() * _Config->BandwidthOffset;
+        const double tlen         = std::min(1. / Bandwidth, HzToBin / _Config->BandwidthCap);
+        const double actualLength = _Config->UseGranularBandwidth ? tlen * sampleRate : std::min(std::trunc(std::pow(2., std::round(std::log2(tlen * sampleRate)))), (double) _FreqData.size() / _Config->BandwidthCap);
+        const double flen         = std::min(_Config->BandwidthAmount * (double) _FreqData.size() / actualLength, (double) _FreqData.size());
 
         const double Start        = std::ceil (Center - flen / 2.);
         const double End          = std::floor(Center + flen / 2.);
@@ -319,7 +341,7 @@ double fft_analyzer_t::Interpolate(const std::vector<std::complex<double>> & fft
         if ((i & 1) == 0)
             Weight = -Weight;
 
-        const size_t CoefIdx = msc::Wrap((size_t) Index, fftCoeffs.size());
+        const size_t CoefIdx = Wrap((size_t) Index, fftCoeffs.size());
 
         Sum += fftCoeffs[CoefIdx] * Weight;
     }
@@ -1,5 +1,5 @@
 
-/** $VER: FFTAnalyzer.h (2026.02.08) P. Stuer **/
+/** $VER: FFTAnalyzer.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -7,10 +7,6 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <WinSock2.h>
-#include <Windows.h>
-
 #include "Analyzer.h"
 #include "FrequencyBand.h"
 
@@ -32,7 +28,7 @@ public:
 
     virtual ~fft_analyzer_t();
 
-    fft_analyzer_t(const state_t * state, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction, const window_function_t & brownPucketteKernel, size_t fftSize);
+    fft_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup, const window_function_t & windowFunction, const window_function_t & brownPucketteKernel, size_t fftSize);
     bool AnalyzeSamples(const audio_sample * samples, size_t sampleCount, uint32_t channels, frequency_bands_t & frequencyBands) noexcept;
 
 private:
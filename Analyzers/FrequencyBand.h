@@ -1,5 +1,5 @@
 
-/** $VER: FrequencyBand.h (2024.03.02) P. Stuer **/
+/** $VER: FrequencyBand.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -7,18 +7,15 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <Windows.h>
-#include <d2d1_2.h>
-
+#include <cstring>
 #include <vector>
 
 #pragma warning(disable: 4820)
 struct frequency_band_t
 {
-    frequency_band_t() : RawValue(), Value(), Lo(), Center(), Hi(), MaxValue(), HoldTime(), DecaySpeed(), Opacity() { }
+    frequency_band_t() : RawValue(), Value(), Lo(), Center(), Hi(), MaxValue(), HoldTime(), DecaySpeed(), Opacity(), Label(), HasDarkBackground() { }
 
-    frequency_band_t(double l, double c, double h) : RawValue(), Value(), Lo(l), Center(c), Hi(h), MaxValue(), HoldTime(), DecaySpeed(), Opacity() { }
+    frequency_band_t(double l, double c, double h) : RawValue(), Value(), Lo(l), Center(c), Hi(h), MaxValue(), HoldTime(), DecaySpeed(), Opacity(), Label(), HasDarkBackground() { }
 
     frequency_band_t(const frequency_band_t & other)
     {
@@ -37,7 +34,6 @@ struct frequency_band_t
         ::memcpy(Label, other.Label, sizeof(Label));
 
         HasDarkBackground = other.HasDarkBackground;
-        GradientColor     = other.GradientColor;
     }
 
     virtual ~frequency_band_t() noexcept { }
@@ -54,9 +50,8 @@ struct frequency_band_t
     double DecaySpeed;  // Speed at which the current peak value decays.
     double Opacity;     // 0.0 .. 1.0, The opacity of the maximum indicator
 
-    WCHAR Label[16];
+    wchar_t Label[16];
     bool HasDarkBackground;
-    D2D1_COLOR_F GradientColor;
 };
 
 typedef std::vector<frequency_band_t> frequency_bands_t;
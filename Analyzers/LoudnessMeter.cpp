@@ -0,0 +1,330 @@
+
+/** $VER: LoudnessMeter.cpp (2026.10.18) P. Stuer - Implements a streaming loudness meter (ITU-R BS.1770-4, EBU R128, EBU Tech 3342). **/
+
+#include "LoudnessMeter.h"
+
+#include <algorithm>
+#include <iterator>
+#include "Constants.h"
+
+/// <summary>
+/// Resets the meter. Starts a new measurement.
+/// </summary>
+void loudness_meter_t::Reset() noexcept
+{
+    _ChannelCount  = 0;
+    _ChannelConfig = 0;
+    _SampleRate    = 0;
+
+    _PreFilter = { };
+    _RLBFilter = { };
+
+    std::fill(std::begin(_Weights), std::end(_Weights), 0.);
+
+    for (auto & State : _State)
+        std::fill(std::begin(State), std::end(State), 0.);
+
+    _BlockSize       = 0;
+    _BlockFrameCount = 0;
+    _BlockSum        = 0.;
+
+    std::fill(std::begin(_BlockEnergies), std::end(_BlockEnergies), 0.);
+
+    _BlockIndex = 0;
+    _BlockCount = 0;
+    _HopCount   = 0;
+
+    std::fill(std::begin(_MomentaryHistogram), std::end(_MomentaryHistogram), 0U);
+    std::fill(std::begin(_MomentaryEnergies), std::end(_MomentaryEnergies), 0.);
+    std::fill(std::begin(_ShortTermHistogram), std::end(_ShortTermHistogram), 0U);
+    std::fill(std::begin(_ShortTermEnergies), std::end(_ShortTermEnergies), 0.);
+
+    _MomentaryLoudness  = -std::numeric_limits<double>::infinity();
+    _ShortTermLoudness  = -std::numeric_limits<double>::infinity();
+    _IntegratedLoudness = -std::numeric_limits<double>::infinity();
+    _LoudnessRangeLo    = -std::numeric_limits<double>::infinity();
+    _LoudnessRangeHi    = -std::numeric_limits<double>::infinity();
+}
+
+/// <summary>
+/// Adds the specified frames to the measurement. A change of the channel layout or the sample rate starts a new measurement.
+/// </summary>
+void loudness_meter_t::Process(const audio_sample * frames, size_t frameCount, uint32_t channelCount, uint32_t channelConfig, uint32_t sampleRate) noexcept
+{
+    if ((frames == nullptr) || (frameCount == 0) || (channelCount == 0) || (channelCount > MaxChannels) || (sampleRate == 0))
+        return;
+
+    if ((_ChannelCount != channelCount) || (_ChannelConfig != channelConfig) || (_SampleRate != sampleRate))
+        Configure(channelCount, channelConfig, sampleRate);
+
+    const biquad_t & s1 = _PreFilter;
+    const biquad_t & s2 = _RLBFilter;
+
+    while (frameCount != 0)
+    {
+        const size_t FrameCount = std::min(frameCount, _BlockSize - _BlockFrameCount);
+
+        for (size_t i = 0; i < channelCount; ++i)
+        {
+            if (_Weights[i] == 0.)
+                continue;
+
+            double * z = _State[i];
+            double Sum = 0.;
+
+            const audio_sample * Sample = frames + i;
+
+            for (size_t j = 0; j < FrameCount; ++j, Sample += channelCount)
+            {
+                const double x = (double) *Sample;
+
+                const double y1 = s1.b0 * x + z[0];
+
+                z[0] = s1.b1 * x - s1.a1 * y1 + z[1];
+                z[1] = s1.b2 * x - s1.a2 * y1;
+
+                const double y2 = s2.b0 * y1 + z[2];
+
+                z[2] = s2.b1 * y1 - s2.a1 * y2 + z[3];
+                z[3] = s2.b2 * y1 - s2.a2 * y2;
+
+                Sum += y2 * y2;
+            }
+
+            _BlockSum += _Weights[i] * Sum;
+        }
+
+        _BlockFrameCount += FrameCount;
+
+        if (_BlockFrameCount == _BlockSize)
+            CompleteBlock();
+
+        frames     += FrameCount * channelCount;
+        frameCount -= FrameCount;
+    }
+}
+
+/// <summary>
+/// Converts a mean square energy to loudness (in LUFS).
+/// </summary>
+double loudness_meter_t::ToLoudness(double energy) noexcept
+{
+    return (energy > 0.) ? -0.691 + 10. * std::log10(energy) : -std::numeric_limits<double>::infinity();
+}
+
+/// <summary>
+/// Starts a new measurement for the specified channel layout and sample rate.
+/// </summary>
+void loudness_meter_t::Configure(uint32_t channelCount, uint32_t channelConfig, uint32_t sampleRate) noexcept
+{
+    Reset();
+
+    _ChannelCount  = channelCount;
+    _ChannelConfig = channelConfig;
+    _SampleRate    = sampleRate;
+
+    // Determine the channel weights (ITU-R BS.1770-4, Table 4). The LFE channel is not measured. Layouts without a channel mask are treated as having only front channels.
+    {
+        const uint32_t SurroundChannels = (uint32_t) Channels::BackLeftRight | (uint32_t) Channels::SideLeftRight;
+
+        uint32_t Offset = 0;
+
+        for (uint32_t Channel = 1; (Channel != 0) && (Offset < channelCount); Channel <<= 1)
+        {
+            if ((channelConfig & Channel) == 0)
+                continue;
+
+            _Weights[Offset++] = (Channel == (uint32_t) Channels::LFE) ? 0. : ((Channel & SurroundChannels) ? 1.41 : 1.);
+        }
+
+        while (Offset < channelCount)
+            _Weights[Offset++] = 1.;
+    }
+
+    // Calculate the K-weighting filter coefficients for the sample rate. The analog prototypes are derived from the 48 kHz coefficients in ITU-R BS.1770-4.
+    {
+        const double f0 = 1681.974450955533;
+        const double G  = 3.999843853973347;
+        const double Q  = 0.7071752369554196;
+
+        const double K  = std::tan(M_PI * f0 / (double) sampleRate);
+        const double Vh = std::pow(10., G / 20.);
+        const double Vb = std::pow(Vh, 0.4996667741545416);
+        const double a0 = 1. + K / Q + K * K;
+
+        _PreFilter.b0 = (Vh + Vb * K / Q + K * K) / a0;
+        _PreFilter.b1 = 2. * (K * K - Vh) / a0;
+        _PreFilter.b2 = (Vh - Vb * K / Q + K * K) / a0;
+        _PreFilter.a1 = 2. * (K * K - 1.) / a0;
+        _PreFilter.a2 = (1. - K / Q + K * K) / a0;
+    }
+
+    {
+        const double f0 = 38.13547087602444;
+        const double Q  = 0.5003270373238773;
+
+        const double K  = std::tan(M_PI * f0 / (double) sampleRate);
+        const double a0 = 1. + K / Q + K * K;
+
+        _RLBFilter.b0 =  1.;
+        _RLBFilter.b1 = -2.;
+        _RLBFilter.b2 =  1.;
+        _RLBFilter.a1 = 2. * (K * K - 1.) / a0;
+        _RLBFilter.a2 = (1. - K / Q + K * K) / a0;
+    }
+
+    _BlockSize = std::max((size_t) ((sampleRate + 5) / 10), (size_t) 1);
+}
+
+/// <summary>
+/// Adds the energy of the completed 100 ms block to the ring and updates the measurements.
+/// </summary>
+void loudness_meter_t::CompleteBlock() noexcept
+{
+    _BlockEnergies[_BlockIndex] = _BlockSum / (double) _BlockSize;
+
+    _BlockIndex = (_BlockIndex + 1) % ShortTermBlockCount;
+    _BlockCount = std::min(_BlockCount + 1, ShortTermBlockCount);
+
+    _BlockFrameCount = 0;
+    _BlockSum = 0.;
+
+    // Momentary loudness and integrated loudness: 400 ms gating blocks with a 75% overlap (ITU-R BS.1770-4, EBU R128).
+    if (_BlockCount >= MomentaryBlockCount)
+    {
+        const double Energy = GetBlockEnergy(MomentaryBlockCount);
+
+        _MomentaryLoudness = ToLoudness(Energy);
+
+        if (_MomentaryLoudness >= MinLoudness)
+        {
+            const size_t Index = GetBinIndex(_MomentaryLoudness);
+
+            ++_MomentaryHistogram[Index];
+            _MomentaryEnergies[Index] += Energy;
+
+            _IntegratedLoudness = GetGatedLoudness(_MomentaryHistogram, _MomentaryEnergies, -10.);
+        }
+    }
+
+    // Short-term loudness and loudness range: 3 s blocks (EBU Tech 3342).
+    if (_BlockCount >= ShortTermBlockCount)
+    {
+        const double Energy = GetBlockEnergy(ShortTermBlockCount);
+
+        _ShortTermLoudness = ToLoudness(Energy);
+
+        if (++_HopCount >= ShortTermHopCount)
+        {
+            _HopCount = 0;
+
+            if (_ShortTermLoudness >= MinLoudness)
+            {
+                const size_t Index = GetBinIndex(_ShortTermLoudness);
+
+                ++_ShortTermHistogram[Index];
+                _ShortTermEnergies[Index] += Energy;
+
+                // Apply the relative gate of -20 LU and determine the 10th and the 95th percentile.
+                const double RelativeGate = GetGatedLoudness(_ShortTermHistogram, _ShortTermEnergies, 0.) - 20.;
+
+                const size_t First = (RelativeGate < MinLoudness) ? 0 : GetBinIndex(RelativeGate);
+
+                uint64_t Count = 0;
+
+                for (size_t i = First; i < BinCount; ++i)
+                    Count += _ShortTermHistogram[i];
+
+                if (Count != 0)
+                {
+                    const uint64_t LoIndex = (uint64_t) ((double) (Count - 1) * 0.10 + 0.5);
+                    const uint64_t HiIndex = (uint64_t) ((double) (Count - 1) * 0.95 + 0.5);
+
+                    uint64_t Total = 0;
+                    bool HasLo = false;
+
+                    for (size_t i = First; i < BinCount; ++i)
+                    {
+                        Total += _ShortTermHistogram[i];
+
+                        if (!HasLo && (Total > LoIndex))
+                        {
+                            _LoudnessRangeLo = GetBinLoudness(i);
+                            HasLo = true;
+                        }
+
+                        if (Total > HiIndex)
+                        {
+                            _LoudnessRangeHi = GetBinLoudness(i);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Gets the mean energy of the last blocks in the ring.
+/// </summary>
+double loudness_meter_t::GetBlockEnergy(size_t blockCount) const noexcept
+{
+    double Sum = 0.;
+
+    for (size_t i = 1; i <= blockCount; ++i)
+        Sum += _BlockEnergies[(_BlockIndex + ShortTermBlockCount - i) % ShortTermBlockCount];
+
+    return Sum / (double) blockCount;
+}
+
+/// <summary>
+/// Gets the histogram bin of the specified loudness.
+/// </summary>
+size_t loudness_meter_t::GetBinIndex(double loudness) noexcept
+{
+    return (size_t) std::clamp((loudness - MinLoudness) * (double) BinsPerLU, 0., (double) (BinCount - 1));
+}
+
+/// <summary>
+/// Gets the loudness of the center of the specified histogram bin.
+/// </summary>
+double loudness_meter_t::GetBinLoudness(size_t index) noexcept
+{
+    return MinLoudness + ((double) index + 0.5) / (double) BinsPerLU;
+}
+
+/// <summary>
+/// Gets the loudness of the blocks in the histogram that pass the relative gate (in LU). A relative gate of 0 returns the ungated loudness.
+/// Only the bin that contains the relative gate is approximated: its blocks are either all included or all excluded.
+/// </summary>
+double loudness_meter_t::GetGatedLoudness(const uint32_t * histogram, const double * energies, double relativeGate) noexcept
+{
+    double Sum = 0.;
+    uint64_t Count = 0;
+
+    for (size_t i = 0; i < BinCount; ++i)
+    {
+        Sum   += energies[i];
+        Count += histogram[i];
+    }
+
+    if (Count == 0)
+        return -std::numeric_limits<double>::infinity();
+
+    const double Gate = ToLoudness(Sum / (double) Count) + relativeGate;
+
+    if ((relativeGate == 0.) || (Gate < MinLoudness))
+        return ToLoudness(Sum / (double) Count);
+
+    Sum   = 0.;
+    Count = 0;
+
+    for (size_t i = GetBinIndex(Gate); i < BinCount; ++i)
+    {
+        Sum   += energies[i];
+        Count += histogram[i];
+    }
+
+    return (Count != 0) ? ToLoudness(Sum / (double) Count) : -std::numeric_limits<double>::infinity();
+}
@@ -0,0 +1,107 @@
+
+/** $VER: LoudnessMeter.h (2026.10.18) P. Stuer - Implements a streaming loudness meter (ITU-R BS.1770-4, EBU R128, EBU Tech 3342). **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <audio_math.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cmath>
+
+/// <summary>
+/// Implements a streaming loudness meter. The signal is K-weighted and reduced to the mean square of 100 ms blocks. The momentary (400 ms) and short-term (3 s) loudness
+/// are determined from a fixed ring of block energies. The integrated loudness and the loudness range are determined from fixed-size histograms so memory and time stay constant
+/// regardless of the length of the measurement.
+/// </summary>
+#pragma warning(disable: 4820)
+class loudness_meter_t
+{
+public:
+    static const uint32_t MaxChannels = 32;
+
+    static const size_t MomentaryBlockCount = 4;    // 400 ms
+    static const size_t ShortTermBlockCount = 30;   // 3 s
+    static const size_t ShortTermHopCount   = 10;   // A short-term measurement is added to the loudness range histogram every second.
+
+    static constexpr double MinLoudness = -70.;     // Absolute gate, in LUFS
+    static constexpr double MaxLoudness = +10.;     // in LUFS
+    static const size_t BinsPerLU = 10;
+    static const size_t BinCount = (size_t) (MaxLoudness - MinLoudness) * BinsPerLU;
+
+    loudness_meter_t() noexcept { Reset(); }
+
+    loudness_meter_t(const loudness_meter_t &) = delete;
+    loudness_meter_t & operator=(const loudness_meter_t &) = delete;
+    loudness_meter_t(loudness_meter_t &&) = delete;
+    loudness_meter_t & operator=(loudness_meter_t &&) = delete;
+
+    virtual ~loudness_meter_t() noexcept { }
+
+    void Reset() noexcept;
+    void Process(const audio_sample * frames, size_t frameCount, uint32_t channelCount, uint32_t channelConfig, uint32_t sampleRate) noexcept;
+
+    double GetMomentaryLoudness() const noexcept { return _MomentaryLoudness; }
+    double GetShortTermLoudness() const noexcept { return _ShortTermLoudness; }
+    double GetIntegratedLoudness() const noexcept { return _IntegratedLoudness; }
+
+    double GetLoudnessRange() const noexcept { return std::isfinite(_LoudnessRangeLo) ? _LoudnessRangeHi - _LoudnessRangeLo : 0.; }
+    double GetLoudnessRangeLo() const noexcept { return _LoudnessRangeLo; }
+    double GetLoudnessRangeHi() const noexcept { return _LoudnessRangeHi; }
+
+    static double ToLoudness(double energy) noexcept;
+
+private:
+    /// <summary>
+    /// Represents a second-order IIR filter section (Transposed Direct Form II).
+    /// </summary>
+    struct biquad_t
+    {
+        double b0, b1, b2, a1, a2;
+    };
+
+    void Configure(uint32_t channelCount, uint32_t channelConfig, uint32_t sampleRate) noexcept;
+    void CompleteBlock() noexcept;
+
+    double GetBlockEnergy(size_t blockCount) const noexcept;
+
+    static size_t GetBinIndex(double loudness) noexcept;
+    static double GetBinLoudness(size_t index) noexcept;
+
+    static double GetGatedLoudness(const uint32_t * histogram, const double * energies, double relativeGate) noexcept;
+
+private:
+    uint32_t _ChannelCount;
+    uint32_t _ChannelConfig;
+    uint32_t _SampleRate;
+
+    biquad_t _PreFilter;                            // Stage 1: High shelf that models the acoustic effect of the head.
+    biquad_t _RLBFilter;                            // Stage 2: Revised low-frequency B-weighting high-pass filter.
+
+    double _Weights[MaxChannels];                   // Weight of each channel in the frame, 0 if the channel does not contribute (LFE).
+    double _State[MaxChannels][4];                  // Filter state of each channel in the frame.
+
+    size_t _BlockSize;                              // Number of frames in a 100 ms block.
+    size_t _BlockFrameCount;                        // Number of frames accumulated in the current block.
+    double _BlockSum;                               // Sum of the weighted squares of the K-weighted samples in the current block.
+
+    double _BlockEnergies[ShortTermBlockCount];     // Ring buffer containing the mean square of the last 100 ms blocks.
+    size_t _BlockIndex;                             // Index of the next block in the ring buffer.
+    size_t _BlockCount;                             // Number of blocks in the ring buffer.
+    size_t _HopCount;                               // Number of blocks since the last short-term measurement was added to the loudness range histogram.
+
+    uint32_t _MomentaryHistogram[BinCount];         // Number of 400 ms gating blocks per 0.1 LU, used for the integrated loudness.
+    double _MomentaryEnergies[BinCount];            // Sum of the energies of the 400 ms gating blocks per 0.1 LU.
+    uint32_t _ShortTermHistogram[BinCount];         // Number of 3 s measurements per 0.1 LU, used for the loudness range.
+    double _ShortTermEnergies[BinCount];            // Sum of the energies of the 3 s measurements per 0.1 LU.
+
+    double _MomentaryLoudness;                      // in LUFS
+    double _ShortTermLoudness;                      // in LUFS
+    double _IntegratedLoudness;                     // in LUFS
+    double _LoudnessRangeLo;                        // 10th percentile of the gated short-term loudness, in LUFS
+    double _LoudnessRangeHi;                        // 95th percentile of the gated short-term loudness, in LUFS
+};
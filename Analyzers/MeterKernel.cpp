@@ -0,0 +1,278 @@
+
+/** $VER: MeterKernel.cpp (2026.10.18) P. Stuer - Implements the per-channel peak, RMS and balance kernel of the peak and level meters. **/
+
+#include "MeterKernel.h"
+#include "SIMD.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+/// <summary>
+/// Compiles the channel layout into frame offsets. Returns false if the plan was already up-to-date.
+/// </summary>
+bool meter_plan_t::Build(uint32_t channelCount, uint32_t channelConfig, uint32_t selectedChannels, uint32_t balanceChannels) noexcept
+{
+    if ((ChannelCount == channelCount) && (ChannelConfig == channelConfig) && (SelectedChannels == selectedChannels) && (BalanceChannels == balanceChannels))
+        return false;
+
+    ChannelCount     = channelCount;
+    ChannelConfig    = channelConfig;
+    SelectedChannels = selectedChannels;
+    BalanceChannels  = balanceChannels;
+
+    MeasuredCount = 0;
+
+    LeftOffset  = -1;
+    RightOffset = -1;
+
+    uint32_t Offset = 0; // Offset of the sample of the current channel in the frame.
+
+    for (uint32_t Channel = 1; (Channel != 0) && (Offset < channelCount) && (Offset < MaxChannels); Channel <<= 1)
+    {
+        if ((channelConfig & Channel) == 0)
+            continue;
+
+        if (selectedChannels & Channel)
+            MeasuredOffsets[MeasuredCount++] = Offset;
+
+        if (balanceChannels & Channel)
+        {
+            if (LeftOffset < 0)
+                LeftOffset = (int32_t) Offset;
+            else
+            if (RightOffset < 0)
+                RightOffset = (int32_t) Offset;
+        }
+
+        ++Offset;
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Determines the per-channel peak and sum of squares, and the balance energies of the specified frames.
+/// </summary>
+void meter_kernel_t::Process(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block) noexcept
+{
+    static const process_fn Implementation = SelectImplementation();
+
+    std::fill(std::begin(block.Peak), std::end(block.Peak), 0.);
+    std::fill(std::begin(block.SumOfSquares), std::end(block.SumOfSquares), 0.);
+
+    block.Left = block.Right = block.Mid = block.Side = 0.;
+
+    if ((frames == nullptr) || (frameCount == 0) || (plan.ChannelCount == 0) || (plan.ChannelCount > meter_plan_t::MaxChannels))
+        return;
+
+    double Cross = 0.; // Sum of the products of the left and right balance samples.
+
+    const size_t Processed = Implementation(frames, frameCount, plan, block, Cross);
+
+    // Process the frames that don't fill a complete vector period.
+    if (Processed < frameCount)
+        ProcessScalar(frames + (Processed * plan.ChannelCount), frameCount - Processed, plan, block, Cross);
+
+    // Derive the mid and side energies from the left and right energies: (L ± R)² = L² ± 2LR + R²
+    block.Left  = (plan.LeftOffset  >= 0) ? block.SumOfSquares[plan.LeftOffset]  : 0.;
+    block.Right = (plan.RightOffset >= 0) ? block.SumOfSquares[plan.RightOffset] : 0.;
+
+    block.Mid  =              (block.Left + 2. * Cross + block.Right) / 4.;
+    block.Side = std::max(0., (block.Left - 2. * Cross + block.Right) / 4.);
+}
+
+/// <summary>
+/// Selects the fastest implementation supported by the CPU.
+/// </summary>
+meter_kernel_t::process_fn meter_kernel_t::SelectImplementation() noexcept
+{
+#if defined(SIMD_SSE2_BASELINE)
+    return ProcessSSE2; // SSE2 is part of the baseline of the target.
+#elif defined(SIMD_SSE2)
+    return ::IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) ? ProcessSSE2 : ProcessScalar;
+#else
+    return ProcessScalar;
+#endif
+}
+
+/// <summary>
+/// Processes the frames one by one. Returns the number of processed frames.
+/// </summary>
+size_t meter_kernel_t::ProcessScalar(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept
+{
+    const size_t ChannelCount = plan.ChannelCount;
+    const bool HasBalancePair = (plan.LeftOffset >= 0) && (plan.RightOffset >= 0);
+
+    const audio_sample * EndOfBlock = frames + (frameCount * ChannelCount);
+
+    for (const audio_sample * Frame = frames; Frame < EndOfBlock; Frame += ChannelCount)
+    {
+        for (size_t i = 0; i < ChannelCount; ++i)
+        {
+            const double Value = (double) Frame[i];
+
+            block.Peak[i] = std::max(std::abs(Value), block.Peak[i]);
+            block.SumOfSquares[i] += Value * Value;
+        }
+
+        if (HasBalancePair)
+            cross += (double) Frame[plan.LeftOffset] * (double) Frame[plan.RightOffset];
+    }
+
+    return frameCount;
+}
+
+#if defined(SIMD_SSE2)
+
+/// <summary>
+/// Processes the frames using SSE2. Returns the number of processed frames.
+/// The interleaved samples are processed in periods of lcm(channels, lanes) samples so every vector lane always maps onto the same channel. The lanes are de-interleaved once at the end.
+/// </summary>
+size_t meter_kernel_t::ProcessSSE2(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept
+{
+#if (audio_sample_size == 64)
+    const size_t Lanes = 2;
+#else
+    const size_t Lanes = 4;
+#endif
+
+    const size_t ChannelCount = plan.ChannelCount;
+    const size_t SampleCount  = frameCount * ChannelCount;
+
+    const size_t PeriodSize  = std::lcm(ChannelCount, Lanes); // in samples
+    const size_t VectorCount = PeriodSize / Lanes;
+
+    const bool HasBalancePair = (plan.LeftOffset >= 0) && (plan.RightOffset >= 0);
+
+    // The distance between the left and right sample of a frame. The right samples are loaded with this offset to multiply them lane by lane with the left samples.
+    const size_t Distance = HasBalancePair ? (size_t) (plan.RightOffset - plan.LeftOffset) : 0;
+
+    if (SampleCount < PeriodSize + Distance)
+        return 0;
+
+    const size_t PeriodCount = (SampleCount - Distance) / PeriodSize;
+
+    __m128d Sums[meter_plan_t::MaxChannels * 2];
+    __m128d Crosses[meter_plan_t::MaxChannels * 2];
+
+#if (audio_sample_size == 64)
+    __m128d Maxima[meter_plan_t::MaxChannels];
+
+    const __m128d SignMask = _mm_set1_pd(-0.);
+
+    for (size_t v = 0; v < VectorCount; ++v)
+    {
+        Maxima[v]  = _mm_setzero_pd();
+        Sums[v]    = _mm_setzero_pd();
+        Crosses[v] = _mm_setzero_pd();
+    }
+
+    const double * p = frames;
+
+    for (size_t i = 0; i < PeriodCount; ++i, p += PeriodSize)
+    {
+        for (size_t v = 0; v < VectorCount; ++v)
+        {
+            const __m128d x = _mm_loadu_pd(p + (v * Lanes));
+
+            Maxima[v] = _mm_max_pd(Maxima[v], _mm_andnot_pd(SignMask, x));
+            Sums[v]   = _mm_add_pd(Sums[v], _mm_mul_pd(x, x));
+
+            if (HasBalancePair)
+                Crosses[v] = _mm_add_pd(Crosses[v], _mm_mul_pd(x, _mm_loadu_pd(p + (v * Lanes) + Distance)));
+        }
+    }
+
+    // De-interleave the lanes.
+    alignas(16) double MaximumLanes[2];
+    alignas(16) double SumLanes[2];
+    alignas(16) double CrossLanes[2];
+
+    for (size_t v = 0; v < VectorCount; ++v)
+    {
+        _mm_store_pd(MaximumLanes, Maxima[v]);
+        _mm_store_pd(SumLanes,     Sums[v]);
+        _mm_store_pd(CrossLanes,   Crosses[v]);
+
+        for (size_t l = 0; l < Lanes; ++l)
+        {
+            const size_t Channel = ((v * Lanes) + l) % ChannelCount;
+
+            block.Peak[Channel] = std::max(MaximumLanes[l], block.Peak[Channel]);
+            block.SumOfSquares[Channel] += SumLanes[l];
+
+            if (HasBalancePair && (Channel == (size_t) plan.LeftOffset))
+                cross += CrossLanes[l];
+        }
+    }
+#else
+    __m128 Maxima[meter_plan_t::MaxChannels];
+
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    for (size_t v = 0; v < VectorCount; ++v)
+    {
+        Maxima[v] = _mm_setzero_ps();
+
+        Sums[(v * 2)] = Sums[(v * 2) + 1] = _mm_setzero_pd();
+        Crosses[(v * 2)] = Crosses[(v * 2) + 1] = _mm_setzero_pd();
+    }
+
+    const float * p = frames;
+
+    for (size_t i = 0; i < PeriodCount; ++i, p += PeriodSize)
+    {
+        for (size_t v = 0; v < VectorCount; ++v)
+        {
+            const __m128 x = _mm_loadu_ps(p + (v * Lanes));
+
+            Maxima[v] = _mm_max_ps(Maxima[v], _mm_and_ps(x, AbsMask));
+
+            // Accumulate the squares in double precision to avoid losing precision over long RMS windows.
+            const __m128d Lo = _mm_cvtps_pd(x);
+            const __m128d Hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+
+            Sums[(v * 2)]     = _mm_add_pd(Sums[(v * 2)],     _mm_mul_pd(Lo, Lo));
+            Sums[(v * 2) + 1] = _mm_add_pd(Sums[(v * 2) + 1], _mm_mul_pd(Hi, Hi));
+
+            if (HasBalancePair)
+            {
+                const __m128 y = _mm_loadu_ps(p + (v * Lanes) + Distance);
+
+                Crosses[(v * 2)]     = _mm_add_pd(Crosses[(v * 2)],     _mm_mul_pd(Lo, _mm_cvtps_pd(y)));
+                Crosses[(v * 2) + 1] = _mm_add_pd(Crosses[(v * 2) + 1], _mm_mul_pd(Hi, _mm_cvtps_pd(_mm_movehl_ps(y, y))));
+            }
+        }
+    }
+
+    // De-interleave the lanes.
+    alignas(16) float  MaximumLanes[4];
+    alignas(16) double SumLanes[4];
+    alignas(16) double CrossLanes[4];
+
+    for (size_t v = 0; v < VectorCount; ++v)
+    {
+        _mm_store_ps(MaximumLanes,   Maxima[v]);
+        _mm_store_pd(SumLanes,       Sums[(v * 2)]);
+        _mm_store_pd(SumLanes + 2,   Sums[(v * 2) + 1]);
+        _mm_store_pd(CrossLanes,     Crosses[(v * 2)]);
+        _mm_store_pd(CrossLanes + 2, Crosses[(v * 2) + 1]);
+
+        for (size_t l = 0; l < Lanes; ++l)
+        {
+            const size_t Channel = ((v * Lanes) + l) % ChannelCount;
+
+            block.Peak[Channel] = std::max((double) MaximumLanes[l], block.Peak[Channel]);
+            block.SumOfSquares[Channel] += SumLanes[l];
+
+            if (HasBalancePair && (Channel == (size_t) plan.LeftOffset))
+                cross += CrossLanes[l];
+        }
+    }
+#endif
+
+    return (PeriodCount * PeriodSize) / ChannelCount;
+}
+
+#endif
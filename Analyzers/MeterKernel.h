@@ -0,0 +1,75 @@
+
+/** $VER: MeterKernel.h (2026.10.18) P. Stuer - Implements the per-channel peak, RMS and balance kernel of the peak and level meters. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <audio_math.h>
+
+#include "SIMD.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// <summary>
+/// Represents the channel layout of a chunk compiled into frame offsets. Only rebuilt when the channel layout or the channel selection changes.
+/// </summary>
+#pragma warning(disable: 4820)
+struct meter_plan_t
+{
+    static const uint32_t MaxChannels = 32;
+
+    meter_plan_t() noexcept : ChannelCount(), ChannelConfig(), SelectedChannels(), BalanceChannels(), MeasuredCount(), MeasuredOffsets(), LeftOffset(-1), RightOffset(-1) { }
+
+    bool Build(uint32_t channelCount, uint32_t channelConfig, uint32_t selectedChannels, uint32_t balanceChannels) noexcept;
+
+    uint32_t ChannelCount;                      // Number of samples per frame.
+    uint32_t ChannelConfig;                     // Mask containing the channels in the audio chunk.
+    uint32_t SelectedChannels;                  // Mask containing the channels selected by the user for the level measuring.
+    uint32_t BalanceChannels;                   // Mask containing the channels selected by the user for the balance measuring.
+
+    uint32_t MeasuredCount;                     // Number of measured channels.
+    uint32_t MeasuredOffsets[MaxChannels];      // Offset in the frame of each measured channel, in the order of the peak measurements.
+
+    int32_t LeftOffset;                         // Offset in the frame of the first balance channel, -1 if the channel is not present.
+    int32_t RightOffset;                        // Offset in the frame of the second balance channel, -1 if the channel is not present.
+};
+
+/// <summary>
+/// Represents the result of running the meter kernel over a block of frames.
+/// </summary>
+struct meter_block_t
+{
+    double Peak[meter_plan_t::MaxChannels];         // Max. absolute sample value per frame offset.
+    double SumOfSquares[meter_plan_t::MaxChannels]; // Sum of the squared sample values per frame offset.
+    double TruePeak[meter_plan_t::MaxChannels];     // Max. absolute value of the oversampled signal per frame offset. Only determined for the measured channels in true-peak mode.
+
+    double Left;                                    // Sum of the squared samples of the left balance channel.
+    double Right;                                   // Sum of the squared samples of the right balance channel.
+    double Mid;                                     // Sum of the squared mid values, ((L + R) / 2)².
+    double Side;                                    // Sum of the squared side values, ((L - R) / 2)².
+};
+
+/// <summary>
+/// Implements the per-channel peak, RMS and balance kernel. Dispatches to a vectorized implementation when the CPU supports it.
+/// </summary>
+class meter_kernel_t
+{
+public:
+    static void Process(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block) noexcept;
+
+private:
+    friend struct meter_kernel_test_t; // Compares the implementations with each other.
+
+    using process_fn = size_t (*)(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept;
+
+    static process_fn SelectImplementation() noexcept;
+
+    static size_t ProcessScalar(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept;
+#if defined(SIMD_SSE2)
+    static size_t ProcessSSE2(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept;
+#endif
+};
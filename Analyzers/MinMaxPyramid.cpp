@@ -0,0 +1,212 @@
+
+/** $VER: MinMaxPyramid.cpp (2026.10.18) P. Stuer - Implements a min/max decimation pyramid of a channel of interleaved samples. **/
+
+#include "MinMaxPyramid.h"
+#include "SIMD.h"
+
+#include <cmath>
+
+/// <summary>
+/// Builds the pyramid for the specified channel. The samples must remain valid while the pyramid is in use.
+/// </summary>
+void min_max_pyramid_t::Build(const audio_sample * samples, size_t sampleCount, size_t stride) noexcept
+{
+    _Samples = samples;
+    _Stride  = stride;
+    _Count   = (samples != nullptr) ? sampleCount : 0;
+
+    _Offsets.clear();
+
+    // Determine the size of all levels. The buffers only grow when a chunk is larger than any chunk before.
+    size_t Size = 0;
+
+    for (size_t n = (_Count + 1) / 2; _Count >= 2; n = (n + 1) / 2)
+    {
+        _Offsets.push_back(Size);
+        Size += n;
+
+        if (n == 1)
+            break;
+    }
+
+    if (_Min.size() < Size)
+    {
+        _Min.resize(Size);
+        _Max.resize(Size);
+    }
+
+    if (_SumOfSquares.size() < _Count + 1)
+        _SumOfSquares.resize(_Count + 1);
+
+    // Sum the squares of the samples.
+    {
+        const audio_sample * Sample = samples;
+
+        double Sum = 0.;
+
+        _SumOfSquares[0] = 0.;
+
+        for (size_t i = 0; i < _Count; ++i, Sample += stride)
+        {
+            const double Value = (double) *Sample;
+
+            Sum += Value * Value;
+
+            _SumOfSquares[i + 1] = Sum;
+        }
+    }
+
+    if (_Count < 2)
+        return;
+
+    // Level 1: Reduce pairs of samples. The samples of a mono chunk are contiguous and can be reduced like any other level.
+    if (stride == 1)
+        Reduce(samples, samples, _Count, _Min.data(), _Max.data());
+    else
+    {
+        const audio_sample * Sample = samples;
+
+        size_t i = 0;
+
+        for (; i < _Count / 2; ++i, Sample += 2 * stride)
+        {
+            const audio_sample a = Sample[0];
+            const audio_sample b = Sample[stride];
+
+            _Min[i] = std::min(a, b);
+            _Max[i] = std::max(a, b);
+        }
+
+        if (_Count & 1)
+            _Min[i] = _Max[i] = *Sample;
+    }
+
+    // Level 2 and up: Reduce pairs of entries of the level below.
+    for (size_t k = 1; k < _Offsets.size(); ++k)
+    {
+        const size_t Src   = _Offsets[k - 1];
+        const size_t Dst   = _Offsets[k];
+        const size_t Count = Dst - Src; // Number of entries in the level below.
+
+        Reduce(_Min.data() + Src, _Max.data() + Src, Count, _Min.data() + Dst, _Max.data() + Dst);
+    }
+}
+
+/// <summary>
+/// Gets the minimum and maximum of the samples in the range [first, last).
+/// </summary>
+void min_max_pyramid_t::GetRange(size_t first, size_t last, audio_sample & min, audio_sample & max) const noexcept
+{
+    last = std::min(last, _Count);
+
+    if (first >= last)
+    {
+        min = max = 0;
+        return;
+    }
+
+    min =  std::numeric_limits<audio_sample>::max();
+    max = -std::numeric_limits<audio_sample>::max();
+
+    // Level 0: The samples themselves.
+    if (first & 1)
+    {
+        const audio_sample Value = _Samples[first * _Stride];
+
+        min = std::min(min, Value);
+        max = std::max(max, Value);
+
+        ++first;
+    }
+
+    if ((last & 1) && (first < last))
+    {
+        --last;
+
+        const audio_sample Value = _Samples[last * _Stride];
+
+        min = std::min(min, Value);
+        max = std::max(max, Value);
+    }
+
+    first >>= 1;
+    last  >>= 1;
+
+    // Levels 1 and up: Only the entries that lie completely inside the range are used.
+    for (size_t k = 0; (first < last) && (k < _Offsets.size()); ++k, first >>= 1, last >>= 1)
+    {
+        const size_t Offset = _Offsets[k];
+
+        if (first & 1)
+        {
+            min = std::min(min, _Min[Offset + first]);
+            max = std::max(max, _Max[Offset + first]);
+
+            ++first;
+        }
+
+        if ((last & 1) && (first < last))
+        {
+            --last;
+
+            min = std::min(min, _Min[Offset + last]);
+            max = std::max(max, _Max[Offset + last]);
+        }
+    }
+}
+
+/// <summary>
+/// Gets the RMS of the samples in the range [first, last).
+/// </summary>
+double min_max_pyramid_t::GetRMS(size_t first, size_t last) const noexcept
+{
+    last = std::min(last, _Count);
+
+    if (first >= last)
+        return 0.;
+
+    return std::sqrt(std::max(_SumOfSquares[last] - _SumOfSquares[first], 0.) / (double) (last - first));
+}
+
+/// <summary>
+/// Reduces pairs of contiguous entries to their minimum and maximum. An odd last entry is copied.
+/// </summary>
+void min_max_pyramid_t::Reduce(const audio_sample * srcMin, const audio_sample * srcMax, size_t count, audio_sample * dstMin, audio_sample * dstMax) noexcept
+{
+    size_t i = 0; // Index of the destination entry
+
+#if defined(SIMD_SSE2)
+    // Separate the even and the odd entries and combine them a vector at a time.
+#if (audio_sample_size == 64)
+    for (; (2 * i) + 4 <= count; i += 2)
+    {
+        const __m128d m0 = _mm_loadu_pd(srcMin + (2 * i)), m1 = _mm_loadu_pd(srcMin + (2 * i) + 2);
+        const __m128d n0 = _mm_loadu_pd(srcMax + (2 * i)), n1 = _mm_loadu_pd(srcMax + (2 * i) + 2);
+
+        _mm_storeu_pd(dstMin + i, _mm_min_pd(_mm_shuffle_pd(m0, m1, 0), _mm_shuffle_pd(m0, m1, 3)));
+        _mm_storeu_pd(dstMax + i, _mm_max_pd(_mm_shuffle_pd(n0, n1, 0), _mm_shuffle_pd(n0, n1, 3)));
+    }
+#else
+    for (; (2 * i) + 8 <= count; i += 4)
+    {
+        const __m128 m0 = _mm_loadu_ps(srcMin + (2 * i)), m1 = _mm_loadu_ps(srcMin + (2 * i) + 4);
+        const __m128 n0 = _mm_loadu_ps(srcMax + (2 * i)), n1 = _mm_loadu_ps(srcMax + (2 * i) + 4);
+
+        _mm_storeu_ps(dstMin + i, _mm_min_ps(_mm_shuffle_ps(m0, m1, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(m0, m1, _MM_SHUFFLE(3, 1, 3, 1))));
+        _mm_storeu_ps(dstMax + i, _mm_max_ps(_mm_shuffle_ps(n0, n1, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(n0, n1, _MM_SHUFFLE(3, 1, 3, 1))));
+    }
+#endif
+#endif
+
+    for (; (2 * i) + 2 <= count; ++i)
+    {
+        dstMin[i] = std::min(srcMin[2 * i], srcMin[2 * i + 1]);
+        dstMax[i] = std::max(srcMax[2 * i], srcMax[2 * i + 1]);
+    }
+
+    if (count & 1)
+    {
+        dstMin[i] = srcMin[2 * i];
+        dstMax[i] = srcMax[2 * i];
+    }
+}
@@ -0,0 +1,46 @@
+
+/** $VER: MinMaxPyramid.h (2026.10.18) P. Stuer - Implements a min/max decimation pyramid of a channel of interleaved samples. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <audio_math.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Implements a min/max decimation pyramid of a channel of interleaved samples. Level 0 are the samples themselves; they are read in place and never copied.
+/// Each entry of level k + 1 contains the minimum and maximum of 2 entries of level k. The minimum and maximum of any range of samples is found in O(log n).
+/// The running sum of the squared samples is kept as well so the RMS of any range of samples is found in O(1).
+/// </summary>
+#pragma warning(disable: 4820)
+class min_max_pyramid_t
+{
+public:
+    min_max_pyramid_t() noexcept : _Samples(), _Stride(), _Count() { }
+
+    void Build(const audio_sample * samples, size_t sampleCount, size_t stride) noexcept;
+    void GetRange(size_t first, size_t last, audio_sample & min, audio_sample & max) const noexcept;
+    double GetRMS(size_t first, size_t last) const noexcept;
+
+    size_t GetCount() const noexcept { return _Count; }
+
+private:
+    const audio_sample * _Samples;      // First sample of the channel. Not owned.
+    size_t _Stride;                     // Distance between 2 samples of the channel.
+    size_t _Count;                      // Number of samples in the channel.
+
+    std::vector<audio_sample> _Min;     // Minimum of each entry of all levels above level 0, level after level.
+    std::vector<audio_sample> _Max;     // Maximum of each entry of all levels above level 0, level after level.
+    std::vector<size_t> _Offsets;       // Offset of each level above level 0 in _Min and _Max.
+
+    std::vector<double> _SumOfSquares;  // Sum of the squares of the samples before each sample. Contains count + 1 entries.
+
+private:
+    static void Reduce(const audio_sample * srcMin, const audio_sample * srcMax, size_t count, audio_sample * dstMin, audio_sample * dstMax) noexcept;
+};
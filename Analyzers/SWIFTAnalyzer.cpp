@@ -1,17 +1,12 @@
 
-/** $VER: SWIFTAnalyzer.cpp (2025.10.05) P. Stuer - Based on TF3RDL's Sliding Windowed Infinite Fourier Transform (SWIFT), https://codepen.io/TF3RDL/pen/JjBzjeY **/
+/** $VER: SWIFTAnalyzer.cpp (2026.10.18) P. Stuer - Based on TF3RDL's Sliding Windowed Infinite Fourier Transform (SWIFT), https://codepen.io/TF3RDL/pen/JjBzjeY **/
 
-#include "pch.h"
 #include "SWIFTAnalyzer.h"
 
-#include "Support.h"
-
-#pragma hdrstop
-
 /// <summary>
 /// Initializes a new instance.
 /// </summary>
-swift_analyzer_t::swift_analyzer_t(const state_t * state, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup) : analyzer_t(state, sampleRate, channelCount, channelSetup, window_function_t())
+swift_analyzer_t::swift_analyzer_t(const analysis_config_t * config, uint32_t sampleRate, uint32_t channelCount, uint32_t channelSetup) : analyzer_t(config, sampleRate, channelCount, channelSetup, window_function_t())
 {
 }
 
@@ -20,8 +15,8 @@ swift_analyzer_t::swift_analyzer_t(const state_t * state, uint32_t sampleRate, u
 /// </summary>
 bool swift_analyzer_t::Initialize(const frequency_bands_t & frequencyBands) noexcept
 {
-    const double Constant1 = 4. * _State->_IIRBandwidth / (double) _SampleRate;
-    const double Constant2 = 1. / (_State->_TimeResolution * (double) _SampleRate / 2000.);
+    const double Constant1 = 4. * _Config->IIRBandwidth / (double) _SampleRate;
+    const double Constant2 = 1. / (_Config->TimeResolution * (double) _SampleRate / 2000.);
 
     const double a = M_PI * 2. / (double) _SampleRate;
 
@@ -62,7 +57,7 @@ bool swift_analyzer_t::AnalyzeSamples(const audio_sample * frames, size_t frameC
         {
             swift_value_t CurValue = { Sample, 0. };
 
-            for (uint32_t j = 0; j < _State->_FilterBankOrder; ++j)
+            for (uint32_t j = 0; j < _Config->FilterBankOrder; ++j)
             {
                 swift_value_t & Value = Coef.Values[j];
 
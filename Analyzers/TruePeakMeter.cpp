@@ -0,0 +1,151 @@
+
+/** $VER: TruePeakMeter.cpp (2026.10.18) P. Stuer - Implements a true-peak meter using 4x oversampling (ITU-R BS.1770-4, Annex 2). **/
+
+#include "TruePeakMeter.h"
+#include "SIMD.h"
+
+#include <cmath>
+#include <cstring>
+
+/// <summary>
+/// Resets the filter history of all channels.
+/// </summary>
+void true_peak_meter_t::Reset() noexcept
+{
+    for (auto & History : _History)
+        std::fill(std::begin(History), std::end(History), 0.f);
+}
+
+/// <summary>
+/// Determines the true peak of each measured channel of the specified frames.
+/// </summary>
+void true_peak_meter_t::Process(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block) noexcept
+{
+    static const filter_fn Implementation = SelectImplementation();
+
+    if ((frames == nullptr) || (frameCount == 0) || (plan.ChannelCount == 0) || (plan.ChannelCount > meter_plan_t::MaxChannels))
+        return;
+
+    if (_Samples.size() < HistorySize + frameCount)
+        _Samples.resize(HistorySize + frameCount); // Only grows when a chunk is larger than any chunk before.
+
+    float * Samples = _Samples.data();
+
+    for (size_t i = 0; i < plan.MeasuredCount; ++i)
+    {
+        const uint32_t Offset = plan.MeasuredOffsets[i];
+
+        // De-interleave the channel behind the history of the previous chunk.
+        ::memcpy(Samples, _History[i], sizeof(_History[i]));
+
+        const audio_sample * Sample = frames + Offset;
+
+        for (size_t j = 0; j < frameCount; ++j, Sample += plan.ChannelCount)
+            Samples[HistorySize + j] = (float) *Sample;
+
+        const double TruePeak = (double) Implementation(Samples + HistorySize, frameCount);
+
+        // The interpolation filter does not pass the original samples unaltered so never report less than the sample peak.
+        block.TruePeak[Offset] = std::max(TruePeak, block.Peak[Offset]);
+
+        ::memcpy(_History[i], Samples + frameCount, sizeof(_History[i]));
+    }
+}
+
+/// <summary>
+/// Selects the fastest implementation supported by the CPU.
+/// </summary>
+true_peak_meter_t::filter_fn true_peak_meter_t::SelectImplementation() noexcept
+{
+#if defined(SIMD_SSE2_BASELINE)
+    return FilterSSE2; // SSE2 is part of the baseline of the target.
+#elif defined(SIMD_SSE2)
+    return ::IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) ? FilterSSE2 : FilterScalar;
+#else
+    return FilterScalar;
+#endif
+}
+
+/// <summary>
+/// Upsamples the samples and returns the maximum absolute value. The samples must be preceded by HistorySize samples.
+/// </summary>
+float true_peak_meter_t::FilterScalar(const float * samples, size_t sampleCount) noexcept
+{
+    float Max = 0.f;
+
+    for (size_t i = 0; i < sampleCount; ++i)
+    {
+        float Phases[PhaseCount] = { };
+
+        for (size_t k = 0; k < TapsPerPhase; ++k)
+        {
+            const float x = samples[(ptrdiff_t) i - (ptrdiff_t) k];
+
+            for (size_t p = 0; p < PhaseCount; ++p)
+                Phases[p] += Coefficients[k][p] * x;
+        }
+
+        for (size_t p = 0; p < PhaseCount; ++p)
+            Max = std::max(std::abs(Phases[p]), Max);
+    }
+
+    return Max;
+}
+
+#if defined(SIMD_SSE2)
+
+/// <summary>
+/// Upsamples the samples and returns the maximum absolute value using SSE2. The samples must be preceded by HistorySize samples.
+/// All 4 phases of an input sample are calculated in one vector.
+/// </summary>
+float true_peak_meter_t::FilterSSE2(const float * samples, size_t sampleCount) noexcept
+{
+    __m128 c[TapsPerPhase];
+
+    for (size_t k = 0; k < TapsPerPhase; ++k)
+        c[k] = _mm_loadu_ps(Coefficients[k]);
+
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 Max = _mm_setzero_ps();
+
+    for (size_t i = 0; i < sampleCount; ++i)
+    {
+        const float * x = samples + i;
+
+        __m128 y = _mm_mul_ps(c[0], _mm_set1_ps(x[0]));
+
+        for (size_t k = 1; k < TapsPerPhase; ++k)
+            y = _mm_add_ps(y, _mm_mul_ps(c[k], _mm_set1_ps(x[-(ptrdiff_t) k])));
+
+        Max = _mm_max_ps(Max, _mm_and_ps(y, AbsMask));
+    }
+
+    // Reduce the 4 phases.
+    Max = _mm_max_ps(Max, _mm_movehl_ps(Max, Max));
+    Max = _mm_max_ss(Max, _mm_shuffle_ps(Max, Max, _MM_SHUFFLE(1, 1, 1, 1)));
+
+    return _mm_cvtss_f32(Max);
+}
+
+#endif
+
+/// <summary>
+/// The polyphase filter coefficients from ITU-R BS.1770-4, Annex 2, transposed so that the coefficients of all phases for one tap are adjacent.
+/// </summary>
+alignas(16) const float true_peak_meter_t::Coefficients[TapsPerPhase][PhaseCount] =
+{
+    //   Phase 0          Phase 1          Phase 2          Phase 3
+    {  0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f },
+    {  0.0109863281250f,  0.0292968750000f,  0.0330810546875f,  0.0148925781250f },
+    { -0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f },
+    {  0.0332031250000f,  0.0891113281250f,  0.1015625000000f,  0.0476074218750f },
+    { -0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f },
+    {  0.1373291015625f,  0.4650878906250f,  0.7797851562500f,  0.9721679687500f },
+    {  0.9721679687500f,  0.7797851562500f,  0.4650878906250f,  0.1373291015625f },
+    { -0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f },
+    {  0.0476074218750f,  0.1015625000000f,  0.0891113281250f,  0.0332031250000f },
+    { -0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f },
+    {  0.0148925781250f,  0.0330810546875f,  0.0292968750000f,  0.0109863281250f },
+    { -0.0083007812500f, -0.0189208984375f, -0.0291748046875f,  0.0017089843750f },
+};
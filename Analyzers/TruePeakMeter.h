@@ -0,0 +1,54 @@
+
+/** $VER: TruePeakMeter.h (2026.10.18) P. Stuer - Implements a true-peak meter using 4x oversampling (ITU-R BS.1770-4, Annex 2). **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "MeterKernel.h"
+#include "SIMD.h"
+
+#include <vector>
+
+/// <summary>
+/// Implements a true-peak meter. Each measured channel is upsampled 4x with a 48-tap polyphase FIR filter and the maximum absolute value of the upsampled signal is reported.
+/// </summary>
+#pragma warning(disable: 4820)
+class true_peak_meter_t
+{
+public:
+    static const size_t PhaseCount   =  4;
+    static const size_t TapsPerPhase = 12;
+    static const size_t HistorySize  = TapsPerPhase - 1;
+
+    true_peak_meter_t() noexcept : _History() { }
+
+    true_peak_meter_t(const true_peak_meter_t &) = delete;
+    true_peak_meter_t & operator=(const true_peak_meter_t &) = delete;
+    true_peak_meter_t(true_peak_meter_t &&) = delete;
+    true_peak_meter_t & operator=(true_peak_meter_t &&) = delete;
+
+    virtual ~true_peak_meter_t() noexcept { }
+
+    void Reset() noexcept;
+    void Process(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block) noexcept;
+
+private:
+    using filter_fn = float (*)(const float * samples, size_t sampleCount) noexcept;
+
+    static filter_fn SelectImplementation() noexcept;
+
+    static float FilterScalar(const float * samples, size_t sampleCount) noexcept;
+#if defined(SIMD_SSE2)
+    static float FilterSSE2(const float * samples, size_t sampleCount) noexcept;
+#endif
+
+private:
+    float _History[meter_plan_t::MaxChannels][HistorySize]; // The last samples of the previous chunk of each measured channel.
+
+    std::vector<float> _Samples;                            // De-interleaved samples of the channel being processed, preceded by its history.
+
+    static const float Coefficients[TapsPerPhase][PhaseCount];
+};
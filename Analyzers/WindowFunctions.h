@@ -1,5 +1,5 @@
 
-/** $VER: WindowFunctions.h (2026.02.11) P. Stuer **/
+/** $VER: WindowFunctions.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -7,9 +7,6 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <Windows.h>
-
 #include <cmath>
 
 using namespace std;
@@ -96,7 +93,7 @@ public:
 
     virtual double operator () (double) const override
     {
-        return __super::operator()(1.);
+        return window_function_t::operator()(1.);
     }
 };
 
@@ -113,7 +110,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 0.5 * (1. + std::cos(x * M_PI));
 /*
@@ -138,7 +135,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 0.53836   - (0.46164 * std::cos(x * 2. * M_PI));
     //  return 0.54      + (0.46    * std::cos(x * M_PI));
@@ -159,7 +156,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 0.42 + (0.5 * std::cos(x * M_PI)) + (0.08 * std::cos(x * 2. * M_PI));
 //      return 0.42 - (0.5 * std::cos(x * 2. * M_PI)) + (0.08 * std::cos(x * 4. * M_PI));
@@ -178,7 +175,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 0.355768 + (0.487396 * std::cos(x * M_PI)) + (0.144232 * std::cos(2. * x * M_PI)) + (0.012604 * std::cos(3. * x * M_PI));
     }
@@ -196,7 +193,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 0.21557895 + (0.41663158 * std::cos(x * M_PI)) + (0.277263158 * std::cos(2. * x * M_PI)) + (0.083578947 * std::cos(3. * x * M_PI)) + (0.006947368 * std::cos(4. * x * M_PI));
     }
@@ -214,7 +211,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 1. - std::fabs(x);
     }
@@ -232,7 +229,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return (std::fabs(x) > 0.5) ? (-2. * std::pow((-1. + std::fabs(x)), 3.)) : (1. - 24. * std::pow(std::fabs(x / 2.), 2.) + 48. * std::pow(std::fabs(x / 2.), 3.));
     }
@@ -250,7 +247,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::pow(1. - (x * x), _Power);
     }
@@ -271,7 +268,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::pow(std::cos(x * M_PI_2), _Power);
     }
@@ -292,7 +289,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::pow(std::sqrt(1. - (x * x)), _Power);
     }
@@ -314,7 +311,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::exp(-(_Sigma * _Sigma) * (x * x));
     }
@@ -335,7 +332,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return (std::fabs(x) <= 1. - _Parameter) ? 1 : (x > 0. ? std::pow(-::sin((x - 1.) * M_PI / _Parameter / 2.), 2.) : std::pow(std::sin((x + 1.) * M_PI / _Parameter / 2.), 2.));
     }
@@ -356,7 +353,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::cosh(std::sqrt(1. - (x * x)) * _AlphaSquared) / std::cosh(_AlphaSquared);
     }
@@ -377,7 +374,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::exp(-::fabs(x * _ParameterSquared));
     }
@@ -398,7 +395,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 1. / std::cosh(x * _ParameterSquared);
     }
@@ -419,7 +416,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return (std::fabs(x) <= 0.5) ? -std::pow((x * M_SQRT2), 2.) + 1. : std::pow(std::fabs(x * M_SQRT2) - M_SQRT2, 2.);
     }
@@ -437,7 +434,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         const double y = std::cos(x * M_PI_2);
 
@@ -457,7 +454,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return 1. - std::sin(M_PI_2 * std::pow(std::sin(x * M_PI_2), 2.));
     }
@@ -475,7 +472,7 @@ public:
 
     virtual double operator () (double x) const override
     {
-        x = __super::operator()(x);
+        x = window_function_t::operator()(x);
 
         return std::pow(((1. - 1. /(x + 2.)) * (1. - 1. / (-x + 2.))) * 4., 2.) * -(std::tanh(M_SQRT2 * (-x + 1.)) * std::tanh(M_SQRT2 * (-x - 1.))) / _Denominator;
     }
@@ -0,0 +1,491 @@
+
+/** $VER: Benchmark.cpp (2026.10.18) P. Stuer - Measures the throughput of the window functions, the FFT, the band processing, the spectrum analyzers, the spectrum curves and the meters of the portable core. **/
+
+#include "WindowFunctions.h"
+#include "BandProcessor.h"
+#include "FFT.h"
+#include "FFTAnalyzer.h"
+#include "CQTAnalyzer.h"
+#include "SWIFTAnalyzer.h"
+#include "AnalogStyleAnalyzer.h"
+#include "MeterKernel.h"
+#include "TruePeakMeter.h"
+#include "LoudnessMeter.h"
+#include "BitMeterKernel.h"
+#include "MinMaxPyramid.h"
+#include "CurveBuilder.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// <summary>
+/// Represents a channel layout of the benchmark.
+/// </summary>
+struct layout_t
+{
+    const char * Name;
+    uint32_t ChannelCount;
+    uint32_t ChannelConfig;
+};
+
+static const layout_t Layouts[] =
+{
+    { "mono",   1, (uint32_t) Channels::ConfigMono },
+    { "stereo", 2, (uint32_t) Channels::ConfigStereo },
+    { "5.1",    6, (uint32_t) Channels::Config5point1 },
+    { "7.1",    8, (uint32_t) Channels::Config7point1 },
+};
+
+static const uint32_t SampleRates[] = { 44100, 48000, 96000, 192000 };
+static const size_t BandCounts[]    = { 64, 320, 1000 };
+static const size_t FFTSizes[]      = { 1024, 2048, 4096, 8192, 16384, 32768 };
+
+// The defaults of the component. Each sweep varies one parameter and keeps the others at their default.
+static const layout_t & DefaultLayout = Layouts[1];
+static const uint32_t DefaultSampleRate = 48000;
+static const size_t DefaultBandCount = 320;
+static const size_t DefaultFFTSize = 4096;
+
+static const double FrameRate = 60.; // One chunk per frame
+
+static double Duration = 1.; // Minimum duration of a measurement (in seconds)
+
+/// <summary>
+/// Runs the specified function repeatedly and reports the time per call and how much faster than real-time the audio of a call is processed.
+/// </summary>
+template<class F>
+static void Measure(const char * name, size_t framesPerCall, uint32_t sampleRate, F && f)
+{
+    using clock = std::chrono::steady_clock;
+
+    f(); // Warm up.
+
+    size_t Calls = 0;
+
+    const auto Start = clock::now();
+    auto Now = Start;
+
+    do
+    {
+        for (size_t i = 0; i < 16; ++i)
+            f();
+
+        Calls += 16;
+        Now = clock::now();
+    }
+    while (std::chrono::duration<double>(Now - Start).count() < Duration);
+
+    const double Seconds = std::chrono::duration<double>(Now - Start).count();
+    const double PerCall = Seconds / (double) Calls;
+
+    if (framesPerCall != 0)
+        ::printf("%-68s %10.2f us/call  %10.1fx real-time\n", name, PerCall * 1e6, ((double) framesPerCall / (double) sampleRate) / PerCall);
+    else
+        ::printf("%-68s %10.2f us/call\n", name, PerCall * 1e6);
+}
+
+/// <summary>
+/// Generates 1 second of interleaved frames: a 997 Hz tone in the first channel and white noise in the other channels.
+/// </summary>
+static std::vector<audio_sample> GenerateFrames(uint32_t sampleRate, uint32_t channelCount)
+{
+    std::vector<audio_sample> Frames((size_t) sampleRate * channelCount);
+
+    std::mt19937 Generator(1);
+    std::uniform_real_distribution<double> Noise(-0.5, 0.5);
+
+    for (size_t i = 0; i < sampleRate; ++i)
+    {
+        Frames[i * channelCount] = (audio_sample) (0.5 * std::sin(2. * M_PI * 997. * (double) i / (double) sampleRate));
+
+        for (size_t j = 1; j < channelCount; ++j)
+            Frames[i * channelCount + j] = (audio_sample) Noise(Generator);
+    }
+
+    return Frames;
+}
+
+/// <summary>
+/// Generates the specified number of logarithmically spaced frequency bands between 20 Hz and 20 kHz, the same way the component does.
+/// </summary>
+static frequency_bands_t GenerateFrequencyBands(size_t bandCount)
+{
+    band_config_t Config;
+
+    Config.Distribution = FrequencyDistribution::Linear;
+    Config.BandCount    = bandCount;
+
+    frequency_bands_t Bands;
+
+    band_processor_t::Generate(Config, Bands);
+
+    return Bands;
+}
+
+/// <summary>
+/// Feeds consecutive chunks of a test signal to an analyzer or a meter, wrapping around at the end of the signal.
+/// </summary>
+#pragma warning(disable: 4820)
+class chunk_source_t
+{
+public:
+    chunk_source_t(uint32_t sampleRate, const layout_t & layout) : _Frames(GenerateFrames(sampleRate, layout.ChannelCount)), _SampleRate(sampleRate), _ChannelCount(layout.ChannelCount), _ChunkSize((size_t) ((double) sampleRate / FrameRate)), _Offset() { }
+
+    const audio_sample * Next() noexcept
+    {
+        _Offset = (_Offset + _ChunkSize) % (_SampleRate - _ChunkSize);
+
+        return _Frames.data() + _Offset * _ChannelCount;
+    }
+
+    size_t GetChunkSize() const noexcept { return _ChunkSize; }
+
+private:
+    std::vector<audio_sample> _Frames;
+    uint32_t _SampleRate;
+    uint32_t _ChannelCount;
+    size_t _ChunkSize;
+    size_t _Offset;
+};
+
+/// <summary>
+/// Measures the spectrum analyzers with the specified parameters.
+/// </summary>
+static void MeasureAnalyzers(uint32_t sampleRate, const layout_t & layout, size_t bandCount, size_t fftSize, bool allMappings)
+{
+    analysis_config_t Config;
+
+    std::unique_ptr<window_function_t> Window(window_function_t::Create(WindowFunction::Hann, 1., 0., true));
+    std::unique_ptr<window_function_t> Kernel(window_function_t::Create(WindowFunction::Hann, 1., 0., true));
+
+    frequency_bands_t Bands = GenerateFrequencyBands(bandCount);
+
+    chunk_source_t Source(sampleRate, layout);
+
+    const size_t ChunkSize = Source.GetChunkSize();
+
+    char Name[128];
+
+    const struct { Mapping Method; const char * Name; } Methods[] =
+    {
+        { Mapping::Standard,             "standard" },
+        { Mapping::TriangularFilterBank, "filter bank" },
+        { Mapping::BrownPuckette,        "Brown-Puckette" },
+    };
+
+    for (const auto & [Method, MethodName] : Methods)
+    {
+        if (!allMappings && (Method != Mapping::Standard))
+            continue;
+
+        Config.MappingMethod = Method;
+
+        fft_analyzer_t Analyzer(&Config, sampleRate, layout.ChannelCount, layout.ChannelConfig, *Window, *Kernel, fftSize);
+
+        ::snprintf(Name, sizeof(Name), "FFT analyzer (%zu, %s, %zu bands, %u Hz, %s)", fftSize, MethodName, bandCount, sampleRate, layout.Name);
+
+        Measure(Name, ChunkSize, sampleRate, [&]() { Analyzer.AnalyzeSamples(Source.Next(), ChunkSize, layout.ChannelConfig, Bands); });
+    }
+
+    if (!allMappings)
+        return;
+
+    Config.MappingMethod = Mapping::Standard;
+
+    {
+        cqt_analyzer_t Analyzer(&Config, sampleRate, layout.ChannelCount, layout.ChannelConfig, *Window);
+
+        ::snprintf(Name, sizeof(Name), "CQT analyzer (%zu bands, %u Hz, %s)", bandCount, sampleRate, layout.Name);
+
+        Measure(Name, ChunkSize, sampleRate, [&]() { Analyzer.AnalyzeSamples(Source.Next(), ChunkSize, layout.ChannelConfig, Bands); });
+    }
+
+    {
+        swift_analyzer_t Analyzer(&Config, sampleRate, layout.ChannelCount, layout.ChannelConfig);
+
+        Analyzer.Initialize(Bands);
+
+        ::snprintf(Name, sizeof(Name), "SWIFT analyzer (%zu bands, %u Hz, %s)", bandCount, sampleRate, layout.Name);
+
+        Measure(Name, ChunkSize, sampleRate, [&]() { Analyzer.AnalyzeSamples(Source.Next(), ChunkSize, layout.ChannelConfig, Bands); });
+    }
+
+    {
+        analog_style_analyzer_t Analyzer(&Config, sampleRate, layout.ChannelCount, layout.ChannelConfig, *Window);
+
+        Analyzer.Initialize(Bands);
+
+        ::snprintf(Name, sizeof(Name), "Analog-style analyzer (%zu bands, %u Hz, %s)", bandCount, sampleRate, layout.Name);
+
+        Measure(Name, ChunkSize, sampleRate, [&]() { Analyzer.AnalyzeSamples(Source.Next(), ChunkSize, layout.ChannelConfig, Bands); });
+    }
+}
+
+/// <summary>
+/// Measures the band generation, the weighting and the normalization of the analysis with the specified number of bands.
+/// </summary>
+static void MeasureBandProcessing(size_t bandCount)
+{
+    band_config_t Config;
+
+    Config.Distribution = FrequencyDistribution::Linear;
+    Config.BandCount    = bandCount;
+    Config.Weighting    = WeightingType::AWeighting;
+    Config.WeightingAmount = 1.;
+
+    const amplitude_scale_t Scale;
+
+    frequency_bands_t Bands;
+
+    char Name[128];
+
+    ::snprintf(Name, sizeof(Name), "Band generation (%zu bands)", bandCount);
+
+    Measure(Name, 0, DefaultSampleRate, [&]() { band_processor_t::Generate(Config, Bands); });
+
+    std::mt19937 Generator(1);
+    std::uniform_real_distribution<double> Amplitude(0., 1.);
+
+    ::snprintf(Name, sizeof(Name), "Weighting and normalization (%zu bands)", bandCount);
+
+    Measure(Name, 0, DefaultSampleRate, [&]()
+    {
+        for (auto & fb : Bands)
+            fb.RawValue = Amplitude(Generator);
+
+        band_processor_t::ApplyWeighting(Config, DefaultSampleRate, DefaultFFTSize, Bands);
+        band_processor_t::Normalize(Scale, SmoothingMethod::Average, 0.5, Bands);
+    });
+}
+
+/// <summary>
+/// Measures the knots and the control points of the curves of the spectrum with the specified number of bands. The spectrum renders the curve of the values and the curve of the peaks every frame.
+/// </summary>
+static void MeasureCurves(size_t bandCount)
+{
+    frequency_bands_t Bands = GenerateFrequencyBands(bandCount);
+
+    std::mt19937 Generator(1);
+    std::uniform_real_distribution<double> Value(0., 1.);
+
+    for (auto & fb : Bands)
+    {
+        fb.Value    = Value(Generator);
+        fb.MaxValue = std::max(fb.Value, Value(Generator));
+    }
+
+    const curve_settings_t Settings = { 1920.f, 1080.f, false, DefaultSampleRate / 2., 100.f, 500.f, 0.f };
+
+    curve_builder_t Builder;
+    curve_points_t Points;
+
+    char Name[128];
+
+    ::snprintf(Name, sizeof(Name), "Curve, value and peak (%zu bands)", bandCount);
+
+    Measure(Name, 0, DefaultSampleRate, [&]()
+    {
+        Builder.Build(Bands, Settings, false, Points);
+        Builder.Build(Bands, Settings, true, Points);
+    });
+
+    ::snprintf(Name, sizeof(Name), "Radial curve, value and peak (%zu bands)", bandCount);
+
+    Measure(Name, 0, DefaultSampleRate, [&]()
+    {
+        Builder.BuildRadial(Bands, Settings, false, Points);
+        Builder.BuildRadial(Bands, Settings, true, Points);
+    });
+
+    // The control points only, through the knots of the last curve.
+    bezier_spline_t Spline;
+
+    Builder.Build(Bands, Settings, false, Points);
+
+    const std::vector<layout_point_t> Knots = Points.p0;
+
+    ::snprintf(Name, sizeof(Name), "Bezier control points, 2 splines (%zu knots)", Knots.size());
+
+    Measure(Name, 0, DefaultSampleRate, [&]()
+    {
+        for (int i = 0; i < 2; ++i)
+            Spline.GetControlPoints(Knots, Points.p1, Points.p2, [](layout_point_t p) { return p; });
+    });
+}
+
+/// <summary>
+/// Measures the meters with the specified sample rate and channel layout. All channels are measured.
+/// </summary>
+static void MeasureMeters(uint32_t sampleRate, const layout_t & layout)
+{
+    chunk_source_t Source(sampleRate, layout);
+
+    const size_t ChunkSize = Source.GetChunkSize();
+
+    meter_plan_t Plan;
+
+    Plan.Build(layout.ChannelCount, layout.ChannelConfig, layout.ChannelConfig, (uint32_t) Channels::ConfigStereo);
+
+    meter_block_t Block;
+
+    char Name[128];
+
+    ::snprintf(Name, sizeof(Name), "Meter kernel (%u Hz, %s)", sampleRate, layout.Name);
+
+    Measure(Name, ChunkSize, sampleRate, [&]() { meter_kernel_t::Process(Source.Next(), ChunkSize, Plan, Block); });
+
+    true_peak_meter_t TruePeakMeter;
+
+    ::snprintf(Name, sizeof(Name), "True-peak meter (%u Hz, %s)", sampleRate, layout.Name);
+
+    Measure(Name, ChunkSize, sampleRate, [&]() { TruePeakMeter.Process(Source.Next(), ChunkSize, Plan, Block); });
+
+    loudness_meter_t LoudnessMeter;
+
+    ::snprintf(Name, sizeof(Name), "Loudness meter (%u Hz, %s)", sampleRate, layout.Name);
+
+    Measure(Name, ChunkSize, sampleRate, [&]() { LoudnessMeter.Process(Source.Next(), ChunkSize, layout.ChannelCount, layout.ChannelConfig, sampleRate); });
+
+    uint32_t Counts[meter_plan_t::MaxChannels][bit_meter_kernel_t::MaxBits];
+
+    ::memset(Counts, 0, sizeof(Counts));
+
+    ::snprintf(Name, sizeof(Name), "Bit meter kernel (native, %u Hz, %s)", sampleRate, layout.Name);
+
+    Measure(Name, ChunkSize, sampleRate, [&]() { bit_meter_kernel_t::Process(Source.Next(), ChunkSize, Plan, BitMeterView::Native, Counts); });
+
+    ::snprintf(Name, sizeof(Name), "Bit meter kernel (24-bit, %u Hz, %s)", sampleRate, layout.Name);
+
+    Measure(Name, ChunkSize, sampleRate, [&]() { bit_meter_kernel_t::Process(Source.Next(), ChunkSize, Plan, BitMeterView::Int24, Counts); });
+}
+
+/// <summary>
+/// Entry point. The optional argument specifies the minimum duration of a measurement (in seconds).
+/// </summary>
+int main(int argc, char * argv[])
+{
+    if (argc > 1)
+        Duration = std::max(0.01, std::atof(argv[1]));
+
+    ::printf("Portable analysis core, one chunk per frame at %.0f fps, %zu-bit samples\n", FrameRate, sizeof(audio_sample) * 8);
+    ::printf("Defaults: %u Hz, %s, %zu bands, FFT %zu\n\n", DefaultSampleRate, DefaultLayout.Name, DefaultBandCount, DefaultFFTSize);
+
+    const std::vector<audio_sample> Frames = GenerateFrames(DefaultSampleRate, DefaultLayout.ChannelCount);
+
+    // Window functions
+    {
+        const struct { WindowFunction Type; const char * Name; } Windows[] =
+        {
+            { WindowFunction::Hann,     "Hann window (4096 points)" },
+            { WindowFunction::Blackman, "Blackman window (4096 points)" },
+            { WindowFunction::Kaiser,   "Kaiser window (4096 points)" },
+        };
+
+        for (const auto & [Type, Name] : Windows)
+        {
+            std::unique_ptr<window_function_t> Window(window_function_t::Create(Type, 1., 0., true));
+
+            volatile double Sink = 0.;
+
+            Measure(Name, 0, DefaultSampleRate, [&]()
+            {
+                double Sum = 0.;
+
+                for (size_t i = 0; i < 4096; ++i)
+                    Sum += (*Window)(((double) i / 4095.) * 2. - 1.);
+
+                Sink = Sum;
+            });
+        }
+    }
+
+    // FFT
+    for (size_t FFTSize : FFTSizes)
+    {
+        fft_t FFT;
+
+        FFT.Initialize(FFTSize);
+
+        std::vector<std::complex<double>> TimeData(FFTSize), FreqData(FFTSize);
+
+        for (size_t i = 0; i < FFTSize; ++i)
+            TimeData[i] = std::complex<double>((double) Frames[(i * DefaultLayout.ChannelCount) % Frames.size()], 0.);
+
+        char Name[64];
+
+        ::snprintf(Name, sizeof(Name), "FFT (%zu points)", FFTSize);
+
+        Measure(Name, 0, DefaultSampleRate, [&]() { FFT.Transform(TimeData, FreqData); });
+    }
+
+    ::printf("\n");
+
+    // Spectrum analyzers: the FFT size, the number of bands and the signal.
+    for (size_t FFTSize : FFTSizes)
+        MeasureAnalyzers(DefaultSampleRate, DefaultLayout, DefaultBandCount, FFTSize, false);
+
+    ::printf("\n");
+
+    for (size_t BandCount : BandCounts)
+    {
+        MeasureBandProcessing(BandCount);
+        MeasureAnalyzers(DefaultSampleRate, DefaultLayout, BandCount, DefaultFFTSize, true);
+    }
+
+    ::printf("\n");
+
+    // Spectrum curves
+    for (size_t BandCount : BandCounts)
+        MeasureCurves(BandCount);
+
+    ::printf("\n");
+
+    for (uint32_t SampleRate : SampleRates)
+    {
+        for (const auto & Layout : Layouts)
+            MeasureAnalyzers(SampleRate, Layout, DefaultBandCount, DefaultFFTSize, false);
+    }
+
+    ::printf("\n");
+
+    // Meters
+    for (uint32_t SampleRate : SampleRates)
+    {
+        for (const auto & Layout : Layouts)
+            MeasureMeters(SampleRate, Layout);
+    }
+
+    ::printf("\n");
+
+    // Oscilloscope
+    {
+        min_max_pyramid_t Pyramid;
+
+        Measure("Min/max pyramid (1 s)", DefaultSampleRate, DefaultSampleRate, [&]() { Pyramid.Build(Frames.data(), DefaultSampleRate, DefaultLayout.ChannelCount); });
+
+        volatile double Sink = 0.;
+
+        Measure("Min/max pyramid (1920 columns)", 0, DefaultSampleRate, [&]()
+        {
+            audio_sample Min, Max;
+            double Sum = 0.;
+
+            for (size_t x = 0; x < 1920; ++x)
+            {
+                Pyramid.GetRange((x * DefaultSampleRate) / 1920, ((x + 1) * DefaultSampleRate) / 1920, Min, Max);
+
+                Sum += (double) (Max - Min);
+            }
+
+            Sink = Sum;
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+
+/** $VER: FramePacing.cpp (2026.10.18) P. Stuer - Measures the lateness and the CPU usage of the frame pacer with a real clock (POSIX). **/
+
+#include "FramePacer.h"
+
+#include <time.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/// <summary>
+/// Implements the frame clock with the monotonic clock and clock_nanosleep(), the POSIX counterpart of the waitable timer clock of the component.
+/// </summary>
+class posix_clock_t : public frame_clock_t
+{
+public:
+    int64_t Now() const noexcept override
+    {
+        timespec ts;
+
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+        return (int64_t) ts.tv_sec * 1'000'000'000 + ts.tv_nsec;
+    }
+
+    int64_t GetFrequency() const noexcept override { return 1'000'000'000; }
+
+    bool Sleep(int64_t ticks) noexcept override
+    {
+        const timespec ts = { (time_t) (ticks / 1'000'000'000), (long) (ticks % 1'000'000'000) };
+
+        ::clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, nullptr);
+
+        return true;
+    }
+};
+
+/// <summary>
+/// Gets the CPU time used by the process (in ns).
+/// </summary>
+static int64_t GetProcessTime() noexcept
+{
+    timespec ts;
+
+    ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+    return (int64_t) ts.tv_sec * 1'000'000'000 + ts.tv_nsec;
+}
+
+/// <summary>
+/// Entry point. The optional arguments specify the number of frames (300 by default) and the frame rate (60 by default).
+/// </summary>
+int main(int argc, char * argv[])
+{
+    const int FrameCount = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 300;
+    const double FrameRate = (argc > 2) ? std::max(1., std::atof(argv[2])) : 60.;
+
+    posix_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    std::vector<int64_t> Lateness;
+
+    Lateness.reserve((size_t) FrameCount);
+
+    const int64_t StartTime = Clock.Now();
+    const int64_t StartProcessTime = GetProcessTime();
+
+    Pacer.Start(FrameRate, 0);
+
+    for (int i = 0; i < FrameCount; ++i)
+    {
+        if (!Pacer.WaitForNextFrame())
+            break;
+
+        Lateness.push_back(Pacer.GetLateness());
+    }
+
+    const double WallTime = (double) (Clock.Now() - StartTime);
+    const double ProcessTime = (double) (GetProcessTime() - StartProcessTime);
+
+    std::sort(Lateness.begin(), Lateness.end());
+
+    const auto Percentile = [&Lateness](double p) { return (double) Lateness[std::min((size_t) (p * (double) Lateness.size()), Lateness.size() - 1)] / 1000.; };
+
+    ::printf("%zu frames at %.1f fps in %.3f s\n", Lateness.size(), FrameRate, WallTime / 1e9);
+    ::printf("CPU usage:       %.2f%%\n", 100. * ProcessTime / WallTime);
+    ::printf("Lateness median: %.1f us\n", Percentile(0.50));
+    ::printf("Lateness p99:    %.1f us\n", Percentile(0.99));
+    ::printf("Lateness max:    %.1f us\n", (double) Lateness.back() / 1000.);
+    ::printf("Slack:           %.1f us\n", (double) Pacer.GetSlack() / 1000.);
+    ::printf("Missed frames:   %llu\n", (unsigned long long) Pacer.GetMissedFrames());
+
+    return 0;
+}
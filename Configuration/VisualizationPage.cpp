@@ -1,5 +1,5 @@
 
-/** $VER: VisualizationPage.cpp (2026.03.12) P. Stuer - Implements a configuration dialog page. **/
+/** $VER: VisualizationPage.cpp (2026.10.18) P. Stuer - Implements a configuration dialog page. **/
 
 #include "pch.h"
 
@@ -32,15 +32,19 @@ BOOL visualization_page_t::OnInitDialog(CWindow w, LPARAM lParam) noexcept
         { IDC_ANGULAR_VELOCITY, "Sets the angular velocity of the rotation in degrees per second. Positive values result in clockwise rotation; negative values in anti-clockwise rotation." },
 
         { IDC_OPACITY_MODE, "Renders the bit occurancy using opacity." },
+        { IDC_BIT_METER_VIEW, "Selects the representation of the samples: the floating-point value or the value converted to a 16-bit, 24-bit or 32-bit integer." },
 
         { IDC_SCROLLING_SPECTROGRAM, "Activates scrolling of the spectrogram." },
         { IDC_HORIZONTAL_SPECTROGRAM, "Renders the spectrogram horizontally." },
         { IDC_SPECTRUM_BAR_METRICS, "Uses the same rounding algorithm as when displaying spectrum bars. This makes it easier to align a vertical spectrogram with a spectrum bar visualization." },
+        { IDC_SPECTROGRAM_HISTORY, "Specifies how many seconds of the spectrogram are kept to recreate it after a resize or a change of colors." },
 
         { IDC_HORIZONTAL_PEAK_METER, "Renders the peak meter horizontally." },
         { IDC_RMS_PLUS_3, "Enables RMS readings compliant with IEC 61606:1997 / AES17-1998 standard (RMS +3)." },
         { IDC_CENTER_SCALE, "Renders a scale between the meter bars" },
         { IDC_SCALE_LINES, "Renders a scale line on the background of the meter bars" },
+        { IDC_TRUE_PEAK, "Measures the true peak of the 4x oversampled signal (ITU-R BS.1770) instead of the sample peak." },
+        { IDC_LOUDNESS_METER, "Shows the momentary, short-term and integrated loudness and the loudness range (EBU R128) instead of the channel levels." },
         { IDC_RMS_WINDOW, "Specifies the duration of each RMS measurement." },
         { IDC_BAR_GAP, "Specifies the gap between the peak meter bars (in pixels)." },
         { IDC_MAX_BAR_SIZE, "Specifies the max. size of a meter bar (in pixels). Use 0 to remove constraint." },
@@ -51,6 +55,8 @@ BOOL visualization_page_t::OnInitDialog(CWindow w, LPARAM lParam) noexcept
         { IDC_X_GAIN, "Specifies the gain applied to the X signal." },
         { IDC_Y_GAIN, "Specifies the gain applied to the Y signal." },
         { IDC_ROTATION, "Specifies the rotation angle of the signal in degrees." },
+        { IDC_ENVELOPE_MODE, "Renders the signal as a filled envelope of the minimum and maximum sample of each pixel column when the window holds more samples than pixels." },
+        { IDC_RMS_TRACE, "Renders the RMS of each pixel column inside the envelope." },
         { IDC_PHOSPHOR_DECAY, "Enables phosphor decay effect simulation of analog oscilloscopes." },
         { IDC_BLUR_SIGMA, "Specifies the number of pixels for the Gaussian blur. Higher values increase the blurring." },
         { IDC_DECAY_FACTOR, "Specifies the color fade speed. Lower values cause a faster decay." },
@@ -122,6 +128,15 @@ void visualization_page_t::InitializeControls() noexcept
     // Bit Meter
     {
         SendDlgItemMessageW(IDC_OPACITY_MODE, BM_SETCHECK, _State->_OpacityMode);
+
+        auto w = (CComboBox) GetDlgItem(IDC_BIT_METER_VIEW);
+
+        w.ResetContent();
+
+        for (const auto & x : { L"Floating point", L"16-bit integer", L"24-bit integer", L"32-bit integer" })
+            w.AddString(x);
+
+        w.SetCurSel((int) _State->_BitMeterView);
     }
 
     // Spectrogram
@@ -129,6 +144,12 @@ void visualization_page_t::InitializeControls() noexcept
         SendDlgItemMessageW(IDC_SCROLLING_SPECTROGRAM, BM_SETCHECK, _State->_ScrollingSpectrogram);
         SendDlgItemMessageW(IDC_HORIZONTAL_SPECTROGRAM, BM_SETCHECK, _State->_HorizontalSpectrogram);
         SendDlgItemMessageW(IDC_SPECTRUM_BAR_METRICS, BM_SETCHECK, _State->_UseSpectrumBarMetrics);
+
+        {
+            auto ne = std::make_shared<CNumericEdit>(); ne->Initialize(GetDlgItem(IDC_SPECTROGRAM_HISTORY)); _NumericEdits.push_back(ne);
+
+            SetDouble(IDC_SPECTROGRAM_HISTORY, _State->_SpectrogramHistory, 0, 0);
+        }
     }
 
     // Peak Meter
@@ -137,6 +158,8 @@ void visualization_page_t::InitializeControls() noexcept
         SendDlgItemMessageW(IDC_RMS_PLUS_3, BM_SETCHECK, _State->_RMSPlus3);
         SendDlgItemMessageW(IDC_CENTER_SCALE, BM_SETCHECK, _State->_HasCenterScale);
         SendDlgItemMessageW(IDC_SCALE_LINES, BM_SETCHECK, _State->_HasScaleLines);
+        SendDlgItemMessageW(IDC_TRUE_PEAK, BM_SETCHECK, _State->_TruePeak);
+        SendDlgItemMessageW(IDC_LOUDNESS_METER, BM_SETCHECK, _State->_IsLoudnessMeter);
 
         {
             auto ne = std::make_shared<CNumericEdit>(); ne->Initialize(GetDlgItem(IDC_RMS_WINDOW)); _NumericEdits.push_back(ne);
@@ -188,6 +211,9 @@ void visualization_page_t::InitializeControls() noexcept
             auto ne = std::make_shared<CNumericEdit>(); ne->Initialize(GetDlgItem(IDC_ROTATION)); _NumericEdits.push_back(ne); SetDouble(IDC_ROTATION, _State->_Rotation);
         }
 
+        SendDlgItemMessageW(IDC_ENVELOPE_MODE, BM_SETCHECK, _State->_EnvelopeMode);
+        SendDlgItemMessageW(IDC_RMS_TRACE, BM_SETCHECK, _State->_RMSTrace);
+
         SendDlgItemMessageW(IDC_PHOSPHOR_DECAY, BM_SETCHECK, _State->_PhosphorDecay);
         {
             auto ne = std::make_shared<CNumericEdit>(); ne->Initialize(GetDlgItem(IDC_BLUR_SIGMA)); _NumericEdits.push_back(ne); SetDouble(IDC_BLUR_SIGMA, _State->_BlurSigma);
@@ -244,19 +270,23 @@ void visualization_page_t::UpdateControls() noexcept
 
     // Bit Meter
     GetDlgItem(IDC_OPACITY_MODE).EnableWindow(IsBitMeter);
+    GetDlgItem(IDC_BIT_METER_VIEW).EnableWindow(IsBitMeter);
 
     // Spectrogram
     GetDlgItem(IDC_SCROLLING_SPECTROGRAM).EnableWindow(IsSpectrogram);
     GetDlgItem(IDC_HORIZONTAL_SPECTROGRAM).EnableWindow(IsSpectrogram);
     GetDlgItem(IDC_SPECTRUM_BAR_METRICS).EnableWindow(IsSpectrogram && !_State->_HorizontalSpectrogram);
+    GetDlgItem(IDC_SPECTROGRAM_HISTORY).EnableWindow(IsSpectrogram);
 
     // Peak Meter
     GetDlgItem(IDC_HORIZONTAL_PEAK_METER).EnableWindow(IsPeakMeter);
-    GetDlgItem(IDC_RMS_PLUS_3).EnableWindow(IsPeakMeter);
+    GetDlgItem(IDC_RMS_PLUS_3).EnableWindow(IsPeakMeter && !_State->_IsLoudnessMeter);
     GetDlgItem(IDC_CENTER_SCALE).EnableWindow(IsPeakMeter);
     GetDlgItem(IDC_SCALE_LINES).EnableWindow(IsPeakMeter);
+    GetDlgItem(IDC_TRUE_PEAK).EnableWindow(IsPeakMeter && !_State->_IsLoudnessMeter);
+    GetDlgItem(IDC_LOUDNESS_METER).EnableWindow(IsPeakMeter);
 
-    GetDlgItem(IDC_RMS_WINDOW).EnableWindow(IsPeakMeter);
+    GetDlgItem(IDC_RMS_WINDOW).EnableWindow(IsPeakMeter && !_State->_IsLoudnessMeter);
     GetDlgItem(IDC_BAR_GAP).EnableWindow(IsPeakMeter);
     GetDlgItem(IDC_MAX_BAR_SIZE).EnableWindow(IsPeakMeter);
 
@@ -270,6 +300,9 @@ void visualization_page_t::UpdateControls() noexcept
     GetDlgItem(IDC_Y_GAIN).EnableWindow(IsOscilloscope);    // Available in both modes.
     GetDlgItem(IDC_ROTATION).EnableWindow(IsOscilloscope && _State->_XYMode);
 
+    GetDlgItem(IDC_ENVELOPE_MODE).EnableWindow(IsOscilloscope && !_State->_XYMode);
+    GetDlgItem(IDC_RMS_TRACE).EnableWindow(IsOscilloscope && !_State->_XYMode && _State->_EnvelopeMode);
+
     GetDlgItem(IDC_PHOSPHOR_DECAY).EnableWindow(IsOscilloscope);
 
     GetDlgItem(IDC_BLUR_SIGMA).EnableWindow(IsOscilloscope & _State->_PhosphorDecay);
@@ -330,6 +363,12 @@ void visualization_page_t::OnSelectionChanged(UINT notificationCode, int id, CWi
             UpdateControls();
             break;
         }
+
+        case IDC_BIT_METER_VIEW:
+        {
+            _State->_BitMeterView = (BitMeterView) SelectedIndex;
+            break;
+        }
     }
 
     ConfigurationChanged(ChangedSettings);
@@ -413,6 +452,15 @@ void visualization_page_t::OnEditChange(UINT code, int id, CWindow) noexcept
             break;
         }
 
+        // Spectrogram
+        case IDC_SPECTROGRAM_HISTORY:
+        {
+            if (!SetProperty(_State->_SpectrogramHistory, std::clamp(::_wtof(Text), MinSpectrogramHistory, MaxSpectrogramHistory)))
+                return;
+
+            break;
+        }
+
         // Peak Meter
         case IDC_RMS_WINDOW:
         {
@@ -548,6 +596,13 @@ void visualization_page_t::OnEditLostFocus(UINT code, int id, CWindow) noexcept
             break;
         }
 
+        // Spectrogram
+        case IDC_SPECTROGRAM_HISTORY:
+        {
+            SetDouble(id, _State->_SpectrogramHistory, 0, 0);
+            break;
+        }
+
         // Peak Meter
         case IDC_RMS_WINDOW:
         {
@@ -693,6 +748,20 @@ void visualization_page_t::OnButtonClick(UINT, int id, CWindow) noexcept
             break;
         }
 
+        case IDC_TRUE_PEAK:
+        {
+            _State->_TruePeak = (bool) SendDlgItemMessageW(id, BM_GETCHECK);
+            break;
+        }
+
+        case IDC_LOUDNESS_METER:
+        {
+            _State->_IsLoudnessMeter = (bool) SendDlgItemMessageW(id, BM_GETCHECK);
+
+            UpdateControls();
+            break;
+        }
+
         case IDC_HORIZONTAL_LEVEL_METER:
         {
             _State->_HorizontalLevelMeter = (bool) SendDlgItemMessageW(id, BM_GETCHECK);
@@ -711,6 +780,24 @@ void visualization_page_t::OnButtonClick(UINT, int id, CWindow) noexcept
             break;
         }
 
+        case IDC_ENVELOPE_MODE:
+        {
+            _State->_EnvelopeMode = (bool) SendDlgItemMessageW(id, BM_GETCHECK);
+
+            UpdateControls();
+
+            ChangedSettings = ConfigurationChanges::Oscilloscope;
+            break;
+        }
+
+        case IDC_RMS_TRACE:
+        {
+            _State->_RMSTrace = (bool) SendDlgItemMessageW(id, BM_GETCHECK);
+
+            ChangedSettings = ConfigurationChanges::Oscilloscope;
+            break;
+        }
+
         case IDC_PHOSPHOR_DECAY:
         {
             _State->_PhosphorDecay = (bool) SendDlgItemMessageW(id, BM_GETCHECK);
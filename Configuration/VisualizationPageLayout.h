@@ -1,5 +1,5 @@
 
-/** $VER: VisualizationPageLayout.h (2026.03.12) P. Stuer - Defines the layout of a configuration dialog page. **/
+/** $VER: VisualizationPageLayout.h (2026.10.18) P. Stuer - Defines the layout of a configuration dialog page. **/
 
 #pragma once
 
@@ -193,8 +193,22 @@
     #define X_C80    X_C50 + 5
     #define Y_C80    Y_C50 + 11
 
+    #pragma region View
+    // Label
+    #define W_C83    42
+    #define H_C83    H_LBL
+    #define X_C83    X_C80
+    #define Y_C83    Y_C80 + H_C80 + IY
+
+    // Combobox
+    #define W_C84    60
+    #define H_C84    H_CBX
+    #define X_C84    X_C83 + W_C83 + IX
+    #define Y_C84    Y_C83
+    #pragma endregion
+
 #define W_C50   W_B15
-#define H_C50   11 + H_C80 + 7
+#define H_C50   11 + H_C80 + IY + H_C84 + 7
 
 /** Spectrogram **/
 
@@ -226,6 +240,26 @@
     #define Y_C28    Y_C27 + H_C27 + IY
     #pragma endregion
 
+    #pragma region History
+    // Label
+    #define W_C85    46
+    #define H_C85    H_LBL
+    #define X_C85    X_C28 + W_C28 + IX
+    #define Y_C85    Y_C15
+
+    // Textbox
+    #define W_C86    34
+    #define H_C86    H_TBX
+    #define X_C86    X_C85 + W_C85 + IX
+    #define Y_C86    Y_C85
+
+    // Label
+    #define W_C87    10
+    #define H_C87    H_LBL
+    #define X_C87    X_C86 + W_C86 + IX
+    #define Y_C87    Y_C86
+    #pragma endregion
+
 #define W_B08   232
 #define H_B08   11 + H_C15 + IY + H_C27 + IY + H_C28 + 7
 
@@ -260,6 +294,18 @@
     #define X_C77    X_C74
     #define Y_C77    Y_C74 + H_C74 + IY 
 
+    // Checkbox: True peak
+    #define W_C81    50
+    #define H_C81    H_CHB
+    #define X_C81    X_C74 + W_C74 + IX
+    #define Y_C81    Y_C74
+
+    // Checkbox: Loudness meter
+    #define W_C82    50
+    #define H_C82    H_CHB
+    #define X_C82    X_C81
+    #define Y_C82    Y_C81 + H_C81 + IY
+
     #pragma region RMS window
     // Label: RMS window
     #define W_C21   46
@@ -370,6 +416,18 @@
     #define X_C79    X_C78 + W_C78 + IX
     #define Y_C79    Y_C78
 
+    // Checkbox: Envelope mode
+    #define W_C88    62
+    #define H_C88    H_CHB
+    #define X_C88    X_C54
+    #define Y_C88    Y_C78
+
+    // Checkbox: RMS trace
+    #define W_C89    W_C60 + IX + W_C62
+    #define H_C89    H_CHB
+    #define X_C89    X_C60
+    #define Y_C89    Y_C78
+
     // Checkbox: Phosphor decay effect
     #define W_C64    62
     #define H_C64    H_CHB
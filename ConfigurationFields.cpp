@@ -0,0 +1,62 @@
+
+/** $VER: ConfigurationFields.cpp (2026.10.18) P. Stuer - Represents the settings that determine which subsystems a configuration change affects. **/
+
+#include "ConfigurationFields.h"
+
+/// <summary>
+/// Determines which subsystems are affected by the settings that differ between the old and the new fields.
+/// Settings that are not explicitly classified invalidate everything.
+/// </summary>
+ConfigurationChanges configuration_fields_t::GetChanges(const configuration_fields_t & o, const configuration_fields_t & n) noexcept
+{
+    // The visualizations, the spectrogram history and the peak indicators depend on the number and the position of the frequency bands.
+    if ((o.OtherSettings != n.OtherSettings) || !HasSameBands(o.Bands, n.Bands) || (o.Styles.size() != n.Styles.size()))
+        return ConfigurationChanges::All;
+
+    ConfigurationChanges Changes = ConfigurationChanges::None;
+
+    if ((o.RefreshRateLimit != n.RefreshRateLimit) || (o.ShowFrameCounter != n.ShowFrameCounter) || (o.ShowToolTipsAlways != n.ShowToolTipsAlways) || (o.VisualizeDuringPause != n.VisualizeDuringPause) ||
+        (o.ShowArtworkOnBackground != n.ShowArtworkOnBackground) || (o.ArtworkOpacity != n.ArtworkOpacity) || (o.Fit != n.Fit))
+        Changes = Changes | ConfigurationChanges::RenderLoop;
+
+    if ((o.XYMode != n.XYMode) || (o.XGain != n.XGain) || (o.YGain != n.YGain) || (o.Rotation != n.Rotation) ||
+        (o.PhosphorDecay != n.PhosphorDecay) || (o.BlurSigma != n.BlurSigma) || (o.DecayFactor != n.DecayFactor) || (o.EnvelopeMode != n.EnvelopeMode) || (o.RMSTrace != n.RMSTrace))
+        Changes = Changes | ConfigurationChanges::Oscilloscope;
+
+    if ((o.Smoothing != n.Smoothing) || (o.SmoothingFactor != n.SmoothingFactor))
+        Changes = Changes | ConfigurationChanges::Smoothing;
+
+    if ((o.Peaks != n.Peaks) || (o.HoldTime != n.HoldTime) || (o.Acceleration != n.Acceleration))
+        Changes = Changes | ConfigurationChanges::PeakIndicators;
+
+    if ((o.NumArtworkColors != n.NumArtworkColors) || (o.LightnessThreshold != n.LightnessThreshold) || (o.TransparencyThreshold != n.TransparencyThreshold) || (o.Order != n.Order))
+        Changes = Changes | ConfigurationChanges::Artwork;
+
+    // The bounds of the bands, the weighting and the analyzers change but the bands stay where they are.
+    if (!(o.Bands == n.Bands) || !(o.Analysis == n.Analysis) || (o.Transformation != n.Transformation) ||
+        (o.FFTSize != n.FFTSize) || (o.FFTCustom != n.FFTCustom) || (o.FFTDuration != n.FFTDuration) ||
+        (o.Window != n.Window) || (o.WindowParameter != n.WindowParameter) || (o.WindowSkew != n.WindowSkew) || (o.Truncate != n.Truncate) ||
+        (o.KernelShape != n.KernelShape) || (o.KernelShapeParameter != n.KernelShapeParameter) || (o.KernelAsymmetry != n.KernelAsymmetry))
+        Changes = Changes | ConfigurationChanges::Bands;
+
+    // The colors, the opacity and the thickness of a style are applied when its brush is recreated.
+    for (size_t i = 0; i < o.Styles.size(); ++i)
+    {
+        if (o.Styles[i].ID != n.Styles[i].ID)
+            return ConfigurationChanges::All;
+
+        if (!(o.Styles[i] == n.Styles[i]))
+            Changes = Changes | ConfigurationChanges::Styles;
+    }
+
+    return Changes;
+}
+
+/// <summary>
+/// Returns true if both settings generate the same number of frequency bands with the same center frequencies. Compares the settings of every distribution.
+/// </summary>
+bool configuration_fields_t::HasSameBands(const band_config_t & a, const band_config_t & b) noexcept
+{
+    return (a.Distribution == b.Distribution) && (a.BandCount == b.BandCount) && (a.LoFrequency == b.LoFrequency) && (a.HiFrequency == b.HiFrequency) && (a.Scaling == b.Scaling) && (a.SkewFactor == b.SkewFactor) &&
+           (a.MinNote == b.MinNote) && (a.MaxNote == b.MaxNote) && (a.BandsPerOctave == b.BandsPerOctave) && (a.TuningPitch == b.TuningPitch) && (a.Transpose == b.Transpose);
+}
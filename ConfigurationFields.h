@@ -0,0 +1,107 @@
+
+/** $VER: ConfigurationFields.h (2026.10.18) P. Stuer - Represents the settings that determine which subsystems a configuration change affects. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+#include "WindowFunctions.h"
+#include "AnalysisConfig.h"
+#include "BandProcessor.h"
+
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Represents the appearance of a style. Changing it only requires new brushes.
+/// </summary>
+#pragma warning(disable: 4820)
+struct style_fields_t
+{
+    uint32_t ID = 0;                            // Visual element of the style.
+
+    ColorSource Source = ColorSource::None;
+    uint32_t ColorIndex = 0;
+    ColorScheme Scheme = ColorScheme::Solid;
+    float CustomColor[4] = { };                 // Red, green, blue and alpha
+    std::vector<float> CustomGradientStops;     // Position, red, green, blue and alpha of each stop.
+
+    float Opacity = 1.f;
+    float Thickness = 1.f;
+
+    bool operator==(const style_fields_t &) const noexcept = default;
+};
+
+/// <summary>
+/// Represents the settings that determine which subsystems a configuration change affects. Taken from the state so the classification
+/// of the changes can be used and tested without the foobar2000 SDK. Portable: does not depend on Windows.
+/// </summary>
+struct configuration_fields_t
+{
+    // Settings that are read by the render loop and the visual elements every frame.
+    int64_t RefreshRateLimit = 0;
+    bool ShowFrameCounter = false;
+    bool ShowToolTipsAlways = false;
+    bool VisualizeDuringPause = false;
+    bool ShowArtworkOnBackground = false;
+    float ArtworkOpacity = 1.f;
+    FitMode Fit = FitMode::Free;
+
+    // Settings of the oscilloscope.
+    bool XYMode = false;
+    double XGain = 1.;
+    double YGain = 1.;
+    float Rotation = 0.f;
+    bool PhosphorDecay = false;
+    float BlurSigma = 0.f;
+    float DecayFactor = 0.f;
+    bool EnvelopeMode = false;
+    bool RMSTrace = false;
+
+    // Settings that are read by the normalization and the peak indicators of the analysis.
+    SmoothingMethod Smoothing = SmoothingMethod::Average;
+    double SmoothingFactor = 0.;
+
+    PeakMode Peaks = PeakMode::Classic;
+    double HoldTime = 0.;
+    double Acceleration = 0.;
+
+    // Settings that are used to extract the colors from the artwork.
+    uint32_t NumArtworkColors = 0;
+    float LightnessThreshold = 0.f;
+    float TransparencyThreshold = 0.f;
+    ColorOrder Order = ColorOrder::None;
+
+    // Settings of the frequency bands, the spectrum analyzers and their window functions. Only the settings that move the bands rebuild everything.
+    band_config_t Bands;
+    analysis_config_t Analysis;
+
+    Transform Transformation = Transform::FFT;
+
+    FFTMode FFTSize = FFTMode::FFT4096;
+    size_t FFTCustom = 0;
+    double FFTDuration = 0.;
+
+    WindowFunction Window = WindowFunction::Hann;
+    double WindowParameter = 1.;
+    double WindowSkew = 0.;
+    bool Truncate = true;
+
+    WindowFunction KernelShape = WindowFunction::Nuttall;
+    double KernelShapeParameter = 1.;
+    double KernelAsymmetry = 0.;
+
+    // Appearance of the styles, ordered by visual element.
+    std::vector<style_fields_t> Styles;
+
+    // The serialized settings without the ones above that rebuild less than everything. Any difference rebuilds everything.
+    std::vector<uint8_t> OtherSettings;
+
+    static ConfigurationChanges GetChanges(const configuration_fields_t & oldFields, const configuration_fields_t & newFields) noexcept;
+
+private:
+    static bool HasSameBands(const band_config_t & a, const band_config_t & b) noexcept;
+};
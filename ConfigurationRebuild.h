@@ -0,0 +1,55 @@
+
+/** $VER: ConfigurationRebuild.h (2026.10.18) P. Stuer - Determines what the render thread rebuilds when it adopts a configuration change. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+
+/// <summary>
+/// Represents what the render thread rebuilds when it adopts a configuration change. Portable: does not depend on Windows.
+/// </summary>
+struct configuration_rebuild_t
+{
+    bool DeleteDeviceResources;     // Release the brushes of the styles.
+    bool CreateGraphs;              // Recreate the graphs. Discards the spectrogram history and the peak indicators.
+    bool CreateBands;               // Regenerate the frequency bands and recreate the spectrum analyzers of the graphs. Keeps the graphs, the spectrogram history and the peak indicators.
+    bool ExtractArtworkColors;      // Extract the colors from the artwork again.
+    bool RestoreArtworkColors;      // Reapply the colors that were extracted from the artwork before.
+
+    /// <summary>
+    /// Gets what has to be rebuilt for the specified changes. The styles of every snapshot lose the colors extracted from the artwork, so they are always
+    /// extracted again or restored. The settings that are read every frame rebuild nothing else. The settings of the bands and the analyzers only rebuild the bands.
+    /// Any other change rebuilds everything.
+    /// </summary>
+    static configuration_rebuild_t Get(ConfigurationChanges changes, bool hasArtworkColors) noexcept
+    {
+        const uint32_t FrameSettings = (uint32_t) (ConfigurationChanges::RenderLoop | ConfigurationChanges::RefreshRate | ConfigurationChanges::PhosphorEffect |
+            ConfigurationChanges::Smoothing | ConfigurationChanges::PeakIndicators | ConfigurationChanges::Styles | ConfigurationChanges::Artwork);
+
+        const uint32_t BandSettings = (uint32_t) ConfigurationChanges::Bands;
+
+        configuration_rebuild_t Rebuild = { };
+
+        if (((uint32_t) changes & ~(FrameSettings | BandSettings)) != 0)
+        {
+            Rebuild.DeleteDeviceResources = true;
+            Rebuild.CreateGraphs          = true;
+            Rebuild.ExtractArtworkColors  = true;
+
+            return Rebuild;
+        }
+
+        Rebuild.CreateBands = ((uint32_t) changes & BandSettings) != 0;
+
+        if (((uint32_t) changes & (uint32_t) ConfigurationChanges::Artwork) != 0)
+            Rebuild.ExtractArtworkColors = true;
+        else
+            Rebuild.RestoreArtworkColors = hasArtworkColors;
+
+        return Rebuild;
+    }
+};
@@ -1,10 +1,13 @@
 
-/** $VER: Constants.h (2026.03.11) P. Stuer **/
+/** $VER: Constants.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <limits>
+
 inline const int MinFFTSize =     2;
 inline const int MaxFFTSize = 32768;
 
@@ -117,20 +120,23 @@ inline const double MaxHoldTime = 120.;
 inline const double MinAcceleration = 0.;
 inline const double MaxAcceleration = 2.;
 
-inline const FLOAT MinLEDSize =  0.f;
-inline const FLOAT MaxLEDSize = 32.f;
+inline const float MinLEDSize =  0.f;
+inline const float MaxLEDSize = 32.f;
 
-inline const FLOAT MinLEDGap =  0.f;
-inline const FLOAT MaxLEDGap = 32.f;
+inline const float MinLEDGap =  0.f;
+inline const float MaxLEDGap = 32.f;
 
 inline const double MinRMSWindow = 0.; // in seconds
 inline const double MaxRMSWindow = 3.; // in seconds
 
-inline const FLOAT MinBarGap =   0.; // in pixels
-inline const FLOAT MaxBarGap = std::numeric_limits<FLOAT>::max(); // in pixels
+inline const double MinSpectrogramHistory =   0.; // in seconds
+inline const double MaxSpectrogramHistory = 600.; // in seconds
+
+inline const float MinBarGap =   0.; // in pixels
+inline const float MaxBarGap = std::numeric_limits<float>::max(); // in pixels
 
-inline const FLOAT MinBarSize =   0.; // in pixels
-inline const FLOAT MaxBarSize = std::numeric_limits<FLOAT>::max(); // in pixels
+inline const float MinBarSize =   0.; // in pixels
+inline const float MaxBarSize = std::numeric_limits<float>::max(); // in pixels
 
 inline const double MinArtworkOpacity = 0.;
 inline const double MaxArtworkOpacity = 1.;
@@ -149,14 +155,14 @@ inline const double MaxXGain = 10.;
 inline const double MinYGain =  0.;
 inline const double MaxYGain = 10.;
 
-inline const FLOAT MinRotation = -180.f;
-inline const FLOAT MaxRotation =  180.f;
+inline const float MinRotation = -180.f;
+inline const float MaxRotation =  180.f;
 
-inline const FLOAT MinBlurSigma =  1.f;
-inline const FLOAT MaxBlurSigma = 10.f;
+inline const float MinBlurSigma =  1.f;
+inline const float MaxBlurSigma = 10.f;
 
-inline const FLOAT MinDecayFactor = 0.f;
-inline const FLOAT MaxDecayFactor = 1.f;
+inline const float MinDecayFactor = 0.f;
+inline const float MaxDecayFactor = 1.f;
 
 
 
@@ -327,7 +333,15 @@ enum class VisualizationTypes : uint64_t
     Oscilloscope    = 1 << (int) VisualizationType::Oscilloscope,
     BitMeter        = 1 << (int) VisualizationType::BitMeter,
 
-    All = ~0
+    All = ~0ull
+};
+
+enum class BitMeterView
+{
+    Native = 0,     // The bits of the floating-point sample (32 or 64 bits)
+    Int16 = 1,      // The bits of the sample converted to a 16-bit integer
+    Int24 = 2,      // The bits of the sample converted to a 24-bit integer
+    Int32 = 3,      // The bits of the sample converted to a 32-bit integer
 };
 
 enum class PeakMode
@@ -591,6 +605,12 @@ enum class ConfigurationChanges : uint32_t
     RefreshRate     = 1 << 2,
     PhosphorEffect  = 1 << 3, // Configuration change impacts the phosphor effect.
 
+    Smoothing       = 1 << 4, // Configuration change impacts the smoothing of the normalized values.
+    PeakIndicators  = 1 << 5, // Configuration change impacts the peak indicators.
+    Styles          = 1 << 6, // Configuration change impacts the colors, opacity or thickness of the styles.
+    Artwork         = 1 << 7, // Configuration change impacts the colors extracted from the artwork.
+    Bands           = 1 << 8, // Configuration change impacts the bounds and the weighting of the frequency bands or the spectrum analyzers but not the number and the position of the bands.
+
     Oscilloscope = PhosphorEffect,
 
     All = ~0u,
@@ -600,3 +620,8 @@ inline bool operator==(ConfigurationChanges a, ConfigurationChanges b)
 {
     return (size_t) a == (size_t) b;
 }
+
+inline ConfigurationChanges operator|(ConfigurationChanges a, ConfigurationChanges b)
+{
+    return (ConfigurationChanges) ((uint32_t) a | (uint32_t) b);
+}
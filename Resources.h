@@ -1,5 +1,5 @@
 
-/** $VER: Resources.h (2026.03.15) P. Stuer **/
+/** $VER: Resources.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -59,6 +59,7 @@
 #define STR_WINDOW_CLASS_NAME   "{08e851a2-ec49-467e-a336-775d79ee26de}"
 
 #define UM_CONFIGURATION_CHANGED        WM_USER + 1
+#define UM_GRAPHS_CHANGED               WM_USER + 2     // The render thread recreated the graphs.
 
 #define CC_PRESET_LOADED                1       // The user has loaded a preset from the context menu.
 #define CC_COLORS                       2       // The colors have changed, either by the render thread or by the user in the main foobar2000 preference dialog.
@@ -448,6 +449,10 @@
 #define IDC_HORIZONTAL_SPECTROGRAM      7154
 #define IDC_SPECTRUM_BAR_METRICS        7156
 
+#define IDC_SPECTROGRAM_HISTORY_LBL     7157
+#define IDC_SPECTROGRAM_HISTORY         7158
+#define IDC_SPECTROGRAM_HISTORY_UNIT    7159
+
 // Peak Meter
 
 #define IDC_PEAK_METER                  7160
@@ -456,6 +461,8 @@
 #define IDC_RMS_PLUS_3                  7164
 #define IDC_CENTER_SCALE                7166
 #define IDC_SCALE_LINES                 7168
+#define IDC_TRUE_PEAK                   7186
+#define IDC_LOUDNESS_METER              7188
 
 #define IDC_RMS_WINDOW_LBL              7170
 #define IDC_RMS_WINDOW                  7172
@@ -495,12 +502,18 @@
 #define IDC_DECAY_FACTOR_LBL            7222
 #define IDC_DECAY_FACTOR                7224
 
+#define IDC_ENVELOPE_MODE               7226
+#define IDC_RMS_TRACE                   7228
+
 // Bit Meter
 
 #define IDC_BIT_METER                   7240
 
 #define IDC_OPACITY_MODE                7242
 
+#define IDC_BIT_METER_VIEW_LBL          7244
+#define IDC_BIT_METER_VIEW              7246
+
 #pragma endregion
 
 #pragma region Styles
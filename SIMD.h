@@ -0,0 +1,18 @@
+
+/** $VER: SIMD.h (2026.10.18) P. Stuer - Detects the vector instruction sets the kernels can use. Portable: does not depend on Windows. **/
+
+#pragma once
+
+// SIMD_SSE2 is defined when the compiler can generate SSE2 code (MSVC x86 and x64, GCC and Clang targeting SSE2).
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define SIMD_SSE2 1
+#endif
+
+// SIMD_SSE2_BASELINE is defined when every processor the code can run on supports SSE2. On 32-bit MSVC builds the kernels check the processor at run-time.
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define SIMD_SSE2_BASELINE 1
+#endif
+
+#if defined(SIMD_SSE2)
+#include <emmintrin.h>
+#endif
@@ -0,0 +1,6 @@
+
+/** $VER: Warnings.h (2026.10.18) P. Stuer - Stands in for the C++ Core Check warnings header of Visual Studio when the portable core is built with another compiler. **/
+
+#pragma once
+
+#define ALL_CPPCORECHECK_WARNINGS
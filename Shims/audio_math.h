@@ -0,0 +1,14 @@
+
+/** $VER: audio_math.h (2026.10.18) P. Stuer - Stands in for the audio sample definitions of the foobar2000 SDK when the portable core is built without the SDK. **/
+
+#pragma once
+
+#ifndef audio_sample_size
+#define audio_sample_size 32
+#endif
+
+#if (audio_sample_size == 64)
+typedef double audio_sample;
+#else
+typedef float audio_sample;
+#endif
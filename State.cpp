@@ -1,5 +1,5 @@
 
-/** $VER: State.cpp (2026.03.12) P. Stuer **/
+/** $VER: State.cpp (2026.10.18) P. Stuer **/
 
 #include "pch.h"
 #include "State.h"
@@ -38,6 +38,7 @@ void state_t::Reset() noexcept
     _RefreshRateLimit = 20; // Hz
     _SleepTime = 200; // μs
 
+    _ShowFrameCounter = false;
     _UseHardwareRendering = true;
     _UseAntialiasing = true;
 
@@ -235,10 +236,13 @@ void state_t::Reset() noexcept
     _ScrollingSpectrogram = true;
     _HorizontalSpectrogram = true;
     _UseSpectrumBarMetrics = false;
+    _SpectrogramHistory = 60.; // seconds
 
     // Peak Meter
     _IsHorizontalPeakMeter = false;
     _RMSPlus3 = false;
+    _TruePeak = false;
+    _IsLoudnessMeter = false;
     _RMSWindow = .300; // seconds
     _BarGap = 1.f; // pixels
     _HasCenterScale = false;
@@ -257,9 +261,12 @@ void state_t::Reset() noexcept
     _PhosphorDecay = true;
     _BlurSigma = 3.f;
     _DecayFactor = 0.92f;
+    _EnvelopeMode = false;
+    _RMSTrace = true;
 
     // Bit Meter
     _OpacityMode = false;
+    _BitMeterView = BitMeterView::Native;
 
     _StyleManager.Reset();
 
@@ -271,8 +278,6 @@ void state_t::Reset() noexcept
 
     /** Not serialized **/
 
-    _SampleRate = 0;
-
     _ActivePresetName.clear();
 }
 
@@ -286,6 +291,7 @@ state_t & state_t::operator=(const state_t & other) noexcept
 
     _RefreshRateLimit = other._RefreshRateLimit;
 
+    _ShowFrameCounter = other._ShowFrameCounter;
     _UseHardwareRendering = other._UseHardwareRendering;
     _UseAntialiasing = other._UseAntialiasing;
 
@@ -511,10 +517,13 @@ state_t & state_t::operator=(const state_t & other) noexcept
     _ScrollingSpectrogram = other._ScrollingSpectrogram;
     _HorizontalSpectrogram = other._HorizontalSpectrogram;
     _UseSpectrumBarMetrics = other._UseSpectrumBarMetrics;
+    _SpectrogramHistory = other._SpectrogramHistory;
 
     // Peak Meter
     _IsHorizontalPeakMeter = other._IsHorizontalPeakMeter;
     _RMSPlus3 = other._RMSPlus3;
+    _TruePeak = other._TruePeak;
+    _IsLoudnessMeter = other._IsLoudnessMeter;
     _RMSWindow = other._RMSWindow;
     _BarGap = other._BarGap;
     _HasCenterScale = other._HasCenterScale;
@@ -533,9 +542,12 @@ state_t & state_t::operator=(const state_t & other) noexcept
     _PhosphorDecay = other._PhosphorDecay;
     _BlurSigma = other._BlurSigma;
     _DecayFactor = other._DecayFactor;
+    _EnvelopeMode = other._EnvelopeMode;
+    _RMSTrace = other._RMSTrace;
 
     // Bit Meter
     _OpacityMode = other._OpacityMode;
+    _BitMeterView = other._BitMeterView;
 
     #pragma endregion
 
@@ -553,7 +565,6 @@ state_t & state_t::operator=(const state_t & other) noexcept
 
     #pragma region Not serialized
 
-    _BinCount = other._BinCount;
     _ActivePresetName = other._ActivePresetName;
 
     #pragma endregion
@@ -561,6 +572,282 @@ state_t & state_t::operator=(const state_t & other) noexcept
     return *this;
 }
 
+/// <summary>
+/// Gets the settings of the spectrum analyzers.
+/// </summary>
+analysis_config_t state_t::GetAnalysisConfig() const noexcept
+{
+    analysis_config_t Config;
+
+    Config.KernelSize             = _KernelSize;
+    Config.Summation              = _SummationMethod;
+    Config.SmoothLowerFrequencies = _SmoothLowerFrequencies;
+    Config.SmoothGainTransition   = _SmoothGainTransition;
+
+    Config.MappingMethod          = _MappingMethod;
+
+    Config.BandwidthOffset        = _BandwidthOffset;
+    Config.BandwidthCap           = _BandwidthCap;
+    Config.BandwidthAmount        = _BandwidthAmount;
+    Config.UseGranularBandwidth   = _UseGranularBandwidth;
+
+    Config.CQTBandwidthOffset     = _CQTBandwidthOffset;
+    Config.CQTAlignment           = _CQTAlignment;
+    Config.CQTDownSample          = _CQTDownSample;
+
+    Config.FilterBankOrder        = _FilterBankOrder;
+    Config.TimeResolution         = _TimeResolution;
+    Config.IIRBandwidth           = _IIRBandwidth;
+    Config.ConstantQ              = _ConstantQ;
+    Config.CompensateBW           = _CompensateBW;
+    Config.PreWarpQ               = _PreWarpQ;
+
+    return Config;
+}
+
+/// <summary>
+/// Gets the settings of the frequency bands and of the weighting of their values.
+/// </summary>
+band_config_t state_t::GetBandConfig() const noexcept
+{
+    band_config_t Config;
+
+    Config.Distribution        = _FrequencyDistribution;
+
+    Config.BandCount           = _BandCount;
+    Config.LoFrequency         = _LoFrequency;
+    Config.HiFrequency         = _HiFrequency;
+
+    Config.Scaling             = _ScalingFunction;
+    Config.SkewFactor          = _SkewFactor;
+
+    Config.MinNote             = _MinNote;
+    Config.MaxNote             = _MaxNote;
+    Config.BandsPerOctave      = _BandsPerOctave;
+    Config.TuningPitch         = _TuningPitch;
+    Config.Transpose           = _Transpose;
+
+    // Only the triangular filter bank and the CQT use the bandwidth setting.
+    Config.Bandwidth           = (((_Transform == Transform::FFT) && (_MappingMethod == Mapping::TriangularFilterBank)) || (_Transform == Transform::CQT)) ? _Bandwidth : 0.5;
+
+    Config.Weighting           = _WeightingType;
+    Config.WeightingAmount     = _WeightingAmount;
+
+    Config.SlopeFunctionOffset = _SlopeFunctionOffset;
+    Config.Slope               = _Slope;
+    Config.SlopeOffset         = _SlopeOffset;
+
+    Config.EqualizeAmount      = _EqualizeAmount;
+    Config.EqualizeOffset      = _EqualizeOffset;
+    Config.EqualizeDepth       = _EqualizeDepth;
+
+    return Config;
+}
+
+/// <summary>
+/// Gets the number of FFT bins for the specified sample rate.
+/// </summary>
+size_t state_t::GetBinCount(uint32_t sampleRate) const noexcept
+{
+    #pragma warning(disable: 4061)
+
+    switch (_FFTMode)
+    {
+        default:
+            return (size_t) (64. * ::exp2((long) _FFTMode));
+
+        case FFTMode::FFTCustom:
+            return (_FFTCustom > 0) ? (size_t) _FFTCustom : 64;
+
+        case FFTMode::FFTDuration:
+            return (_FFTDuration > 0.) ? (size_t) (((double) sampleRate * _FFTDuration) / 1000.) : 64;
+    }
+
+    #pragma warning(default: 4061)
+}
+
+/// <summary>
+/// Determines which subsystems are affected by the settings that differ between the specified state and this state.
+/// Settings that are not explicitly classified invalidate everything.
+/// </summary>
+ConfigurationChanges state_t::GetChanges(const state_t & other) const noexcept
+{
+    return configuration_fields_t::GetChanges(other.GetConfigurationFields(), GetConfigurationFields());
+}
+
+/// <summary>
+/// Gets the settings that determine which subsystems a configuration change affects.
+/// </summary>
+configuration_fields_t state_t::GetConfigurationFields() const noexcept
+{
+    configuration_fields_t Fields;
+
+    Fields.RefreshRateLimit        = _RefreshRateLimit;
+    Fields.ShowFrameCounter        = _ShowFrameCounter;
+    Fields.ShowToolTipsAlways      = _ShowToolTipsAlways;
+    Fields.VisualizeDuringPause    = _VisualizeDuringPause;
+    Fields.ShowArtworkOnBackground = _ShowArtworkOnBackground;
+    Fields.ArtworkOpacity          = _ArtworkOpacity;
+    Fields.Fit                     = _FitMode;
+
+    Fields.XYMode                  = _XYMode;
+    Fields.XGain                   = _XGain;
+    Fields.YGain                   = _YGain;
+    Fields.Rotation                = _Rotation;
+    Fields.PhosphorDecay           = _PhosphorDecay;
+    Fields.BlurSigma               = _BlurSigma;
+    Fields.DecayFactor             = _DecayFactor;
+    Fields.EnvelopeMode            = _EnvelopeMode;
+    Fields.RMSTrace                = _RMSTrace;
+
+    Fields.Smoothing               = _SmoothingMethod;
+    Fields.SmoothingFactor         = _SmoothingFactor;
+
+    Fields.Peaks                   = _PeakMode;
+    Fields.HoldTime                = _HoldTime;
+    Fields.Acceleration            = _Acceleration;
+
+    Fields.NumArtworkColors        = _NumArtworkColors;
+    Fields.LightnessThreshold      = _LightnessThreshold;
+    Fields.TransparencyThreshold   = _TransparencyThreshold;
+    Fields.Order                   = _ColorOrder;
+
+    Fields.Bands                   = GetBandConfig();
+    Fields.Analysis                = GetAnalysisConfig();
+
+    Fields.Transformation          = _Transform;
+
+    Fields.FFTSize                 = _FFTMode;
+    Fields.FFTCustom               = _FFTCustom;
+    Fields.FFTDuration             = _FFTDuration;
+
+    Fields.Window                  = _WindowFunction;
+    Fields.WindowParameter         = _WindowParameter;
+    Fields.WindowSkew              = _WindowSkew;
+    Fields.Truncate                = _Truncate;
+
+    Fields.KernelShape             = _KernelShape;
+    Fields.KernelShapeParameter    = _KernelShapeParameter;
+    Fields.KernelAsymmetry         = _KernelAsymmetry;
+
+    for (const auto & [ID, Style] : _StyleManager.Styles)
+    {
+        style_fields_t StyleFields;
+
+        StyleFields.ID          = (uint32_t) ID;
+        StyleFields.Source      = Style._ColorSource;
+        StyleFields.ColorIndex  = Style._ColorIndex;
+        StyleFields.Scheme      = Style._ColorScheme;
+
+        StyleFields.CustomColor[0] = Style._CustomColor.r;
+        StyleFields.CustomColor[1] = Style._CustomColor.g;
+        StyleFields.CustomColor[2] = Style._CustomColor.b;
+        StyleFields.CustomColor[3] = Style._CustomColor.a;
+
+        for (const auto & Stop : Style._CustomGradientStops)
+            StyleFields.CustomGradientStops.insert(StyleFields.CustomGradientStops.end(), { Stop.position, Stop.color.r, Stop.color.g, Stop.color.b, Stop.color.a });
+
+        StyleFields.Opacity     = Style._Opacity;
+        StyleFields.Thickness   = Style._Thickness;
+
+        Fields.Styles.push_back(StyleFields);
+    }
+
+    std::sort(Fields.Styles.begin(), Fields.Styles.end(), [](const style_fields_t & a, const style_fields_t & b) { return a.ID < b.ID; });
+
+    // Serialize the other settings after clearing the ones that rebuild less than everything. The settings that move the frequency bands are kept.
+    state_t Other; Other = *this;
+
+    Other._DialogRect = { };
+
+    Other._RefreshRateLimit = { };
+    Other._ShowFrameCounter = { };
+    Other._ShowToolTipsAlways = { };
+    Other._VisualizeDuringPause = { };
+    Other._ShowArtworkOnBackground = { };
+    Other._ArtworkOpacity = { };
+    Other._FitMode = { };
+
+    Other._XYMode = { };
+    Other._XGain = { };
+    Other._YGain = { };
+    Other._Rotation = { };
+    Other._PhosphorDecay = { };
+    Other._BlurSigma = { };
+    Other._DecayFactor = { };
+    Other._EnvelopeMode = { };
+    Other._RMSTrace = { };
+
+    Other._SmoothingMethod = { };
+    Other._SmoothingFactor = { };
+
+    Other._PeakMode = { };
+    Other._HoldTime = { };
+    Other._Acceleration = { };
+
+    Other._NumArtworkColors = { };
+    Other._LightnessThreshold = { };
+    Other._TransparencyThreshold = { };
+    Other._ColorOrder = { };
+
+    Other._Bandwidth = { };
+
+    Other._WeightingType = { };
+    Other._WeightingAmount = { };
+    Other._SlopeFunctionOffset = { };
+    Other._Slope = { };
+    Other._SlopeOffset = { };
+    Other._EqualizeAmount = { };
+    Other._EqualizeOffset = { };
+    Other._EqualizeDepth = { };
+
+    Other._KernelSize = { };
+    Other._SummationMethod = { };
+    Other._SmoothLowerFrequencies = { };
+    Other._SmoothGainTransition = { };
+    Other._MappingMethod = { };
+    Other._BandwidthOffset = { };
+    Other._BandwidthCap = { };
+    Other._BandwidthAmount = { };
+    Other._UseGranularBandwidth = { };
+    Other._FilterBankOrder = { };
+    Other._TimeResolution = { };
+    Other._IIRBandwidth = { };
+    Other._ConstantQ = { };
+    Other._CompensateBW = { };
+    Other._PreWarpQ = { };
+
+    Other._Transform = { };
+    Other._FFTMode = { };
+    Other._FFTCustom = { };
+    Other._FFTDuration = { };
+    Other._WindowFunction = { };
+    Other._WindowParameter = { };
+    Other._WindowSkew = { };
+    Other._KernelShape = { };
+    Other._KernelShapeParameter = { };
+    Other._KernelAsymmetry = { };
+
+    for (auto & [ID, Style] : Other._StyleManager.Styles)
+    {
+        Style._ColorSource = { };
+        Style._ColorIndex = { };
+        Style._ColorScheme = { };
+        Style._CustomColor = { };
+        Style._CustomGradientStops.clear();
+        Style._Opacity = { };
+        Style._Thickness = { };
+    }
+
+    stream_writer_buffer_simple Data;
+
+    Other.Write(&Data);
+
+    Fields.OtherSettings.assign((const uint8_t *) Data.m_buffer.get_ptr(), (const uint8_t *) Data.m_buffer.get_ptr() + Data.m_buffer.get_size());
+
+    return Fields;
+}
+
 /// <summary>
 /// Reads this instance with the specified reader.
 /// </summary>
@@ -976,6 +1263,32 @@ void state_t::Read(stream_reader * reader, size_t size, abort_callback & abortHa
         {
             reader->read_object_t(_OpacityMode, abortHandler);
         }
+
+        if (Version >= 36)
+        {
+            reader->read_object_t(_TruePeak, abortHandler);
+        }
+
+        if (Version >= 37)
+        {
+            reader->read_object_t(_IsLoudnessMeter, abortHandler);
+        }
+
+        if (Version >= 38)
+        {
+            reader->read(&_BitMeterView, sizeof(_BitMeterView), abortHandler);
+        }
+
+        if (Version >= 39)
+        {
+            reader->read_object_t(_SpectrogramHistory, abortHandler);
+        }
+
+        if (Version >= 40)
+        {
+            reader->read_object_t(_EnvelopeMode, abortHandler);
+            reader->read_object_t(_RMSTrace, abortHandler);
+        }
     }
     catch (exception & ex)
     {
@@ -1315,6 +1628,22 @@ void state_t::Write(stream_writer * writer, abort_callback & abortHandler, bool
 
         // Version 35, v0.10.0-beta1
         writer->write_object_t(_OpacityMode, abortHandler);
+
+        // Version 36, v0.10.0-beta3
+        writer->write_object_t(_TruePeak, abortHandler);
+
+        // Version 37, v0.10.0-beta3
+        writer->write_object_t(_IsLoudnessMeter, abortHandler);
+
+        // Version 38, v0.10.0-beta3
+        writer->write(&_BitMeterView, sizeof(_BitMeterView), abortHandler);
+
+        // Version 39, v0.10.0-beta3
+        writer->write_object_t(_SpectrogramHistory, abortHandler);
+
+        // Version 40, v0.10.0-beta3
+        writer->write_object_t(_EnvelopeMode, abortHandler);
+        writer->write_object_t(_RMSTrace, abortHandler);
     }
     catch (exception & ex)
     {
@@ -1,5 +1,5 @@
 
-/** $VER: State.h (2026.03.12) P. Stuer **/
+/** $VER: State.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -11,6 +11,9 @@
 
 #include "Constants.h"
 #include "WindowFunctions.h"
+#include "AnalysisConfig.h"
+#include "BandProcessor.h"
+#include "ConfigurationFields.h"
 
 #include "StyleManager.h"
 #include "GraphDescription.h"
@@ -37,6 +40,12 @@ public:
     void Read(stream_reader * reader, size_t size, abort_callback & abortHandler = fb2k::noAbort, bool isPreset = false) noexcept;
     void Write(stream_writer * writer, abort_callback & abortHandler = fb2k::noAbort, bool isPreset = false) const noexcept;
 
+    ConfigurationChanges GetChanges(const state_t & other) const noexcept;
+    configuration_fields_t GetConfigurationFields() const noexcept;
+    analysis_config_t GetAnalysisConfig() const noexcept;
+    band_config_t GetBandConfig() const noexcept;
+    size_t GetBinCount(uint32_t sampleRate) const noexcept;
+
     /// <summary>
     /// Gets the duration (in ms) of the window that will be rendered.
     /// </summary>
@@ -55,7 +64,7 @@ public:
     int32_t _RefreshRateLimit;                                          // Target FPS in Hz
 #endif
 
-    int64_t _SleepTime;                                                 // Number of μs that the render thread is put to sleep to yield to the UI thread.
+    int64_t _SleepTime;                                                 // Initial margin (in μs) by which the render thread and the analysis thread wake up before the deadline of a frame. Calibrated at run time.
 
     bool _ShowFrameCounter;
     bool _UseHardwareRendering;
@@ -227,6 +236,7 @@ public:
             bool _ScrollingSpectrogram;                             // True if the spectrogram needs to scroll.
             bool _HorizontalSpectrogram;                            // True if the spectrogram should be rendered horizontally.
             bool _UseSpectrumBarMetrics;                            // True if the same algorithm should be used as the bar spectrum.
+            double _SpectrogramHistory;                             // Duration of the history that is kept to recreate the spectrogram after a resize or a change of colors (in seconds)
 
         #pragma endregion
 
@@ -234,6 +244,8 @@ public:
 
             bool _IsHorizontalPeakMeter;                            // True if the peak meter should be rendered horizontally.
             bool _RMSPlus3;                                         // True if the RMS readings should be increased by 3dB.
+            bool _TruePeak;                                         // True if the peak readings should be determined from the 4x oversampled signal (ITU-R BS.1770).
+            bool _IsLoudnessMeter;                                  // True if the peak meter should render the momentary, short-term and integrated loudness and the loudness range (EBU R128) instead of the channel levels.
             bool _HasCenterScale;                                   // Render a scale between the bars.
             bool _HasScaleLines;                                    // Render a scale between the bars.
 
@@ -259,12 +271,15 @@ public:
             bool _PhosphorDecay;
             FLOAT _BlurSigma;
             FLOAT _DecayFactor;
+            bool _EnvelopeMode;                                     // Renders the signal as the filled min/max envelope of each pixel column.
+            bool _RMSTrace;                                         // Renders the RMS of each pixel column inside the envelope.
 
         #pragma endregion
 
         #pragma region Bit Meter
 
             bool _OpacityMode;
+            BitMeterView _BitMeterView;                             // Determines how the bits of a sample are presented.
 
         #pragma endregion
 
@@ -301,16 +316,12 @@ public:
     std::wstring _ActivePresetName;                                     // The name of the last loaded preset.
     bool _ShowToolTipsNow;                                              // True when the tool tip is forced to be visible (left mousebutton down)
 
-    uint32_t _SampleRate;
-
     #pragma endregion
 
     #pragma region Render thread
 
     std::vector<D2D1_COLOR_F> _ArtworkColors;                           // The colors extracted from the artwork bitmap.
 
-    size_t _BinCount;                                                   // Spectrum
-
     double _PlaybackTime;                                               // Spectrogram: Timestamp of the last rendered audio chunk.
     double _TrackTime;                                                  // Spectrogram
 
@@ -384,7 +395,18 @@ private:
     #pragma endregion
 
 private:
-    const size_t _CurrentVersion = 35; // v0.10.0.0-beta1
+    const size_t _CurrentVersion = 40; // v0.10.0.0-beta3
+};
+
+/// <summary>
+/// Represents a snapshot of the configuration published by the UI thread. It is never modified after it has been published.
+/// </summary>
+struct configuration_snapshot_t
+{
+    configuration_snapshot_t() noexcept : Changes(ConfigurationChanges::None) { }
+
+    state_t State;
+    ConfigurationChanges Changes;   // Changes since the last snapshot adopted by the render thread.
 };
 
 const LogLevel DefaultCfgLogLevel = LogLevel::Info;
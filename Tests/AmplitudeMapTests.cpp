@@ -0,0 +1,106 @@
+
+/** $VER: AmplitudeMapTests.cpp (2026.10.18) P. Stuer - Tests the mapping of amplitudes to colors. **/
+
+#include "Test.h"
+
+#include "AmplitudeMap.h"
+
+#include <vector>
+
+static const amplitude_gradient_stop_t BlackToWhite[] =
+{
+    { 0.f, { 1.f, 1.f, 1.f, 1.f } },
+    { 1.f, { 0.f, 0.f, 0.f, 1.f } },
+};
+
+TEST_CASE(AmplitudeMap, MapsTheFirstStopToTheHighestAmplitude)
+{
+    std::vector<amplitude_color_t> Colors;
+
+    CHECK(amplitude_map_t::Create(BlackToWhite, 2, false, Colors));
+    CHECK(Colors.size() == amplitude_map_t::Size);
+
+    CHECK_NEAR(Colors.front().r, 0., 1e-6);
+    CHECK_NEAR(Colors.back().r,  1., 1e-6);
+    CHECK_NEAR(Colors[Colors.size() / 2].r, 0.5, 0.01);
+
+    for (size_t i = 1; i < Colors.size(); ++i)
+        CHECK(Colors[i].r >= Colors[i - 1].r);
+}
+
+TEST_CASE(AmplitudeMap, CalculatesTheSoXColors)
+{
+    std::vector<amplitude_color_t> Colors;
+
+    CHECK(amplitude_map_t::Create(BlackToWhite, 2, true, Colors));
+    CHECK(Colors.size() == amplitude_map_t::Size);
+
+    // Black for silence, white for full scale.
+    CHECK_NEAR(Colors.front().r, 0., 1e-6);
+    CHECK_NEAR(Colors.front().g, 0., 1e-6);
+    CHECK_NEAR(Colors.front().b, 0., 1e-6);
+
+    CHECK_NEAR(Colors.back().r, 1., 1e-6);
+    CHECK_NEAR(Colors.back().g, 1., 1e-6);
+    CHECK_NEAR(Colors.back().b, 1., 1e-6);
+}
+
+TEST_CASE(AmplitudeMap, RequiresGradientStops)
+{
+    std::vector<amplitude_color_t> Colors;
+
+    CHECK(!amplitude_map_t::Create(nullptr, 0, false, Colors));
+}
+
+TEST_CASE(AmplitudeMap, CreatesPremultipliedPixels)
+{
+    const amplitude_color_t Colors[] = { { 1.f, 0.5f, 0.f, 1.f }, { 1.f, 1.f, 1.f, 0.5f } };
+
+    std::vector<uint32_t> Pixels;
+
+    amplitude_map_t::CreatePixels(Colors, 2, 1.f, Pixels);
+
+    CHECK(Pixels.size() == 2);
+    CHECK(Pixels[0] == 0xFFFF8000u);
+    CHECK(Pixels[1] == 0x80808080u);
+
+    amplitude_map_t::CreatePixels(Colors, 2, 0.f, Pixels);
+
+    CHECK(Pixels[0] == 0u);
+}
+
+TEST_CASE(AmplitudeMap, MapsEachValueToItsShareOfTheMap)
+{
+    std::vector<uint32_t> Map(amplitude_map_t::Size);
+
+    for (size_t i = 0; i < Map.size(); ++i)
+        Map[i] = (uint32_t) i;
+
+    // Enough values to use the vectorized path and the remainder.
+    std::vector<uint16_t> Values;
+
+    for (uint32_t v = 0; v <= 65535; v += 37)
+        Values.push_back((uint16_t) v);
+
+    Values.push_back(65535);
+
+    std::vector<uint32_t> Pixels(Values.size());
+
+    amplitude_map_t::GetPixels(Map.data(), Map.size(), Values.data(), Values.size(), Pixels.data());
+
+    for (size_t i = 0; i < Values.size(); ++i)
+        CHECK(Pixels[i] == ((uint32_t) Values[i] * amplitude_map_t::Size) >> 16);
+
+    CHECK(Pixels.front() == 0);
+    CHECK(Pixels.back() == amplitude_map_t::Size - 1);
+}
+
+TEST_CASE(AmplitudeMap, ClearsThePixelsWithoutAMap)
+{
+    const uint16_t Values[3] = { 0, 1000, 65535 };
+    uint32_t Pixels[3] = { 1, 2, 3 };
+
+    amplitude_map_t::GetPixels(nullptr, 0, Values, 3, Pixels);
+
+    CHECK((Pixels[0] == 0) && (Pixels[1] == 0) && (Pixels[2] == 0));
+}
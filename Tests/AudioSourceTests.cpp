@@ -0,0 +1,296 @@
+
+/** $VER: AudioSourceTests.cpp (2026.10.18) P. Stuer - Tests the sample history and the incremental audio source. **/
+
+#include "Test.h"
+
+#include "AudioSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/// <summary>
+/// Gets the value of the specified sample. Every sample has a different value so a misplaced frame or channel is detected.
+/// </summary>
+static audio_sample GetSample(int64_t frame, uint32_t channel)
+{
+    return (audio_sample) (frame * 16 + channel);
+}
+
+/// <summary>
+/// Stands in for the visualisation stream of the player. Returns the frames of a fixed signal and records the requests.
+/// </summary>
+class fake_stream_t : public audio_stream_t
+{
+public:
+    fake_stream_t(uint32_t sampleRate, uint32_t channelCount) noexcept : SampleRate(sampleRate), ChannelCount(channelCount), ChannelConfig((1u << channelCount) - 1), MaxFrameCount(~(size_t) 0), IsAvailable(true), RequestCount(), LastFrameCount() { }
+
+    bool GetFrames(double offset, double length, audio_frames_t & frames) noexcept override
+    {
+        ++RequestCount;
+
+        if (!IsAvailable)
+            return false;
+
+        const int64_t First = std::llround(offset * (double) SampleRate);
+        const size_t FrameCount = std::min((size_t) std::llround(length * (double) SampleRate), MaxFrameCount);
+
+        _Data.resize(FrameCount * ChannelCount);
+
+        for (size_t i = 0; i < FrameCount; ++i)
+            for (uint32_t j = 0; j < ChannelCount; ++j)
+                _Data[(i * ChannelCount) + j] = GetSample(First + (int64_t) i, j);
+
+        LastFrameCount = FrameCount;
+
+        frames = { _Data.data(), FrameCount, ChannelCount, ChannelConfig, SampleRate };
+
+        return true;
+    }
+
+    uint32_t SampleRate;
+    uint32_t ChannelCount;
+    uint32_t ChannelConfig;
+    size_t MaxFrameCount;                       // Number of frames after which a request is cut short.
+    bool IsAvailable;
+
+    size_t RequestCount;
+    size_t LastFrameCount;                      // Number of frames returned by the last request.
+
+private:
+    std::vector<audio_sample> _Data;
+};
+
+/// <summary>
+/// Returns true if the window of the source contains the specified number of frames of the signal, starting at the specified frame.
+/// </summary>
+static bool HasWindow(const audio_source_t & source, int64_t first, size_t frameCount)
+{
+    if ((source.GetFrameCount() != frameCount) || (source.GetPosition() != first + (int64_t) frameCount))
+        return false;
+
+    const uint32_t ChannelCount = source.GetChannelCount();
+
+    std::vector<audio_sample> Frames(frameCount * ChannelCount);
+
+    source.CopyWindow(Frames.data());
+
+    for (size_t i = 0; i < frameCount; ++i)
+        for (uint32_t j = 0; j < ChannelCount; ++j)
+            if (Frames[(i * ChannelCount) + j] != GetSample(first + (int64_t) i, j))
+                return false;
+
+    return true;
+}
+
+/// <summary>
+/// Returns true if the specified frames are the frames of the signal, starting at the specified frame.
+/// </summary>
+static bool HasFrames(const std::vector<audio_sample> & frames, uint32_t channelCount, int64_t first)
+{
+    for (size_t i = 0; i < frames.size() / channelCount; ++i)
+        for (uint32_t j = 0; j < channelCount; ++j)
+            if (frames[(i * channelCount) + j] != GetSample(first + (int64_t) i, j))
+                return false;
+
+    return true;
+}
+
+TEST_CASE(AudioSource, WrapsTheHistoryAroundTheRing)
+{
+    const uint32_t ChannelCount = 2;
+
+    std::vector<audio_sample> Signal(20 * ChannelCount);
+
+    for (size_t i = 0; i < 20; ++i)
+        for (uint32_t j = 0; j < ChannelCount; ++j)
+            Signal[(i * ChannelCount) + j] = GetSample((int64_t) i, j);
+
+    sample_history_t History;
+
+    History.Reset(ChannelCount, 5);
+
+    History.Append(Signal.data(), 3);
+
+    CHECK(History.GetFrameCount() == 3);
+
+    // Frames 3 to 6 wrap around the end of the ring.
+    History.Append(Signal.data() + (3 * ChannelCount), 4);
+
+    CHECK(History.GetFrameCount() == 5);
+
+    std::vector<audio_sample> Frames(5 * ChannelCount);
+
+    History.CopyLast(5, Frames.data());
+
+    CHECK(HasFrames(Frames, ChannelCount, 2));
+
+    Frames.resize(3 * ChannelCount);
+
+    History.CopyLast(3, Frames.data());
+
+    CHECK(HasFrames(Frames, ChannelCount, 4));
+
+    // Only the last frames are kept when more frames than the capacity are appended.
+    History.Append(Signal.data() + (7 * ChannelCount), 12);
+
+    CHECK(History.GetFrameCount() == 5);
+
+    Frames.assign(8 * ChannelCount, -1.f);
+
+    History.CopyLast(8, Frames.data());
+
+    Frames.resize(5 * ChannelCount);
+
+    CHECK(HasFrames(Frames, ChannelCount, 14));
+}
+
+TEST_CASE(AudioSource, FetchesOnlyTheNewFrames)
+{
+    fake_stream_t Stream(1000, 2);
+
+    audio_source_t Source;
+
+    // The first update fills the whole window of 100 ms.
+    CHECK(Source.Update(Stream, 1.0, 0.1));
+    CHECK(Stream.LastFrameCount == 100);
+    CHECK(Source.GetNewFrameCount() == 100);
+    CHECK(HasWindow(Source, 1000, 100));
+
+    // Each next window only adds 20 ms.
+    for (int i = 1; i <= 10; ++i)
+    {
+        CHECK(Source.Update(Stream, 1.0 + (0.02 * i), 0.1));
+        CHECK(Stream.LastFrameCount == 20);
+        CHECK(Source.GetNewFrameCount() == 20);
+        CHECK(HasWindow(Source, 1000 + (20 * i), 100));
+    }
+
+    CHECK(Stream.RequestCount == 11);
+
+    // A window that did not move requests nothing.
+    CHECK(Source.Update(Stream, 1.2, 0.1));
+    CHECK(Stream.RequestCount == 11);
+    CHECK(Source.GetNewFrameCount() == 0);
+    CHECK(HasWindow(Source, 1200, 100));
+}
+
+TEST_CASE(AudioSource, RefillsAfterASeek)
+{
+    fake_stream_t Stream(1000, 2);
+
+    audio_source_t Source;
+
+    CHECK(Source.Update(Stream, 1.0, 0.1));
+
+    // Forward, beyond the last fetched frame.
+    CHECK(Source.Update(Stream, 5.0, 0.1));
+    CHECK(Stream.LastFrameCount == 100);
+    CHECK(Source.GetNewFrameCount() == 100);
+    CHECK(HasWindow(Source, 5000, 100));
+
+    // Backward, before the first frame in the history.
+    CHECK(Source.Update(Stream, 2.0, 0.1));
+    CHECK(Stream.LastFrameCount == 100);
+    CHECK(HasWindow(Source, 2000, 100));
+
+    // Backward, by less than the window. The history only continues forward.
+    CHECK(Source.Update(Stream, 1.95, 0.1));
+    CHECK(Stream.LastFrameCount == 100);
+    CHECK(HasWindow(Source, 1950, 100));
+
+    // Forward, by less than the window: only the new frames are fetched.
+    CHECK(Source.Update(Stream, 2.0, 0.1));
+    CHECK(Stream.LastFrameCount == 50);
+    CHECK(HasWindow(Source, 2000, 100));
+}
+
+TEST_CASE(AudioSource, GrowsTheHistoryWithTheWindow)
+{
+    fake_stream_t Stream(1000, 1);
+
+    audio_source_t Source;
+
+    CHECK(Source.Update(Stream, 1.0, 0.1));
+
+    // A window that no longer fits in the history refills it.
+    CHECK(Source.Update(Stream, 1.0, 0.3));
+    CHECK(Stream.LastFrameCount == 300);
+    CHECK(HasWindow(Source, 1000, 300));
+
+    // The capacity is kept when the window shrinks and grows again.
+    const size_t RequestCount = Stream.RequestCount;
+
+    CHECK(Source.Update(Stream, 1.25, 0.1));
+    CHECK(Stream.RequestCount == RequestCount + 1);
+    CHECK(Stream.LastFrameCount == 50);
+    CHECK(HasWindow(Source, 1250, 100));
+
+    CHECK(Source.Update(Stream, 1.05, 0.3));
+    CHECK(Stream.RequestCount == RequestCount + 1);
+    CHECK(HasWindow(Source, 1050, 300));
+}
+
+TEST_CASE(AudioSource, RefillsWhenTheFormatChanges)
+{
+    fake_stream_t Stream(1000, 2);
+
+    audio_source_t Source;
+
+    CHECK(Source.Update(Stream, 1.0, 0.1));
+
+    // The first incremental request reveals the new format. The whole window is fetched again.
+    Stream.ChannelCount  = 3;
+    Stream.ChannelConfig = 7;
+
+    CHECK(Source.Update(Stream, 1.02, 0.1));
+    CHECK(Stream.LastFrameCount == 100);
+    CHECK(Source.GetChannelCount() == 3);
+    CHECK(Source.GetChannelConfig() == 7);
+    CHECK(HasWindow(Source, 1020, 100));
+
+    Stream.SampleRate = 2000;
+
+    CHECK(Source.Update(Stream, 1.04, 0.1));
+    CHECK(Stream.LastFrameCount == 200);
+    CHECK(Source.GetSampleRate() == 2000);
+    CHECK(HasWindow(Source, 2080, 200));
+
+    // No audio keeps the history until it has to be refilled.
+    Stream.IsAvailable = false;
+
+    CHECK(!Source.Update(Stream, 1.06, 0.1));
+    CHECK(Source.GetSampleRate() == 2000);
+
+    CHECK(!Source.Update(Stream, 5.0, 0.1));
+    CHECK(Source.GetFrameCount() == 0);
+    CHECK(Source.GetSampleRate() == 0);
+}
+
+TEST_CASE(AudioSource, HandlesShortReads)
+{
+    fake_stream_t Stream(1000, 2);
+
+    audio_source_t Source;
+
+    // The window ends where the stream stopped returning frames.
+    Stream.MaxFrameCount = 60;
+
+    CHECK(Source.Update(Stream, 1.0, 0.1));
+    CHECK(Source.GetNewFrameCount() == 60);
+    CHECK(HasWindow(Source, 1000, 60));
+
+    // The history has room for the whole window. The missing frames are requested by the next update.
+    Stream.MaxFrameCount = 30;
+
+    CHECK(Source.Update(Stream, 1.02, 0.1));
+    CHECK(Stream.LastFrameCount == 30);
+    CHECK(Source.GetNewFrameCount() == 30);
+    CHECK(HasWindow(Source, 1020, 70));
+
+    Stream.MaxFrameCount = ~(size_t) 0;
+
+    CHECK(Source.Update(Stream, 1.04, 0.1));
+    CHECK(Stream.LastFrameCount == 50);
+    CHECK(HasWindow(Source, 1040, 100));
+}
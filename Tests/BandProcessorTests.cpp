@@ -0,0 +1,206 @@
+
+/** $VER: BandProcessorTests.cpp (2026.10.18) P. Stuer - Tests the generation, the weighting and the normalization of the frequency bands. **/
+
+#include "Test.h"
+
+#include "BandProcessor.h"
+
+#include <cmath>
+#include <cwchar>
+#include <limits>
+
+TEST_CASE(BandProcessor, GeneratesNoteBands)
+{
+    band_config_t Config;
+
+    frequency_bands_t Bands;
+
+    band_processor_t::Generate(Config, Bands);
+
+    // C0 to F#10, one band per semitone.
+    CHECK(Bands.size() == 127);
+
+    const frequency_band_t & A4 = Bands[57];
+
+    CHECK_NEAR(A4.Center, 440., 1e-9);
+    CHECK_NEAR(A4.Lo, 440. * std::exp2(-1. / 24.), 1e-9);
+    CHECK_NEAR(A4.Hi, 440. * std::exp2( 1. / 24.), 1e-9);
+    CHECK(std::wcscmp(A4.Label, L"A4\n440.00Hz") == 0);
+    CHECK(!A4.HasDarkBackground);
+
+    // The sharps have a dark background.
+    CHECK(Bands[58].HasDarkBackground);
+    CHECK_NEAR(Bands[0].Center, 440. * std::exp2(-57. / 12.), 1e-9);
+
+    // The tuning pitch shifts all bands. 2 bands per octave skip every other quarter tone group.
+    Config.TuningPitch    = 432.;
+    Config.BandsPerOctave = 2.;
+    Config.MinNote        = 48.;
+    Config.MaxNote        = 60.;
+
+    band_processor_t::Generate(Config, Bands);
+
+    CHECK(Bands.size() == 3);
+    CHECK_NEAR(Bands[1].Center, 432. * std::exp2(-3. / 12.), 1e-9);
+
+    // The bandwidth widens the bands around the same centers.
+    Config.Bandwidth = 1.;
+
+    frequency_bands_t WideBands;
+
+    band_processor_t::Generate(Config, WideBands);
+
+    CHECK_NEAR(WideBands[1].Center, Bands[1].Center, 1e-9);
+    CHECK_NEAR(WideBands[1].Lo, WideBands[0].Center, 1e-9);
+    CHECK_NEAR(WideBands[1].Hi, WideBands[2].Center, 1e-9);
+}
+
+TEST_CASE(BandProcessor, GeneratesLinearAndAveePlayerBands)
+{
+    band_config_t Config;
+
+    Config.Distribution = FrequencyDistribution::Linear;
+    Config.BandCount    = 3;
+
+    frequency_bands_t Bands;
+
+    band_processor_t::Generate(Config, Bands);
+
+    // Logarithmic scaling: the centers are evenly spaced on a log scale from the lowest to the highest frequency.
+    CHECK(Bands.size() == 3);
+    CHECK_NEAR(Bands[0].Center, 20., 1e-9);
+    CHECK_NEAR(Bands[1].Center, std::sqrt(20. * 20000.), 1e-9);
+    CHECK_NEAR(Bands[2].Center, 20000., 1e-6);
+    CHECK_NEAR(Bands[1].Lo, std::sqrt(Bands[0].Center * Bands[1].Center), 1e-9);
+    CHECK(std::wcscmp(Bands[0].Label, L"20.00Hz") == 0);
+
+    // Linear scaling.
+    Config.Scaling = ScalingFunction::Linear;
+
+    band_processor_t::Generate(Config, Bands);
+
+    CHECK_NEAR(Bands[1].Center, 10010., 1e-9);
+    CHECK_NEAR(Bands[1].Hi - Bands[1].Lo, 9990., 1e-9);
+
+    // AveePlayer: logarithmic without skew, linear with a skew factor of 1.
+    Config.Distribution = FrequencyDistribution::AveePlayer;
+    Config.BandCount    = 5;
+
+    band_processor_t::Generate(Config, Bands);
+
+    CHECK(Bands.size() == 5);
+    CHECK_NEAR(Bands[0].Center, 20., 1e-9);
+    CHECK_NEAR(Bands[2].Center, std::sqrt(20. * 20000.), 1e-9);
+    CHECK_NEAR(Bands[4].Center, 20000., 1e-6);
+
+    Config.SkewFactor = 1.;
+
+    band_processor_t::Generate(Config, Bands);
+
+    CHECK_NEAR(Bands[2].Center, 10010., 1e-9);
+}
+
+TEST_CASE(BandProcessor, AppliesTheWeighting)
+{
+    band_config_t Config;
+
+    Config.SlopeFunctionOffset = 0.;
+
+    frequency_bands_t Bands = { frequency_band_t(90., 100., 110.), frequency_band_t(900., 1000., 1100.) };
+
+    for (auto & fb : Bands)
+        fb.RawValue = 0.5;
+
+    // No weighting leaves the values alone, even with a slope.
+    Config.Slope = 6.;
+
+    band_processor_t::ApplyWeighting(Config, 48000, 4096, Bands);
+
+    CHECK(Bands[0].RawValue == 0.5);
+
+    // A-weighting is 0 dB at 1 kHz and -19.1 dB at 100 Hz.
+    Config.Slope           = 0.;
+    Config.Weighting       = WeightingType::AWeighting;
+    Config.WeightingAmount = 1.;
+
+    band_processor_t::ApplyWeighting(Config, 48000, 4096, Bands);
+
+    CHECK_NEAR(20. * std::log10(Bands[0].RawValue / 0.5), -19.1, 0.05);
+    CHECK_NEAR(20. * std::log10(Bands[1].RawValue / 0.5),   0.0, 0.05);
+
+    // The slope is 0 dB at its offset and rises with the specified dB per octave.
+    Config.Weighting = WeightingType::None;
+    Config.Slope     = 6.;
+
+    CHECK_NEAR(band_processor_t::GetWeight(Config, 1000.), 1., 1e-9);
+    CHECK_NEAR(band_processor_t::GetWeight(Config, 2000.), 2., 1e-9);
+
+    // The slope function offset shifts the frequencies by a number of FFT bins.
+    Config.SlopeFunctionOffset = 1.;
+    Config.Weighting = WeightingType::CWeighting;
+    Config.Slope     = 0.;
+
+    Bands[1].RawValue = 1.;
+
+    band_processor_t::ApplyWeighting(Config, 48000, 48, Bands);
+
+    CHECK_NEAR(Bands[1].RawValue, band_processor_t::GetWeight(Config, 2000.), 1e-12);
+}
+
+TEST_CASE(BandProcessor, NormalizesAndSmoothsTheValues)
+{
+    amplitude_scale_t Scale;
+
+    // -90 dB to 0 dB
+    CHECK_NEAR(Scale.Scale(1.), 1., 1e-12);
+    CHECK_NEAR(Scale.Scale(std::pow(10., -45. / 20.)), 0.5, 1e-12);
+
+    frequency_bands_t Bands(3);
+
+    Bands[0].RawValue = 2.;                                     // Clamped to 1
+    Bands[1].RawValue = std::pow(10., -45. / 20.);
+    Bands[2].RawValue = 0.;                                     // -∞ dB, clamped to 0
+
+    band_processor_t::Normalize(Scale, SmoothingMethod::None, 0.5, Bands);
+
+    CHECK(Bands[0].Value == 1.);
+    CHECK_NEAR(Bands[1].Value, 0.5, 1e-12);
+    CHECK(Bands[2].Value == 0.);
+
+    // Average smoothing blends the new value with the previous one. A non-finite value counts as silence.
+    Bands[0].RawValue = std::pow(10., -90. / 20.);
+    Bands[2].RawValue = std::numeric_limits<double>::quiet_NaN();
+    Bands[2].Value    = 0.8;
+
+    band_processor_t::Normalize(Scale, SmoothingMethod::Average, 0.5, Bands);
+
+    CHECK_NEAR(Bands[0].Value, 0.5, 1e-12);
+    CHECK_NEAR(Bands[1].Value, 0.5, 1e-12);
+    CHECK_NEAR(Bands[2].Value, 0.4, 1e-12);
+
+    // Peak smoothing keeps the decaying previous value until a higher value arrives.
+    Bands[0].RawValue = std::pow(10., -81. / 20.);
+
+    band_processor_t::Normalize(Scale, SmoothingMethod::Peak, 0.5, Bands);
+
+    CHECK_NEAR(Bands[0].Value, 0.25, 1e-12);
+
+    Bands[0].RawValue = 1.;
+
+    band_processor_t::Normalize(Scale, SmoothingMethod::Peak, 0.5, Bands);
+
+    CHECK(Bands[0].Value == 1.);
+
+    // Linear scale with the n-th root. The lower amplitude maps to 0 unless the absolute range is used.
+    Scale.Mode        = YAxisMode::Linear;
+    Scale.Gamma       = 2.;
+    Scale.UseAbsolute = true;
+
+    CHECK_NEAR(Scale.Scale(0.25), 0.5, 1e-12);
+
+    Scale.UseAbsolute = false;
+    Scale.AmplitudeLo = 20. * std::log10(0.25);
+
+    CHECK_NEAR(Scale.Scale(0.25), 0., 1e-12);
+    CHECK_NEAR(Scale.Scale(1.), 1., 1e-12);
+}
@@ -0,0 +1,251 @@
+
+/** $VER: BarLayoutTests.cpp (2026.10.18) P. Stuer - Tests the layout of the bars of the spectrum. **/
+
+#include "Test.h"
+
+#include "BarLayout.h"
+
+/// <summary>
+/// Creates bands with the specified value, alternating between dark and light backgrounds. The lower frequency of band i is (i + 1) kHz.
+/// </summary>
+static frequency_bands_t CreateBands(size_t count, double value, double maxValue = 0.)
+{
+    frequency_bands_t Bands;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        frequency_band_t fb(1000. * (double) (i + 1), 1000. * (double) (i + 1) + 500., 1000. * (double) (i + 2));
+
+        fb.Value             = value;
+        fb.MaxValue          = maxValue;
+        fb.Opacity           = 1.;
+        fb.HasDarkBackground = (i % 2) == 0;
+
+        Bands.push_back(fb);
+    }
+
+    return Bands;
+}
+
+/// <summary>
+/// Gets settings that lay out all parts of visible bars without LEDs.
+/// </summary>
+static bar_layout_settings_t GetSettings(float width, float height, HorizontalAlignment alignment)
+{
+    bar_layout_settings_t Settings = { };
+
+    Settings.Width               = width;
+    Settings.Height              = height;
+    Settings.Alignment           = alignment;
+    Settings.IsVisible           = true;
+    Settings.SuppressMirrorImage = false;
+    Settings.NyquistFrequency    = 1e9;
+    Settings.ShowPeaks           = true;
+    Settings.TopThickness        = 4.f;
+    Settings.PeakTopThickness    = 2.f;
+
+    for (auto & IsEnabled : Settings.IsEnabled)
+        IsEnabled = true;
+
+    return Settings;
+}
+
+/// <summary>
+/// Returns true if the rectangles are the same.
+/// </summary>
+static bool IsEqual(const layout_rect_t & a, const layout_rect_t & b)
+{
+    return (a.left == b.left) && (a.top == b.top) && (a.right == b.right) && (a.bottom == b.bottom);
+}
+
+TEST_CASE(BarLayout, AlignsTheBars)
+{
+    const frequency_bands_t Bands = CreateBands(8, 0.5);
+
+    bar_layout_t Layout;
+
+    // 100 DIP / 8 bands = 12.5 DIP, rounded down to 12 DIP unless the bars fit the client area.
+    const struct { HorizontalAlignment Alignment; float BarWidth; float Offset; } Cases[] =
+    {
+        { HorizontalAlignment::Near,   12.f,  0.f },
+        { HorizontalAlignment::Center, 12.f,  2.f },
+        { HorizontalAlignment::Far,    12.f,  4.f },
+        { HorizontalAlignment::Fit,    12.5f, 0.f },
+    };
+
+    for (const auto & [Alignment, BarWidth, Offset] : Cases)
+    {
+        Layout.Layout(Bands, GetSettings(100.f, 50.f, Alignment));
+
+        CHECK(Layout.GetBarWidth() == BarWidth);
+        CHECK(Layout.GetOffset() == Offset);
+
+        const auto & Parts = Layout.GetParts(BarPart::Area);
+
+        CHECK(Parts.size() == 8);
+
+        for (size_t i = 0; i < Parts.size(); ++i)
+        {
+            const float x = Offset + BarWidth * (float) i;
+
+            CHECK(IsEqual(Parts[i].Rect, { x, 0.f, x + BarWidth - 1.f, 25.f }));
+        }
+    }
+}
+
+TEST_CASE(BarLayout, BarsAreAtLeastTwoWide)
+{
+    CHECK(bar_layout_t::GetBarWidth(10.f, 20, HorizontalAlignment::Near) == 2.f);
+    CHECK(bar_layout_t::GetBarWidth(10.f, 20, HorizontalAlignment::Fit) == 2.f);
+    CHECK(bar_layout_t::GetBarWidth(10.f,  0, HorizontalAlignment::Near) == 10.f);
+
+    // Bars that do not fit are clamped to the client area.
+    bar_layout_t Layout;
+
+    Layout.Layout(CreateBands(20, 1.), GetSettings(10.f, 50.f, HorizontalAlignment::Near));
+
+    const auto & Parts = Layout.GetParts(BarPart::Area);
+
+    CHECK(Parts.size() == 20);
+    CHECK(Parts.back().Rect.left == 10.f);
+    CHECK(Parts.back().Rect.right == 9.f);
+}
+
+TEST_CASE(BarLayout, AlternatesTheBackgrounds)
+{
+    bar_layout_t Layout;
+
+    Layout.Layout(CreateBands(5, 0.5), GetSettings(100.f, 50.f, HorizontalAlignment::Near));
+
+    const auto & Dark  = Layout.GetParts(BarPart::DarkBackground);
+    const auto & Light = Layout.GetParts(BarPart::LightBackground);
+
+    CHECK(Dark.size() == 3);
+    CHECK(Light.size() == 2);
+
+    CHECK(IsEqual(Dark[1].Rect,  { 40.f, 0.f, 59.f, 50.f }));
+    CHECK(IsEqual(Light[0].Rect, { 20.f, 0.f, 39.f, 50.f }));
+
+    // Disabled styles are left out.
+    bar_layout_settings_t Settings = GetSettings(100.f, 50.f, HorizontalAlignment::Near);
+
+    Settings.IsEnabled[(size_t) BarPart::DarkBackground] = false;
+
+    Layout.Layout(CreateBands(5, 0.5), Settings);
+
+    CHECK(Layout.GetParts(BarPart::DarkBackground).empty());
+    CHECK(Layout.GetParts(BarPart::LightBackground).size() == 2);
+}
+
+TEST_CASE(BarLayout, SuppressesTheMirrorImage)
+{
+    bar_layout_t Layout;
+
+    bar_layout_settings_t Settings = GetSettings(100.f, 50.f, HorizontalAlignment::Near);
+
+    Settings.NyquistFrequency = 3000.; // Bands 2, 3 and 4 start at or above the Nyquist frequency.
+
+    Layout.Layout(CreateBands(5, 0.5, 0.75), Settings);
+
+    CHECK(Layout.GetParts(BarPart::Area).size() == 5);
+
+    Settings.SuppressMirrorImage = true;
+
+    Layout.Layout(CreateBands(5, 0.5, 0.75), Settings);
+
+    CHECK(Layout.GetParts(BarPart::Area).size() == 2);
+    CHECK(Layout.GetParts(BarPart::PeakArea).size() == 2);
+
+    // The backgrounds are kept.
+    CHECK(Layout.GetParts(BarPart::DarkBackground).size() + Layout.GetParts(BarPart::LightBackground).size() == 5);
+}
+
+TEST_CASE(BarLayout, LaysOutThePeaksAndTops)
+{
+    bar_layout_t Layout;
+
+    bar_layout_settings_t Settings = GetSettings(100.f, 100.f, HorizontalAlignment::Near);
+
+    Layout.Layout(CreateBands(1, 0.5, 0.75), Settings);
+
+    CHECK(IsEqual(Layout.GetParts(BarPart::PeakArea)[0].Rect, { 0.f,  0.f, 99.f, 75.f }));
+    CHECK(IsEqual(Layout.GetParts(BarPart::PeakTop)[0].Rect,  { 0.f, 74.f, 99.f, 76.f }));
+    CHECK(IsEqual(Layout.GetParts(BarPart::Area)[0].Rect,     { 0.f,  0.f, 99.f, 50.f }));
+    CHECK(IsEqual(Layout.GetParts(BarPart::Top)[0].Rect,      { 0.f, 48.f, 99.f, 52.f }));
+
+    CHECK(Layout.GetParts(BarPart::Area)[0].Value == 0.5);
+
+    // The tops of full bars stay inside the client area.
+    Layout.Layout(CreateBands(1, 1.), Settings);
+
+    CHECK(IsEqual(Layout.GetParts(BarPart::Top)[0].Rect, { 0.f, 98.f, 99.f, 100.f }));
+
+    // Bands without a value have no bar.
+    Settings.ShowPeaks = false;
+
+    Layout.Layout(CreateBands(1, 0., 0.75), Settings);
+
+    CHECK(Layout.GetParts(BarPart::Area).empty());
+    CHECK(Layout.GetParts(BarPart::PeakArea).empty());
+}
+
+TEST_CASE(BarLayout, SnapsToWholeLEDs)
+{
+    bar_layout_t Layout;
+
+    bar_layout_settings_t Settings = GetSettings(100.f, 100.f, HorizontalAlignment::Near);
+
+    Settings.LEDMode         = true;
+    Settings.LEDIntegralSize = true;
+    Settings.LEDSize         = 6.f;
+
+    Layout.Layout(CreateBands(1, 0.5), Settings);
+
+    CHECK(IsEqual(Layout.GetParts(BarPart::Area)[0].Rect, { 0.f, 0.f, 99.f, 54.f }));
+    CHECK(IsEqual(Layout.GetParts(BarPart::Top)[0].Rect,  { 0.f, 48.f, 99.f, 54.f }));
+
+    // Snapping never extends a bar beyond the client area.
+    Layout.Layout(CreateBands(1, 0.99), Settings);
+
+    CHECK(Layout.GetParts(BarPart::Area)[0].Rect.bottom == 100.f);
+    CHECK(Layout.GetParts(BarPart::Top)[0].Rect.bottom == 100.f);
+}
+
+TEST_CASE(BarLayout, HiddenBarsOnlyHaveBackgrounds)
+{
+    bar_layout_t Layout;
+
+    bar_layout_settings_t Settings = GetSettings(100.f, 100.f, HorizontalAlignment::Near);
+
+    Settings.IsVisible = false;
+
+    Layout.Layout(CreateBands(4, 0.5, 0.75), Settings);
+
+    CHECK(Layout.GetParts(BarPart::DarkBackground).size() == 2);
+    CHECK(Layout.GetParts(BarPart::LightBackground).size() == 2);
+
+    for (BarPart Part : { BarPart::PeakArea, BarPart::PeakTop, BarPart::Area, BarPart::Top })
+        CHECK(Layout.GetParts(Part).empty());
+}
+
+TEST_CASE(BarLayout, FlipsTheLayout)
+{
+    // A 10x20 rectangle in the bottom-left corner of a 100x50 client area.
+    const layout_rect_t Rect = { 0.f, 0.f, 10.f, 20.f };
+
+    const struct { bool FlipH; bool FlipV; layout_rect_t Expected; } Cases[] =
+    {
+        { false, false, {  0.f,  30.f,  10.f, 50.f } }, // Bottom-left
+        { true,  false, { 90.f,  30.f, 100.f, 50.f } }, // Bottom-right
+        { false, true,  {  0.f,   0.f,  10.f, 20.f } }, // Top-left
+        { true,  true,  { 90.f,   0.f, 100.f, 20.f } }, // Top-right
+    };
+
+    for (const auto & [FlipH, FlipV, Expected] : Cases)
+        CHECK(IsEqual(layout_transform_t::Get(100.f, 50.f, FlipH, FlipV).Apply(Rect), Expected));
+
+    CHECK(layout_transform_t::GetHOffset(HorizontalAlignment::Near,   10.f) ==  0.f);
+    CHECK(layout_transform_t::GetHOffset(HorizontalAlignment::Center, 10.f) ==  5.f);
+    CHECK(layout_transform_t::GetHOffset(HorizontalAlignment::Far,    10.f) == 10.f);
+    CHECK(layout_transform_t::GetHOffset(HorizontalAlignment::Fit,    10.f) ==  0.f);
+}
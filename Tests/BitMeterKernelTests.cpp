@@ -0,0 +1,238 @@
+
+/** $VER: BitMeterKernelTests.cpp (2026.10.18) P. Stuer - Compares the implementations of the bit meter kernel with a bit-by-bit reference. **/
+
+#include "Test.h"
+
+#include "BitMeterKernel.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+/// <summary>
+/// Gives the tests access to the implementations of the kernel.
+/// </summary>
+struct bit_meter_kernel_test_t
+{
+    static void CountScalar(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept
+    {
+        bit_meter_kernel_t::CountScalar(values, byteCount, counts);
+    }
+
+#if defined(SIMD_SSE2)
+    static void CountSSE2(const uint32_t * values, size_t byteCount, uint32_t * counts) noexcept
+    {
+        bit_meter_kernel_t::CountSSE2(values, byteCount, counts);
+    }
+#endif
+};
+
+static const BitMeterView Views[] = { BitMeterView::Native, BitMeterView::Int16, BitMeterView::Int24, BitMeterView::Int32 };
+
+/// <summary>
+/// Counts the set bits in the least significant bytes of a group of values, one bit at a time.
+/// </summary>
+static void CountReference(const uint32_t * values, size_t byteCount, uint32_t * counts)
+{
+    for (size_t i = 0; i < bit_meter_kernel_t::GroupSize; ++i)
+        for (size_t j = 0; j < byteCount * 8; ++j)
+            counts[j] += (values[i] >> j) & 1;
+}
+
+/// <summary>
+/// Gets the bits of a sample in the specified view, least significant bit first.
+/// </summary>
+static uint64_t GetBits(audio_sample sample, BitMeterView view)
+{
+    if (view == BitMeterView::Native)
+    {
+    #if (audio_sample_size == 64)
+        return std::bit_cast<uint64_t>(sample);
+    #else
+        return std::bit_cast<uint32_t>(sample);
+    #endif
+    }
+
+    const size_t BitCount = bit_meter_kernel_t::GetBitCount(view);
+    const double Scale = (double) (1ULL << (BitCount - 1));
+
+    const int64_t Value = (int64_t) std::floor(std::clamp((double) sample * Scale, -Scale, Scale - 1.) + 0.5);
+
+    return (uint64_t) Value & ((1ULL << BitCount) - 1);
+}
+
+/// <summary>
+/// Gets a group of values with the specified pattern.
+/// </summary>
+static void GetPattern(int pattern, std::mt19937 & generator, uint32_t * values)
+{
+    for (size_t i = 0; i < bit_meter_kernel_t::GroupSize; ++i)
+    {
+        switch (pattern)
+        {
+            default:
+            case 0: values[i] = 0; break;                                       // Silence
+            case 1: values[i] = ~0U; break;                                     // All ones
+            case 2: values[i] = 0x80000000U >> (i % 4 * 8); break;              // The sign bit of each integer view
+            case 3: values[i] = (i % 2) ? 0xAAAAAAAAU : 0x55555555U; break;     // Alternating bits
+            case 4: values[i] = (uint32_t) generator(); break;
+            case 5: values[i] = (uint32_t) generator() >> (generator() % 32); break;
+        }
+    }
+}
+
+TEST_CASE(BitMeterKernel, ImplementationsMatchTheReference)
+{
+    std::mt19937 Generator(29);
+
+    for (int Pattern = 0; Pattern < 6; ++Pattern)
+    {
+        for (size_t ByteCount = 1; ByteCount <= 4; ++ByteCount)
+        {
+            alignas(16) uint32_t Values[bit_meter_kernel_t::GroupSize];
+            alignas(16) uint32_t MaskedValues[bit_meter_kernel_t::GroupSize];
+
+            GetPattern(Pattern, Generator, Values);
+
+            // The scalar implementation counts every set bit. The kernel masks the values of the integer views before counting.
+            const uint32_t Mask = (ByteCount < 4) ? (1U << (ByteCount * 8)) - 1 : ~0U;
+
+            for (size_t i = 0; i < bit_meter_kernel_t::GroupSize; ++i)
+                MaskedValues[i] = Values[i] & Mask;
+
+            // The counts accumulate.
+            uint32_t Expected[bit_meter_kernel_t::MaxBits];
+
+            for (size_t i = 0; i < bit_meter_kernel_t::MaxBits; ++i)
+                Expected[i] = (uint32_t) i;
+
+            uint32_t Scalar[bit_meter_kernel_t::MaxBits];
+
+            std::memcpy(Scalar, Expected, sizeof(Scalar));
+
+            CountReference(Values, ByteCount, Expected);
+            bit_meter_kernel_test_t::CountScalar(MaskedValues, ByteCount, Scalar);
+
+            CHECK(std::equal(std::begin(Scalar), std::end(Scalar), std::begin(Expected)));
+
+        #if defined(SIMD_SSE2)
+            // The SSE2 implementation ignores the bytes beyond the byte count.
+            uint32_t SSE2[bit_meter_kernel_t::MaxBits];
+
+            for (size_t i = 0; i < bit_meter_kernel_t::MaxBits; ++i)
+                SSE2[i] = (uint32_t) i;
+
+            bit_meter_kernel_test_t::CountSSE2(Values, ByteCount, SSE2);
+
+            CHECK(std::equal(std::begin(SSE2), std::end(SSE2), std::begin(Expected)));
+        #endif
+        }
+    }
+}
+
+TEST_CASE(BitMeterKernel, CountsTheBitsOfEachView)
+{
+    std::mt19937 Generator(29);
+    std::uniform_real_distribution<double> Noise(-1.2, 1.2);
+
+    for (uint32_t ChannelCount : { 1u, 3u, 5u })
+    {
+        // Measure every other channel so the offsets are not consecutive.
+        const uint32_t ChannelConfig = (1u << ChannelCount) - 1;
+        const uint32_t SelectedChannels = 0x55555555u & ChannelConfig;
+
+        meter_plan_t Plan;
+
+        Plan.Build(ChannelCount, ChannelConfig, SelectedChannels, 0);
+
+        CHECK(Plan.MeasuredCount == (ChannelCount + 1) / 2);
+
+        for (size_t FrameCount : { (size_t) 1, (size_t) 15, (size_t) 16, (size_t) 17, (size_t) 47, (size_t) 100 })
+        {
+            std::vector<audio_sample> Frames(FrameCount * ChannelCount);
+
+            // Mix the special patterns with noise: the full scale values of both signs, the smallest negative value of each integer view and silence.
+            for (size_t i = 0; i < Frames.size(); ++i)
+            {
+                switch (i % 7)
+                {
+                    case 0: Frames[i] = (audio_sample) -1.; break;
+                    case 1: Frames[i] = (audio_sample)  1.; break;
+                    case 2: Frames[i] = (audio_sample) (-1. / 32768.); break;
+                    case 3: Frames[i] = (audio_sample) (-1. / 8388608.); break;
+                    case 4: Frames[i] = (audio_sample) 0.; break;
+                    default: Frames[i] = (audio_sample) Noise(Generator); break;
+                }
+            }
+
+            for (BitMeterView View : Views)
+            {
+                const size_t BitCount = bit_meter_kernel_t::GetBitCount(View);
+
+                uint32_t Counts[meter_plan_t::MaxChannels][bit_meter_kernel_t::MaxBits] = { };
+                uint32_t Expected[meter_plan_t::MaxChannels][bit_meter_kernel_t::MaxBits] = { };
+
+                bit_meter_kernel_t::Process(Frames.data(), FrameCount, Plan, View, Counts);
+
+                for (size_t i = 0; i < Plan.MeasuredCount; ++i)
+                {
+                    for (size_t j = 0; j < FrameCount; ++j)
+                    {
+                        const uint64_t Bits = GetBits(Frames[(j * ChannelCount) + Plan.MeasuredOffsets[i]], View);
+
+                        for (size_t k = 0; k < BitCount; ++k)
+                            Expected[i][k] += (uint32_t) ((Bits >> k) & 1);
+                    }
+                }
+
+                CHECK(std::memcmp(Counts, Expected, sizeof(Counts)) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE(BitMeterKernel, CountsTheSignAndTheFullScale)
+{
+    const size_t FrameCount = 21;
+
+    meter_plan_t Plan;
+
+    Plan.Build(1, 1, 1, 0);
+
+    for (BitMeterView View : { BitMeterView::Int16, BitMeterView::Int24, BitMeterView::Int32 })
+    {
+        const size_t BitCount = bit_meter_kernel_t::GetBitCount(View);
+
+        // -1.0 only sets the sign bit.
+        std::vector<audio_sample> Frames(FrameCount, (audio_sample) -1.);
+
+        uint32_t Counts[meter_plan_t::MaxChannels][bit_meter_kernel_t::MaxBits] = { };
+
+        bit_meter_kernel_t::Process(Frames.data(), FrameCount, Plan, View, Counts);
+
+        for (size_t k = 0; k < bit_meter_kernel_t::MaxBits; ++k)
+            CHECK(Counts[0][k] == ((k == BitCount - 1) ? FrameCount : 0));
+
+        // The smallest negative value sets all bits.
+        std::fill(Frames.begin(), Frames.end(), (audio_sample) (-1. / (double) (1ULL << (BitCount - 1))));
+
+        std::memset(Counts, 0, sizeof(Counts));
+
+        bit_meter_kernel_t::Process(Frames.data(), FrameCount, Plan, View, Counts);
+
+        for (size_t k = 0; k < bit_meter_kernel_t::MaxBits; ++k)
+            CHECK(Counts[0][k] == ((k < BitCount) ? FrameCount : 0));
+
+        // Silence sets no bits.
+        std::fill(Frames.begin(), Frames.end(), (audio_sample) 0.);
+
+        std::memset(Counts, 0, sizeof(Counts));
+
+        bit_meter_kernel_t::Process(Frames.data(), FrameCount, Plan, View, Counts);
+
+        CHECK(std::all_of(std::begin(Counts[0]), std::end(Counts[0]), [](uint32_t n) { return n == 0; }));
+    }
+}
@@ -0,0 +1,192 @@
+
+/** $VER: ConfigurationRebuildTests.cpp (2026.10.18) P. Stuer - Tests what the render thread rebuilds for each kind of configuration change. **/
+
+#include "Test.h"
+
+#include "ConfigurationRebuild.h"
+#include "ConfigurationFields.h"
+
+#include <functional>
+
+/// <summary>
+/// Returns true if the change is adopted without rebuilding the graphs or the device resources.
+/// </summary>
+static bool KeepsTheGraphs(const configuration_rebuild_t & rebuild)
+{
+    return !rebuild.CreateGraphs && !rebuild.DeleteDeviceResources;
+}
+
+/// <summary>
+/// Gets the fields of a configuration with two styles.
+/// </summary>
+static configuration_fields_t GetFields()
+{
+    configuration_fields_t Fields;
+
+    style_fields_t Style;
+
+    Style.ID     = 1;
+    Style.Source = ColorSource::Solid;
+    Style.CustomColor[3] = 1.f;
+
+    Fields.Styles.push_back(Style);
+
+    Style.ID     = 2;
+    Style.Source = ColorSource::Gradient;
+    Style.CustomGradientStops = { 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f, 0.f, 1.f, 1.f };
+
+    Fields.Styles.push_back(Style);
+
+    Fields.OtherSettings = { 1, 2, 3, 4 };
+
+    return Fields;
+}
+
+/// <summary>
+/// Gets the changes after applying the specified change to the fields of a configuration.
+/// </summary>
+static ConfigurationChanges GetChanges(const std::function<void(configuration_fields_t &)> & change)
+{
+    const configuration_fields_t Old = GetFields();
+
+    configuration_fields_t New = Old;
+
+    change(New);
+
+    return configuration_fields_t::GetChanges(Old, New);
+}
+
+TEST_CASE(ConfigurationRebuild, AllRebuildsEverything)
+{
+    for (bool HasArtworkColors : { false, true })
+    {
+        const auto Rebuild = configuration_rebuild_t::Get(ConfigurationChanges::All, HasArtworkColors);
+
+        CHECK(Rebuild.DeleteDeviceResources);
+        CHECK(Rebuild.CreateGraphs);
+        CHECK(Rebuild.ExtractArtworkColors);
+        CHECK(!Rebuild.RestoreArtworkColors);
+    }
+}
+
+TEST_CASE(ConfigurationRebuild, LayoutRebuildsEverything)
+{
+    const auto Rebuild = configuration_rebuild_t::Get(ConfigurationChanges::Layout | ConfigurationChanges::Smoothing, true);
+
+    CHECK(Rebuild.CreateGraphs);
+    CHECK(Rebuild.DeleteDeviceResources);
+    CHECK(Rebuild.ExtractArtworkColors);
+}
+
+TEST_CASE(ConfigurationRebuild, FrameSettingsKeepTheGraphs)
+{
+    for (ConfigurationChanges Changes : { ConfigurationChanges::None, ConfigurationChanges::RenderLoop, ConfigurationChanges::RefreshRate, ConfigurationChanges::PhosphorEffect,
+        ConfigurationChanges::Smoothing, ConfigurationChanges::PeakIndicators, ConfigurationChanges::Styles,
+        ConfigurationChanges::RenderLoop | ConfigurationChanges::Smoothing | ConfigurationChanges::PeakIndicators | ConfigurationChanges::Styles })
+    {
+        const auto Rebuild = configuration_rebuild_t::Get(Changes, false);
+
+        CHECK(KeepsTheGraphs(Rebuild));
+        CHECK(!Rebuild.CreateBands);
+        CHECK(!Rebuild.ExtractArtworkColors);
+    }
+}
+
+TEST_CASE(ConfigurationRebuild, BandSettingsKeepTheGraphs)
+{
+    for (ConfigurationChanges Changes : { ConfigurationChanges::Bands, ConfigurationChanges::Bands | ConfigurationChanges::Smoothing | ConfigurationChanges::Styles })
+    {
+        const auto Rebuild = configuration_rebuild_t::Get(Changes, true);
+
+        CHECK(KeepsTheGraphs(Rebuild));
+        CHECK(Rebuild.CreateBands);
+        CHECK(Rebuild.RestoreArtworkColors);
+    }
+
+    // New graphs get new bands anyway.
+    const auto Rebuild = configuration_rebuild_t::Get(ConfigurationChanges::Bands | ConfigurationChanges::Layout, false);
+
+    CHECK(Rebuild.CreateGraphs);
+    CHECK(!Rebuild.CreateBands);
+}
+
+TEST_CASE(ConfigurationRebuild, ArtworkExtractsTheColors)
+{
+    for (ConfigurationChanges Changes : { ConfigurationChanges::Artwork, ConfigurationChanges::Artwork | ConfigurationChanges::Styles })
+    {
+        const auto Rebuild = configuration_rebuild_t::Get(Changes, true);
+
+        CHECK(KeepsTheGraphs(Rebuild));
+        CHECK(Rebuild.ExtractArtworkColors);
+        CHECK(!Rebuild.RestoreArtworkColors);
+    }
+}
+
+TEST_CASE(ConfigurationRebuild, OtherChangesRestoreTheArtworkColors)
+{
+    // The copied styles lose the colors extracted from the artwork. They are restored when there are any, whatever changed.
+    for (ConfigurationChanges Changes : { ConfigurationChanges::None, ConfigurationChanges::RenderLoop, ConfigurationChanges::Smoothing, ConfigurationChanges::Styles })
+    {
+        CHECK(configuration_rebuild_t::Get(Changes, true).RestoreArtworkColors);
+        CHECK(!configuration_rebuild_t::Get(Changes, false).RestoreArtworkColors);
+    }
+}
+
+TEST_CASE(ConfigurationRebuild, ClassifiesTheFrameSettings)
+{
+    CHECK(GetChanges([](configuration_fields_t &) { }) == ConfigurationChanges::None);
+
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Styles[0].CustomColor[0] = 0.5f; }) == ConfigurationChanges::Styles);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Styles[1].CustomGradientStops[5] = 0.5f; }) == ConfigurationChanges::Styles);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Styles[1].Opacity = 0.5f; }) == ConfigurationChanges::Styles);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Styles[0].Thickness = 2.f; }) == ConfigurationChanges::Styles);
+
+    CHECK(GetChanges([](configuration_fields_t & f) { f.SmoothingFactor = 0.5; }) == ConfigurationChanges::Smoothing);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Smoothing = SmoothingMethod::Peak; }) == ConfigurationChanges::Smoothing);
+
+    CHECK(GetChanges([](configuration_fields_t & f) { f.HoldTime = 10.; }) == ConfigurationChanges::PeakIndicators);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Peaks = PeakMode::AIMP; }) == ConfigurationChanges::PeakIndicators);
+
+    CHECK(GetChanges([](configuration_fields_t & f) { f.RefreshRateLimit = 144; }) == ConfigurationChanges::RenderLoop);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Fit = FitMode::Fill; }) == ConfigurationChanges::RenderLoop);
+
+    CHECK(GetChanges([](configuration_fields_t & f) { f.BlurSigma = 2.f; }) == ConfigurationChanges::Oscilloscope);
+
+    CHECK(GetChanges([](configuration_fields_t & f) { f.NumArtworkColors = 5; }) == ConfigurationChanges::Artwork);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Order = ColorOrder::HueAscending; }) == ConfigurationChanges::Artwork);
+
+    // The changes of different subsystems are combined.
+    CHECK(GetChanges([](configuration_fields_t & f) { f.SmoothingFactor = 0.5; f.Styles[0].Opacity = 0.5f; }) == (ConfigurationChanges::Smoothing | ConfigurationChanges::Styles));
+}
+
+TEST_CASE(ConfigurationRebuild, ClassifiesTheBandSettings)
+{
+    // The bounds and the weighting of the bands and the settings of the analyzers keep the bands where they are.
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.Bandwidth = 2.; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.Weighting = WeightingType::AWeighting; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.Slope = 3.; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Analysis.MappingMethod = Mapping::TriangularFilterBank; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Analysis.CQTAlignment = 0.; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Transformation = Transform::CQT; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.FFTSize = FFTMode::FFT8192; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Window = WindowFunction::Blackman; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Truncate = false; }) == ConfigurationChanges::Bands);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.KernelAsymmetry = 0.5; }) == ConfigurationChanges::Bands);
+
+    // The number and the position of the bands change.
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.BandCount = 64; }) == ConfigurationChanges::All);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.LoFrequency = 50.; }) == ConfigurationChanges::All);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.Distribution = FrequencyDistribution::Linear; }) == ConfigurationChanges::All);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.TuningPitch = 432.; }) == ConfigurationChanges::All);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Bands.BandsPerOctave = 24.; f.SmoothingFactor = 0.5; }) == ConfigurationChanges::All);
+}
+
+TEST_CASE(ConfigurationRebuild, OtherSettingsRebuildEverything)
+{
+    CHECK(GetChanges([](configuration_fields_t & f) { f.OtherSettings[2] = 0; }) == ConfigurationChanges::All);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.OtherSettings.push_back(0); }) == ConfigurationChanges::All);
+
+    // A style that is added or replaced by another one.
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Styles.pop_back(); }) == ConfigurationChanges::All);
+    CHECK(GetChanges([](configuration_fields_t & f) { f.Styles[1].ID = 3; }) == ConfigurationChanges::All);
+}
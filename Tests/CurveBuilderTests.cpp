@@ -0,0 +1,186 @@
+
+/** $VER: CurveBuilderTests.cpp (2026.10.18) P. Stuer - Tests the knots and the control points of the curves of the spectrum. **/
+
+#include "Test.h"
+
+#include "CurveBuilder.h"
+
+#include <cmath>
+
+/// <summary>
+/// Creates bands with the specified values. The lower frequency of band i is (i + 1) kHz.
+/// </summary>
+static frequency_bands_t CreateBands(const std::vector<double> & values, double maxValue = 0.)
+{
+    frequency_bands_t Bands;
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        frequency_band_t fb(1000. * (double) (i + 1), 1000. * (double) (i + 1) + 500., 1000. * (double) (i + 2));
+
+        fb.Value    = values[i];
+        fb.MaxValue = maxValue;
+
+        Bands.push_back(fb);
+    }
+
+    return Bands;
+}
+
+/// <summary>
+/// Gets the settings of a 100x50 client area without Nyquist suppression.
+/// </summary>
+static curve_settings_t GetSettings()
+{
+    curve_settings_t Settings = { };
+
+    Settings.Width            = 100.f;
+    Settings.Height           = 50.f;
+    Settings.NyquistFrequency = 1e9;
+    Settings.InnerRadius      = 10.f;
+    Settings.OuterRadius      = 20.f;
+    Settings.Angle            = (float) M_PI_2;
+
+    return Settings;
+}
+
+TEST_CASE(CurveBuilder, CentersTheKnotsInTheBands)
+{
+    curve_builder_t Builder;
+    curve_points_t Points;
+
+    CHECK(Builder.Build(CreateBands({ 0.1, 0.5, 1.0, 2.0, -1.0 }), GetSettings(), false, Points));
+
+    CHECK(Points.p0.size() == 5);
+    CHECK(Points.p1.size() == 4);
+    CHECK(Points.p2.size() == 4);
+
+    // 100 DIP / 4 intervals = 25 DIP per band. The values are clamped to the height of the client area.
+    const float y[] = { 5.f, 25.f, 50.f, 50.f, 0.f };
+
+    for (size_t i = 0; i < Points.p0.size(); ++i)
+    {
+        CHECK_NEAR(Points.p0[i].x, 12.5 + 25. * (double) i, 1e-4);
+        CHECK_NEAR(Points.p0[i].y, y[i], 1e-4);
+    }
+
+    // The peak curve uses the maximum values.
+    CHECK(Builder.Build(CreateBands({ 0.1, 0.5, 1.0 }, 0.25), GetSettings(), true, Points));
+
+    CHECK(Points.p0.size() == 3);
+
+    for (const auto & p : Points.p0)
+        CHECK_NEAR(p.y, 12.5, 1e-4);
+}
+
+TEST_CASE(CurveBuilder, RejectsFlatLines)
+{
+    curve_builder_t Builder;
+    curve_points_t Points;
+
+    CHECK(!Builder.Build(CreateBands({ 0.5 }), GetSettings(), false, Points));
+    CHECK(Points.p0.empty());
+
+    CHECK(!Builder.Build(CreateBands({ 0., 0., 0. }), GetSettings(), false, Points));
+
+    // Bands above the Nyquist frequency are flattened when the mirror image is suppressed.
+    curve_settings_t Settings = GetSettings();
+
+    Settings.NyquistFrequency    = 1500.;
+    Settings.SuppressMirrorImage = true;
+
+    CHECK(!Builder.Build(CreateBands({ 0., 0.5, 0.5 }), Settings, false, Points));
+
+    CHECK(Builder.Build(CreateBands({ 0.5, 0.5, 0.5 }), Settings, false, Points));
+    CHECK_NEAR(Points.p0[0].y, 25., 1e-4);
+    CHECK_NEAR(Points.p0[1].y,  0., 1e-4);
+    CHECK_NEAR(Points.p0[2].y,  0., 1e-4);
+}
+
+TEST_CASE(CurveBuilder, SplineIsSmooth)
+{
+    curve_builder_t Builder;
+    curve_points_t Points;
+
+    CHECK(Builder.Build(CreateBands({ 0.2, 0.6, 0.3, 0.7, 0.4, 0.5 }), GetSettings(), false, Points));
+
+    const size_t n = Points.p1.size();
+
+    // The first derivative is continuous at the inner knots: P1[i] + P2[i-1] = 2 Q[i].
+    for (size_t i = 1; i < n; ++i)
+    {
+        CHECK_NEAR(Points.p1[i].x + Points.p2[i - 1].x, 2. * Points.p0[i].x, 1e-3);
+        CHECK_NEAR(Points.p1[i].y + Points.p2[i - 1].y, 2. * Points.p0[i].y, 1e-3);
+    }
+
+    // The second derivative is continuous at the inner knots: P1[i-1] + 2 P1[i] = P2[i] + 2 P2[i-1].
+    for (size_t i = 1; i < n; ++i)
+        CHECK_NEAR(Points.p1[i - 1].y + 2. * Points.p1[i].y, Points.p2[i].y + 2. * Points.p2[i - 1].y, 1e-3);
+
+    // The control points stay inside the client area.
+    CHECK(Builder.Build(CreateBands({ 0., 1., 0., 1., 0. }), GetSettings(), false, Points));
+
+    for (size_t i = 0; i < Points.p1.size(); ++i)
+    {
+        CHECK((Points.p1[i].y >= 0.f) && (Points.p1[i].y <= 50.f));
+        CHECK((Points.p2[i].y >= 0.f) && (Points.p2[i].y <= 50.f));
+    }
+}
+
+TEST_CASE(CurveBuilder, TwoKnotsMakeAStraightLine)
+{
+    curve_builder_t Builder;
+    curve_points_t Points;
+
+    CHECK(Builder.Build(CreateBands({ 0.2, 0.8 }), GetSettings(), false, Points));
+
+    CHECK(Points.p1.size() == 1);
+
+    // Knots at (50, 10) and (150, 40).
+    CHECK_NEAR(Points.p1[0].x, (2. * 50. + 150.) / 3., 1e-3);
+    CHECK_NEAR(Points.p1[0].y, (2. * 10. +  40.) / 3., 1e-3);
+    CHECK_NEAR(Points.p2[0].x, (50. + 2. * 150.) / 3., 1e-3);
+    CHECK_NEAR(Points.p2[0].y, (10. + 2. *  40.) / 3., 1e-3);
+}
+
+TEST_CASE(CurveBuilder, ClosesTheRadialCurve)
+{
+    curve_builder_t Builder;
+    curve_points_t Points;
+
+    CHECK(Builder.BuildRadial(CreateBands({ 1.0, 0.5, 0.0, 0.5 }), GetSettings(), false, Points));
+
+    // One knot per band plus the first knot to close the curve.
+    CHECK(Points.p0.size() == 5);
+    CHECK(Points.p1.size() == 4);
+
+    CHECK(Points.p0.front().x == Points.p0.back().x);
+    CHECK(Points.p0.front().y == Points.p0.back().y);
+
+    // The bands run clockwise from the start angle (straight up) at the inner radius plus the value times the height of the ring.
+    const double Expected[][2] = { { 0., 20. }, { 15., 0. }, { 0., -10. }, { -15., 0. } };
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        CHECK_NEAR(Points.p0[i].x, Expected[i][0], 1e-4);
+        CHECK_NEAR(Points.p0[i].y, Expected[i][1], 1e-4);
+    }
+
+    // No control point is inside the inner circle.
+    for (size_t i = 0; i < Points.p1.size(); ++i)
+    {
+        CHECK(std::hypot(Points.p1[i].x, Points.p1[i].y) >= 10.f - 1e-4f);
+        CHECK(std::hypot(Points.p2[i].x, Points.p2[i].y) >= 10.f - 1e-4f);
+    }
+
+    // The bands above the Nyquist frequency are left out.
+    curve_settings_t Settings = GetSettings();
+
+    Settings.NyquistFrequency    = 2500.;
+    Settings.SuppressMirrorImage = true;
+
+    CHECK(Builder.BuildRadial(CreateBands({ 1.0, 0.5, 0.0, 0.5 }), Settings, false, Points));
+    CHECK(Points.p0.size() == 3);
+
+    CHECK(!Builder.BuildRadial(CreateBands({ 1.0 }), GetSettings(), false, Points));
+}
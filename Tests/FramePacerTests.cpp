@@ -0,0 +1,262 @@
+
+/** $VER: FramePacerTests.cpp (2026.10.18) P. Stuer - Tests the frame pacer and the frame rate governor. **/
+
+#include "Test.h"
+
+#include "FramePacer.h"
+#include "FrameRateGovernor.h"
+
+/// <summary>
+/// Implements a clock that only advances when the pacer sleeps or when a frame does its work. A sleep takes the requested time plus the oversleep.
+/// </summary>
+class fake_clock_t : public frame_clock_t
+{
+public:
+    int64_t Now() const noexcept override { return _Now; }
+    int64_t GetFrequency() const noexcept override { return 1'000'000; }
+
+    bool Sleep(int64_t ticks) noexcept override
+    {
+        if (_Interrupted)
+            return false;
+
+        _Now += ticks + _Oversleep;
+        ++_SleepCount;
+
+        return true;
+    }
+
+    void Work(int64_t ticks) noexcept { _Now += ticks; }
+
+    int64_t _Now = 1'000;
+    int64_t _Oversleep = 0;
+    uint64_t _SleepCount = 0;
+    bool _Interrupted = false;
+};
+
+TEST_CASE(FramePacer, PacesAtTheFrameRate)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Pacer.Start(50., 0);
+
+    CHECK(Pacer.GetPeriod() == 20'000);
+
+    int64_t Previous = Clock.Now();
+
+    for (int i = 0; i < 300; ++i)
+    {
+        CHECK(Pacer.WaitForNextFrame());
+
+        CHECK(Clock.Now() - Previous == 20'000);
+        CHECK(Pacer.GetLateness() == 0);
+
+        Previous = Clock.Now();
+
+        Clock.Work(5'000);
+    }
+
+    CHECK(Pacer.GetMissedFrames() == 0);
+}
+
+TEST_CASE(FramePacer, CalibratesTheSlackToTheOversleep)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Clock._Oversleep = 500;
+
+    Pacer.Start(60., 0);
+
+    for (int i = 0; i < 300; ++i)
+    {
+        CHECK(Pacer.WaitForNextFrame());
+
+        Clock.Work(2'000);
+    }
+
+    // The moving average of the slack converges to within 1/8 of its resolution of the oversleep, so the frames start within a few ticks of their deadline.
+    CHECK_NEAR(Pacer.GetSlack(), 500, 8);
+    CHECK_NEAR(Pacer.GetLateness(), 0, 8);
+}
+
+TEST_CASE(FramePacer, LimitsTheSlackToHalfAPeriod)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Clock._Oversleep = 50'000;
+
+    Pacer.Start(100., 1'000'000);
+
+    CHECK(Pacer.GetSlack() == 5'000);
+
+    for (int i = 0; i < 50; ++i)
+        CHECK(Pacer.WaitForNextFrame());
+
+    CHECK(Pacer.GetSlack() <= 5'000);
+}
+
+TEST_CASE(FramePacer, CatchesUpWithoutDroppingFrames)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Pacer.Start(100., 0);
+
+    CHECK(Pacer.WaitForNextFrame());
+
+    // A frame that takes 2.5 periods delays the next frames but stays within the catch-up limit.
+    Clock.Work(25'000);
+
+    const uint64_t SleepCount = Clock._SleepCount;
+
+    CHECK(Pacer.WaitForNextFrame());
+    CHECK(Pacer.GetLateness() == 15'000);
+
+    CHECK(Pacer.WaitForNextFrame());
+    CHECK(Pacer.GetLateness() == 5'000);
+
+    // The frames started back to back until the pacer caught up.
+    CHECK(Clock._SleepCount == SleepCount);
+
+    CHECK(Pacer.WaitForNextFrame());
+    CHECK(Pacer.GetLateness() == 0);
+
+    CHECK(Pacer.GetMissedFrames() == 0);
+}
+
+TEST_CASE(FramePacer, DropsFramesBeyondTheCatchUpLimit)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Pacer.Start(100., 0);
+
+    CHECK(Pacer.WaitForNextFrame());
+
+    const int64_t Start = Clock.Now();
+
+    // A stall of 10.5 periods.
+    Clock.Work(105'000);
+
+    CHECK(Pacer.WaitForNextFrame());
+
+    CHECK(Pacer.GetMissedFrames() == 9);
+    CHECK(Pacer.GetLateness() == 0);
+    CHECK(Clock.Now() == Start + 105'000);
+
+    // The next frame is a period after the late frame.
+    CHECK(Pacer.WaitForNextFrame());
+    CHECK(Clock.Now() == Start + 115'000);
+}
+
+TEST_CASE(FramePacer, KeepsTheDeadlineWhenTheFrameRateChanges)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Pacer.Start(100., 0);
+
+    const int64_t Start = Clock.Now();
+
+    Pacer.SetFrameRate(50.);
+
+    CHECK(Pacer.GetPeriod() == 20'000);
+
+    CHECK(Pacer.WaitForNextFrame());
+    CHECK(Clock.Now() == Start + 10'000);
+
+    CHECK(Pacer.WaitForNextFrame());
+    CHECK(Clock.Now() == Start + 30'000);
+}
+
+TEST_CASE(FramePacer, StopsWhenTheSleepIsInterrupted)
+{
+    fake_clock_t Clock;
+    frame_pacer_t Pacer(Clock);
+
+    Pacer.Start(60., 0);
+
+    Clock._Interrupted = true;
+
+    CHECK(!Pacer.WaitForNextFrame());
+}
+
+TEST_CASE(FrameRateGovernor, LowersTheFrameRateWhenIdle)
+{
+    frame_rate_governor_t Governor;
+
+    Governor.Reset(60.);
+
+    // Changing frames keep the maximum frame rate.
+    for (int i = 0; i < 120; ++i)
+        Governor.Update(60., 0.1, false, 0.002);
+
+    CHECK(Governor.GetFrameRate() == 60.);
+    CHECK(Governor.GetReason() == FrameRateReason::Limit);
+
+    // A second without a change lowers the frame rate to the idle frame rate.
+    for (int i = 0; i < 61; ++i)
+        Governor.Update(60., 0., false, 0.002);
+
+    CHECK(Governor.GetFrameRate() == frame_rate_governor_t::MinFrameRate);
+    CHECK(Governor.GetReason() == FrameRateReason::Idle);
+
+    // Moving peak indicators count as a change.
+    CHECK(Governor.Update(60., 0., true, 0.002));
+    CHECK(Governor.GetFrameRate() == 60.);
+
+    // So does any change above the threshold.
+    for (int i = 0; i < 61; ++i)
+        Governor.Update(60., 0., false, 0.002);
+
+    CHECK(Governor.GetReason() == FrameRateReason::Idle);
+
+    CHECK(Governor.Update(60., frame_rate_governor_t::ChangeThreshold * 2., false, 0.002));
+    CHECK(Governor.GetFrameRate() == 60.);
+    CHECK(Governor.GetReason() == FrameRateReason::Limit);
+}
+
+TEST_CASE(FrameRateGovernor, LowersTheFrameRateOnOverruns)
+{
+    frame_rate_governor_t Governor;
+
+    Governor.Reset(60.);
+
+    // Frames of 30 ms don't fit a period of 16.7 ms. The frame rate is lowered after the overrun limit.
+    for (uint32_t i = 0; i < frame_rate_governor_t::OverrunLimit - 1; ++i)
+        Governor.Update(60., 0.1, false, 0.030);
+
+    CHECK(Governor.GetFrameRate() == 60.);
+
+    CHECK(Governor.Update(60., 0.1, false, 0.030));
+
+    CHECK_NEAR(Governor.GetFrameRate(), frame_rate_governor_t::TargetLoad / 0.030, 1e-9);
+    CHECK(Governor.GetReason() == FrameRateReason::Overrun);
+
+    // Cheap frames raise the frame rate step by step until it is back at the maximum.
+    for (int i = 0; i < 2000; ++i)
+        Governor.Update(60., 0.1, false, 0.002);
+
+    CHECK(Governor.GetFrameRate() == 60.);
+    CHECK(Governor.GetReason() == FrameRateReason::Limit);
+    CHECK(Governor.GetStatistics().OverrunFrameCount > 0);
+}
+
+TEST_CASE(FrameRateGovernor, StartsOverWhenTheLimitChanges)
+{
+    frame_rate_governor_t Governor;
+
+    Governor.Reset(60.);
+
+    for (int i = 0; i < 61; ++i)
+        Governor.Update(60., 0., false, 0.002);
+
+    CHECK(Governor.GetReason() == FrameRateReason::Idle);
+
+    CHECK(Governor.Update(144., 0., false, 0.002));
+    CHECK(Governor.GetFrameRate() == 144.);
+    CHECK(Governor.GetReason() == FrameRateReason::Limit);
+}
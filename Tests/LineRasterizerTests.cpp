@@ -0,0 +1,112 @@
+
+/** $VER: LineRasterizerTests.cpp (2026.10.18) P. Stuer - Tests the rasterization of a spectrogram line. **/
+
+#include "Test.h"
+
+#include "LineRasterizer.h"
+
+#include <vector>
+
+static const uint32_t Colors[] = { 0xFF000001, 0xFF000002, 0xFF000003, 0xFF000004, 0xFF000005 };
+
+/// <summary>
+/// Returns true if the rasterized pixels are the expected pixels.
+/// </summary>
+static bool HasPixels(const uint32_t * pixels, const std::vector<uint32_t> & expected)
+{
+    for (size_t i = 0; i < expected.size(); ++i)
+        if (pixels[i] != expected[i])
+            return false;
+
+    return true;
+}
+
+TEST_CASE(LineRasterizer, CoversThePixelsByTheirCenter)
+{
+    line_rasterizer_t Rasterizer;
+
+    // Band bounds at 0, 2.5, 5 and 7.5. The pixel at 2 has its center on the bound and belongs to the next band. The last pixel is not covered.
+    const uint32_t * Pixels = Rasterizer.Rasterize(Colors, 3, 0., 2.5, 8, 1, false);
+
+    CHECK(HasPixels(Pixels, { Colors[0], Colors[0], Colors[1], Colors[1], Colors[1], Colors[2], Colors[2], 0 }));
+
+    // Bands smaller than a pixel: only the band that contains the center of a pixel is visible.
+    Pixels = Rasterizer.Rasterize(Colors, 5, 0., 0.4, 2, 1, false);
+
+    CHECK(HasPixels(Pixels, { Colors[1], Colors[3] }));
+
+    // Bands of 1.5 pixels alternate between 1 and 2 pixels.
+    Pixels = Rasterizer.Rasterize(Colors, 4, 0., 1.5, 6, 1, true);
+
+    CHECK(HasPixels(Pixels, { Colors[0], Colors[1], Colors[1], Colors[2], Colors[3], Colors[3] }));
+}
+
+TEST_CASE(LineRasterizer, ShiftsTheBandsByTheOffset)
+{
+    line_rasterizer_t Rasterizer;
+
+    const uint32_t * Pixels = Rasterizer.Rasterize(Colors, 2, 1.5, 2., 8, 1, false);
+
+    CHECK(HasPixels(Pixels, { 0, Colors[0], Colors[0], Colors[1], Colors[1], 0, 0, 0 }));
+
+    // A fractional offset moves the bounds by less than a pixel.
+    Pixels = Rasterizer.Rasterize(Colors, 2, 0.75, 2., 6, 1, false);
+
+    CHECK(HasPixels(Pixels, { 0, Colors[0], Colors[0], Colors[1], Colors[1], 0 }));
+}
+
+TEST_CASE(LineRasterizer, ClipsTheBandsToTheLine)
+{
+    line_rasterizer_t Rasterizer;
+
+    // The first band lies before the start of the line, the last band extends beyond its end.
+    const uint32_t * Pixels = Rasterizer.Rasterize(Colors, 4, -3., 2., 4, 1, false);
+
+    CHECK(HasPixels(Pixels, { Colors[1], Colors[2], Colors[2], Colors[3] }));
+
+    // All bands beyond the end of the line.
+    Pixels = Rasterizer.Rasterize(Colors, 3, 10., 1., 4, 1, false);
+
+    CHECK(HasPixels(Pixels, { 0, 0, 0, 0 }));
+
+    // All bands before the start of the line.
+    Pixels = Rasterizer.Rasterize(Colors, 3, -5., 1., 4, 1, false);
+
+    CHECK(HasPixels(Pixels, { 0, 0, 0, 0 }));
+
+    // No bands.
+    Pixels = Rasterizer.Rasterize(Colors, 0, 0., 1., 3, 1, false);
+
+    CHECK(HasPixels(Pixels, { 0, 0, 0 }));
+}
+
+TEST_CASE(LineRasterizer, RepeatsTheLineToTheThickness)
+{
+    line_rasterizer_t Rasterizer;
+
+    // A column: each pixel of the line becomes a row of 3 pixels.
+    const uint32_t * Pixels = Rasterizer.Rasterize(Colors, 2, 1., 1., 4, 3, true);
+
+    CHECK(HasPixels(Pixels,
+    {
+        0,         0,         0,
+        Colors[0], Colors[0], Colors[0],
+        Colors[1], Colors[1], Colors[1],
+        0,         0,         0,
+    }));
+
+    // A row: the line is repeated 3 times.
+    Pixels = Rasterizer.Rasterize(Colors, 2, 1., 1., 4, 3, false);
+
+    CHECK(HasPixels(Pixels,
+    {
+        0, Colors[0], Colors[1], 0,
+        0, Colors[0], Colors[1], 0,
+        0, Colors[0], Colors[1], 0,
+    }));
+
+    // A thinner line after a thicker one.
+    Pixels = Rasterizer.Rasterize(Colors, 3, 0., 1., 3, 2, true);
+
+    CHECK(HasPixels(Pixels, { Colors[0], Colors[0], Colors[1], Colors[1], Colors[2], Colors[2] }));
+}
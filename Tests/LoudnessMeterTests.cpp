@@ -0,0 +1,145 @@
+
+/** $VER: LoudnessMeterTests.cpp (2026.10.18) P. Stuer - Tests the loudness meter with the minimum requirements test signals of EBU Tech 3341 and EBU Tech 3342. **/
+
+#include "Test.h"
+
+#include "LoudnessMeter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+static const uint32_t ChannelCount  = 2;
+static const uint32_t ChannelConfig = 0x3; // Front left and front right
+
+/// <summary>
+/// Represents a segment of a test signal: a 1 kHz sine with the specified level in both channels.
+/// </summary>
+struct segment_t
+{
+    double Level;       // in dBFS
+    double Duration;    // in seconds
+};
+
+/// <summary>
+/// Feeds a test signal to the meter in chunks of 100 ms, continuing the phase of the sine from one segment to the next.
+/// </summary>
+static void Measure(loudness_meter_t & meter, uint32_t sampleRate, const std::vector<segment_t> & segments)
+{
+    const size_t ChunkSize = sampleRate / 10;
+
+    std::vector<audio_sample> Frames(ChunkSize * ChannelCount);
+
+    size_t t = 0; // Index of the next frame of the signal.
+
+    for (const auto & Segment : segments)
+    {
+        const double Amplitude = std::pow(10., Segment.Level / 20.);
+
+        size_t FrameCount = (size_t) std::llround(Segment.Duration * (double) sampleRate);
+
+        while (FrameCount != 0)
+        {
+            const size_t n = std::min(ChunkSize, FrameCount);
+
+            for (size_t i = 0; i < n; ++i, ++t)
+            {
+                const audio_sample Sample = (audio_sample) (Amplitude * std::sin(2. * M_PI * 1000. * (double) t / (double) sampleRate));
+
+                Frames[i * ChannelCount + 0] = Sample;
+                Frames[i * ChannelCount + 1] = Sample;
+            }
+
+            meter.Process(Frames.data(), n, ChannelCount, ChannelConfig, sampleRate);
+
+            FrameCount -= n;
+        }
+    }
+}
+
+TEST_CASE(LoudnessMeter, Tech3341StationarySignals)
+{
+    // Cases 1 and 2: the momentary, short-term and integrated loudness of a stationary sine are its level (±0.1 LU).
+    for (uint32_t SampleRate : { 44100u, 48000u })
+    {
+        for (double Level : { -23., -33. })
+        {
+            loudness_meter_t Meter;
+
+            Measure(Meter, SampleRate, { { Level, 20. } });
+
+            CHECK_NEAR(Meter.GetMomentaryLoudness(),  Level, 0.1);
+            CHECK_NEAR(Meter.GetShortTermLoudness(),  Level, 0.1);
+            CHECK_NEAR(Meter.GetIntegratedLoudness(), Level, 0.1);
+        }
+    }
+}
+
+TEST_CASE(LoudnessMeter, Tech3341Gating)
+{
+    // Cases 3, 4 and 5: the absolute and the relative gate leave out the quiet segments. The integrated loudness is -23.0 LUFS (±0.1 LU).
+    const std::vector<segment_t> Signals[] =
+    {
+        { { -36., 10. }, { -23., 60. }, { -36., 10. } },
+        { { -72., 10. }, { -36., 10. }, { -23., 60. }, { -36., 10. }, { -72., 10. } },
+        { { -26., 20. }, { -20., 20.1 }, { -26., 20. } },
+    };
+
+    for (uint32_t SampleRate : { 44100u, 48000u })
+    {
+        for (const auto & Signal : Signals)
+        {
+            loudness_meter_t Meter;
+
+            Measure(Meter, SampleRate, Signal);
+
+            CHECK_NEAR(Meter.GetIntegratedLoudness(), -23., 0.1);
+        }
+    }
+}
+
+TEST_CASE(LoudnessMeter, Tech3342LoudnessRange)
+{
+    // Cases 1 to 4: the loudness range of consecutive stationary segments (±1 LU).
+    const struct { std::vector<segment_t> Signal; double LRA; } Cases[] =
+    {
+        { { { -20., 20. }, { -30., 20. } }, 10. },
+        { { { -20., 20. }, { -15., 20. } },  5. },
+        { { { -40., 20. }, { -20., 20. } }, 20. },
+        { { { -50., 20. }, { -35., 20. }, { -20., 20. }, { -35., 20. }, { -50., 20. } }, 15. },
+    };
+
+    for (uint32_t SampleRate : { 44100u, 48000u })
+    {
+        for (const auto & [Signal, LRA] : Cases)
+        {
+            loudness_meter_t Meter;
+
+            Measure(Meter, SampleRate, Signal);
+
+            CHECK_NEAR(Meter.GetLoudnessRange(), LRA, 1.);
+            CHECK(Meter.GetLoudnessRangeLo() <= Meter.GetLoudnessRangeHi());
+        }
+    }
+}
+
+TEST_CASE(LoudnessMeter, ResetStartsANewMeasurement)
+{
+    loudness_meter_t Meter;
+
+    Measure(Meter, 48000, { { -20., 10. } });
+
+    Meter.Reset();
+
+    Measure(Meter, 48000, { { -30., 10. } });
+
+    CHECK_NEAR(Meter.GetIntegratedLoudness(), -30., 0.1);
+    CHECK_NEAR(Meter.GetLoudnessRange(), 0., 1.);
+
+    // Silence stays below the absolute gate.
+    Meter.Reset();
+
+    Measure(Meter, 48000, { { -200., 5. } });
+
+    CHECK(!(Meter.GetIntegratedLoudness() > loudness_meter_t::MinLoudness));
+}
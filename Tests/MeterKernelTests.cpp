@@ -0,0 +1,268 @@
+
+/** $VER: MeterKernelTests.cpp (2026.10.18) P. Stuer - Compares the implementations of the meter kernel with each other and with a reference. **/
+
+#include "Test.h"
+
+#include "MeterKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/// <summary>
+/// Gives the tests access to the implementations of the kernel.
+/// </summary>
+struct meter_kernel_test_t
+{
+    static size_t ProcessScalar(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept
+    {
+        return meter_kernel_t::ProcessScalar(frames, frameCount, plan, block, cross);
+    }
+
+#if defined(SIMD_SSE2)
+    static size_t ProcessSSE2(const audio_sample * frames, size_t frameCount, const meter_plan_t & plan, meter_block_t & block, double & cross) noexcept
+    {
+        return meter_kernel_t::ProcessSSE2(frames, frameCount, plan, block, cross);
+    }
+#endif
+};
+
+/// <summary>
+/// Represents the channels selected for the level and the balance measuring.
+/// </summary>
+struct layout_t
+{
+    uint32_t SelectedChannels;
+    uint32_t BalanceChannels;
+};
+
+static const uint32_t ChannelCounts[] = { 1, 3, 5, 6, 8 };
+
+// None of the frame counts is a multiple of the period of 1, 3, 5 or 6 channels. With 8 channels the period is a single frame.
+static const size_t FrameCounts[] = { 1, 3, 7, 17, 101, 1001 };
+
+/// <summary>
+/// Gets the channel selections to test with the specified number of channels.
+/// </summary>
+static std::vector<layout_t> GetLayouts(uint32_t channelCount)
+{
+    const uint32_t AllChannels = (1u << channelCount) - 1;
+    const uint32_t LastChannel = 1u << (channelCount - 1);
+
+    std::vector<layout_t> Layouts =
+    {
+        { AllChannels, 0 },                             // No balance measuring
+        { AllChannels, LastChannel },                   // A single balance channel: no mid and side.
+    };
+
+    if (channelCount > 1)
+        Layouts.push_back({ AllChannels, 1u | LastChannel }); // The balance channels are as far apart as possible.
+
+    // The balance channels follow the last meter channel. The right samples of the last frames lie beyond the last complete period.
+    if (channelCount > 2)
+        Layouts.push_back({ AllChannels >> 2, AllChannels & ~(AllChannels >> 2) });
+
+    return Layouts;
+}
+
+/// <summary>
+/// Gets frames of noise with a full scale spike in each channel. The spike of the last channel lies in the last frame.
+/// </summary>
+static std::vector<audio_sample> GetFrames(size_t frameCount, uint32_t channelCount, std::mt19937 & generator)
+{
+    std::uniform_real_distribution<double> Noise(-0.9, 0.9);
+
+    std::vector<audio_sample> Frames(frameCount * channelCount);
+
+    for (audio_sample & Sample : Frames)
+        Sample = (audio_sample) Noise(generator);
+
+    for (uint32_t i = 0; i < channelCount; ++i)
+    {
+        const size_t Frame = (frameCount - 1) - (((size_t) (channelCount - 1 - i) * 5) % frameCount);
+
+        Frames[(Frame * channelCount) + i] = (audio_sample) ((i % 2) ? -1. : 1.);
+    }
+
+    return Frames;
+}
+
+/// <summary>
+/// Clears the accumulators of a block.
+/// </summary>
+static void Clear(meter_block_t & block, double & cross)
+{
+    block = { };
+    cross = 0.;
+}
+
+/// <summary>
+/// Gets the tolerance of a sum of squares. The implementations add the squares in a different order.
+/// </summary>
+static double GetTolerance(double expected)
+{
+    return 1e-12 * std::max(1., std::abs(expected));
+}
+
+TEST_CASE(MeterKernel, ImplementationsMatch)
+{
+#if defined(SIMD_SSE2)
+    std::mt19937 Generator(26);
+
+    for (uint32_t ChannelCount : ChannelCounts)
+    {
+        for (size_t FrameCount : FrameCounts)
+        {
+            const std::vector<audio_sample> Frames = GetFrames(FrameCount, ChannelCount, Generator);
+
+            for (const layout_t & Layout : GetLayouts(ChannelCount))
+            {
+                meter_plan_t Plan;
+
+                Plan.Build(ChannelCount, (1u << ChannelCount) - 1, Layout.SelectedChannels, Layout.BalanceChannels);
+
+                meter_block_t Scalar;
+                double ScalarCross;
+
+                Clear(Scalar, ScalarCross);
+
+                CHECK(meter_kernel_test_t::ProcessScalar(Frames.data(), FrameCount, Plan, Scalar, ScalarCross) == FrameCount);
+
+                // The SSE2 implementation leaves the frames that don't fill a complete period to the scalar implementation.
+                meter_block_t SSE2;
+                double SSE2Cross;
+
+                Clear(SSE2, SSE2Cross);
+
+                const size_t Processed = meter_kernel_test_t::ProcessSSE2(Frames.data(), FrameCount, Plan, SSE2, SSE2Cross);
+
+                CHECK(Processed <= FrameCount);
+                CHECK((FrameCount < 101) || (Processed > FrameCount / 2));
+
+                if (Processed < FrameCount)
+                    meter_kernel_test_t::ProcessScalar(Frames.data() + (Processed * ChannelCount), FrameCount - Processed, Plan, SSE2, SSE2Cross);
+
+                for (uint32_t i = 0; i < ChannelCount; ++i)
+                {
+                    CHECK(SSE2.Peak[i] == Scalar.Peak[i]);
+                    CHECK_NEAR(SSE2.SumOfSquares[i], Scalar.SumOfSquares[i], GetTolerance(Scalar.SumOfSquares[i]));
+                }
+
+                CHECK_NEAR(SSE2Cross, ScalarCross, GetTolerance((double) FrameCount));
+            }
+        }
+    }
+#endif
+}
+
+TEST_CASE(MeterKernel, MatchesTheReference)
+{
+    std::mt19937 Generator(26);
+
+    for (uint32_t ChannelCount : ChannelCounts)
+    {
+        for (size_t FrameCount : FrameCounts)
+        {
+            const std::vector<audio_sample> Frames = GetFrames(FrameCount, ChannelCount, Generator);
+
+            for (const layout_t & Layout : GetLayouts(ChannelCount))
+            {
+                meter_plan_t Plan;
+
+                Plan.Build(ChannelCount, (1u << ChannelCount) - 1, Layout.SelectedChannels, Layout.BalanceChannels);
+
+                meter_block_t Block;
+
+                meter_kernel_t::Process(Frames.data(), FrameCount, Plan, Block);
+
+                // Peak and RMS of each channel
+                for (uint32_t i = 0; i < ChannelCount; ++i)
+                {
+                    double Peak = 0.;
+                    double SumOfSquares = 0.;
+
+                    for (size_t j = 0; j < FrameCount; ++j)
+                    {
+                        const double Value = (double) Frames[(j * ChannelCount) + i];
+
+                        Peak = std::max(Peak, std::abs(Value));
+                        SumOfSquares += Value * Value;
+                    }
+
+                    CHECK(Block.Peak[i] == Peak);
+                    CHECK(Block.Peak[i] == 1.);
+                    CHECK_NEAR(std::sqrt(Block.SumOfSquares[i] / (double) FrameCount), std::sqrt(SumOfSquares / (double) FrameCount), 1e-12);
+                }
+
+                // Balance, mid and side
+                double Left = 0., Right = 0., Mid = 0., Side = 0.;
+
+                if (Plan.LeftOffset >= 0)
+                {
+                    for (size_t j = 0; j < FrameCount; ++j)
+                    {
+                        const double L = (double) Frames[(j * ChannelCount) + (size_t) Plan.LeftOffset];
+
+                        Left += L * L;
+
+                        if (Plan.RightOffset >= 0)
+                        {
+                            const double R = (double) Frames[(j * ChannelCount) + (size_t) Plan.RightOffset];
+
+                            Right += R * R;
+                            Mid   += ((L + R) / 2.) * ((L + R) / 2.);
+                            Side  += ((L - R) / 2.) * ((L - R) / 2.);
+                        }
+                    }
+                }
+
+                const double Tolerance = GetTolerance(Left + Right);
+
+                CHECK_NEAR(Block.Left,  Left,  Tolerance);
+                CHECK_NEAR(Block.Right, Right, Tolerance);
+                CHECK_NEAR(Block.Mid,   (Plan.RightOffset >= 0) ? Mid  : Left / 4., Tolerance);
+                CHECK_NEAR(Block.Side,  (Plan.RightOffset >= 0) ? Side : Left / 4., Tolerance);
+            }
+        }
+    }
+}
+
+TEST_CASE(MeterKernel, DerivesTheMidAndTheSide)
+{
+    const uint32_t ChannelCount = 3;
+    const size_t FrameCount = 37;
+
+    meter_plan_t Plan;
+
+    // The balance channels follow the meter channel.
+    Plan.Build(ChannelCount, 7, 1, 6);
+
+    std::vector<audio_sample> Frames(FrameCount * ChannelCount);
+
+    // Identical channels have no side.
+    for (size_t j = 0; j < FrameCount; ++j)
+    {
+        Frames[(j * ChannelCount) + 0] = (audio_sample) 0.1;
+        Frames[(j * ChannelCount) + 1] =
+        Frames[(j * ChannelCount) + 2] = (audio_sample) ((j % 2) ? -0.5 : 0.5);
+    }
+
+    meter_block_t Block;
+
+    meter_kernel_t::Process(Frames.data(), FrameCount, Plan, Block);
+
+    CHECK_NEAR(Block.Left,  FrameCount * 0.25, 1e-12);
+    CHECK_NEAR(Block.Right, FrameCount * 0.25, 1e-12);
+    CHECK_NEAR(Block.Mid,   FrameCount * 0.25, 1e-12);
+    CHECK(Block.Side == 0.);
+
+    // Channels in opposite phase have no mid.
+    for (size_t j = 0; j < FrameCount; ++j)
+        Frames[(j * ChannelCount) + 2] = -Frames[(j * ChannelCount) + 1];
+
+    meter_kernel_t::Process(Frames.data(), FrameCount, Plan, Block);
+
+    CHECK_NEAR(Block.Mid,  0., 1e-12);
+    CHECK_NEAR(Block.Side, FrameCount * 0.25, 1e-12);
+}
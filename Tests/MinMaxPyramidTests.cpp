@@ -0,0 +1,174 @@
+
+/** $VER: MinMaxPyramidTests.cpp (2026.10.18) P. Stuer - Tests the min/max decimation pyramid against a brute-force scan. **/
+
+#include "Test.h"
+
+#include "MinMaxPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+/// <summary>
+/// Generates interleaved frames of white noise.
+/// </summary>
+static std::vector<audio_sample> GenerateFrames(size_t frameCount, size_t channelCount, uint32_t seed)
+{
+    std::vector<audio_sample> Frames(frameCount * channelCount);
+
+    std::mt19937 Generator(seed);
+    std::uniform_real_distribution<double> Noise(-1., 1.);
+
+    for (auto & Sample : Frames)
+        Sample = (audio_sample) Noise(Generator);
+
+    return Frames;
+}
+
+/// <summary>
+/// Returns true if the pyramid returns exactly the extremes of a brute-force scan of the range [first, last) of the specified channel.
+/// </summary>
+static bool IsExact(const min_max_pyramid_t & pyramid, const std::vector<audio_sample> & frames, size_t channelCount, size_t channel, size_t first, size_t last)
+{
+    audio_sample Min, Max;
+
+    pyramid.GetRange(first, last, Min, Max);
+
+    audio_sample ExpectedMin =  std::numeric_limits<audio_sample>::max();
+    audio_sample ExpectedMax = -std::numeric_limits<audio_sample>::max();
+
+    for (size_t i = first; i < last; ++i)
+    {
+        ExpectedMin = std::min(ExpectedMin, frames[i * channelCount + channel]);
+        ExpectedMax = std::max(ExpectedMax, frames[i * channelCount + channel]);
+    }
+
+    return (Min == ExpectedMin) && (Max == ExpectedMax);
+}
+
+/// <summary>
+/// Gets the RMS of the range [first, last) of the specified channel with a brute-force scan.
+/// </summary>
+static double GetRMS(const std::vector<audio_sample> & frames, size_t channelCount, size_t channel, size_t first, size_t last)
+{
+    double Sum = 0.;
+
+    for (size_t i = first; i < last; ++i)
+        Sum += (double) frames[i * channelCount + channel] * (double) frames[i * channelCount + channel];
+
+    return std::sqrt(Sum / (double) (last - first));
+}
+
+TEST_CASE(MinMaxPyramid, MatchesABruteForceScanOfAllRanges)
+{
+    // Cover odd and even lengths around the vector widths of the reduction, mono and interleaved.
+    for (size_t ChannelCount : { (size_t) 1, (size_t) 2, (size_t) 3 })
+    {
+        for (size_t FrameCount : { (size_t) 1, (size_t) 2, (size_t) 7, (size_t) 8, (size_t) 9, (size_t) 16, (size_t) 17, (size_t) 63, (size_t) 100 })
+        {
+            const std::vector<audio_sample> Frames = GenerateFrames(FrameCount, ChannelCount, (uint32_t) (FrameCount * 10 + ChannelCount));
+
+            for (size_t Channel = 0; Channel < ChannelCount; ++Channel)
+            {
+                min_max_pyramid_t Pyramid;
+
+                Pyramid.Build(Frames.data() + Channel, FrameCount, ChannelCount);
+
+                CHECK(Pyramid.GetCount() == FrameCount);
+
+                size_t FailureCount = 0;
+
+                for (size_t First = 0; First < FrameCount; ++First)
+                {
+                    for (size_t Last = First + 1; Last <= FrameCount; ++Last)
+                    {
+                        if (!IsExact(Pyramid, Frames, ChannelCount, Channel, First, Last))
+                            ++FailureCount;
+
+                        if (std::abs(Pyramid.GetRMS(First, Last) - GetRMS(Frames, ChannelCount, Channel, First, Last)) > 1e-6)
+                            ++FailureCount;
+                    }
+                }
+
+                CHECK(FailureCount == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE(MinMaxPyramid, MatchesABruteForceScanOfRandomRanges)
+{
+    const size_t FrameCount = 48000;
+
+    const std::vector<audio_sample> Frames = GenerateFrames(FrameCount, 2, 1);
+
+    min_max_pyramid_t Pyramid;
+
+    Pyramid.Build(Frames.data() + 1, FrameCount, 2);
+
+    std::mt19937 Generator(2);
+    std::uniform_int_distribution<size_t> Index(0, FrameCount);
+
+    size_t FailureCount = 0;
+
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        size_t First = Index(Generator);
+        size_t Last  = Index(Generator);
+
+        if (First > Last)
+            std::swap(First, Last);
+
+        if (First == Last)
+            continue;
+
+        if (!IsExact(Pyramid, Frames, 2, 1, First, Last))
+            ++FailureCount;
+
+        if (std::abs(Pyramid.GetRMS(First, Last) - GetRMS(Frames, 2, 1, First, Last)) > 1e-6)
+            ++FailureCount;
+    }
+
+    CHECK(FailureCount == 0);
+
+    // The columns of a 1920 pixel wide oscilloscope cover all samples exactly once.
+    for (size_t x = 0; x < 1920; ++x)
+    {
+        if (!IsExact(Pyramid, Frames, 2, 1, (x * FrameCount) / 1920, ((x + 1) * FrameCount) / 1920))
+            ++FailureCount;
+    }
+
+    CHECK(FailureCount == 0);
+}
+
+TEST_CASE(MinMaxPyramid, HandlesEmptyRanges)
+{
+    const std::vector<audio_sample> Frames = GenerateFrames(10, 1, 3);
+
+    min_max_pyramid_t Pyramid;
+
+    Pyramid.Build(Frames.data(), Frames.size(), 1);
+
+    audio_sample Min = 1, Max = 1;
+
+    Pyramid.GetRange(5, 5, Min, Max);
+
+    CHECK((Min == 0) && (Max == 0));
+    CHECK(Pyramid.GetRMS(5, 5) == 0.);
+
+    // The end of the range is clamped to the number of samples.
+    CHECK(IsExact(Pyramid, Frames, 1, 0, 4, 10));
+
+    Pyramid.GetRange(4, 1000, Min, Max);
+
+    audio_sample ExpectedMin, ExpectedMax;
+
+    Pyramid.GetRange(4, 10, ExpectedMin, ExpectedMax);
+
+    CHECK((Min == ExpectedMin) && (Max == ExpectedMax));
+
+    Pyramid.GetRange(20, 30, Min, Max);
+
+    CHECK((Min == 0) && (Max == 0));
+}
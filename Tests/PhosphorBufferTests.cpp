@@ -0,0 +1,222 @@
+
+/** $VER: PhosphorBufferTests.cpp (2026.10.18) P. Stuer - Tests the intensity accumulation buffer of the phosphor decay effect. **/
+
+#include "Test.h"
+
+#include "PhosphorBuffer.h"
+
+#include <cmath>
+#include <limits>
+
+static const uint32_t White = 0xFFFFFFFFu; // Each level of white has the level in all 4 channels.
+
+/// <summary>
+/// Gets the intensity level (0 .. 255) of a pixel.
+/// </summary>
+static uint32_t GetLevel(const uint32_t * pixels, const phosphor_buffer_t & buffer, size_t x, size_t y)
+{
+    return pixels[(y * buffer.GetWidth()) + x] >> 24;
+}
+
+/// <summary>
+/// Lights the pixel with the specified intensity by adding a point at its center.
+/// </summary>
+static void Light(phosphor_buffer_t & buffer, size_t x, size_t y, float intensity)
+{
+    buffer.AddLine((float) x + 0.5f, (float) y + 0.5f, (float) x + 0.5f, (float) y + 0.5f, intensity);
+}
+
+TEST_CASE(PhosphorBuffer, AccumulatesAtThePixelCenter)
+{
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(8, 8));
+
+    Buffer.SetColor(White);
+
+    Light(Buffer, 2, 3, 0.25f);
+
+    const uint32_t * Pixels = Buffer.Resolve();
+
+    CHECK(GetLevel(Pixels, Buffer, 2, 3) == 64);
+    CHECK(GetLevel(Pixels, Buffer, 3, 3) == 0);
+    CHECK(GetLevel(Pixels, Buffer, 2, 4) == 0);
+
+    Light(Buffer, 2, 3, 0.25f);
+
+    Pixels = Buffer.Resolve();
+
+    CHECK(GetLevel(Pixels, Buffer, 2, 3) == 128);
+    CHECK(Pixels[(3 * 8) + 2] == 0x80808080u);
+
+    // Saturates at full intensity.
+    Light(Buffer, 2, 3, 2.f);
+
+    CHECK(Buffer.Resolve()[(3 * 8) + 2] == White);
+}
+
+TEST_CASE(PhosphorBuffer, SplitsAPointBetweenPixels)
+{
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(8, 8));
+
+    Buffer.SetColor(White);
+    Buffer.AddLine(3.f, 3.5f, 3.f, 3.5f, 1.f);
+
+    const uint32_t * Pixels = Buffer.Resolve();
+
+    CHECK(GetLevel(Pixels, Buffer, 2, 3) == 128);
+    CHECK(GetLevel(Pixels, Buffer, 3, 3) == 128);
+    CHECK(GetLevel(Pixels, Buffer, 2, 2) == 0);
+}
+
+TEST_CASE(PhosphorBuffer, DividesTheIntensityAlongALine)
+{
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(32, 2));
+
+    Buffer.SetColor(White);
+
+    // 4 steps of 1 pixel: each pixel after the start point gets a quarter.
+    Buffer.AddLine(0.5f, 0.5f, 4.5f, 0.5f, 1.f);
+
+    // 16 steps: no pixel gets less than a quarter.
+    Buffer.AddLine(0.5f, 1.5f, 16.5f, 1.5f, 1.f);
+
+    const uint32_t * Pixels = Buffer.Resolve();
+
+    CHECK(GetLevel(Pixels, Buffer, 0, 0) == 0);
+
+    for (size_t x = 1; x <= 4; ++x)
+        CHECK(GetLevel(Pixels, Buffer, x, 0) == 64);
+
+    CHECK(GetLevel(Pixels, Buffer, 5, 0) == 0);
+
+    for (size_t x = 1; x <= 16; ++x)
+        CHECK(GetLevel(Pixels, Buffer, x, 1) == 64);
+}
+
+TEST_CASE(PhosphorBuffer, IgnoresLinesOutsideTheBuffer)
+{
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(8, 8));
+
+    Buffer.SetColor(White);
+
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+    const float Inf = std::numeric_limits<float>::infinity();
+
+    Buffer.AddLine(-10.f, -10.f, -20.f, -5.f, 1.f);
+    Buffer.AddLine(NaN, 1.f, 2.f, 2.f, 1.f);
+    Buffer.AddLine(1.f, 1.f, Inf, 2.f, 1.f);
+
+    const uint32_t * Pixels = Buffer.Resolve();
+
+    for (size_t i = 0; i < 8 * 8; ++i)
+        CHECK(Pixels[i] == 0);
+}
+
+TEST_CASE(PhosphorBuffer, DecaysExponentially)
+{
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(8, 8));
+
+    Buffer.SetColor(White);
+
+    Light(Buffer, 4, 4, 1.f);
+
+    Buffer.Decay(0.5f);
+
+    CHECK(GetLevel(Buffer.Resolve(), Buffer, 4, 4) == 128);
+
+    Buffer.Decay(0.5f);
+
+    CHECK(GetLevel(Buffer.Resolve(), Buffer, 4, 4) == 64);
+
+    // 1/256 is still visible.
+    for (int i = 0; i < 6; ++i)
+        Buffer.Decay(0.5f);
+
+    CHECK(GetLevel(Buffer.Resolve(), Buffer, 4, 4) == 1);
+
+    // 1/512 is below half a level: the pixel is turned off and stays off.
+    Buffer.Decay(0.5f);
+    Buffer.Decay(4.f);
+
+    CHECK(GetLevel(Buffer.Resolve(), Buffer, 4, 4) == 0);
+}
+
+TEST_CASE(PhosphorBuffer, ClampsInvalidIntensities)
+{
+    const float NaN = std::numeric_limits<float>::quiet_NaN();
+    const float Inf = std::numeric_limits<float>::infinity();
+
+    // 7 pixels: 4 are resolved by the vectorized path, 3 by the scalar path.
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(7, 1));
+
+    Buffer.SetColor(White);
+
+    // A point also adds zero-weighted intensity to the next pixel: NaN and infinity turn it into NaN.
+    Light(Buffer, 0, 0, NaN);
+    Light(Buffer, 3, 0, -1.f);
+    Light(Buffer, 5, 0, Inf);
+
+    const uint32_t * Pixels = Buffer.Resolve();
+
+    CHECK(Pixels[0] == 0);
+    CHECK(Pixels[1] == 0);
+    CHECK(Pixels[2] == 0);
+    CHECK(Pixels[3] == 0);
+    CHECK(Pixels[4] == 0);
+    CHECK(Pixels[5] == White);
+    CHECK(Pixels[6] == 0);
+
+    // Decay turns off the pixels that are NaN.
+    Buffer.Decay(1.f);
+
+    Pixels = Buffer.Resolve();
+
+    CHECK(Pixels[0] == 0);
+    CHECK(Pixels[5] == White);
+
+    // The glow spreads the invalid intensities. Every pixel must still map to a level.
+    Buffer.Clear();
+    Buffer.SetBlur(1.);
+
+    Light(Buffer, 1, 0, NaN);
+    Light(Buffer, 5, 0, Inf);
+
+    Pixels = Buffer.Resolve();
+
+    for (size_t i = 0; i < 7; ++i)
+        CHECK(Pixels[i] == (Pixels[i] >> 24) * 0x01010101u);
+}
+
+TEST_CASE(PhosphorBuffer, GlowsAroundALitPixel)
+{
+    phosphor_buffer_t Buffer;
+
+    CHECK(Buffer.Initialize(9, 9));
+
+    Buffer.SetColor(White);
+    Buffer.SetBlur(1.);
+
+    Light(Buffer, 4, 4, 0.5f);
+
+    const uint32_t * Pixels = Buffer.Resolve();
+
+    const uint32_t Center = GetLevel(Pixels, Buffer, 4, 4);
+    const uint32_t Next   = GetLevel(Pixels, Buffer, 5, 4);
+
+    CHECK(Center > 128);
+    CHECK((Next > 0) && (Next < Center));
+    CHECK(GetLevel(Pixels, Buffer, 3, 4) == Next);
+    CHECK(GetLevel(Pixels, Buffer, 4, 3) == Next);
+    CHECK(GetLevel(Pixels, Buffer, 0, 0) == 0);
+}
@@ -0,0 +1,126 @@
+
+/** $VER: SpectrogramHistoryTests.cpp (2026.10.18) P. Stuer - Tests the history of the spectrogram. **/
+
+#include "Test.h"
+
+#include "SpectrogramHistory.h"
+
+/// <summary>
+/// Adds lines whose bands all have the value of the line number divided by 100.
+/// </summary>
+static void AddLines(spectrogram_history_t & history, size_t first, size_t count)
+{
+    double Values[4];
+
+    for (size_t i = first; i < first + count; ++i)
+    {
+        for (auto & Value : Values)
+            Value = (double) i / 100.;
+
+        history.Add(Values, 4);
+    }
+}
+
+/// <summary>
+/// Gets the line number stored in a line.
+/// </summary>
+static size_t GetLineNumber(const spectrogram_history_t & history, size_t age)
+{
+    return (size_t) ((double) history.GetLine(age)[0] * 100. / spectrogram_history_t::MaxValue + 0.5);
+}
+
+TEST_CASE(SpectrogramHistory, KeepsTheNewestLines)
+{
+    spectrogram_history_t History;
+
+    History.Initialize(4, 8);
+
+    AddLines(History, 1, 10);
+
+    CHECK(History.GetCount() == 8);
+    CHECK(GetLineNumber(History, 0) == 10);
+    CHECK(GetLineNumber(History, 7) == 3);
+}
+
+TEST_CASE(SpectrogramHistory, QuantizesTheValues)
+{
+    spectrogram_history_t History;
+
+    History.Initialize(4, 2);
+
+    const double Values[] = { -1., 0., 0.5, 2. };
+
+    History.Add(Values, 3);
+
+    const uint16_t * Line = History.GetLine(0);
+
+    CHECK(Line[0] == 0);
+    CHECK(Line[1] == 0);
+    CHECK(Line[2] == 32768);
+    CHECK(Line[3] == 0); // Band without a value
+
+    History.Add(Values + 3, 1);
+
+    CHECK(History.GetLine(0)[0] == spectrogram_history_t::MaxValue);
+}
+
+TEST_CASE(SpectrogramHistory, GrowsWithoutLosingLines)
+{
+    spectrogram_history_t History;
+
+    History.Initialize(4, 8);
+
+    AddLines(History, 1, 10); // Wraps around.
+
+    History.Resize(16);
+
+    CHECK(History.GetCapacity() == 16);
+    CHECK(History.GetCount() == 8);
+
+    for (size_t Age = 0; Age < 8; ++Age)
+        CHECK(GetLineNumber(History, Age) == 10 - Age);
+
+    AddLines(History, 11, 10);
+
+    CHECK(History.GetCount() == 16);
+    CHECK(GetLineNumber(History, 0) == 20);
+    CHECK(GetLineNumber(History, 15) == 5);
+}
+
+TEST_CASE(SpectrogramHistory, ShrinksToTheNewestLines)
+{
+    spectrogram_history_t History;
+
+    History.Initialize(4, 8);
+
+    AddLines(History, 1, 6);
+
+    History.Resize(4);
+
+    CHECK(History.GetCapacity() == 4);
+    CHECK(History.GetCount() == 4);
+
+    for (size_t Age = 0; Age < 4; ++Age)
+        CHECK(GetLineNumber(History, Age) == 6 - Age);
+
+    AddLines(History, 7, 1);
+
+    CHECK(History.GetCount() == 4);
+    CHECK(GetLineNumber(History, 0) == 7);
+    CHECK(GetLineNumber(History, 3) == 4);
+}
+
+TEST_CASE(SpectrogramHistory, KeepsAtLeastOneLine)
+{
+    spectrogram_history_t History;
+
+    History.Initialize(4, 8);
+
+    AddLines(History, 1, 3);
+
+    History.Resize(0);
+
+    CHECK(History.GetCapacity() == 1);
+    CHECK(History.GetCount() == 1);
+    CHECK(GetLineNumber(History, 0) == 3);
+}
@@ -0,0 +1,113 @@
+
+/** $VER: StageTimingsTests.cpp (2026.10.18) P. Stuer - Tests the percentiles of the stage timings. **/
+
+#include "Test.h"
+
+#include "StageTimings.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+/// <summary>
+/// Converts a duration (in µs) to ticks.
+/// </summary>
+static int64_t GetTicks(int64_t microseconds)
+{
+    return (int64_t) std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(microseconds)).count();
+}
+
+/// <summary>
+/// Returns true if the percentiles of the stage are the specified durations (in µs).
+/// </summary>
+static bool HasPercentiles(const stage_timings_t & timings, size_t stage, size_t count, int64_t p50, int64_t p95, int64_t p99)
+{
+    stage_timings_t::percentiles_t Percentiles;
+
+    if (!timings.GetPercentiles(stage, Percentiles))
+        return false;
+
+    auto IsNear = [](double value, int64_t expected) { return std::abs(value - (double) expected / 1000.) < 1e-9; };
+
+    return (Percentiles.Count == count) && IsNear(Percentiles.P50, p50) && IsNear(Percentiles.P95, p95) && IsNear(Percentiles.P99, p99);
+}
+
+TEST_CASE(StageTimings, HasNoPercentilesWithoutSamples)
+{
+    auto Timings = std::make_unique<stage_timings_t>();
+
+    stage_timings_t::percentiles_t Percentiles;
+
+    CHECK(!Timings->GetPercentiles((size_t) Stage::Fetch, Percentiles));
+    CHECK(Percentiles.Count == 0);
+
+    // Samples of unknown stages are ignored.
+    Timings->Add(stage_timings_t::StageCount, GetTicks(1));
+
+    CHECK(!Timings->GetPercentiles(stage_timings_t::StageCount, Percentiles));
+
+    // Each stage has its own ring.
+    Timings->Add((size_t) Stage::Transform, GetTicks(5));
+
+    CHECK(!Timings->GetPercentiles((size_t) Stage::Fetch, Percentiles));
+    CHECK(HasPercentiles(*Timings, (size_t) Stage::Transform, 1, 5, 5, 5));
+}
+
+TEST_CASE(StageTimings, UsesThePartlyFilledRing)
+{
+    auto Timings = std::make_unique<stage_timings_t>();
+
+    const size_t StageIndex = stage_timings_t::GetStageIndex(Stage::Graph, 2);
+
+    // 1 to 100 µs in random order. The percentiles only take the recorded samples into account, not the empty part of the ring.
+    std::vector<int64_t> Durations(100);
+
+    for (size_t i = 0; i < Durations.size(); ++i)
+        Durations[i] = (int64_t) i + 1;
+
+    std::shuffle(Durations.begin(), Durations.end(), std::mt19937(37));
+
+    for (int64_t Duration : Durations)
+        Timings->Add(StageIndex, GetTicks(Duration));
+
+    CHECK(HasPercentiles(*Timings, StageIndex, 100, 50, 95, 99));
+
+    // An outlier only adds a sample: it does not skew the percentiles.
+    Timings->Add(StageIndex, GetTicks(10000));
+
+    CHECK(HasPercentiles(*Timings, StageIndex, 101, 51, 96, 100));
+
+    // Negative durations count as 0.
+    Timings->Add((size_t) Stage::Present, -GetTicks(5));
+
+    CHECK(HasPercentiles(*Timings, (size_t) Stage::Present, 1, 0, 0, 0));
+}
+
+TEST_CASE(StageTimings, KeepsTheLastSamplesOfTheRing)
+{
+    auto Timings = std::make_unique<stage_timings_t>();
+
+    const size_t StageIndex = (size_t) Stage::Normalization;
+
+    // A full ring
+    for (int64_t i = 1; i <= (int64_t) stage_timings_t::RingSize; ++i)
+        Timings->Add(StageIndex, GetTicks(i));
+
+    CHECK(HasPercentiles(*Timings, StageIndex, 256, 128, 243, 253));
+
+    // The ring wraps around: only the last 256 samples, 345 to 600 µs, remain.
+    for (int64_t i = (int64_t) stage_timings_t::RingSize + 1; i <= 600; ++i)
+        Timings->Add(StageIndex, GetTicks(i));
+
+    CHECK(HasPercentiles(*Timings, StageIndex, 256, 345 + 127, 345 + 242, 345 + 252));
+
+    // Newer short durations replace the oldest samples, which are the shortest ones.
+    for (int64_t i = 0; i < 128; ++i)
+        Timings->Add(StageIndex, GetTicks(1));
+
+    // 128 samples of 1 µs and 473 to 600 µs
+    CHECK(HasPercentiles(*Timings, StageIndex, 256, 1, 473 + 114, 473 + 124));
+}
@@ -0,0 +1,96 @@
+
+/** $VER: Test.cpp (2026.10.18) P. Stuer - Implements a minimal test harness for the portable core. **/
+
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+
+size_t test_registry_t::_FailureCount = 0;
+
+/// <summary>
+/// Registers a test case. Called during static initialization.
+/// </summary>
+bool test_registry_t::Register(const char * suite, const char * name, void (* function)())
+{
+    GetTestCases().push_back({ suite, name, function });
+
+    return true;
+}
+
+/// <summary>
+/// Runs the test cases of the specified suite, or all test cases when no suite is specified. Returns the process exit code.
+/// </summary>
+int test_registry_t::Run(const char * suite)
+{
+    size_t TestCount = 0;
+    size_t FailedTestCount = 0;
+
+    for (const auto & TestCase : GetTestCases())
+    {
+        if ((suite != nullptr) && (::strcmp(suite, TestCase.Suite) != 0))
+            continue;
+
+        const size_t FailureCount = _FailureCount;
+
+        TestCase.Function();
+
+        const bool Passed = (_FailureCount == FailureCount);
+
+        ::printf("[%s] %s.%s\n", Passed ? "  OK  " : " FAIL ", TestCase.Suite, TestCase.Name);
+
+        ++TestCount;
+
+        if (!Passed)
+            ++FailedTestCount;
+    }
+
+    if (TestCount == 0)
+    {
+        ::printf("No test cases found.\n");
+
+        return 1;
+    }
+
+    ::printf("%zu of %zu test cases passed.\n", TestCount - FailedTestCount, TestCount);
+
+    return (FailedTestCount == 0) ? 0 : 1;
+}
+
+/// <summary>
+/// Reports a failed check.
+/// </summary>
+void test_registry_t::Fail(const char * file, int line, const char * expression)
+{
+    ::printf("%s(%d): Check failed: %s\n", file, line, expression);
+
+    ++_FailureCount;
+}
+
+/// <summary>
+/// Reports a value that is not within the tolerance of the expected value.
+/// </summary>
+void test_registry_t::FailNear(const char * file, int line, const char * expression, double value, double expected, double tolerance)
+{
+    ::printf("%s(%d): Check failed: %s is %.9g, expected %.9g +/- %.3g\n", file, line, expression, value, expected, tolerance);
+
+    ++_FailureCount;
+}
+
+/// <summary>
+/// Gets the registered test cases.
+/// </summary>
+std::vector<test_case_t> & test_registry_t::GetTestCases()
+{
+    static std::vector<test_case_t> TestCases;
+
+    return TestCases;
+}
+
+/// <summary>
+/// Entry point. The optional argument specifies the suite to run.
+/// </summary>
+int main(int argc, char * argv[])
+{
+    return test_registry_t::Run((argc > 1) ? argv[1] : nullptr);
+}
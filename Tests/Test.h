@@ -0,0 +1,61 @@
+
+/** $VER: Test.h (2026.10.18) P. Stuer - Implements a minimal test harness for the portable core. **/
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+/// <summary>
+/// Represents a test case. The suite groups the test cases of a component so they can be run separately.
+/// </summary>
+struct test_case_t
+{
+    const char * Suite;
+    const char * Name;
+    void (* Function)();
+};
+
+/// <summary>
+/// Implements the registry of the test cases and counts the failed checks.
+/// </summary>
+class test_registry_t
+{
+public:
+    static bool Register(const char * suite, const char * name, void (* function)());
+    static int Run(const char * suite);
+
+    static void Fail(const char * file, int line, const char * expression);
+    static void FailNear(const char * file, int line, const char * expression, double value, double expected, double tolerance);
+
+private:
+    static std::vector<test_case_t> & GetTestCases();
+
+    static size_t _FailureCount;
+};
+
+/// <summary>
+/// Defines and registers a test case.
+/// </summary>
+#define TEST_CASE(suite, name) \
+    static void suite##_##name(); \
+    static const bool suite##_##name##_Registered = test_registry_t::Register(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+/// <summary>
+/// Checks that the expression is true.
+/// </summary>
+#define CHECK(expression) \
+    do { if (!(expression)) test_registry_t::Fail(__FILE__, __LINE__, #expression); } while (0)
+
+/// <summary>
+/// Checks that a value is within the tolerance of the expected value.
+/// </summary>
+#define CHECK_NEAR(value, expected, tolerance) \
+    do \
+    { \
+        const double Value__ = (double) (value), Expected__ = (double) (expected), Tolerance__ = (double) (tolerance); \
+        if (!((Value__ >= Expected__ - Tolerance__) && (Value__ <= Expected__ + Tolerance__))) \
+            test_registry_t::FailNear(__FILE__, __LINE__, #value, Value__, Expected__, Tolerance__); \
+    } \
+    while (0)
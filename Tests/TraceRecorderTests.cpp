@@ -0,0 +1,231 @@
+
+/** $VER: TraceRecorderTests.cpp (2026.10.18) P. Stuer - Tests the trace recorder. **/
+
+#include "Test.h"
+
+#include "TraceRecorder.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE(TraceRecorder, RecordsNothingWhileStopped)
+{
+    trace_recorder_t Recorder(16);
+
+    Recorder.Begin("Frame");
+    Recorder.End("Frame");
+
+    trace_t Trace;
+
+    CHECK(Recorder.GetTrace(Trace));
+    CHECK(Trace.Events.empty());
+    CHECK(Trace.DroppedCount == 0);
+}
+
+TEST_CASE(TraceRecorder, RecordsBeginAndEndEvents)
+{
+    trace_recorder_t Recorder(16);
+
+    CHECK(Recorder.Start());
+    CHECK(Recorder.IsRecording());
+
+    {
+        scoped_trace_t Trace(Recorder, "Frame", 1.5);
+    }
+
+    Recorder.Stop();
+
+    CHECK(!Recorder.IsRecording());
+
+    // Events after the recording stopped are ignored.
+    Recorder.Begin("Late");
+
+    trace_t Trace;
+
+    CHECK(!Recorder.IsRecording() && Recorder.GetTrace(Trace));
+    CHECK(Trace.Events.size() == 2);
+
+    if (Trace.Events.size() == 2)
+    {
+        CHECK(Trace.Events[0].Phase == 'B');
+        CHECK(::strcmp(Trace.Events[0].Name, "Frame") == 0);
+        CHECK(Trace.Events[0].SampleTime == 1.5);
+
+        CHECK(Trace.Events[1].Phase == 'E');
+        CHECK(Trace.Events[1].Timestamp >= Trace.Events[0].Timestamp);
+        CHECK(Trace.Events[1].ThreadId == Trace.Events[0].ThreadId);
+    }
+}
+
+TEST_CASE(TraceRecorder, CannotCopyWhileRecording)
+{
+    trace_recorder_t Recorder(16);
+
+    CHECK(Recorder.Start());
+
+    trace_t Trace;
+
+    CHECK(!Recorder.GetTrace(Trace));
+
+    Recorder.Stop();
+}
+
+TEST_CASE(TraceRecorder, NamesEachThreadOncePerRecording)
+{
+    trace_recorder_t Recorder(16);
+
+    std::thread([&Recorder]()
+    {
+        trace_recorder_t::SetThreadName("Worker");
+
+        for (int Session = 0; Session < 2; ++Session)
+        {
+            Recorder.Start();
+
+            Recorder.Begin("A");
+            Recorder.End("A");
+
+            Recorder.Stop();
+        }
+    }).join();
+
+    trace_t Trace;
+
+    CHECK(Recorder.GetTrace(Trace));
+
+    // The second recording starts empty and names the thread again.
+    CHECK(Trace.Events.size() == 3);
+
+    if (Trace.Events.size() == 3)
+    {
+        CHECK(Trace.Events[0].Phase == 'M');
+        CHECK(::strcmp(Trace.Events[0].Name, "Worker") == 0);
+        CHECK(Trace.Events[1].Phase == 'B');
+        CHECK(Trace.Events[2].Phase == 'E');
+    }
+}
+
+TEST_CASE(TraceRecorder, DropsEventsThatDoNotFit)
+{
+    trace_recorder_t Recorder(4);
+
+    Recorder.Start();
+
+    for (int i = 0; i < 5; ++i)
+    {
+        Recorder.Begin("A");
+        Recorder.End("A");
+    }
+
+    Recorder.Stop();
+
+    trace_t Trace;
+
+    CHECK(Recorder.GetTrace(Trace));
+    CHECK(Trace.Events.size() == 4);
+    CHECK(Trace.DroppedCount == 6);
+}
+
+TEST_CASE(TraceRecorder, StopWaitsForTheWriters)
+{
+    static const char * const Names[] = { "Render", "Analysis", "Graph" };
+
+    trace_recorder_t Recorder(1024);
+
+    std::atomic<bool> IsDone = false;
+    std::vector<std::thread> Threads;
+
+    for (const char * Name : Names)
+    {
+        Threads.emplace_back([&Recorder, &IsDone, Name]()
+        {
+            trace_recorder_t::SetThreadName(Name);
+
+            while (!IsDone.load(std::memory_order_relaxed))
+            {
+                scoped_trace_t Trace(Recorder, Name);
+            }
+        });
+    }
+
+    // Start and stop while the threads record. Each trace must only contain complete events of its own recording.
+    for (int i = 0; i < 200; ++i)
+    {
+        Recorder.Start();
+
+        std::this_thread::yield();
+
+        Recorder.Stop();
+
+        trace_t Trace;
+
+        CHECK(Recorder.GetTrace(Trace));
+        CHECK(Trace.Events.size() <= 1024);
+
+        for (const trace_event_t & e : Trace.Events)
+        {
+            bool IsKnown = false;
+
+            for (const char * Name : Names)
+                IsKnown = IsKnown || (e.Name == Name);
+
+            CHECK(IsKnown);
+            CHECK((e.Phase == 'B') || (e.Phase == 'E') || (e.Phase == 'M'));
+            CHECK(e.Timestamp >= 0.);
+            CHECK(e.ThreadId != 0);
+        }
+    }
+
+    IsDone = true;
+
+    for (auto & Thread : Threads)
+        Thread.join();
+}
+
+TEST_CASE(TraceRecorder, SavesChromeTraceEvents)
+{
+    trace_recorder_t Recorder(16);
+
+    trace_recorder_t::SetThreadName("Main");
+
+    Recorder.Start();
+
+    {
+        scoped_trace_t Trace(Recorder, "Frame", 2.);
+    }
+
+    Recorder.Stop();
+
+    trace_t Trace;
+
+    CHECK(Recorder.GetTrace(Trace));
+
+    const std::filesystem::path FilePath = std::filesystem::temp_directory_path() / "TraceRecorderTests.json";
+
+    CHECK(Trace.Save(FilePath));
+
+    std::ifstream Stream(FilePath);
+    std::stringstream Text;
+
+    Text << Stream.rdbuf();
+
+    const std::string Json = Text.str();
+
+    CHECK(Json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+    CHECK(Json.find("{\"name\":\"thread_name\",\"ph\":\"M\"") != std::string::npos);
+    CHECK(Json.find("\"args\":{\"name\":\"Main\"}") != std::string::npos);
+    CHECK(Json.find("{\"name\":\"Frame\",\"ph\":\"B\"") != std::string::npos);
+    CHECK(Json.find("\"args\":{\"sample_time\":2.000000}") != std::string::npos);
+    CHECK(Json.find("{\"name\":\"Frame\",\"ph\":\"E\"") != std::string::npos);
+    CHECK(Json.find("\"otherData\":{\"dropped_events\":0}}") != std::string::npos);
+
+    Stream.close();
+
+    std::filesystem::remove(FilePath);
+}
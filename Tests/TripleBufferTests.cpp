@@ -0,0 +1,124 @@
+
+/** $VER: TripleBufferTests.cpp (2026.10.18) P. Stuer - Tests the lock-free triple buffer. **/
+
+#include "Test.h"
+
+#include "TripleBuffer.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE(TripleBuffer, TakesTheLastPublishedValue)
+{
+    triple_buffer_t<int> Buffer;
+
+    CHECK(!Buffer.Update());
+
+    Buffer.GetWriteBuffer() = 1;
+    Buffer.Publish();
+
+    Buffer.GetWriteBuffer() = 2;
+    Buffer.Publish();
+
+    CHECK(Buffer.Update());
+    CHECK(Buffer.GetReadBuffer() == 2);
+
+    CHECK(!Buffer.Update());
+    CHECK(Buffer.GetReadBuffer() == 2);
+}
+
+TEST_CASE(TripleBuffer, CirculatesTheBuffers)
+{
+    triple_buffer_t<std::vector<int>> Buffer;
+
+    std::vector<int> Producer(1000, 1);
+    std::vector<int> Consumer;
+
+    const int * Allocation = Producer.data();
+
+    // The producer swaps its data into the write buffer and the consumer swaps it out of the read buffer. No data is copied.
+    Buffer.GetWriteBuffer().swap(Producer);
+    Buffer.Publish();
+
+    CHECK(Buffer.Update());
+
+    Consumer.swap(Buffer.GetReadBuffer());
+
+    CHECK(Consumer.data() == Allocation);
+
+    // The buffer the consumer handed back reaches the producer after 2 more hand-offs.
+    Buffer.GetReadBuffer().swap(Consumer);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        Buffer.Publish();
+
+        CHECK(Buffer.Update());
+    }
+
+    CHECK(Buffer.GetWriteBuffer().data() == Allocation);
+}
+
+TEST_CASE(TripleBuffer, HandsOverCompleteFrames)
+{
+    const uint32_t FrameCount = 100000;
+    const size_t FrameSize = 256;
+
+    triple_buffer_t<std::vector<uint32_t>> Buffer;
+
+    // Every element of a frame is derived from its sequence number. A frame that is read while it is written has elements of different frames.
+    std::thread Writer([&Buffer, FrameCount, FrameSize]()
+    {
+        for (uint32_t Sequence = 1; Sequence <= FrameCount; ++Sequence)
+        {
+            std::vector<uint32_t> & Frame = Buffer.GetWriteBuffer();
+
+            Frame.resize(FrameSize);
+
+            for (size_t i = 0; i < FrameSize; ++i)
+                Frame[i] = Sequence + (uint32_t) i;
+
+            Buffer.Publish();
+        }
+    });
+
+    // The last frame is never replaced so the reader always receives it.
+    uint32_t LastSequence = 0;
+    size_t ReadCount = 0;
+    bool IsComplete = true;
+    bool IsNewer = true;
+
+    while (LastSequence != FrameCount)
+    {
+        if (!Buffer.Update())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const std::vector<uint32_t> & Frame = Buffer.GetReadBuffer();
+
+        if (Frame.size() != FrameSize)
+        {
+            IsComplete = false;
+            break;
+        }
+
+        const uint32_t Sequence = Frame[0];
+
+        for (size_t i = 0; i < FrameSize; ++i)
+            IsComplete = IsComplete && (Frame[i] == Sequence + (uint32_t) i);
+
+        IsNewer = IsNewer && (Sequence > LastSequence);
+
+        LastSequence = Sequence;
+        ++ReadCount;
+    }
+
+    Writer.join();
+
+    CHECK(IsComplete);
+    CHECK(IsNewer);
+    CHECK(LastSequence == FrameCount);
+    CHECK((ReadCount > 0) && (ReadCount <= FrameCount));
+}
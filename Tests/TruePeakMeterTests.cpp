@@ -0,0 +1,203 @@
+
+/** $VER: TruePeakMeterTests.cpp (2026.10.18) P. Stuer - Tests the true-peak meter with sines and inter-sample peaks against the tolerance of EBU Tech 3341. **/
+
+#include "Test.h"
+
+#include "TruePeakMeter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+static const uint32_t SampleRate    = 48000;
+static const uint32_t ChannelCount  = 2;
+static const uint32_t ChannelConfig = 0x3; // Front left and front right
+
+// EBU Tech 3341 requires true-peak meters to read within +0.2 dB and -0.4 dB of the true peak of its test signals.
+static const double MaxOverRead  = 0.2;
+static const double MaxUnderRead = 0.4;
+
+/// <summary>
+/// Converts an amplitude to dBTP.
+/// </summary>
+static double ToDecibel(double value)
+{
+    return 20. * std::log10(std::max(value, 1e-10));
+}
+
+/// <summary>
+/// Generates 1 second of stereo frames. The left channel contains a sine with the specified frequency, amplitude and phase (in degrees). The right channel is silent.
+/// </summary>
+static std::vector<audio_sample> GenerateSine(double frequency, double amplitude, double phase)
+{
+    std::vector<audio_sample> Frames(SampleRate * ChannelCount, 0);
+
+    for (size_t i = 0; i < SampleRate; ++i)
+        Frames[i * ChannelCount] = (audio_sample) (amplitude * std::sin((2. * M_PI * frequency * (double) i / (double) SampleRate) + (phase * M_PI / 180.)));
+
+    return Frames;
+}
+
+/// <summary>
+/// Measures the true peak of each channel of the frames, processed in chunks of the specified size. The chunks that start before the warm-up period
+/// are processed but not measured so the ringing of the filter at the abrupt start of a test signal is not counted.
+/// </summary>
+static void Measure(true_peak_meter_t & meter, const std::vector<audio_sample> & frames, size_t chunkSize, double truePeak[ChannelCount], size_t warmUp = 0)
+{
+    meter_plan_t Plan;
+
+    Plan.Build(ChannelCount, ChannelConfig, ChannelConfig, ChannelConfig);
+
+    meter_block_t Block = { };
+
+    const size_t FrameCount = frames.size() / ChannelCount;
+
+    std::fill(truePeak, truePeak + ChannelCount, 0.);
+
+    for (size_t i = 0; i < FrameCount; i += chunkSize)
+    {
+        const size_t n = std::min(chunkSize, FrameCount - i);
+
+        meter_kernel_t::Process(frames.data() + (i * ChannelCount), n, Plan, Block);
+        meter.Process(frames.data() + (i * ChannelCount), n, Plan, Block);
+
+        if (i < warmUp)
+            continue;
+
+        for (size_t j = 0; j < ChannelCount; ++j)
+            truePeak[j] = std::max(truePeak[j], Block.TruePeak[j]);
+    }
+}
+
+/// <summary>
+/// Measures the true peak of the left channel of the frames (in dBTP), skipping the first 100 ms.
+/// </summary>
+static double MeasureLeft(const std::vector<audio_sample> & frames)
+{
+    true_peak_meter_t Meter;
+
+    double TruePeak[ChannelCount];
+
+    Measure(Meter, frames, 800, TruePeak, SampleRate / 10);
+
+    return ToDecibel(TruePeak[0]);
+}
+
+TEST_CASE(TruePeakMeter, ReadsSinesWithinTolerance)
+{
+    // Sines of -6 dBFS at frequencies up to 15 kHz. The peaks of most of them fall between 2 samples.
+    const struct { double Frequency; double Phase; } Signals[] =
+    {
+        {   576., 0. },
+        {   997., 0. },
+        {  1920., 0. },
+        {  5000., 7. },
+        {  9600., 0. },
+        { 12000., 45. },
+        { 15000., 3. },
+    };
+
+    const double Expected = ToDecibel(0.5);
+
+    for (const auto & [Frequency, Phase] : Signals)
+    {
+        const double TruePeak = MeasureLeft(GenerateSine(Frequency, 0.5, Phase));
+
+        CHECK_NEAR(TruePeak, Expected + (MaxOverRead - MaxUnderRead) / 2., (MaxOverRead + MaxUnderRead) / 2.);
+    }
+}
+
+TEST_CASE(TruePeakMeter, DetectsInterSamplePeaks)
+{
+    // A sine at a quarter of the sample rate with a phase of 45 degrees: the samples are at 0.707 of the true peak (-3.01 dB).
+    {
+        const std::vector<audio_sample> Frames = GenerateSine(SampleRate / 4., 1., 45.);
+
+        CHECK_NEAR(std::abs(Frames[0]), std::sqrt(0.5), 1e-6);
+
+        CHECK_NEAR(MeasureLeft(Frames), 0. + (MaxOverRead - MaxUnderRead) / 2., (MaxOverRead + MaxUnderRead) / 2.);
+    }
+
+    // The sequence +a, +a, -a, -a is the same signal with a true peak of a √2 (+3.01 dB): a sample peak of -6.02 dBFS reads -3.01 dBTP.
+    {
+        std::vector<audio_sample> Frames(SampleRate * ChannelCount, 0);
+
+        for (size_t i = 0; i < SampleRate; ++i)
+            Frames[i * ChannelCount] = (audio_sample) (((i & 2) == 0) ? 0.5 : -0.5);
+
+        CHECK_NEAR(MeasureLeft(Frames), ToDecibel(0.5 * std::sqrt(2.)) + (MaxOverRead - MaxUnderRead) / 2., (MaxOverRead + MaxUnderRead) / 2.);
+    }
+}
+
+TEST_CASE(TruePeakMeter, NeverReadsLessThanTheSamplePeak)
+{
+    // A single full-scale sample. The interpolation filter passes it at 0.972 but the meter reports at least the sample peak.
+    std::vector<audio_sample> Frames(SampleRate * ChannelCount, 0);
+
+    Frames[10000 * ChannelCount] = 1;
+
+    CHECK(MeasureLeft(Frames) >= 0.);
+
+    // DC
+    std::fill(Frames.begin(), Frames.end(), (audio_sample) 0.5);
+
+    CHECK_NEAR(MeasureLeft(Frames), ToDecibel(0.5) + MaxOverRead / 2., MaxOverRead / 2.);
+}
+
+TEST_CASE(TruePeakMeter, KeepsTheHistoryBetweenChunks)
+{
+    std::vector<audio_sample> Frames = GenerateSine(997., 0.5, 0.);
+
+    std::mt19937 Generator(1);
+    std::uniform_real_distribution<double> Noise(-0.25, 0.25);
+
+    for (size_t i = 0; i < SampleRate; ++i)
+        Frames[i * ChannelCount + 1] = (audio_sample) Noise(Generator);
+
+    double Expected[ChannelCount];
+
+    {
+        true_peak_meter_t Meter;
+
+        Measure(Meter, Frames, SampleRate, Expected);
+    }
+
+    // The chunk size does not change the result: the filter continues with the last samples of the previous chunk.
+    for (size_t ChunkSize : { (size_t) 1, (size_t) 7, (size_t) 800, (size_t) 1023 })
+    {
+        true_peak_meter_t Meter;
+
+        double TruePeak[ChannelCount];
+
+        Measure(Meter, Frames, ChunkSize, TruePeak);
+
+        CHECK(TruePeak[0] == Expected[0]);
+        CHECK(TruePeak[1] == Expected[1]);
+    }
+}
+
+TEST_CASE(TruePeakMeter, ResetClearsTheHistory)
+{
+    const std::vector<audio_sample> Loud = GenerateSine(SampleRate / 4., 1., 45.);
+    const std::vector<audio_sample> Silence(64 * ChannelCount, 0);
+
+    true_peak_meter_t Meter;
+
+    double TruePeak[ChannelCount];
+
+    Measure(Meter, Loud, 800, TruePeak);
+
+    // The filter rings out the end of the previous chunk.
+    Measure(Meter, Silence, 64, TruePeak);
+
+    CHECK(TruePeak[0] > 0.);
+    CHECK(TruePeak[1] == 0.);
+
+    Measure(Meter, Loud, 800, TruePeak);
+
+    Meter.Reset();
+
+    Measure(Meter, Silence, 64, TruePeak);
+
+    CHECK(TruePeak[0] == 0.);
+}
@@ -0,0 +1,926 @@
+
+/** $VER: RenderSpectrogram.cpp (2026.10.18) P. Stuer - Renders the spectrogram of WAV and raw PCM files offline using the portable analysis core. **/
+
+#include "WindowFunctions.h"
+#include "BandProcessor.h"
+#include "FFTAnalyzer.h"
+#include "AmplitudeMap.h"
+#include "LineRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Identifies the format of the output files.
+/// </summary>
+enum class OutputFormat
+{
+    PNG = 0,
+    PPM,
+    F32,                                // Raw 32-bit float band matrix, one row of bands per line.
+};
+
+/// <summary>
+/// Represents the sample format of raw PCM input files. Raw samples are little-endian and interleaved.
+/// </summary>
+struct raw_format_t
+{
+    uint32_t SampleRate = 44100;
+    uint32_t ChannelCount = 2;
+    uint32_t BitsPerSample = 0;         // 0 = WAV input
+    bool IsFloat = false;
+};
+
+/// <summary>
+/// Represents the command line options.
+/// </summary>
+struct options_t
+{
+    double LinesPerSecond = 60.;        // Same as the default refresh rate of the component.
+    size_t FFTSize = 4096;
+    double BandsPerOctave = 12.;
+    double MinNote = 0.;                // C0
+    double MaxNote = 126.;              // F#10
+    double TuningPitch = 440.;
+    double AmplitudeLo = -90.;          // dB
+    double AmplitudeHi = 0.;            // dB
+    size_t Height = 0;                  // Pixels, 0 = one pixel per band
+    bool IsGray = false;                // Default: SoX color scheme
+    OutputFormat Format = OutputFormat::PNG;
+    bool IsRawValues = false;           // F32 only. Default: the normalized values
+    raw_format_t RawFormat;
+    size_t Jobs = 0;                    // 0 = one per hardware thread
+    std::string OutputDirectory;
+};
+
+/// <summary>
+/// Provides read-only access to the samples of a WAV or raw PCM file. The file is memory-mapped where available.
+/// </summary>
+#pragma warning(disable: 4820)
+class wave_file_t
+{
+public:
+    wave_file_t() noexcept : _Data(), _Size(), _IsMapped(), _Samples(), _FrameCount(), _SampleRate(), _ChannelCount(), _BitsPerSample(), _IsFloat() { }
+
+    wave_file_t(const wave_file_t &) = delete;
+    wave_file_t & operator=(const wave_file_t &) = delete;
+    wave_file_t(wave_file_t &&) = delete;
+    wave_file_t & operator=(wave_file_t &&) = delete;
+
+    ~wave_file_t() noexcept
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (_IsMapped)
+            ::munmap((void *) _Data, _Size);
+#endif
+    }
+
+    bool Open(const char * filePath, const raw_format_t & rawFormat, std::string & error);
+    void Read(size_t frameIndex, size_t frameCount, audio_sample * frames) const noexcept;
+
+    size_t GetFrameCount() const noexcept { return _FrameCount; }
+    uint32_t GetSampleRate() const noexcept { return _SampleRate; }
+    uint32_t GetChannelCount() const noexcept { return _ChannelCount; }
+
+private:
+    bool Parse(std::string & error) noexcept;
+
+    static uint16_t GetUInt16(const uint8_t * p) noexcept { return (uint16_t) (p[0] | (p[1] << 8)); }
+    static uint32_t GetUInt32(const uint8_t * p) noexcept { return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24); }
+
+private:
+    const uint8_t * _Data;
+    size_t _Size;
+    bool _IsMapped;
+    std::vector<uint8_t> _Buffer;       // Contains the file when it is not memory-mapped.
+
+    const uint8_t * _Samples;
+    size_t _FrameCount;
+    uint32_t _SampleRate;
+    uint32_t _ChannelCount;
+    uint32_t _BitsPerSample;
+    bool _IsFloat;
+};
+
+/// <summary>
+/// Opens the specified file. The file contains raw PCM samples in the specified format if the format has a sample size, otherwise it is a WAV file.
+/// </summary>
+bool wave_file_t::Open(const char * filePath, const raw_format_t & rawFormat, std::string & error)
+{
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = ::open(filePath, O_RDONLY);
+
+    if (fd != -1)
+    {
+        struct stat Stat;
+
+        if ((::fstat(fd, &Stat) == 0) && (Stat.st_size > 0))
+        {
+            void * p = ::mmap(nullptr, (size_t) Stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (p != MAP_FAILED)
+            {
+                _Data     = (const uint8_t *) p;
+                _Size     = (size_t) Stat.st_size;
+                _IsMapped = true;
+            }
+        }
+
+        ::close(fd);
+    }
+#endif
+
+    if (!_IsMapped)
+    {
+        FILE * fp = ::fopen(filePath, "rb");
+
+        if (fp == nullptr)
+        {
+            error = "unable to open the file";
+
+            return false;
+        }
+
+        uint8_t Chunk[65536];
+
+        for (size_t n; (n = ::fread(Chunk, 1, sizeof(Chunk), fp)) > 0; )
+            _Buffer.insert(_Buffer.end(), Chunk, Chunk + n);
+
+        ::fclose(fp);
+
+        _Data = _Buffer.data();
+        _Size = _Buffer.size();
+    }
+
+    if (rawFormat.BitsPerSample == 0)
+        return Parse(error);
+
+    _Samples       = _Data;
+    _SampleRate    = rawFormat.SampleRate;
+    _ChannelCount  = rawFormat.ChannelCount;
+    _BitsPerSample = rawFormat.BitsPerSample;
+    _IsFloat       = rawFormat.IsFloat;
+    _FrameCount    = _Size / (_ChannelCount * (_BitsPerSample / 8));
+
+    return true;
+}
+
+/// <summary>
+/// Parses the RIFF structure of the file. Supports PCM (8, 16, 24 and 32-bit) and IEEE floating point (32 and 64-bit) samples.
+/// </summary>
+bool wave_file_t::Parse(std::string & error) noexcept
+{
+    if ((_Size < 12) || (::memcmp(_Data, "RIFF", 4) != 0) || (::memcmp(_Data + 8, "WAVE", 4) != 0))
+    {
+        error = "not a WAV file";
+
+        return false;
+    }
+
+    bool HasFormat = false;
+
+    for (size_t Offset = 12; Offset + 8 <= _Size; )
+    {
+        const uint8_t * Chunk = _Data + Offset;
+        const size_t ChunkSize = std::min((size_t) GetUInt32(Chunk + 4), _Size - (Offset + 8));
+
+        if ((::memcmp(Chunk, "fmt ", 4) == 0) && (ChunkSize >= 16))
+        {
+            uint16_t FormatTag = GetUInt16(Chunk + 8);
+
+            _ChannelCount  = GetUInt16(Chunk + 10);
+            _SampleRate    = GetUInt32(Chunk + 12);
+            _BitsPerSample = GetUInt16(Chunk + 22);
+
+            // WAVE_FORMAT_EXTENSIBLE: the format is the first 2 bytes of the sub-format GUID.
+            if ((FormatTag == 0xFFFE) && (ChunkSize >= 40))
+                FormatTag = GetUInt16(Chunk + 32);
+
+            _IsFloat = (FormatTag == 3);
+
+            if (((FormatTag != 1) && (FormatTag != 3)) || (_ChannelCount == 0) || (_ChannelCount > 32) || (_SampleRate == 0))
+            {
+                error = "unsupported sample format";
+
+                return false;
+            }
+
+            if ((_IsFloat && (_BitsPerSample != 32) && (_BitsPerSample != 64)) || (!_IsFloat && ((_BitsPerSample % 8) != 0 || (_BitsPerSample == 0) || (_BitsPerSample > 32))))
+            {
+                error = "unsupported sample size";
+
+                return false;
+            }
+
+            HasFormat = true;
+        }
+        else
+        if ((::memcmp(Chunk, "data", 4) == 0) && HasFormat)
+        {
+            _Samples    = Chunk + 8;
+            _FrameCount = ChunkSize / (_ChannelCount * (_BitsPerSample / 8));
+
+            return true;
+        }
+
+        Offset += 8 + ChunkSize + (ChunkSize & 1);
+    }
+
+    error = HasFormat ? "no sample data" : "no format chunk";
+
+    return false;
+}
+
+/// <summary>
+/// Reads the specified frames and converts them to interleaved audio samples between -1.0 and 1.0.
+/// </summary>
+void wave_file_t::Read(size_t frameIndex, size_t frameCount, audio_sample * frames) const noexcept
+{
+    const size_t BytesPerSample = _BitsPerSample / 8;
+    const size_t SampleCount = frameCount * _ChannelCount;
+
+    const uint8_t * p = _Samples + (frameIndex * _ChannelCount * BytesPerSample);
+
+    if (_IsFloat)
+    {
+        for (size_t i = 0; i < SampleCount; ++i, p += BytesPerSample)
+        {
+            if (BytesPerSample == 4)
+            {
+                float Value; ::memcpy(&Value, p, sizeof(Value));
+
+                frames[i] = (audio_sample) Value;
+            }
+            else
+            {
+                double Value; ::memcpy(&Value, p, sizeof(Value));
+
+                frames[i] = (audio_sample) Value;
+            }
+        }
+    }
+    else
+    if (BytesPerSample == 1)
+    {
+        // 8-bit samples are unsigned.
+        for (size_t i = 0; i < SampleCount; ++i, ++p)
+            frames[i] = (audio_sample) (((int) *p - 128) / 128.);
+    }
+    else
+    {
+        // Shift the sample into the most significant bytes of a 32-bit integer to extend the sign.
+        const double Scale = 1. / 2147483648.;
+
+        for (size_t i = 0; i < SampleCount; ++i, p += BytesPerSample)
+        {
+            uint32_t Value = 0;
+
+            for (size_t j = 0; j < BytesPerSample; ++j)
+                Value |= (uint32_t) p[j] << (8 * (4 - BytesPerSample + j));
+
+            frames[i] = (audio_sample) ((double) (int32_t) Value * Scale);
+        }
+    }
+}
+
+/// <summary>
+/// Generates the frequency bands of the Octaves frequency distribution, the default of the component.
+/// </summary>
+static frequency_bands_t GenerateFrequencyBands(const options_t & options)
+{
+    band_config_t Config;
+
+    Config.Distribution   = FrequencyDistribution::Octaves;
+    Config.BandsPerOctave = options.BandsPerOctave;
+    Config.MinNote        = options.MinNote;
+    Config.MaxNote        = options.MaxNote;
+    Config.TuningPitch    = options.TuningPitch;
+
+    frequency_bands_t Bands;
+
+    band_processor_t::Generate(Config, Bands);
+
+    return Bands;
+}
+
+/// <summary>
+/// Gets the scale of the amplitudes: decibels in the range of the options, like the spectrogram of the component.
+/// </summary>
+static amplitude_scale_t GetAmplitudeScale(const options_t & options) noexcept
+{
+    amplitude_scale_t Scale;
+
+    Scale.Mode        = YAxisMode::Decibels;
+    Scale.AmplitudeLo = options.AmplitudeLo;
+    Scale.AmplitudeHi = options.AmplitudeHi;
+
+    return Scale;
+}
+
+/// <summary>
+/// Creates the pixels the amplitudes are mapped to.
+/// </summary>
+static std::vector<uint32_t> CreatePixelMap(const options_t & options)
+{
+    // White maps to the highest amplitudes, black to the lowest. The SoX colors are calculated from a formula instead.
+    static const amplitude_gradient_stop_t Stops[] =
+    {
+        { 0.f, { 1.f, 1.f, 1.f, 1.f } },
+        { 1.f, { 0.f, 0.f, 0.f, 1.f } },
+    };
+
+    std::vector<amplitude_color_t> Colors;
+
+    amplitude_map_t::Create(Stops, std::size(Stops), !options.IsGray, Colors);
+
+    std::vector<uint32_t> Pixels;
+
+    amplitude_map_t::CreatePixels(Colors.data(), Colors.size(), 1.f, Pixels);
+
+    return Pixels;
+}
+
+/// <summary>
+/// Gets the position of the frame that ends the analysis window of the specified line.
+/// </summary>
+static size_t GetLineEnd(size_t line, uint32_t sampleRate, double linesPerSecond) noexcept
+{
+    return (size_t) std::llround((double) (line + 1) * (double) sampleRate / linesPerSecond);
+}
+
+/// <summary>
+/// Renders the lines of a segment of the spectrogram. Each line is stored as a column of the image, with the lowest frequency at the bottom, or as a row of the band matrix.
+/// The analyzer is first fed the frames that precede the segment: its ring buffer holds exactly one FFT of frames so the result is the same as rendering the file in one pass.
+/// </summary>
+static void RenderSegment(const wave_file_t & file, const options_t & options, const window_function_t & window, const std::vector<uint32_t> & pixelMap, size_t lineLo, size_t lineHi, size_t width, size_t height, uint32_t * image, float * matrix)
+{
+    const uint32_t ChannelCount  = file.GetChannelCount();
+    const uint32_t ChannelConfig = (ChannelCount < 32) ? (1u << ChannelCount) - 1u : ~0u;
+
+    analysis_config_t Config;
+
+    fft_analyzer_t Analyzer(&Config, file.GetSampleRate(), ChannelCount, ChannelConfig, window, window, options.FFTSize);
+
+    frequency_bands_t Bands = GenerateFrequencyBands(options);
+
+    const amplitude_scale_t Scale = GetAmplitudeScale(options);
+
+    std::vector<audio_sample> Frames;
+
+    size_t Position = (lineLo == 0) ? 0 : GetLineEnd(lineLo - 1, file.GetSampleRate(), options.LinesPerSecond);
+
+    // Warm up the analyzer.
+    if (Position > 0)
+    {
+        const size_t First = (Position > options.FFTSize) ? Position - options.FFTSize : 0;
+
+        Frames.resize((Position - First) * ChannelCount);
+
+        file.Read(First, Position - First, Frames.data());
+
+        Analyzer.AnalyzeSamples(Frames.data(), Position - First, ChannelConfig, Bands);
+    }
+
+    std::vector<uint16_t> Values(Bands.size());
+    std::vector<uint32_t> Colors(Bands.size());
+
+    line_rasterizer_t Rasterizer;
+
+    const double BandSize = (double) height / (double) Bands.size();
+
+    for (size_t Line = lineLo; Line < lineHi; ++Line)
+    {
+        const size_t End = std::min(GetLineEnd(Line, file.GetSampleRate(), options.LinesPerSecond), file.GetFrameCount());
+
+        Frames.resize((End - Position) * ChannelCount);
+
+        file.Read(Position, End - Position, Frames.data());
+
+        Analyzer.AnalyzeSamples(Frames.data(), End - Position, ChannelConfig, Bands);
+
+        Position = End;
+
+        // Same normalization as the spectrogram of the component. Each line is normalized on its own.
+        band_processor_t::Normalize(Scale, SmoothingMethod::None, 0., Bands);
+
+        if (matrix != nullptr)
+        {
+            float * Row = matrix + (Line * Bands.size());
+
+            for (size_t i = 0; i < Bands.size(); ++i)
+                Row[i] = (float) (options.IsRawValues ? Bands[i].RawValue : Bands[i].Value);
+
+            continue;
+        }
+
+        // Same quantization as the spectrogram of the component.
+        for (size_t i = 0; i < Bands.size(); ++i)
+            Values[i] = (uint16_t) (Bands[i].Value * 65535. + 0.5);
+
+        amplitude_map_t::GetPixels(pixelMap.data(), pixelMap.size(), Values.data(), Values.size(), Colors.data());
+
+        const uint32_t * Pixels = Rasterizer.Rasterize(Colors.data(), Colors.size(), 0., BandSize, height, 1, false);
+
+        for (size_t y = 0; y < height; ++y)
+            image[((height - 1 - y) * width) + Line] = Pixels[y];
+    }
+}
+
+/// <summary>
+/// Calculates the CRC-32 of PNG chunks.
+/// </summary>
+static uint32_t UpdateCRC32(uint32_t crc, const uint8_t * data, size_t size) noexcept
+{
+    static uint32_t Table[256];
+
+    if (Table[1] == 0)
+    {
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+
+            Table[i] = c;
+        }
+    }
+
+    crc = ~crc;
+
+    for (size_t i = 0; i < size; ++i)
+        crc = Table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+/// <summary>
+/// Appends a 32-bit big-endian integer.
+/// </summary>
+static void PutUInt32(std::vector<uint8_t> & data, uint32_t value)
+{
+    data.push_back((uint8_t) (value >> 24));
+    data.push_back((uint8_t) (value >> 16));
+    data.push_back((uint8_t) (value >>  8));
+    data.push_back((uint8_t)  value);
+}
+
+/// <summary>
+/// Writes a PNG chunk.
+/// </summary>
+static bool WriteChunk(FILE * fp, const char * type, const std::vector<uint8_t> & data)
+{
+    std::vector<uint8_t> Header;
+
+    PutUInt32(Header, (uint32_t) data.size());
+    Header.insert(Header.end(), type, type + 4);
+
+    uint32_t CRC = UpdateCRC32(0, Header.data() + 4, 4);
+
+    CRC = UpdateCRC32(CRC, data.data(), data.size());
+
+    std::vector<uint8_t> Trailer;
+
+    PutUInt32(Trailer, CRC);
+
+    return (::fwrite(Header.data(), 1, Header.size(), fp) == Header.size()) && (::fwrite(data.data(), 1, data.size(), fp) == data.size()) && (::fwrite(Trailer.data(), 1, Trailer.size(), fp) == Trailer.size());
+}
+
+/// <summary>
+/// Writes the image as an 8-bit RGB PNG. The image data is stored uncompressed: the file is meant to be processed further, not archived.
+/// </summary>
+static bool WritePNG(FILE * fp, const uint32_t * image, size_t width, size_t height)
+{
+    static const uint8_t Signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    if (::fwrite(Signature, 1, sizeof(Signature), fp) != sizeof(Signature))
+        return false;
+
+    std::vector<uint8_t> Data;
+
+    PutUInt32(Data, (uint32_t) width);
+    PutUInt32(Data, (uint32_t) height);
+    Data.insert(Data.end(), { 8, 2, 0, 0, 0 }); // 8-bit, RGB, deflate, adaptive filtering, no interlace
+
+    if (!WriteChunk(fp, "IHDR", Data))
+        return false;
+
+    // Each row starts with a filter type byte (none).
+    std::vector<uint8_t> Raw;
+
+    Raw.reserve(height * (1 + width * 3));
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        Raw.push_back(0);
+
+        for (size_t x = 0; x < width; ++x)
+        {
+            const uint32_t Pixel = image[(y * width) + x];
+
+            Raw.push_back((uint8_t) (Pixel >> 16));
+            Raw.push_back((uint8_t) (Pixel >>  8));
+            Raw.push_back((uint8_t)  Pixel);
+        }
+    }
+
+    // Wrap the rows in a zlib stream of stored deflate blocks.
+    Data.clear();
+    Data.reserve(Raw.size() + (Raw.size() / 65535 + 1) * 5 + 6);
+
+    Data.push_back(0x78);
+    Data.push_back(0x01);
+
+    uint32_t a = 1, b = 0;
+
+    for (size_t Offset = 0; Offset < Raw.size() || Offset == 0; )
+    {
+        const size_t Size = std::min(Raw.size() - Offset, (size_t) 65535);
+        const bool IsLast = (Offset + Size == Raw.size());
+
+        Data.push_back(IsLast ? 1 : 0);
+        Data.push_back((uint8_t)  Size);
+        Data.push_back((uint8_t) (Size >> 8));
+        Data.push_back((uint8_t) ~Size);
+        Data.push_back((uint8_t) (~Size >> 8));
+
+        Data.insert(Data.end(), Raw.begin() + (ptrdiff_t) Offset, Raw.begin() + (ptrdiff_t) (Offset + Size));
+
+        for (size_t i = Offset; i < Offset + Size; ++i)
+        {
+            a = (a + Raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+
+        Offset += Size;
+
+        if (IsLast)
+            break;
+    }
+
+    PutUInt32(Data, (b << 16) | a);
+
+    return WriteChunk(fp, "IDAT", Data) && WriteChunk(fp, "IEND", { });
+}
+
+/// <summary>
+/// Writes the image as a binary PPM.
+/// </summary>
+static bool WritePPM(FILE * fp, const uint32_t * image, size_t width, size_t height)
+{
+    ::fprintf(fp, "P6\n%zu %zu\n255\n", width, height);
+
+    std::vector<uint8_t> Row(width * 3);
+
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            const uint32_t Pixel = image[(y * width) + x];
+
+            Row[x * 3 + 0] = (uint8_t) (Pixel >> 16);
+            Row[x * 3 + 1] = (uint8_t) (Pixel >>  8);
+            Row[x * 3 + 2] = (uint8_t)  Pixel;
+        }
+
+        if (::fwrite(Row.data(), 1, Row.size(), fp) != Row.size())
+            return false;
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Writes the band matrix as raw native-endian 32-bit floats: one row per line, from the first line to the last, with the lowest band first.
+/// </summary>
+static bool WriteF32(FILE * fp, const float * matrix, size_t lineCount, size_t bandCount)
+{
+    return ::fwrite(matrix, sizeof(float) * bandCount, lineCount, fp) == lineCount;
+}
+
+/// <summary>
+/// Gets the file name extension of the output format.
+/// </summary>
+static const char * GetExtension(OutputFormat format) noexcept
+{
+    switch (format)
+    {
+        default:
+
+        case OutputFormat::PNG: return ".png";
+        case OutputFormat::PPM: return ".ppm";
+        case OutputFormat::F32: return ".f32";
+    }
+}
+
+/// <summary>
+/// Renders the spectrogram of a file. The lines are divided into segments that are rendered in parallel.
+/// </summary>
+static bool RenderFile(const char * filePath, const options_t & options, const window_function_t & window, const std::vector<uint32_t> & pixelMap)
+{
+    wave_file_t File;
+    std::string Error;
+
+    if (!File.Open(filePath, options.RawFormat, Error))
+    {
+        ::fprintf(stderr, "%s: %s\n", filePath, Error.c_str());
+
+        return false;
+    }
+
+    const size_t Width = (size_t) ((double) File.GetFrameCount() * options.LinesPerSecond / (double) File.GetSampleRate());
+    const size_t BandCount = GenerateFrequencyBands(options).size();
+    const size_t Height = (options.Height != 0) ? options.Height : BandCount;
+
+    if ((Width == 0) || (BandCount == 0))
+    {
+        ::fprintf(stderr, "%s: too short\n", filePath);
+
+        return false;
+    }
+
+    const bool IsMatrix = (options.Format == OutputFormat::F32);
+
+    std::vector<uint32_t> Image(IsMatrix ? 0 : Width * Height);
+    std::vector<float> Matrix(IsMatrix ? Width * BandCount : 0);
+
+    const size_t JobCount = std::min((options.Jobs != 0) ? options.Jobs : (size_t) std::max(std::thread::hardware_concurrency(), 1u), Width);
+
+    {
+        std::vector<std::thread> Threads;
+
+        for (size_t i = 0; i < JobCount; ++i)
+        {
+            const size_t LineLo = (Width *  i)      / JobCount;
+            const size_t LineHi = (Width * (i + 1)) / JobCount;
+
+            Threads.emplace_back(RenderSegment, std::cref(File), std::cref(options), std::cref(window), std::cref(pixelMap), LineLo, LineHi, Width, Height, Image.data(), IsMatrix ? Matrix.data() : nullptr);
+        }
+
+        for (auto & Thread : Threads)
+            Thread.join();
+    }
+
+    // Name the image after the file.
+    std::string OutputPath(filePath);
+
+    {
+        const size_t Slash = OutputPath.find_last_of("/\\");
+        const size_t Dot = OutputPath.find_last_of('.');
+
+        if ((Dot != std::string::npos) && ((Slash == std::string::npos) || (Dot > Slash)))
+            OutputPath.resize(Dot);
+
+        if (!options.OutputDirectory.empty())
+            OutputPath = options.OutputDirectory + "/" + ((Slash != std::string::npos) ? OutputPath.substr(Slash + 1) : OutputPath);
+
+        OutputPath += GetExtension(options.Format);
+    }
+
+    FILE * fp = ::fopen(OutputPath.c_str(), "wb");
+
+    if (fp == nullptr)
+    {
+        ::fprintf(stderr, "%s: unable to create the file\n", OutputPath.c_str());
+
+        return false;
+    }
+
+    bool Success;
+
+    switch (options.Format)
+    {
+        default:
+
+        case OutputFormat::PNG: Success = WritePNG(fp, Image.data(), Width, Height); break;
+        case OutputFormat::PPM: Success = WritePPM(fp, Image.data(), Width, Height); break;
+        case OutputFormat::F32: Success = WriteF32(fp, Matrix.data(), Width, BandCount); break;
+    }
+
+    Success = (::fclose(fp) == 0) && Success;
+
+    if (!Success)
+    {
+        ::fprintf(stderr, "%s: unable to write the file\n", OutputPath.c_str());
+
+        return false;
+    }
+
+    if (IsMatrix)
+        ::printf("%s: %zu lines x %zu bands, %u Hz, %u channels, %zu threads -> %s\n", filePath, Width, BandCount, File.GetSampleRate(), File.GetChannelCount(), JobCount, OutputPath.c_str());
+    else
+        ::printf("%s: %zu x %zu pixels, %u Hz, %u channels, %zu threads -> %s\n", filePath, Width, Height, File.GetSampleRate(), File.GetChannelCount(), JobCount, OutputPath.c_str());
+
+    return true;
+}
+
+/// <summary>
+/// Parses a range of the form lo:hi.
+/// </summary>
+static bool ParseRange(const char * text, double & lo, double & hi) noexcept
+{
+    char * End = nullptr;
+
+    lo = std::strtod(text, &End);
+
+    if (*End != ':')
+        return false;
+
+    hi = std::strtod(End + 1, &End);
+
+    return (*End == '\0') && (hi > lo);
+}
+
+/// <summary>
+/// Parses a raw sample format: u8, s16, s24, s32, f32 or f64.
+/// </summary>
+static bool ParseSampleFormat(const char * text, raw_format_t & format) noexcept
+{
+    const struct { const char * Name; uint32_t BitsPerSample; bool IsFloat; } Formats[] =
+    {
+        { "u8",   8, false },
+        { "s16", 16, false },
+        { "s24", 24, false },
+        { "s32", 32, false },
+        { "f32", 32, true },
+        { "f64", 64, true },
+    };
+
+    for (const auto & [Name, BitsPerSample, IsFloat] : Formats)
+    {
+        if (::strcmp(text, Name) == 0)
+        {
+            format.BitsPerSample = BitsPerSample;
+            format.IsFloat       = IsFloat;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Prints the usage.
+/// </summary>
+static void Usage() noexcept
+{
+    ::fprintf(stderr,
+        "Usage: render_spectrogram [options] file...\n"
+        "  --fps n               Lines per second (60)\n"
+        "  --fft n               FFT size, a power of 2 (4096)\n"
+        "  --bands-per-octave n  Frequency bands per octave (12)\n"
+        "  --notes lo:hi         Range of the frequency bands as MIDI notes (0:126)\n"
+        "  --pitch f             Tuning pitch in Hz (440)\n"
+        "  --range lo:hi         Amplitude range in dB (-90:0)\n"
+        "  --height n            Height of the image in pixels (one pixel per band)\n"
+        "  --colors sox|gray     Color scheme (sox)\n"
+        "  --format png|ppm|f32  Output format (png). f32 writes the band matrix as raw 32-bit floats, one row of bands per line\n"
+        "  --values norm|raw     Values of the f32 band matrix: normalized to [0, 1] or the raw amplitudes (norm)\n"
+        "  --raw u8|s16|s24|s32|f32|f64\n"
+        "                        Read the files as raw little-endian interleaved PCM in the specified format (WAV)\n"
+        "  --rate n              Sample rate of raw files in Hz (44100)\n"
+        "  --channels n          Number of channels of raw files (2)\n"
+        "  --jobs n              Number of threads (one per hardware thread)\n"
+        "  --output dir          Directory of the images (the directory of each file)\n");
+}
+
+/// <summary>
+/// Entry point. Renders the spectrogram of each file to an image or a band matrix with the same name.
+/// </summary>
+int main(int argc, char * argv[])
+{
+    options_t Options;
+
+    std::vector<const char *> FilePaths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string Arg(argv[i]);
+
+        if (Arg.rfind("--", 0) != 0)
+        {
+            FilePaths.push_back(argv[i]);
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            Usage();
+
+            return 1;
+        }
+
+        const char * Value = argv[++i];
+
+        bool IsValid = true;
+
+        if (Arg == "--fps")
+            IsValid = (Options.LinesPerSecond = std::atof(Value)) > 0.;
+        else
+        if (Arg == "--fft")
+        {
+            Options.FFTSize = (size_t) std::atol(Value);
+            IsValid = (Options.FFTSize >= 64) && ((Options.FFTSize & (Options.FFTSize - 1)) == 0);
+        }
+        else
+        if (Arg == "--bands-per-octave")
+            IsValid = (Options.BandsPerOctave = std::atof(Value)) > 0.;
+        else
+        if (Arg == "--notes")
+            IsValid = ParseRange(Value, Options.MinNote, Options.MaxNote);
+        else
+        if (Arg == "--pitch")
+            IsValid = (Options.TuningPitch = std::atof(Value)) > 0.;
+        else
+        if (Arg == "--range")
+            IsValid = ParseRange(Value, Options.AmplitudeLo, Options.AmplitudeHi);
+        else
+        if (Arg == "--height")
+            IsValid = (Options.Height = (size_t) std::atol(Value)) > 0;
+        else
+        if (Arg == "--colors")
+            IsValid = (Options.IsGray = (::strcmp(Value, "gray") == 0)) || (::strcmp(Value, "sox") == 0);
+        else
+        if (Arg == "--format")
+        {
+            if (::strcmp(Value, "png") == 0)
+                Options.Format = OutputFormat::PNG;
+            else
+            if (::strcmp(Value, "ppm") == 0)
+                Options.Format = OutputFormat::PPM;
+            else
+            if (::strcmp(Value, "f32") == 0)
+                Options.Format = OutputFormat::F32;
+            else
+                IsValid = false;
+        }
+        else
+        if (Arg == "--values")
+            IsValid = (Options.IsRawValues = (::strcmp(Value, "raw") == 0)) || (::strcmp(Value, "norm") == 0);
+        else
+        if (Arg == "--raw")
+            IsValid = ParseSampleFormat(Value, Options.RawFormat);
+        else
+        if (Arg == "--rate")
+            IsValid = (Options.RawFormat.SampleRate = (uint32_t) std::atol(Value)) > 0;
+        else
+        if (Arg == "--channels")
+        {
+            Options.RawFormat.ChannelCount = (uint32_t) std::atol(Value);
+            IsValid = (Options.RawFormat.ChannelCount > 0) && (Options.RawFormat.ChannelCount <= 32);
+        }
+        else
+        if (Arg == "--jobs")
+            IsValid = (Options.Jobs = (size_t) std::atol(Value)) > 0;
+        else
+        if (Arg == "--output")
+            Options.OutputDirectory = Value;
+        else
+            IsValid = false;
+
+        if (!IsValid)
+        {
+            ::fprintf(stderr, "Invalid option: %s %s\n", Arg.c_str(), Value);
+            Usage();
+
+            return 1;
+        }
+    }
+
+    if (FilePaths.empty())
+    {
+        Usage();
+
+        return 1;
+    }
+
+    // Same defaults as the component.
+    std::unique_ptr<window_function_t> Window(window_function_t::Create(WindowFunction::Hann, 1., 0., true));
+
+    const std::vector<uint32_t> PixelMap = CreatePixelMap(Options);
+
+    int Result = 0;
+
+    for (const char * FilePath : FilePaths)
+    {
+        if (!RenderFile(FilePath, Options, *Window, PixelMap))
+            Result = 1;
+    }
+
+    return Result;
+}
@@ -0,0 +1,182 @@
+
+/** $VER: TraceRecorder.cpp (2026.10.18) P. Stuer - Records begin and end events of the render and analysis threads in the Chrome trace event format. **/
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <new>
+#include <thread>
+
+trace_recorder_t _TraceRecorder;
+
+static std::atomic<uint32_t> _NextThreadId = 1;
+
+static thread_local uint32_t _ThreadId = 0;             // Sequential id of the calling thread. Assigned when the thread records its first event.
+static thread_local const char * _ThreadName = nullptr;
+static thread_local uint32_t _ThreadSession = 0;        // Recording in which the name of the calling thread was recorded.
+
+/// <summary>
+/// Starts a new recording. The events of the previous recording are discarded. Returns false if the buffer could not be allocated.
+/// </summary>
+bool trace_recorder_t::Start() noexcept
+{
+    if (IsRecording())
+        return true;
+
+    if (_Events == nullptr)
+    {
+        _Events.reset(new (std::nothrow) trace_event_t[_Capacity]);
+
+        if (_Events == nullptr)
+            return false;
+    }
+
+    _Count.store(0, std::memory_order_relaxed);
+    _Session.fetch_add(1, std::memory_order_relaxed);
+    _Start = std::chrono::steady_clock::now();
+
+    _IsRecording.store(true, std::memory_order_seq_cst);
+
+    return true;
+}
+
+/// <summary>
+/// Stops the recording and waits until the threads that are adding an event are done. The events are kept until the next recording starts.
+/// </summary>
+void trace_recorder_t::Stop() noexcept
+{
+    _IsRecording.store(false, std::memory_order_seq_cst);
+
+    // A thread that announced itself before the store completes its event. A thread that announces itself later sees that the recorder is stopped.
+    while (_WriterCount.load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
+}
+
+/// <summary>
+/// Copies the events of the last recording. The recorder must be stopped.
+/// </summary>
+bool trace_recorder_t::GetTrace(trace_t & trace) const noexcept
+{
+    if (IsRecording())
+        return false;
+
+    try
+    {
+        const size_t Count = _Count.load(std::memory_order_relaxed);
+        const size_t Size = (_Events != nullptr) ? std::min(Count, _Capacity) : 0;
+
+        trace.Events.assign(_Events.get(), _Events.get() + Size);
+        trace.DroppedCount = Count - Size;
+
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
+/// <summary>
+/// Sets the name of the calling thread in the trace. The name must be a string with static storage duration.
+/// </summary>
+void trace_recorder_t::SetThreadName(const char * name) noexcept
+{
+    _ThreadName = name;
+    _ThreadSession = 0;
+}
+
+/// <summary>
+/// Adds an event if the recorder is still running.
+/// </summary>
+void trace_recorder_t::Add(char phase, const char * name, double sampleTime) noexcept
+{
+    // Announce the event before checking the recorder again so Stop() waits for it.
+    _WriterCount.fetch_add(1, std::memory_order_seq_cst);
+
+    if (_IsRecording.load(std::memory_order_seq_cst))
+    {
+        const double Timestamp = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _Start).count();
+
+        if (_ThreadId == 0)
+            _ThreadId = _NextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+        // Record the name of the thread with its first event of this recording.
+        const uint32_t Session = _Session.load(std::memory_order_relaxed);
+
+        if ((_ThreadSession != Session) && (_ThreadName != nullptr))
+        {
+            _ThreadSession = Session;
+
+            Write('M', _ThreadName, NoSampleTime, Timestamp);
+        }
+
+        Write(phase, name, sampleTime, Timestamp);
+    }
+
+    _WriterCount.fetch_sub(1, std::memory_order_release);
+}
+
+/// <summary>
+/// Writes an event in the buffer. Events that do not fit are dropped.
+/// </summary>
+void trace_recorder_t::Write(char phase, const char * name, double sampleTime, double timestamp) noexcept
+{
+    const size_t Index = _Count.fetch_add(1, std::memory_order_relaxed);
+
+    if (Index >= _Capacity)
+        return;
+
+    trace_event_t & e = _Events[Index];
+
+    e.Name       = name;
+    e.Timestamp  = timestamp;
+    e.SampleTime = sampleTime;
+    e.ThreadId   = _ThreadId;
+    e.Phase      = phase;
+}
+
+/// <summary>
+/// Saves the events to the specified file as Chrome trace event JSON.
+/// </summary>
+bool trace_t::Save(const std::filesystem::path & filePath) const noexcept
+{
+    try
+    {
+        std::ofstream Stream(filePath, std::ios::out | std::ios::trunc);
+
+        if (!Stream)
+            return false;
+
+        Stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        bool IsFirst = true;
+
+        char Line[256];
+
+        for (const trace_event_t & e : Events)
+        {
+            if (e.Phase == 'M')
+                ::snprintf(Line, sizeof(Line), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}", IsFirst ? "" : ",", e.ThreadId, e.Name);
+            else
+            if (std::isfinite(e.SampleTime))
+                ::snprintf(Line, sizeof(Line), "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"sample_time\":%.6f}}", IsFirst ? "" : ",", e.Name, e.Phase, e.Timestamp, e.ThreadId, e.SampleTime);
+            else
+                ::snprintf(Line, sizeof(Line), "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", IsFirst ? "" : ",", e.Name, e.Phase, e.Timestamp, e.ThreadId);
+
+            Stream << Line;
+
+            IsFirst = false;
+        }
+
+        Stream << "\n],\"otherData\":{\"dropped_events\":" << DroppedCount << "}}\n";
+
+        return (bool) Stream;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
@@ -0,0 +1,136 @@
+
+/** $VER: TraceRecorder.h (2026.10.18) P. Stuer - Records begin and end events of the render and analysis threads in the Chrome trace event format. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Represents a recorded event.
+/// </summary>
+#pragma warning(disable: 4820)
+struct trace_event_t
+{
+    const char * Name;                      // Must be a string with static storage duration.
+    double Timestamp;                       // Time since the start of the recording (in μs)
+    double SampleTime;                      // Position in the audio stream (in seconds). NaN if the event has none.
+    uint32_t ThreadId;
+    char Phase;                             // 'B' = Begin, 'E' = End, 'M' = Thread name
+};
+
+/// <summary>
+/// Contains a copy of the events of a recording. Can be saved by any thread while the recorder starts a new recording.
+/// </summary>
+class trace_t
+{
+public:
+    bool Save(const std::filesystem::path & filePath) const noexcept;
+
+    std::vector<trace_event_t> Events;
+    size_t DroppedCount = 0;                // Number of events that did not fit in the buffer of the recorder.
+};
+
+/// <summary>
+/// Implements a trace recorder. Any thread can record begin and end events while the recorder is running. The events are kept in a buffer of fixed size
+/// that is allocated when the first recording starts; events that do not fit are dropped. Recording costs an atomic load per event while the recorder is stopped.
+/// Stop() waits until no thread is adding an event so the buffer, the start time and the counters are never written by a late thread of the previous recording.
+/// Start(), Stop() and GetTrace() must be called by the same thread. Portable: does not depend on Windows.
+/// </summary>
+class trace_recorder_t
+{
+public:
+    explicit trace_recorder_t(size_t capacity = DefaultCapacity) noexcept : _IsRecording(false), _Capacity(capacity), _Count(), _WriterCount(), _Session(), _Start() { }
+
+    trace_recorder_t(const trace_recorder_t &) = delete;
+    trace_recorder_t & operator=(const trace_recorder_t &) = delete;
+    trace_recorder_t(trace_recorder_t &&) = delete;
+    trace_recorder_t & operator=(trace_recorder_t &&) = delete;
+
+    bool Start() noexcept;
+    void Stop() noexcept;
+    bool GetTrace(trace_t & trace) const noexcept;
+
+    /// <summary>
+    /// Returns true while the recorder is running.
+    /// </summary>
+    bool IsRecording() const noexcept
+    {
+        return _IsRecording.load(std::memory_order_acquire);
+    }
+
+    /// <summary>
+    /// Records the start of an activity of the calling thread. The sample time (in seconds) is the position in the audio stream the activity relates to, if any.
+    /// </summary>
+    void Begin(const char * name, double sampleTime = NoSampleTime) noexcept
+    {
+        if (IsRecording())
+            Add('B', name, sampleTime);
+    }
+
+    /// <summary>
+    /// Records the end of the last activity of the calling thread.
+    /// </summary>
+    void End(const char * name) noexcept
+    {
+        if (IsRecording())
+            Add('E', name, NoSampleTime);
+    }
+
+    static void SetThreadName(const char * name) noexcept;
+
+public:
+    static const size_t DefaultCapacity = 1 << 17;                  // Number of events (32 bytes each)
+    static constexpr double NoSampleTime = std::numeric_limits<double>::quiet_NaN();
+
+private:
+    void Add(char phase, const char * name, double sampleTime) noexcept;
+    void Write(char phase, const char * name, double sampleTime, double timestamp) noexcept;
+
+    std::atomic<bool> _IsRecording;
+
+    std::unique_ptr<trace_event_t[]> _Events;
+    const size_t _Capacity;
+    std::atomic<size_t> _Count;             // Number of events that were reserved, including the dropped events.
+    std::atomic<size_t> _WriterCount;       // Number of threads that are adding an event.
+
+    std::atomic<uint32_t> _Session;         // Incremented at the start of each recording. Used to record the name of each thread once per recording.
+    std::chrono::steady_clock::time_point _Start;
+};
+
+/// <summary>
+/// Records a begin event when constructed and the matching end event when destroyed.
+/// </summary>
+class scoped_trace_t
+{
+public:
+    scoped_trace_t(trace_recorder_t & recorder, const char * name, double sampleTime = trace_recorder_t::NoSampleTime) noexcept : _Recorder(recorder), _Name(name)
+    {
+        _Recorder.Begin(_Name, sampleTime);
+    }
+
+    ~scoped_trace_t() noexcept
+    {
+        _Recorder.End(_Name);
+    }
+
+    scoped_trace_t(const scoped_trace_t &) = delete;
+    scoped_trace_t & operator=(const scoped_trace_t &) = delete;
+    scoped_trace_t(scoped_trace_t &&) = delete;
+    scoped_trace_t & operator=(scoped_trace_t &&) = delete;
+
+private:
+    trace_recorder_t & _Recorder;
+    const char * _Name;
+};
+
+extern trace_recorder_t _TraceRecorder;
@@ -1,5 +1,5 @@
 
-/** $VER: UIElement.cpp (2026.01.21) P. Stuer - UIElement methods that run on the UI thread. **/
+/** $VER: UIElement.cpp (2026.10.18) P. Stuer - UIElement methods that run on the UI thread. **/
 
 #include "pch.h"
 
@@ -13,13 +13,14 @@
 
 #include "Error.h"
 #include "PresetManager.h"
+#include "TraceRecorder.h"
 
 #pragma hdrstop
 
 /// <summary>
 /// Initializes a new instance.
 /// </summary>
-uielement_t::uielement_t(): _IsFullScreen(false), _IsVisible(true), _IsInitializing(true), _DPI(), _DisplayRefreshRate(), _hStopRendering(), _hThread(), _TrackingGraph(), _TrackingToolInfo(), _LastMousePos(), _LastBandIndex(~0U)
+uielement_t::uielement_t(): _IsFullScreen(false), _IsVisible(true), _IsInitializing(true), _PendingConfiguration(), _PublishedConfiguration(), _DPI(), _DisplayRefreshRate(), _hStopRendering(), _hThread(), _TrackingGraph(), _TrackingToolInfo(), _LastMousePos(), _LastBandIndex(~0U), _AnalysisGeneration(), _AnalysisResetFlags(), _GovernedFrameRate(), _AnalyzedGeneration(), _AnalysisPlaybackTime(), _AnalysisSampleRate(), _AnalysisSleepTime(), _AnalysisThreadId(), _hAnalysisThread(), _hTraceThread()
 {
 }
 
@@ -118,6 +119,7 @@ LRESULT uielement_t::OnCreate(LPCREATESTRUCT cs)
 void uielement_t::OnDestroy()
 {
     StopRenderer();
+    WaitForTraceThread();
 
     ::CloseHandle(_hStopRendering);
 
@@ -197,6 +199,8 @@ void uielement_t::OnSize(UINT type, CSize size)
 
     _CriticalSection.Leave();
 
+    _Event.Raise(event_t::StateChanged);
+
 //  ::InvalidateRect(m_hWnd, nullptr, FALSE); // Force a repaint.
 }
 
@@ -218,6 +222,8 @@ void uielement_t::OnContextMenu(CWindow wnd, CPoint position)
         Menu.AppendMenu((UINT) MF_SEPARATOR);
         Menu.AppendMenu((UINT) MF_STRING, IDM_TOGGLE_FULLSCREEN, L"Toggle Full-Screen Mode");
         Menu.AppendMenu((UINT) MF_STRING | (_UIState._ShowFrameCounter ? MF_CHECKED : 0), IDM_TOGGLE_FRAME_COUNTER, L"Frame Counter");
+        Menu.AppendMenu((UINT) MF_STRING, IDM_DUMP_STAGE_TIMINGS, L"Dump Frame Timings");
+        Menu.AppendMenu((UINT) MF_STRING | (_TraceRecorder.IsRecording() ? MF_CHECKED : 0), IDM_TOGGLE_TRACE_RECORDING, L"Record Trace");
 
         {
             RefreshRateLimitMenu.CreatePopupMenu();
@@ -273,6 +279,14 @@ void uielement_t::OnContextMenu(CWindow wnd, CPoint position)
             ToggleHardwareRendering();
             break;
 
+        case IDM_DUMP_STAGE_TIMINGS:
+            DumpStageTimings();
+            break;
+
+        case IDM_TOGGLE_TRACE_RECORDING:
+            ToggleTraceRecording();
+            break;
+
         case IDM_REFRESH_RATE_LIMIT_20:
             _UIState._RefreshRateLimit =
             _RenderState._RefreshRateLimit = 20; // Near-atomic
@@ -411,8 +425,10 @@ void uielement_t::Resize()
     // Reposition the frame counter.
     _FrameCounter.Resize(SizeF.width, SizeF.height);
 
-    // Resize the grid.
+    // Resize the grid. The render thread can recreate the graphs at any time outside the critical section.
     {
+        _CriticalSection.Enter();
+
         for (auto & Iter : _Grid)
         {
             TTTOOLINFOW ti;
@@ -421,15 +437,9 @@ void uielement_t::Resize()
             _ToolTipControl.DelTool(&ti);
         }
 
-        {
-            _CriticalSection.Enter();
-
-            _Grid.Resize(SizeF.width, SizeF.height);
+        _Grid.Resize(SizeF.width, SizeF.height);
 
-            _RenderState._StyleManager.DeleteGradientBrushes();
-
-            _CriticalSection.Leave();
-        }
+        _RenderState._StyleManager.DeleteGradientBrushes();
 
         for (auto & Iter : _Grid)
         {
@@ -438,6 +448,8 @@ void uielement_t::Resize()
             Iter._Graph->InitToolInfo(m_hWnd, ti);
             _ToolTipControl.AddTool(&ti);
         }
+
+        _CriticalSection.Leave();
     }
 }
 
@@ -477,36 +489,59 @@ void uielement_t::OnColorsChanged()
 /// </summary>
 LRESULT uielement_t::OnConfigurationChanged(UINT uMsg, WPARAM wParam, LPARAM lParam)
 {
-    UpdateState((ConfigurationChanges) wParam);
+    auto Changes = (ConfigurationChanges) wParam;
+
+    // Narrow a full reconfiguration down to the subsystems that are affected by the settings that actually changed.
+    if ((Changes == ConfigurationChanges::All) && (_PublishedConfiguration != nullptr))
+        Changes = _UIState.GetChanges(_PublishedConfiguration->State);
+
+    if (Changes == ConfigurationChanges::None)
+        return 0;
+
+    UpdateState(Changes);
 
     return 0;
 }
 
 /// <summary>
-/// Starts the render thread.
+/// Starts the render thread and the analysis thread.
 /// </summary>
 void uielement_t::StartRenderer() noexcept
 {
     assert(_hThread == NULL);
+    assert(_hAnalysisThread == NULL);
 
     _ThreadId = 0;
+    _AnalysisThreadId = 0;
+
+    // The analysis thread never reads the UI state or the render state without a lock. Hand it the settings it needs to start.
+    _GovernedFrameRate.store((double) _UIState._RefreshRateLimit, std::memory_order_relaxed);
+    _AnalysisSleepTime = _UIState._SleepTime;
 
+    _hAnalysisThread = ::CreateThread(nullptr, 0, CallAnalysisThreadProc, this, 0, &_AnalysisThreadId);
     _hThread = ::CreateThread(nullptr, 0, CallRenderThreadProc, this, 0, &_ThreadId);
 }
 
 /// <summary>
-/// Stops the render thread.
+/// Stops the render thread and the analysis thread.
 /// </summary>
 void uielement_t::StopRenderer() noexcept
 {
-    if (_hThread == NULL)
-        return;
-
     ::SetEvent(_hStopRendering);
 
-    ::WaitForSingleObject(_hThread, INFINITE);
+    if (_hThread != NULL)
+    {
+        ::WaitForSingleObject(_hThread, INFINITE);
+
+        ::CloseHandle(_hThread), _hThread = NULL;
+    }
 
-    ::CloseHandle(_hThread), _hThread = NULL;
+    if (_hAnalysisThread != NULL)
+    {
+        ::WaitForSingleObject(_hAnalysisThread, INFINITE);
+
+        ::CloseHandle(_hAnalysisThread), _hAnalysisThread = NULL;
+    }
 }
 
 /// <summary>
@@ -515,6 +550,8 @@ void uielement_t::StopRenderer() noexcept
 void uielement_t::ToggleFrameCounter() noexcept
 {
     _UIState._ShowFrameCounter = !_UIState._ShowFrameCounter;
+
+    UpdateState(ConfigurationChanges::RenderLoop);
 }
 
 /// <summary>
@@ -528,89 +565,189 @@ void uielement_t::ToggleHardwareRendering() noexcept
 }
 
 /// <summary>
-/// Shows the configuration dialog.
+/// Writes the percentiles of the duration of the stages of a frame to the console.
 /// </summary>
-void uielement_t::Configure() noexcept
+void uielement_t::DumpStageTimings() const noexcept
 {
-    if (!_ConfigurationDialog.IsWindow())
+    Log.AtInfo().Write(STR_COMPONENT_BASENAME " frame timings (last %d samples per stage, in ms):", (int) stage_timings_t::RingSize);
+
+    for (size_t i = 0; i < stage_timings_t::StageCount; ++i)
     {
-        dialog_parameters_t dp = { m_hWnd, &_UIState };
+        stage_timings_t::percentiles_t p;
 
-        if (_ConfigurationDialog.Create(m_hWnd, (LPARAM) &dp) != NULL)
-            _ConfigurationDialog.ShowWindow(SW_SHOW);
+        if (_StageTimings.GetPercentiles(i, p))
+            Log.AtInfo().Write("%-16s p50 %7.3f  p95 %7.3f  p99 %7.3f  (%d samples)", stage_timings_t::GetStageName(i).c_str(), p.P50, p.P95, p.P99, (int) p.Count);
     }
-    else
-        _ConfigurationDialog.BringWindowToTop();
 }
 
 /// <summary>
-/// Updates the state.
+/// Represents a trace that is saved by the trace thread.
 /// </summary>
-void uielement_t::UpdateState(ConfigurationChanges settings) noexcept
+struct trace_file_t
 {
-    if (settings == ConfigurationChanges::All)
+    trace_t Trace;
+    std::filesystem::path FilePath;
+};
+
+/// <summary>
+/// Starts recording a trace of the render and analysis threads or stops the recording and saves the trace to a file in the temporary directory.
+/// The events are copied on the UI thread and written by a separate thread.
+/// </summary>
+void uielement_t::ToggleTraceRecording() noexcept
+{
+    if (!_TraceRecorder.IsRecording())
     {
-        DeleteTrackingToolTip();
+        if (_TraceRecorder.Start())
+            Log.AtInfo().Write(STR_COMPONENT_BASENAME " started recording a trace.");
+        else
+            Log.AtError().Write(STR_COMPONENT_BASENAME " failed to allocate the trace buffer.");
 
-        for (auto & Iter : _Grid)
-        {
-            TTTOOLINFOW ti;
+        return;
+    }
 
-            Iter._Graph->InitToolInfo(m_hWnd, ti);
-            _ToolTipControl.DelTool(&ti);
-        }
+    _TraceRecorder.Stop();
+
+    // Only one trace is written at a time.
+    WaitForTraceThread();
+
+    trace_file_t * TraceFile = new (std::nothrow) trace_file_t;
+
+    if (TraceFile == nullptr)
+        return;
+
+    TraceFile->FilePath = GetTemporaryFilePath(L".json");
+
+    if (TraceFile->FilePath.empty() || !_TraceRecorder.GetTrace(TraceFile->Trace))
+    {
+        delete TraceFile;
+        return;
     }
 
-    _CriticalSection.Enter();
+    _hTraceThread = ::CreateThread(nullptr, 0, SaveTraceThreadProc, TraceFile, 0, nullptr);
 
+    if (_hTraceThread == NULL)
     {
-        _RenderState = _UIState; // Copies only the settings that are relevant for rendering.
+        Log.AtError().Write(STR_COMPONENT_BASENAME " failed to start the trace thread.");
 
-        if (settings == ConfigurationChanges::All)
-        {
-            _RenderState._SampleRate = 0;
-            _RenderState._StyleManager.DeleteDeviceSpecificResources();
+        delete TraceFile;
+    }
+}
 
-            // Recreate the resources that depend on the artwork.
-            CreateArtworkDependentResources();
+/// <summary>
+/// Saves a trace. Runs on the trace thread and takes ownership of the trace.
+/// </summary>
+DWORD WINAPI uielement_t::SaveTraceThreadProc(LPVOID context) noexcept
+{
+    const trace_file_t * TraceFile = (const trace_file_t *) context;
 
-            // Create the graphs.
-            {
-                for (auto & Iter : _Grid)
-                    delete Iter._Graph;
+    if (TraceFile->Trace.Save(TraceFile->FilePath))
+        Log.AtInfo().Write(STR_COMPONENT_BASENAME " saved trace to \"%s\" (%d events dropped).", (const char *) TraceFile->FilePath.u8string().c_str(), (int) TraceFile->Trace.DroppedCount);
+    else
+        Log.AtError().Write(STR_COMPONENT_BASENAME " failed to save trace to \"%s\".", (const char *) TraceFile->FilePath.u8string().c_str());
 
-                _Grid.clear();
+    delete TraceFile;
 
-                _Grid.Initialize(_RenderState._GridRowCount, _RenderState._GridColumnCount);
+    return 0;
+}
 
-                for (const auto & GraphDescription : _RenderState._GraphDescriptions)
-                {
-                    auto * Graph = new graph_t();
+/// <summary>
+/// Waits until the trace thread has saved the last trace.
+/// </summary>
+void uielement_t::WaitForTraceThread() noexcept
+{
+    if (_hTraceThread == NULL)
+        return;
 
-                    Graph->Initialize(&_RenderState, &GraphDescription, nullptr);
+    ::WaitForSingleObject(_hTraceThread, INFINITE);
 
-                    _Grid.push_back({ Graph, GraphDescription._HRatio, GraphDescription._VRatio });
-                }
-            }
-        }
+    ::CloseHandle(_hTraceThread), _hTraceThread = NULL;
+}
+
+/// <summary>
+/// Gets the path of a new file in the temporary directory. The name of the file contains the current date and time and ends with the specified suffix.
+/// </summary>
+std::filesystem::path uielement_t::GetTemporaryFilePath(const WCHAR * suffix) noexcept
+{
+    WCHAR DirectoryPath[MAX_PATH] = { };
+
+    if (::GetTempPathW(_countof(DirectoryPath), DirectoryPath) == 0)
+        return { };
+
+    SYSTEMTIME st;
+
+    ::GetLocalTime(&st);
+
+    WCHAR FileName[MAX_PATH] = { };
+
+    if (FAILED(::StringCchPrintfW(FileName, _countof(FileName), TEXT(STR_COMPONENT_BASENAME) L"-%04d%02d%02d-%02d%02d%02d%s", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond, suffix)))
+        return { };
+
+    return std::filesystem::path(DirectoryPath) / FileName;
+}
+
+/// <summary>
+/// Shows the configuration dialog.
+/// </summary>
+void uielement_t::Configure() noexcept
+{
+    if (!_ConfigurationDialog.IsWindow())
+    {
+        dialog_parameters_t dp = { m_hWnd, &_UIState };
+
+        if (_ConfigurationDialog.Create(m_hWnd, (LPARAM) &dp) != NULL)
+            _ConfigurationDialog.ShowWindow(SW_SHOW);
     }
+    else
+        _ConfigurationDialog.BringWindowToTop();
+}
 
-    _CriticalSection.Leave();
+/// <summary>
+/// Publishes a snapshot of the configuration. The render thread adopts it at the start of its next frame. Neither thread waits for the other.
+/// </summary>
+void uielement_t::UpdateState(ConfigurationChanges settings) noexcept
+{
+    auto Snapshot = std::make_shared<configuration_snapshot_t>();
+
+    // Only the UI thread writes the settings of the UI state that are copied. The artwork colors, which the render thread updates, are not part of the snapshot.
+    Snapshot->State = _UIState; // Copies only the settings that are relevant for rendering.
+
+    // Replace the snapshot that was not adopted yet, if any, but keep its changes.
+    std::shared_ptr<const configuration_snapshot_t> Pending = _PendingConfiguration.load();
 
-    if (settings == ConfigurationChanges::All)
+    do
     {
-        for (auto & Iter : _Grid)
-        {
-            TTTOOLINFOW ti;
+        Snapshot->Changes = (Pending != nullptr) ? (settings | Pending->Changes) : settings;
+    }
+    while (!_PendingConfiguration.compare_exchange_weak(Pending, Snapshot));
 
-            Iter._Graph->InitToolInfo(m_hWnd, ti);
-            _ToolTipControl.AddTool(&ti);
-        }
+    _PublishedConfiguration = Snapshot;
 
-        _ToolTipControl.Activate(_RenderState._ShowToolTipsAlways);
+    _Event.Raise(event_t::StateChanged);
+}
 
-        Resize();
+/// <summary>
+/// Handles the UM_GRAPHS_CHANGED message from the render thread.
+/// </summary>
+LRESULT uielement_t::OnGraphsChanged(UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    _CriticalSection.Enter();
+
+    DeleteTrackingToolTip();
+
+    for (auto & Iter : _Grid)
+    {
+        TTTOOLINFOW ti;
+
+        Iter._Graph->InitToolInfo(m_hWnd, ti);
+        _ToolTipControl.DelTool(&ti);
+        _ToolTipControl.AddTool(&ti);
     }
+
+    _ToolTipControl.Activate(_UIState._ShowToolTipsAlways);
+
+    _CriticalSection.Leave();
+
+    return 0;
 }
 
 /// <summary>
@@ -653,8 +790,6 @@ void uielement_t::on_playback_stop(play_control::t_stop_reason reason)
 {
     _Artwork.DeleteWICResources();
 
-    _UIState._SampleRate = 0;
-
     // Notify the render thread.
     _Event.Raise(event_t::PlaybackStopped);
 }
@@ -1,5 +1,5 @@
 
-/** $VER: UIElement.h (2026.03.13) P. Stuer **/
+/** $VER: UIElement.h (2026.10.18) P. Stuer **/
 
 #pragma once
 
@@ -8,12 +8,16 @@
 #include "State.h"
 #include "ConfigurationDialog.h"
 #include "Event.h"
+#include "VisualisationStream.h"
 
 #include "Grid.h"
 #include "Graph.h"
 #include "Artwork.h"
 #include "FrameCounter.h"
 
+#include <atomic>
+#include <filesystem>
+#include <memory>
 #include <vector>
 
 /// <summary>
@@ -73,6 +77,7 @@ private:
     void OnMouseLeave();
 
     LRESULT OnConfigurationChanged(UINT uMsg, WPARAM wParam, LPARAM lParam);
+    LRESULT OnGraphsChanged(UINT uMsg, WPARAM wParam, LPARAM lParam);
 
     #pragma endregion
 
@@ -95,17 +100,26 @@ private:
     void StopRenderer() noexcept;
 
     static DWORD WINAPI CallRenderThreadProc(LPVOID context) noexcept;
+    static DWORD WINAPI CallAnalysisThreadProc(LPVOID context) noexcept;
 
     virtual void ToggleFullScreen() noexcept = 0; // Handled by DUIElement and CUIElement
 
     void ToggleFrameCounter() noexcept;
     void ToggleHardwareRendering() noexcept;
+    void DumpStageTimings() const noexcept;
+    void ToggleTraceRecording() noexcept;
+    void WaitForTraceThread() noexcept;
+
+    static DWORD WINAPI SaveTraceThreadProc(LPVOID context) noexcept;
+
+    static std::filesystem::path GetTemporaryFilePath(const WCHAR * suffix) noexcept;
 
     void Configure() noexcept;
     void Resize();
 
     // Tool Tips
     void CreateToolTipControl() noexcept;
+    void UpdateToolTip(CPoint pt) noexcept;
     void DeleteTrackingToolTip() noexcept;
     graph_t * GetGraph(const CPoint & pt) noexcept;
 
@@ -135,6 +149,7 @@ private:
         MSG_WM_MOUSELEAVE(OnMouseLeave) // Required for tracking tooltip
 
         MESSAGE_HANDLER_EX(UM_CONFIGURATION_CHANGED, OnConfigurationChanged)
+        MESSAGE_HANDLER_EX(UM_GRAPHS_CHANGED, OnGraphsChanged)
     END_MSG_MAP()
 
     #pragma endregion
@@ -146,12 +161,11 @@ private:
 
     void RenderThreadProc() noexcept;
 
-    void ProcessEvents() noexcept;
+    void AdoptConfiguration() noexcept;
+    bool ProcessEvents() noexcept;
+    double ProcessFrames() noexcept;
     void Render() noexcept;
-    void ProcessAudio() noexcept;
-    void Animate() noexcept;
-
-    void InitializeSampleRateDependentParameters(const audio_chunk_impl & chunk) noexcept;
+    bool Animate() noexcept;
 
     HRESULT CreateDeviceIndependentResources() noexcept;
     void DeleteDeviceIndependentResources() noexcept;
@@ -164,11 +178,23 @@ private:
 
     #pragma endregion
 
+    // These methods run on the analysis thread.
+    #pragma region Analysis thread
+
+    void AnalysisThreadProc() noexcept;
+
+    void ProcessAudio() noexcept;
+
+    void InitializeSampleRateDependentParameters(const audio_chunk_impl & chunk) noexcept;
+
+    #pragma endregion
+
 protected:
     state_t _UIState;
     state_t _RenderState;
 
     msc::critical_section_t _CriticalSection;
+    msc::critical_section_t _AnalysisCriticalSection;   // Protects the graphs and the render state against changes by the UI thread while the analysis thread processes audio.
 //  ConfigurationDialog _ConfigurationDialog;
     configuration_dialog_t _ConfigurationDialog;
     configuration_dialog_t _NewConfigurationDialog;
@@ -185,6 +211,11 @@ private:
 
     artwork_t _Artwork;
 
+    std::atomic<std::shared_ptr<const configuration_snapshot_t>> _PendingConfiguration; // Last configuration published by the UI thread that was not adopted by the render thread yet.
+    std::shared_ptr<const configuration_snapshot_t> _PublishedConfiguration;             // Last configuration published by the UI thread. UI thread only.
+
+    stage_timings_t _StageTimings;  // Durations of the stages of the analysis and the rendering. Each stage is recorded by one thread.
+
     #pragma endregion
 
     #pragma region Render thread
@@ -214,7 +245,6 @@ private:
     CComPtr<ID2D1SolidColorBrush> _DebugBrush;
 #endif
 
-    visualisation_stream_v2::ptr _VisualisationStream;
     bool _IsFrozen;                 // True if the component should stop rendering the spectrum.
 
     frame_counter_t _FrameCounter;
@@ -222,6 +252,24 @@ private:
 
     #pragma endregion
 
+    #pragma region Analysis thread
+
+    visualisation_stream_v2::ptr _VisualisationStream;
+    visualisation_audio_stream_t _AudioStream { _VisualisationStream };
+    audio_source_t _AudioSource;    // Keeps the history of the visualisation stream and only fetches the frames that were not fetched before.
+    std::shared_ptr<audio_chunk_impl> _Chunks[4];   // The graphs and their frames keep a reference to a chunk instead of a copy. A chunk that is not referenced anymore is reused.
+
+    std::atomic<uint64_t> _AnalysisGeneration;      // Incremented by the render thread to make the analysis thread start over. Frames of a previous generation are dropped.
+    std::atomic<uint32_t> _AnalysisResetFlags;      // Playback events that caused the last increment of the generation.
+    std::atomic<double> _GovernedFrameRate;         // Frame rate chosen by the frame rate governor of the render thread. The analysis thread follows it.
+
+    uint64_t _AnalyzedGeneration;   // Generation of the frames produced by the analysis thread.
+    double _AnalysisPlaybackTime;   // Playback time of the last analyzed chunk (in seconds).
+    uint32_t _AnalysisSampleRate;   // Sample rate of the last analyzed chunk. 0 when unknown.
+    int64_t _AnalysisSleepTime;     // Taken from the UI state before the analysis thread starts (in μs).
+
+    #pragma endregion
+
     #pragma region UI thread
 
     enum
@@ -238,6 +286,8 @@ private:
 
         IDM_CONFIGURE,
         IDM_FREEZE,
+        IDM_DUMP_STAGE_TIMINGS,
+        IDM_TOGGLE_TRACE_RECORDING,
 
         IDM_PRESET_NAME,
     };
@@ -245,6 +295,9 @@ private:
     HANDLE _hStopRendering;
     DWORD _ThreadId;
     HANDLE _hThread;
+    DWORD _AnalysisThreadId;
+    HANDLE _hAnalysisThread;
+    HANDLE _hTraceThread;                   // Saves the last trace.
 
     CToolTipCtrl _ToolTipControl;
 
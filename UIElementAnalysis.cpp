@@ -0,0 +1,221 @@
+
+/** $VER: UIElementAnalysis.cpp (2026.10.18) P. Stuer - UIElement methods that run on the analysis thread. **/
+
+#include "pch.h"
+#include "UIElement.h"
+
+#include "WaitableTimerClock.h"
+#include "TraceRecorder.h"
+
+#include "Log.h"
+
+#pragma hdrstop
+
+static bool GetAudioChunk(audio_chunk & chunk, uint32_t sampleRate = 44100, uint32_t frameCount = 1024);
+
+/// <summary>
+/// Analysis thread procedure. Processes the audio at the refresh rate, independent of the render thread.
+/// </summary>
+void uielement_t::AnalysisThreadProc() noexcept
+{
+    waitable_timer_clock_t Clock(_hStopRendering);
+    frame_pacer_t Pacer(Clock);
+
+    Pacer.Start(_GovernedFrameRate.load(std::memory_order_relaxed), (_AnalysisSleepTime * Clock.GetFrequency()) / 1'000'000);
+
+    stage_timings_t::Attach(&_StageTimings);
+    trace_recorder_t::SetThreadName("Analysis");
+
+    for (;;)
+    {
+        if (!Pacer.WaitForNextFrame())
+            break;
+
+        if (::WaitForSingleObject(_hStopRendering, 0) == WAIT_OBJECT_0)
+            break;
+
+        if (!(_IsFrozen || !_IsVisible || ::IsIconic(::GetParent(m_hWnd))))
+        {
+            if (_AnalysisCriticalSection.TryEnter())
+            {
+                if (IsWindowVisible())
+                    ProcessAudio();
+
+                _AnalysisCriticalSection.Leave();
+            }
+        }
+
+        // Follow the frame rate chosen by the frame rate governor of the render thread. There is no point in producing frames the render thread does not take.
+        Pacer.SetFrameRate(_GovernedFrameRate.load(std::memory_order_relaxed));
+    }
+
+    stage_timings_t::Attach(nullptr);
+}
+
+/// <summary>
+/// Processes an audio chunk.
+/// </summary>
+void uielement_t::ProcessAudio() noexcept
+{
+    // Start over when the render thread requests it.
+    const uint64_t Generation = _AnalysisGeneration.load(std::memory_order_acquire);
+
+    if (_AnalyzedGeneration != Generation)
+    {
+        _AnalyzedGeneration = Generation;
+
+        const auto Flags = (event_t::Flags) _AnalysisResetFlags.exchange(0);
+
+        if (event_t::IsRaised(Flags, event_t::PlaybackStopped | event_t::PlaybackStartedNewTrack))
+        {
+            _AnalysisPlaybackTime = 0.;
+            _AnalysisSampleRate = 0;
+        }
+
+        for (auto & Iter : _Grid)
+            Iter._Graph->ResetAnalysis();
+    }
+
+    if (!_VisualisationStream.is_valid())
+        return;
+
+    double PlaybackTime; // in seconds
+
+    if (!(_VisualisationStream->get_absolute_time(PlaybackTime) && (PlaybackTime != _AnalysisPlaybackTime)))
+        return; // Playback is paused.
+
+    double WindowSize;
+    double WindowOffset;
+
+    const bool IsSlidingWindow = (_RenderState._Transform == Transform::SWIFT) || (_RenderState._Transform == Transform::AnalogStyle);
+
+    if (!IsSlidingWindow)
+    {
+        if (_AnalysisSampleRate != 0)
+        {
+            WindowSize   = (double) _RenderState.GetBinCount(_AnalysisSampleRate) / (double) _AnalysisSampleRate;
+            WindowOffset = PlaybackTime - (WindowSize * (0.5 + _RenderState._ReactionAlignment));
+        }
+        else
+        {
+            // Get a very small chunk from the visualisation stream to initialize the sample rate dependent parameters. Test with DSF files.
+            WindowSize   = 0.0005; // 500 μs
+            WindowOffset = PlaybackTime;
+        }
+    }
+    else
+    {
+        WindowSize   = PlaybackTime - _AnalysisPlaybackTime;
+        WindowOffset = _AnalysisPlaybackTime;
+    }
+
+    // Use a chunk that is not referenced by a graph or a frame anymore.
+    size_t Index = 0;
+
+    while ((Index < _countof(_Chunks) - 1) && (_Chunks[Index].use_count() > 1))
+        ++Index;
+
+    auto & Chunk = _Chunks[Index];
+
+    if ((Chunk == nullptr) || (Chunk.use_count() > 1))
+        Chunk = std::make_shared<audio_chunk_impl>();
+
+    bool HasSamples = false;
+
+    {
+        scoped_stage_timer_t Timer(Stage::Fetch);
+        scoped_trace_t Trace(_TraceRecorder, "Fetch", WindowOffset);
+
+        HasSamples = _AudioSource.Update(_AudioStream, WindowOffset, WindowSize);
+
+        if (HasSamples)
+        {
+            Chunk->set_data_size(_AudioSource.GetFrameCount() * _AudioSource.GetChannelCount());
+
+            _AudioSource.CopyWindow(Chunk->get_data());
+        }
+    }
+
+    if (HasSamples)
+//  if (GetAudioChunk(*Chunk, 44100, (uint32_t) _RenderState.GetBinCount(44100)))
+    {
+        const size_t FrameCount = _AudioSource.GetFrameCount();
+
+        Chunk->set_sample_count(FrameCount);
+        Chunk->set_channels(_AudioSource.GetChannelCount(), _AudioSource.GetChannelConfig());
+        Chunk->set_sample_rate(_AudioSource.GetSampleRate());
+
+        InitializeSampleRateDependentParameters(*Chunk);
+
+        for (auto & Iter : _Grid)
+        {
+            Iter._Graph->Process(Chunk, _AudioSource.GetPosition());
+            Iter._Graph->Publish(Generation, PlaybackTime);
+        }
+    }
+
+    _AnalysisPlaybackTime = PlaybackTime;
+}
+
+/// <summary>
+/// Initializes the parameters that depend on the sample rate of the chunk. The bin count follows from the sample rate and the FFT settings of the render state.
+/// </summary>
+void uielement_t::InitializeSampleRateDependentParameters(const audio_chunk_impl & chunk) noexcept
+{
+    if (_AnalysisSampleRate == chunk.get_sample_rate())
+        return;
+
+    _AnalysisSampleRate = chunk.get_sample_rate();
+
+    Log.AtDebug().Write(STR_COMPONENT_BASENAME " chunk parameters: %d Hz, %d channels (0x%04X), %d frames, %.1fms, %zu bins", chunk.get_sample_rate(), chunk.get_channel_count(), chunk.get_channel_config(), chunk.get_sample_count(), chunk.get_duration() * 1000., _RenderState.GetBinCount(_AnalysisSampleRate));
+}
+
+/// <summary>
+/// Analysis thread procedure.
+/// </summary>
+DWORD WINAPI uielement_t::CallAnalysisThreadProc(LPVOID context) noexcept
+{
+    ((uielement_t *) context)->AnalysisThreadProc();
+
+    return 0;
+}
+
+/// <summary>
+/// Gets an initialized audio chunk.
+/// </summary>
+bool GetAudioChunk(audio_chunk & chunk, uint32_t sampleRate, uint32_t frameCount)
+{
+    audio_sample * Samples = new audio_sample[frameCount];
+
+    if (Samples == nullptr)
+        return false;
+
+    // Generate samples using a window function.
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+    /** Hann
+        const double x = (double) i / (double) (frameCount - 1);
+
+        Samples[i] = 0.5 * (1. + (audio_sample) std::cos(x * M_PI));
+    **/
+    /** Hamming
+        const double x = 2.0 * M_PI * (double) i / (double) (frameCount - 1);
+
+        Samples[i] = 0.54 - 0.46 * (audio_sample) std::cos(x);
+    **/
+    /** Bartlett
+        Samples[i] = 1. - (double) i / (double) (frameCount - 1);
+     **/
+        const double Frequency = 440.0;
+
+        const double t = (double) i / (double) sampleRate;
+
+        Samples[i] = (audio_sample) std::sin(2.0 * M_PI * Frequency * t);
+    }
+    
+    chunk = audio_chunk_impl(Samples, frameCount, 1, sampleRate);
+    
+    delete[] Samples;
+    
+    return true;
+}
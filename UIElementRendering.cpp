@@ -1,5 +1,5 @@
 
-/** $VER: UIElementRendering.cpp (2026.03.11) P. Stuer - UIElement methods that run on the render thread. **/
+/** $VER: UIElementRendering.cpp (2026.10.18) P. Stuer - UIElement methods that run on the render thread. **/
 
 #include "pch.h"
 #include "UIElement.h"
@@ -13,7 +13,10 @@
 #include "Color.h"
 #include "Gradients.h"
 #include "StyleManager.h"
-#include "Chrono.h"
+#include "WaitableTimerClock.h"
+#include "FrameRateGovernor.h"
+#include "ConfigurationRebuild.h"
+#include "TraceRecorder.h"
 
 #include "Log.h"
 
@@ -25,67 +28,66 @@
 
 #pragma hdrstop
 
-static bool GetAudioChunk(audio_chunk & chunk, uint32_t sampleRate = 44100, uint32_t frameCount = 1024);
-
 /// <summary>
 /// Render thread procedure.
 /// </summary>
 void uielement_t::RenderThreadProc() noexcept
 {
-    chrono_t Chrono;
+    waitable_timer_clock_t Clock(_hStopRendering);
+    frame_pacer_t Pacer(Clock);
+    frame_rate_governor_t Governor;
 
-    const int64_t SleepTime = Chrono.MicrosecondsToTicks(_RenderState._SleepTime);
+    Governor.Reset((double) _RenderState._RefreshRateLimit);
+    _GovernedFrameRate.store(Governor.GetFrameRate(), std::memory_order_relaxed);
 
-    int64_t Now = Chrono.Now();
+    Pacer.Start(Governor.GetFrameRate(), (_RenderState._SleepTime * Clock.GetFrequency()) / 1'000'000);
 
-    int64_t MaxFrameTime = Chrono.SecondsToTicks(1.0 / (double) _RenderState._RefreshRateLimit);
-    int64_t NextFrameTime = Now + MaxFrameTime;
+    Log.AtDebug().Write("Render thread started: Target %d fps / Max. frame time %d ticks",  _RenderState._RefreshRateLimit, Pacer.GetPeriod());
 
-    Log.AtDebug().Write("Render thread started: Target %d fps / Max. frame time %d ticks",  _RenderState._RefreshRateLimit, MaxFrameTime);
+    stage_timings_t::Attach(&_StageTimings);
+    trace_recorder_t::SetThreadName("Render");
 
     for (;;)
     {
-        Now = Chrono.Now();
-
-        const int64_t Elapsed = NextFrameTime - Now;
-
-        // Coarse delay
-        if (Elapsed > SleepTime)
-        {
-            const int64_t Milliseconds = Chrono.TicksToMilliseconds(Elapsed);
-
-            const DWORD TimeOut = (Milliseconds > 1) ? (DWORD) (Milliseconds - 1) : 0;
+        if (!Pacer.WaitForNextFrame())
+            break;
 
-            if (::WaitForSingleObject(_hStopRendering, TimeOut) == WAIT_OBJECT_0)
-                return;
+        if (::WaitForSingleObject(_hStopRendering, 0) == WAIT_OBJECT_0)
+            break;
 
-            continue;
-        }
+        scoped_trace_t Trace(_TraceRecorder, "Frame", _RenderState._PlaybackTime);
 
-        // Fine delay (Ugly busy wait)
-        while (Chrono.Now() < NextFrameTime)
-        {
-            if (::WaitForSingleObject(_hStopRendering, 0) == WAIT_OBJECT_0)
-                return;
-        }
+        AdoptConfiguration();
 
         if (!(_IsFrozen || !_IsVisible || ::IsIconic(::GetParent(m_hWnd))))
         {
             bool HaveColorsChanged = false;
 
+            const int64_t FrameStart = Clock.Now();
+
             if (_CriticalSection.TryEnter())
             {
-                ProcessEvents();
+                // Events and new frames count as a change of the visualization for the frame rate governor.
+                double Change = ProcessEvents() ? 1. : 0.;
 
                 if (IsWindowVisible())
                 {
                     _FrameCounter.NewFrame();
 
-                    ProcessAudio();
+                    Change = std::max(Change, ProcessFrames());
 
                     Render();
 
-                    Animate();
+                    const bool IsAnimating = Animate();
+
+                    const double FrameCost = (double) (Clock.Now() - FrameStart) / (double) Clock.GetFrequency();
+
+                    if (Governor.Update((double) _RenderState._RefreshRateLimit, Change, IsAnimating, FrameCost))
+                    {
+                        _GovernedFrameRate.store(Governor.GetFrameRate(), std::memory_order_relaxed);
+
+                        Log.AtDebug().Write("Frame rate governor: %.1f fps (%s, frame cost %.2f ms)", Governor.GetFrameRate(), frame_rate_governor_t::GetReasonName(Governor.GetReason()), Governor.GetFrameCost() * 1000.);
+                    }
                 }
 
                 if (_IsConfigurationChanged)
@@ -111,26 +113,117 @@ void uielement_t::RenderThreadProc() noexcept
             }
         }
 
-        // Determine the presentation time of the next frame.
-        MaxFrameTime = Chrono.SecondsToTicks(1.0 / (double) _RenderState._RefreshRateLimit);
-        NextFrameTime += MaxFrameTime;
+        // Follow the frame rate chosen by the governor.
+        Pacer.SetFrameRate(Governor.GetFrameRate());
+    }
+
+    stage_timings_t::Attach(nullptr);
+
+    const auto & Statistics = Governor.GetStatistics();
+
+    Log.AtInfo().Write("Render thread stopped: %llu frames, %llu idle, %llu overrun, %llu frame rate changes, %llu missed frames", Statistics.FrameCount, Statistics.IdleFrameCount, Statistics.OverrunFrameCount, Statistics.DecisionCount, Pacer.GetMissedFrames());
+}
+
+/// <summary>
+/// Adopts the last configuration published by the UI thread. Never blocks: when the UI thread or the analysis thread is using the graphs, the configuration is adopted at the start of a later frame.
+/// </summary>
+void uielement_t::AdoptConfiguration() noexcept
+{
+    if (_PendingConfiguration.load(std::memory_order_acquire) == nullptr)
+        return;
+
+    scoped_trace_t Trace(_TraceRecorder, "Adopt Configuration");
+
+    if (!_CriticalSection.TryEnter())
+        return;
+
+    if (!_AnalysisCriticalSection.TryEnter())
+    {
+        _CriticalSection.Leave();
+
+        return;
+    }
+
+    const std::shared_ptr<const configuration_snapshot_t> Snapshot = _PendingConfiguration.exchange(nullptr);
+
+    if (Snapshot != nullptr)
+    {
+        _RenderState = Snapshot->State; // Copies only the settings that are relevant for rendering.
+
+        // The smoothing, the peak indicator, the render loop and the oscilloscope settings are read every frame. The settings of the bands and the analyzers only regenerate the bands.
+        // The graphs and their history are only recreated when any other setting changed.
+        const auto Rebuild = configuration_rebuild_t::Get(Snapshot->Changes, !_RenderState._ArtworkGradientStops.empty());
+
+        if (Rebuild.DeleteDeviceResources)
+            _RenderState._StyleManager.DeleteDeviceSpecificResources();
+
+        // The copied styles released their brushes and lost the colors that were extracted from the artwork, whatever changed.
+        if (Rebuild.ExtractArtworkColors)
+            CreateArtworkDependentResources();
+        else
+        if (Rebuild.RestoreArtworkColors)
+            _RenderState._StyleManager.SetArtworkDependentParameters(_RenderState._ArtworkGradientStops, _RenderState._StyleManager.DominantColor);
+
+        if (Rebuild.CreateGraphs)
+        {
+            _TrackingGraph = nullptr; // Refers to one of the graphs that is about to be deleted.
+
+            for (auto & Iter : _Grid)
+                delete Iter._Graph;
+
+            _Grid.clear();
+
+            _Grid.Initialize(_RenderState._GridRowCount, _RenderState._GridColumnCount);
+
+            for (const auto & GraphDescription : _RenderState._GraphDescriptions)
+            {
+                auto * Graph = new graph_t();
+
+                Graph->Initialize(&_RenderState, &GraphDescription, nullptr);
+
+                _Grid.push_back({ Graph, GraphDescription._HRatio, GraphDescription._VRatio });
+            }
+
+            if (_DeviceContext != nullptr)
+            {
+                const D2D1_SIZE_F SizeF = _DeviceContext->GetSize(); // Gets the size in DPIs.
 
-        const int64_t Latency = Chrono.Now() - NextFrameTime;
+                _Grid.Resize(SizeF.width, SizeF.height);
+            }
 
-        if (Latency > MaxFrameTime * 3)
-            NextFrameTime = Chrono.Now() + MaxFrameTime;
+            // Let the UI thread register the tooltips of the new graphs.
+            PostMessageW(UM_GRAPHS_CHANGED);
+        }
+        else
+        if (Rebuild.CreateBands)
+        {
+            for (auto & Iter : _Grid)
+                Iter._Graph->InitializeBands();
+        }
     }
+
+    _AnalysisCriticalSection.Leave();
+    _CriticalSection.Leave();
 }
 
 /// <summary>
-/// Allows the rendering thread to react to events captured in or generated by the UI thread.
+/// Allows the rendering thread to react to events captured in or generated by the UI thread. Returns true if an event was raised.
 /// </summary>
-void uielement_t::ProcessEvents() noexcept
+bool uielement_t::ProcessEvents() noexcept
 {
+    scoped_trace_t Trace(_TraceRecorder, "Process Events");
+
     const auto Flags = _Event.GetFlags();
 
     if (Flags == 0)
-        return;
+        return false;
+
+    // Make the analysis thread start over. The frames it produced before are dropped.
+    if (event_t::IsRaised(Flags, event_t::PlaybackStopped | event_t::PlaybackStartedNewTrack | event_t::PlaybackPaused))
+    {
+        _AnalysisResetFlags.fetch_or((uint32_t) Flags);
+        _AnalysisGeneration.fetch_add(1, std::memory_order_release);
+    }
 
     if (event_t::IsRaised(Flags, event_t::PlaybackStopped | event_t::PlaybackStartedNewTrack))
     {
@@ -176,58 +269,38 @@ void uielement_t::ProcessEvents() noexcept
         _RenderState._StyleManager.UpdateCurrentColors();
         _RenderState._StyleManager.DeleteDeviceSpecificResources();
     }
+
+    return true;
 }
 
 /// <summary>
-/// Processes an audio chunk.
+/// Takes the last results of the analysis thread. Returns the largest change of a rendered value.
 /// </summary>
-void uielement_t::ProcessAudio() noexcept
+double uielement_t::ProcessFrames() noexcept
 {
-    if (!_VisualisationStream.is_valid())
-        return;
-
-    double PlaybackTime; // in seconds
+    scoped_trace_t Trace(_TraceRecorder, "Process Frames");
 
-    if (!(_VisualisationStream->get_absolute_time(PlaybackTime) && (PlaybackTime != _RenderState._PlaybackTime)))
-        return; // Playback is paused.
+    const uint64_t Generation = _AnalysisGeneration.load(std::memory_order_relaxed);
 
-    double WindowSize;
-    double WindowOffset;
+    bool HasNewFrame = false;
+    double PlaybackTime = 0.;
+    double Change = 0.;
 
-    const bool IsSlidingWindow = (_RenderState._Transform == Transform::SWIFT) || (_RenderState._Transform == Transform::AnalogStyle);
-
-    if (!IsSlidingWindow)
+    for (auto & Iter : _Grid)
     {
-        if (_RenderState._SampleRate != 0)
-        {
-            WindowSize   = (double) _RenderState._BinCount / (double) _RenderState._SampleRate;
-            WindowOffset = PlaybackTime - (WindowSize * (0.5 + _RenderState._ReactionAlignment));
-        }
-        else
+        double GraphChange = 0.;
+
+        if (Iter._Graph->Update(Generation, PlaybackTime, GraphChange))
         {
-            // Get a very small chunk from the visualisation stream to initialize the sample rate dependent parameters. Test with DSF files.
-            WindowSize   = 0.0005; // 500 μs
-            WindowOffset = PlaybackTime;
+            HasNewFrame = true;
+            Change = std::max(Change, GraphChange);
         }
     }
-    else
-    {
-        WindowSize   = PlaybackTime - _RenderState._PlaybackTime;
-        WindowOffset = _RenderState._PlaybackTime;
-    }
-
-    audio_chunk_impl Chunk;
 
-    if (_VisualisationStream->get_chunk_absolute(Chunk, WindowOffset, WindowSize))
-//  if (GetAudioChunk(Chunk, 44100, _RenderState._BinCount))
-    {
-        InitializeSampleRateDependentParameters(Chunk);
-
-        for (auto & Iter : _Grid)
-            Iter._Graph->Process(Chunk);
-    }
+    if (HasNewFrame)
+        _RenderState._PlaybackTime = PlaybackTime;
 
-    _RenderState._PlaybackTime = PlaybackTime;
+    return Change;
 }
 
 /// <summary>
@@ -235,6 +308,8 @@ void uielement_t::ProcessAudio() noexcept
 /// </summary>
 void uielement_t::Render() noexcept
 {
+    scoped_trace_t Trace(_TraceRecorder, "Render");
+
     HRESULT hr = CreateDeviceSpecificResources();
 
     if (!SUCCEEDED(hr))
@@ -244,65 +319,54 @@ void uielement_t::Render() noexcept
 
     _DeviceContext->Clear(D2D1::ColorF(0.f, 0.f, 0.f, 0.f)); // Required for alpha transparency. Do this once for all graphs. A graph can overlay a background color with a semi-transparent style.
 
+    size_t GraphIndex = 0;
+
     for (auto & Iter : _Grid)
+    {
+        scoped_stage_timer_t Timer(Stage::Graph, GraphIndex++);
+
         Iter._Graph->Render(_DeviceContext, _Artwork);
+    }
+
+    if (_RenderState._ShowFrameCounter)
+        _FrameCounter.Render(_DeviceContext, _StageTimings);
 
-    if (_UIState._ShowFrameCounter)
-        _FrameCounter.Render(_DeviceContext);
+    {
+        scoped_stage_timer_t Timer(Stage::Present); // Direct2D executes the batched drawing commands in EndDraw().
+        scoped_trace_t Trace(_TraceRecorder, "Present");
 
-    hr = _DeviceContext->EndDraw();
+        hr = _DeviceContext->EndDraw();
 
-    // Present the swap chain immediately.
-    if (SUCCEEDED(hr))
-        hr = _SwapChain->Present(0, 0);
+        // Present the swap chain immediately.
+        if (SUCCEEDED(hr))
+            hr = _SwapChain->Present(0, 0);
+    }
 
     if (hr == D2DERR_RECREATE_TARGET || hr == DXGI_ERROR_DEVICE_REMOVED)
         DeleteDeviceSpecificResources();
 }
 
 /// <summary>
-/// Updates the current and peak values of all the graphs.
-/// </summary>
-void uielement_t::Animate() noexcept
-{
-    if (_UIState._PeakMode == PeakMode::None)
-        return;
-
-    // Needs to be called even when no audio is playing to keep animating the decay of the peak indicators after the audio stops.
-    for (auto & Iter : _Grid)
-        Iter._Graph->_Analysis.UpdatePeakValues(_RenderState._PlaybackTime == 0.);
-}
-
-/// <summary>
-/// Initializes the parameters that depend on the sample rate of the chunk.
+/// Updates the current and peak values of all the graphs. Returns true while the peak indicators are still moving.
 /// </summary>
-void uielement_t::InitializeSampleRateDependentParameters(const audio_chunk_impl & chunk) noexcept
+bool uielement_t::Animate() noexcept
 {
-    if (_RenderState._SampleRate == chunk.get_sample_rate())
-        return;
-
-    _RenderState._SampleRate = chunk.get_sample_rate();
+    if (_RenderState._PeakMode == PeakMode::None)
+        return false;
 
-    Log.AtDebug().Write(STR_COMPONENT_BASENAME " chunk parameters: %d Hz, %d channels (0x%04X), %d frames, %.1fms", chunk.get_sample_rate(), chunk.get_channel_count(), chunk.get_channel_config(), chunk.get_sample_count(), chunk.get_duration() * 1000.);
+    scoped_stage_timer_t Timer(Stage::PeakAnimation);
+    scoped_trace_t Trace(_TraceRecorder, "Animate");
 
-    #pragma warning(disable: 4061)
+    bool IsAnimating = false;
 
-    switch (_RenderState._FFTMode)
+    // Needs to be called even when no audio is playing to keep animating the decay of the peak indicators after the audio stops.
+    for (auto & Iter : _Grid)
     {
-        default:
-            _UIState._BinCount = _RenderState._BinCount = (size_t) (64. * ::exp2((long) _RenderState._FFTMode));
-            break;
-
-        case FFTMode::FFTCustom:
-            _UIState._BinCount = _RenderState._BinCount = (_RenderState._FFTCustom > 0) ? (size_t) _RenderState._FFTCustom : 64;
-            break;
-
-        case FFTMode::FFTDuration:
-            _UIState._BinCount = _RenderState._BinCount = (_RenderState._FFTDuration > 0.) ? (size_t) (((double) _RenderState._SampleRate * _RenderState._FFTDuration) / 1000.) : 64;
-            break;
+        if (Iter._Graph->_Analysis.UpdatePeakValues(_RenderState._PlaybackTime == 0.))
+            IsAnimating = true;
     }
 
-    #pragma warning(default: 4061)
+    return IsAnimating;
 }
 
 /// <summary>
@@ -626,43 +690,3 @@ HRESULT uielement_t::CreateArtworkDependentResources() noexcept
 }
 
 #pragma endregion
-
-/// <summary>
-/// Gets an initialized audio chunk.
-/// </summary>
-bool GetAudioChunk(audio_chunk & chunk, uint32_t sampleRate, uint32_t frameCount)
-{
-    audio_sample * Samples = new audio_sample[frameCount];
-
-    if (Samples == nullptr)
-        return false;
-
-    // Generate samples using a window function.
-    for (uint32_t i = 0; i < frameCount; ++i)
-    {
-    /** Hann
-        const double x = (double) i / (double) (frameCount - 1);
-
-        Samples[i] = 0.5 * (1. + (audio_sample) std::cos(x * M_PI));
-    **/
-    /** Hamming
-        const double x = 2.0 * M_PI * (double) i / (double) (frameCount - 1);
-
-        Samples[i] = 0.54 - 0.46 * (audio_sample) std::cos(x);
-    **/
-    /** Bartlett
-        Samples[i] = 1. - (double) i / (double) (frameCount - 1);
-     **/
-        const double Frequency = 440.0;
-
-        const double t = (double) i / (double) sampleRate;
-
-        Samples[i] = (audio_sample) std::sin(2.0 * M_PI * Frequency * t);
-    }
-    
-    chunk = audio_chunk_impl(Samples, frameCount, 1, sampleRate);
-    
-    delete[] Samples;
-    
-    return true;
-}
@@ -1,5 +1,5 @@
 
-/** $VER: ToolTips.cpp (2025.11.12) P. Stuer **/
+/** $VER: ToolTips.cpp (2026.10.18) P. Stuer **/
 
 #include "pch.h"
 #include "UIElement.h"
@@ -27,6 +27,19 @@ void uielement_t::OnMouseMove(UINT, CPoint pt)
     if (!_ToolTipControl.IsWindow() || (!_UIState._ShowToolTipsAlways && !_UIState._ShowToolTipsNow))
         return;
 
+    // The render thread can recreate the graphs at any time outside the critical section.
+    _CriticalSection.Enter();
+
+    UpdateToolTip(pt);
+
+    _CriticalSection.Leave();
+}
+
+/// <summary>
+/// Updates the tracking tooltip for the specified mouse position.
+/// </summary>
+void uielement_t::UpdateToolTip(CPoint pt) noexcept
+{
     if (_TrackingGraph == nullptr)
     {
         _TrackingGraph = GetGraph(pt);
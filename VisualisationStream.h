@@ -0,0 +1,46 @@
+
+/** $VER: VisualisationStream.h (2026.10.18) P. Stuer - Implements an audio stream on top of the visualisation stream of foobar2000. **/
+
+#pragma once
+
+#include "pch.h"
+
+#include "AudioSource.h"
+
+/// <summary>
+/// Implements an audio stream on top of the visualisation stream of foobar2000.
+/// </summary>
+#pragma warning(disable: 4820)
+class visualisation_audio_stream_t : public audio_stream_t
+{
+public:
+    visualisation_audio_stream_t(visualisation_stream_v2::ptr & stream) noexcept : _Stream(stream) { }
+
+    visualisation_audio_stream_t(const visualisation_audio_stream_t &) = delete;
+    visualisation_audio_stream_t & operator=(const visualisation_audio_stream_t &) = delete;
+    visualisation_audio_stream_t(visualisation_audio_stream_t &&) = delete;
+    visualisation_audio_stream_t & operator=(visualisation_audio_stream_t &&) = delete;
+
+    virtual ~visualisation_audio_stream_t() noexcept { }
+
+    /// <summary>
+    /// Gets the frames in the window [offset, offset + length), in seconds. Returns false if no audio is available.
+    /// </summary>
+    bool GetFrames(double offset, double length, audio_frames_t & frames) noexcept override
+    {
+        if (!_Stream.is_valid() || !_Stream->get_chunk_absolute(_Chunk, offset, length))
+            return false;
+
+        frames.Data          = _Chunk.get_data();
+        frames.FrameCount    = _Chunk.get_sample_count(); // get_sample_count() actually returns the number of frames.
+        frames.ChannelCount  = _Chunk.get_channel_count();
+        frames.ChannelConfig = _Chunk.get_channel_config();
+        frames.SampleRate    = _Chunk.get_sample_rate();
+
+        return true;
+    }
+
+private:
+    visualisation_stream_v2::ptr & _Stream;
+    audio_chunk_impl _Chunk;        // Receives the frames requested from the visualisation stream. Reused for every request.
+};
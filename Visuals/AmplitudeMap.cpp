@@ -0,0 +1,166 @@
+
+/** $VER: AmplitudeMap.cpp (2026.10.18) P. Stuer - Maps amplitudes to the colors of a gradient. **/
+
+#include "AmplitudeMap.h"
+#include "SIMD.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Creates a color table to map the amplitudes to. The SoX color scheme is calculated instead of interpolated from gradient stops.
+/// Returns false if there are no gradient stops.
+/// </summary>
+/// <remarks>Assumes a sane gradient collection with position running from 0 to 1 in ascending order.</remarks>
+bool amplitude_map_t::Create(const amplitude_gradient_stop_t * stops, size_t count, bool isSoX, std::vector<amplitude_color_t> & colors) noexcept
+{
+    if ((stops == nullptr) || (count == 0))
+        return false;
+
+    const size_t Steps = Size - 1; // Results in a table of Size entries to be mapped to amplitudes between 0 and 1.
+
+    colors.clear();
+    colors.reserve(((count - 1) * Steps) + 1);
+
+    if (!isSoX)
+    {
+        // Linear interpolation of the colors.
+
+        amplitude_color_t Color1 = stops[0].Color;
+        float Position1 = stops[0].Position;
+
+        // Add the run-in colors.
+        uint32_t n = (uint32_t) (Position1 * (float) Steps);
+
+        for (uint32_t j = 0; j <= n; ++j)
+            colors.push_back(Color1);
+
+        // Add the gradient colors.
+        for (size_t i = 1; i < count; ++i)
+        {
+            const amplitude_color_t & Color2 = stops[i].Color;
+            const float & Position2 = stops[i].Position;
+
+            // Positions may not be in ascending order while the user is editing the gradient.
+            if (Position2 > Position1)
+            {
+                const amplitude_color_t Delta = { Color2.r - Color1.r, Color2.g - Color1.g, Color2.b - Color1.b, Color2.a - Color1.a };
+
+                n = (uint32_t) ((Position2 - Position1) * (float) Steps);
+
+                for (uint32_t j = 1; j < n; ++j)
+                {
+                    const float Factor = (float) j / (float) n;
+                    const amplitude_color_t Color =
+                    {
+                        Color1.r + (Delta.r * Factor),
+                        Color1.g + (Delta.g * Factor),
+                        Color1.b + (Delta.b * Factor),
+                        Color1.a + (Delta.a * Factor)
+                    };
+
+                    colors.push_back(Color);
+                }
+            }
+
+            Color1 = Color2;
+            Position1 = Position2;
+        }
+
+        // Add the run-out colors.
+        for (uint32_t j = (uint32_t) (Position1 * (float) Steps); j <= Steps; ++j)
+            colors.push_back(Color1);
+
+        // The color in the lowest position should map to the highest amplitude values.
+        std::reverse(colors.begin(), colors.end());
+    }
+    else
+    {
+        double r = 0.;
+        double g = 0.;
+        double b = 0.;
+
+        for (size_t i = 0; i <= Steps; ++i)
+        {
+            const double amplitude = (double) i / (double) Steps;
+
+            if (amplitude >= 0.13 && amplitude < 0.73)
+                r = ::sin((amplitude - 0.13) / 0.60 * M_PI_2);
+            else
+            if (amplitude >= 0.73)
+                r = 1.0;
+
+            if (amplitude >= 0.6 && amplitude < 0.91)
+                g = ::sin((amplitude - 0.6) / 0.31 * M_PI_2);
+            else
+            if (amplitude >= 0.91)
+                g = 1.0;
+
+            if (amplitude < 0.60)
+                b = 0.5 * ::sin(amplitude / 0.6 * M_PI);
+            else
+            if (amplitude >= 0.78)
+                b = (amplitude - 0.78) / 0.22;
+
+            colors.push_back({ (float) r, (float) g, (float) b, 1.f });
+        }
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Converts colors to premultiplied BGRA pixels.
+/// </summary>
+void amplitude_map_t::CreatePixels(const amplitude_color_t * colors, size_t count, float opacity, std::vector<uint32_t> & pixels) noexcept
+{
+    auto ToByte = [](float x) -> uint32_t { return (uint32_t) (std::clamp(x, 0.f, 1.f) * 255.f + 0.5f); };
+
+    pixels.resize(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const amplitude_color_t & Color = colors[i];
+
+        const float a = Color.a * opacity;
+
+        pixels[i] = (ToByte(a) << 24) | (ToByte(Color.r * a) << 16) | (ToByte(Color.g * a) << 8) | ToByte(Color.b * a);
+    }
+}
+
+/// <summary>
+/// Maps quantized values between 0 and 65535 to the pixels of a map. Each pixel of the map covers an equal part of the value range.
+/// </summary>
+void amplitude_map_t::GetPixels(const uint32_t * map, size_t size, const uint16_t * values, size_t count, uint32_t * pixels) noexcept
+{
+    if ((map == nullptr) || (size == 0))
+    {
+        std::fill_n(pixels, count, 0u);
+        return;
+    }
+
+    // index = (value * size) / 65536.
+    const uint32_t Size = (uint32_t) std::min(size, (size_t) UINT16_MAX);
+
+    size_t i = 0;
+
+#if defined(SIMD_SSE2)
+    // Calculate the indexes of 8 values at a time.
+    {
+        alignas(16) uint16_t Indexes[8];
+
+        const __m128i s = _mm_set1_epi16((short) Size);
+
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm_store_si128((__m128i *) Indexes, _mm_mulhi_epu16(_mm_loadu_si128((const __m128i *) (values + i)), s));
+
+            for (size_t j = 0; j < 8; ++j)
+                pixels[i + j] = map[Indexes[j]];
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+        pixels[i] = map[((uint32_t) values[i] * Size) >> 16];
+}
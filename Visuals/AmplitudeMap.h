@@ -0,0 +1,45 @@
+
+/** $VER: AmplitudeMap.h (2026.10.18) P. Stuer - Maps amplitudes to the colors of a gradient. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Represents a color. Same layout as D2D1_COLOR_F.
+/// </summary>
+struct amplitude_color_t
+{
+    float r;
+    float g;
+    float b;
+    float a;
+};
+
+/// <summary>
+/// Represents a gradient stop. Same layout as D2D1_GRADIENT_STOP.
+/// </summary>
+struct amplitude_gradient_stop_t
+{
+    float Position;
+    amplitude_color_t Color;
+};
+
+/// <summary>
+/// Creates the table of colors amplitudes between 0.0 and 1.0 are mapped to and converts them to pixels. Portable: does not depend on Windows.
+/// </summary>
+class amplitude_map_t
+{
+public:
+    static bool Create(const amplitude_gradient_stop_t * stops, size_t count, bool isSoX, std::vector<amplitude_color_t> & colors) noexcept;
+    static void CreatePixels(const amplitude_color_t * colors, size_t count, float opacity, std::vector<uint32_t> & pixels) noexcept;
+    static void GetPixels(const uint32_t * map, size_t size, const uint16_t * values, size_t count, uint32_t * pixels) noexcept;
+
+    static const size_t Size = 1024;    // Number of colors an amplitude between 0.0 and 1.0 is mapped to.
+};
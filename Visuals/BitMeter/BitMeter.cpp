@@ -1,5 +1,5 @@
 
-/** $VER: BitMeter.cpp (2026.03.13) P. Stuer - Implements a bit meter visualization. **/
+/** $VER: BitMeter.cpp (2026.10.18) P. Stuer - Implements a bit meter visualization. **/
 
 #include <pch.h>
 
@@ -108,13 +108,16 @@ void bit_meter_t::Render(ID2D1DeviceContext * deviceContext) noexcept
     const FLOAT ClientWidth  = _Size.width - YAxisWidth;
     const FLOAT ClientHeight = _Size.height - ((FLOAT) _MeasurementCount * XAxisHeight);
 
-    FLOAT BarWidth = ClientWidth  / audio_sample_size;
+    const size_t BitCount = _Analysis->_BitMeasurements.front().BitCounts.size(); // Depends on the selected view.
+    const bool IsFloatingPoint = (_State->_BitMeterView == BitMeterView::Native);
+
+    FLOAT BarWidth = ClientWidth  / (FLOAT) BitCount;
 
     // Use the full width of the graph?
     if (_Settings->_HorizontalAlignment != HorizontalAlignment::Fit)
         BarWidth = std::floor(BarWidth);
 
-    const FLOAT TotalBarWidth = BarWidth * (FLOAT) audio_sample_size;
+    const FLOAT TotalBarWidth = BarWidth * (FLOAT) BitCount;
 
     const FLOAT ChannelHeight = ClientHeight / (FLOAT) _MeasurementCount;
 
@@ -163,7 +166,7 @@ void bit_meter_t::Render(ID2D1DeviceContext * deviceContext) noexcept
             // Draw the bit count.
             if (!_State->_IsPaused || (_State->_IsPaused && _State->_VisualizeDuringPause))
             {
-                style_t * Style = (BitNumber == 0) ? _BarSign : ((BitNumber <= ExponentBits) ? _BarExponent : _BarMantissa);
+                style_t * Style = (BitNumber == 0) ? _BarSign : ((IsFloatingPoint && (BitNumber <= ExponentBits)) ? _BarExponent : _BarMantissa);
 
                 if (Style->IsEnabled())
                 {
@@ -1,5 +1,5 @@
 
-/** $VER: Element.cpp (2024.04.08) P. Stuer - Base class for all visual elements **/
+/** $VER: Element.cpp (2026.10.18) P. Stuer - Base class for all visual elements **/
 
 #include "pch.h"
 #include "Element.h"
@@ -13,21 +13,9 @@
 /// </summary>
 void element_t::SetTransform(ID2D1DeviceContext * deviceContext, const D2D1_RECT_F & rect) const noexcept
 {
-    D2D1::Matrix3x2F Transform = D2D1::Matrix3x2F::Identity();
+    const layout_transform_t t = layout_transform_t::Get(rect.right - rect.left, rect.bottom - rect.top, _Settings->_FlipHorizontally, _Settings->_FlipVertically);
 
-    if (_Settings->_FlipHorizontally)
-        Transform = D2D1::Matrix3x2F(-1.f, 0.f, 0.f, 1.f, rect.right - rect.left, 0.f);
-
-    if (!_Settings->_FlipVertically) // Negate because the GUI assumes the mathematical (bottom-left 0,0) coordinate system.
-    {
-        const D2D1::Matrix3x2F FlipV = D2D1::Matrix3x2F(1.f, 0.f, 0.f, -1.f, 0.f, rect.bottom - rect.top);
-
-        Transform = Transform * FlipV;
-    }
-
-    const D2D1::Matrix3x2F Translate = D2D1::Matrix3x2F::Translation(rect.left, rect.top);
-
-    deviceContext->SetTransform(Transform * Translate);
+    deviceContext->SetTransform(D2D1::Matrix3x2F(t.ScaleX, 0.f, 0.f, t.ScaleY, rect.left + t.OffsetX, rect.top + t.OffsetY));
 }
 
 /// <summary>
@@ -1,5 +1,5 @@
 
-/** $VER: Element.h (2026.03.11) P. Stuer - Base class for all visual elements. **/
+/** $VER: Element.h (2026.10.18) P. Stuer - Base class for all visual elements. **/
 
 #pragma once
 
@@ -16,6 +16,7 @@
 #include "Direct2D.h"
 
 #include "Style.h"
+#include "LayoutTransform.h"
 
 class element_t
 {
@@ -75,19 +76,7 @@ public:
     /// </summary>
     static FLOAT GetHOffset(HorizontalAlignment horizontalAlignment, FLOAT width) noexcept
     {
-        switch (horizontalAlignment)
-        {
-            case HorizontalAlignment::Center:
-                return width / 2.f;
-
-            default:
-            case HorizontalAlignment::Fit:
-            case HorizontalAlignment::Near:
-                return 0.f;
-
-            case HorizontalAlignment::Far:
-                return width;
-        }
+        return layout_transform_t::GetHOffset(horizontalAlignment, width);
     }
 
 protected:
@@ -1,5 +1,5 @@
 
-/** $VER: FrameCounter.cpp (2024.03.31) P. Stuer **/
+/** $VER: FrameCounter.cpp (2026.10.18) P. Stuer **/
 
 #include "pch.h"
 #include "FrameCounter.h"
@@ -40,7 +40,7 @@ void frame_counter_t::Resize(FLOAT clientWidth, FLOAT clientHeight) noexcept
 /// <summary>
 /// Renders this instance to the specified render target.
 /// </summary>
-HRESULT frame_counter_t::Render(ID2D1DeviceContext * deviceContext) noexcept
+HRESULT frame_counter_t::Render(ID2D1DeviceContext * deviceContext, const stage_timings_t & stageTimings) noexcept
 {
     HRESULT hr = CreateDeviceSpecificResources(deviceContext);
 
@@ -68,6 +68,58 @@ HRESULT frame_counter_t::Render(ID2D1DeviceContext * deviceContext) noexcept
 
             deviceContext->DrawText(Text, (UINT) ::wcsnlen(Text, _countof(Text)), _TextFormat, Rect, _Brush, D2D1_DRAW_TEXT_OPTIONS_NONE);
         }
+
+        hr = RenderStageTimings(deviceContext, stageTimings, Rect.bottom + Inset);
+    }
+
+    return hr;
+}
+
+/// <summary>
+/// Renders the percentiles of the duration of the recorded stages below the frame rate.
+/// </summary>
+HRESULT frame_counter_t::RenderStageTimings(ID2D1DeviceContext * deviceContext, const stage_timings_t & stageTimings, FLOAT top) noexcept
+{
+    if (_TimingsTextFormat == nullptr)
+        return S_OK;
+
+    const FLOAT Inset = 4.f;
+
+    std::wstring Text = L"Stage (ms)           p50     p95     p99";
+
+    for (size_t i = 0; i < stage_timings_t::StageCount; ++i)
+    {
+        stage_timings_t::percentiles_t p;
+
+        if (!stageTimings.GetPercentiles(i, p))
+            continue;
+
+        WCHAR Line[128];
+
+        if (SUCCEEDED(::StringCchPrintfW(Line, _countof(Line), L"\n%-16S %7.2f %7.2f %7.2f", stage_timings_t::GetStageName(i).c_str(), p.P50, p.P95, p.P99)))
+            Text += Line;
+    }
+
+    CComPtr<IDWriteTextLayout> TextLayout;
+
+    HRESULT hr = _DirectWrite.Factory->CreateTextLayout(Text.c_str(), (UINT32) Text.length(), _TimingsTextFormat, _ClientWidth, _ClientHeight, &TextLayout);
+
+    DWRITE_TEXT_METRICS TextMetrics = { };
+
+    if (SUCCEEDED(hr))
+        hr = TextLayout->GetMetrics(&TextMetrics);
+
+    if (SUCCEEDED(hr))
+    {
+        const D2D1_RECT_F Rect = { _ClientWidth - 2.f - (Inset + TextMetrics.width + Inset), top, _ClientWidth - 2.f, top + Inset + TextMetrics.height + Inset };
+
+        _Brush->SetColor(D2D1::ColorF(0.f, 0.f, 0.f, 0.6f));
+
+        deviceContext->FillRoundedRectangle(D2D1::RoundedRect(Rect, Inset, Inset), _Brush);
+
+        _Brush->SetColor(D2D1::ColorF(D2D1::ColorF::White));
+
+        deviceContext->DrawTextLayout({ Rect.left + Inset, Rect.top + Inset }, TextLayout, _Brush, D2D1_DRAW_TEXT_OPTIONS_NONE);
     }
 
     return hr;
@@ -111,6 +163,16 @@ HRESULT frame_counter_t::CreateDeviceIndependentResources() noexcept
         }
     }
 
+    if (SUCCEEDED(hr))
+        hr = _DirectWrite.Factory->CreateTextFormat(_TimingsFontFamilyName.c_str(), NULL, DWRITE_FONT_WEIGHT_NORMAL, DWRITE_FONT_STYLE_NORMAL, DWRITE_FONT_STRETCH_NORMAL, ToDIPs(_TimingsFontSize), L"", &_TimingsTextFormat);
+
+    if (SUCCEEDED(hr))
+    {
+        _TimingsTextFormat->SetTextAlignment(DWRITE_TEXT_ALIGNMENT_LEADING);
+        _TimingsTextFormat->SetParagraphAlignment(DWRITE_PARAGRAPH_ALIGNMENT_NEAR);
+        _TimingsTextFormat->SetWordWrapping(DWRITE_WORD_WRAPPING_NO_WRAP);
+    }
+
     return hr;
 }
 
@@ -119,6 +181,7 @@ HRESULT frame_counter_t::CreateDeviceIndependentResources() noexcept
 /// </summary>
 void frame_counter_t::DeleteDeviceIndependentResources() noexcept
 {
+    _TimingsTextFormat.Release();
     _TextFormat.Release();
 }
 
@@ -1,5 +1,5 @@
 
-/** $VER: FrameCounter.h (2024.03.09) P. Stuer - Represents and renders the frame counter display. **/
+/** $VER: FrameCounter.h (2026.10.18) P. Stuer - Represents and renders the frame counter display. **/
 
 #pragma once
 
@@ -17,6 +17,7 @@
 
 #include "DirectWrite.h"
 #include "RingBuffer.h"
+#include "StageTimings.h"
 
 #include <string>
 
@@ -27,7 +28,7 @@
 class frame_counter_t
 {
 public:
-    frame_counter_t() : _Times(), _FontFamilyName(L"Segoe UI"), _FontSize(20.f), _ClientWidth(), _ClientHeight(), _TextWidth(), _TextHeight()
+    frame_counter_t() : _Times(), _FontFamilyName(L"Segoe UI"), _FontSize(20.f), _TimingsFontFamilyName(L"Consolas"), _TimingsFontSize(9.f), _ClientWidth(), _ClientHeight(), _TextWidth(), _TextHeight()
     {
         ::QueryPerformanceFrequency(&_Frequency);
 
@@ -42,7 +43,7 @@ public:
     void Resize(FLOAT clientWidth, FLOAT clientHeight) noexcept;
 
     void NewFrame() noexcept;
-    HRESULT Render(ID2D1DeviceContext * deviceContext) noexcept;
+    HRESULT Render(ID2D1DeviceContext * deviceContext, const stage_timings_t & stageTimings) noexcept;
 
     HRESULT CreateDeviceIndependentResources() noexcept;
     void DeleteDeviceIndependentResources() noexcept;
@@ -52,6 +53,7 @@ public:
 
 private:
     float GetFPS() const noexcept;
+    HRESULT RenderStageTimings(ID2D1DeviceContext * deviceContext, const stage_timings_t & stageTimings, FLOAT top) noexcept;
 
 private:
     LARGE_INTEGER _Frequency;
@@ -60,12 +62,16 @@ private:
     std::wstring _FontFamilyName;
     FLOAT _FontSize;    // In points.
 
+    std::wstring _TimingsFontFamilyName;
+    FLOAT _TimingsFontSize; // In points.
+
     // Parent-dependent parameters
     FLOAT _ClientWidth;
     FLOAT _ClientHeight;
 
     // Device-independent resources
     CComPtr<IDWriteTextFormat> _TextFormat;
+    CComPtr<IDWriteTextFormat> _TimingsTextFormat;
     FLOAT _TextWidth;
     FLOAT _TextHeight;
 
@@ -1,12 +1,14 @@
 
-/** $VER: Graph.cpp (2026.03.11) P. Stuer - Implements a graph on which the visualizations are rendered. **/
+/** $VER: Graph.cpp (2026.10.18) P. Stuer - Implements a graph on which the visualizations are rendered. **/
 
 #include "pch.h"
 #include "Graph.h"
 
 #include "StyleManager.h"
+#include "BarLayout.h"
 
-#include "DirectWrite.h"
+#include "TextLayoutCache.h"
+#include "TraceRecorder.h"
 
 #pragma hdrstop
 
@@ -35,6 +37,7 @@ void graph_t::Initialize(state_t * state, const graph_description_t * settings,
     _Description = settings->_Description;
 
     _Analysis.Initialize(state, settings);
+    _WorkerAnalysis.Initialize(state, settings);
 
     _Visualization.reset();
 
@@ -98,11 +101,64 @@ void graph_t::Move(const D2D1_RECT_F & rect) noexcept
 }
 
 /// <summary>
-/// Processes an audio chunk.
+/// Processes an audio chunk. The position is the absolute index of the frame that follows the last frame of the chunk.
 /// </summary>
-void graph_t::Process(const audio_chunk & chunk) noexcept
+void graph_t::Process(const std::shared_ptr<const audio_chunk> & chunk, int64_t position) noexcept
 {
-    _Analysis.Process(chunk); // Delegate it to the analysis.
+    _WorkerAnalysis.Process(chunk, position); // Delegate it to the analysis.
+}
+
+/// <summary>
+/// Hands the result of the last analysis pass to the render thread.
+/// </summary>
+void graph_t::Publish(uint64_t generation, double playbackTime) noexcept
+{
+    analysis_frame_t & Frame = _Frames.GetWriteBuffer();
+
+    _WorkerAnalysis.GetFrame(Frame);
+
+    Frame.Generation   = generation;
+    Frame.PlaybackTime = playbackTime;
+
+    _Frames.Publish();
+}
+
+/// <summary>
+/// Resets the analysis that runs on the analysis thread.
+/// </summary>
+void graph_t::ResetAnalysis() noexcept
+{
+    _WorkerAnalysis.Reset();
+}
+
+/// <summary>
+/// Regenerates the frequency bands and recreates the spectrum analyzers of both analyses. Keeps the visualization, its history and the peak indicators.
+/// </summary>
+void graph_t::InitializeBands() noexcept
+{
+    _Analysis.InitializeBands();
+    _WorkerAnalysis.InitializeBands();
+}
+
+/// <summary>
+/// Takes the last result of the analysis thread. Returns false if there is no new result of the specified generation.
+/// The largest change of a rendered value is returned in change.
+/// </summary>
+bool graph_t::Update(uint64_t generation, double & playbackTime, double & change) noexcept
+{
+    if (!_Frames.Update())
+        return false;
+
+    analysis_frame_t & Frame = _Frames.GetReadBuffer();
+
+    if (Frame.Generation != generation)
+        return false;
+
+    change = _Analysis.SetFrame(Frame);
+
+    playbackTime = Frame.PlaybackTime;
+
+    return true;
 }
 
 /// <summary>
@@ -110,6 +166,8 @@ void graph_t::Process(const audio_chunk & chunk) noexcept
 /// </summary>
 void graph_t::Render(ID2D1DeviceContext * deviceContext, artwork_t & artwork) noexcept
 {
+    scoped_trace_t Trace(_TraceRecorder, "Graph");
+
     HRESULT hr = CreateDeviceSpecificResources(deviceContext);
 
     if (FAILED(hr))
@@ -156,13 +214,7 @@ bool graph_t::GetToolTipText(FLOAT x, FLOAT y, std::wstring & toolTip, size_t &
     {
         const msc::rect_t & cr = (const msc::rect_t &) _Visualization->GetClientRect();
 
-        FLOAT t = cr.Width() / (FLOAT) _Analysis._FrequencyBands.size();
-
-        // Allow non-integer bar widths?
-        if (_Settings->_HorizontalAlignment != HorizontalAlignment::Fit)
-            t = ::floor(t);
-
-        const FLOAT BarWidth = std::max(t, 2.f);
+        const FLOAT BarWidth = bar_layout_t::GetBarWidth(cr.Width(), _Analysis._FrequencyBands.size(), _Settings->_HorizontalAlignment);
         const FLOAT SpectrumWidth = (_State->_VisualizationType == VisualizationType::Bars) ? BarWidth * (FLOAT) _Analysis._FrequencyBands.size() : cr.Width();
         const FLOAT HOffset = GetHOffset(_Settings->_HorizontalAlignment, cr.Width() - SpectrumWidth);
 
@@ -249,14 +301,9 @@ void graph_t::RenderDescription(ID2D1DeviceContext * deviceContext) noexcept
     if (_Description.empty())
         return;
 
-    CComPtr<IDWriteTextLayout> TextLayout;
-
-    HRESULT hr = _DirectWrite.Factory->CreateTextLayout(_Description.c_str(), (UINT32) _Description.length(), _DescriptionTextStyle->_TextFormat, _Size.width, _Size.height, &TextLayout);
-
     DWRITE_TEXT_METRICS TextMetrics = { };
 
-    if (SUCCEEDED(hr))
-        hr = TextLayout->GetMetrics(&TextMetrics);
+    HRESULT hr = _TextLayoutCache.GetTextMetrics(_Description, _DescriptionTextStyle->_TextFormat, TextMetrics);
 
     if (SUCCEEDED(hr))
     {
@@ -275,7 +322,15 @@ void graph_t::RenderDescription(ID2D1DeviceContext * deviceContext) noexcept
             deviceContext->FillRoundedRectangle(D2D1::RoundedRect(Rect, Inset, Inset), _DescriptionBackgroundStyle->_Brush);
 
         if (_DescriptionTextStyle->IsEnabled())
-            deviceContext->DrawText(_Description.c_str(), (UINT) _Description.length(), _DescriptionTextStyle->_TextFormat, Rect, _DescriptionTextStyle->_Brush, D2D1_DRAW_TEXT_OPTIONS_NONE);
+        {
+            // Draw the cached layout of the text rectangle instead of letting DrawText() create one every frame.
+            CComPtr<IDWriteTextLayout> TextLayout;
+
+            hr = _TextLayoutCache.GetTextLayout(_Description, _DescriptionTextStyle->_TextFormat, Rect.right - Rect.left, Rect.bottom - Rect.top, &TextLayout);
+
+            if (SUCCEEDED(hr))
+                deviceContext->DrawTextLayout({ Rect.left, Rect.top }, TextLayout, _DescriptionTextStyle->_Brush, D2D1_DRAW_TEXT_OPTIONS_NONE);
+        }
     }
 }
 
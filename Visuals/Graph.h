@@ -1,5 +1,5 @@
 
-/** $VER: Graph.h (2026.03.10) P. Stuer - Implements a graph on which the visualizations are rendered. **/
+/** $VER: Graph.h (2026.10.18) P. Stuer - Implements a graph on which the visualizations are rendered. **/
 
 #pragma once
 
@@ -15,6 +15,7 @@
 #include "Artwork.h"
 
 #include "Element.h"
+#include "TripleBuffer.h"
 
 #include "Spectrum.h"
 #include "Spectrogram.h"
@@ -44,7 +45,14 @@ public:
     void Reset() noexcept override final;
     void Release() noexcept override final;
 
-    void Process(const audio_chunk & chunk) noexcept;
+    // Analysis thread
+    void Process(const std::shared_ptr<const audio_chunk> & chunk, int64_t position) noexcept;
+    void Publish(uint64_t generation, double playbackTime) noexcept;
+    void ResetAnalysis() noexcept;
+    void InitializeBands() noexcept;
+
+    // Render thread
+    bool Update(uint64_t generation, double & playbackTime, double & change) noexcept;
     void Render(ID2D1DeviceContext * deviceContext, artwork_t & artwork) noexcept;
 
     void InitToolInfo(HWND hParent, TTTOOLINFOW & ti) const noexcept;
@@ -80,9 +88,12 @@ private:
     void RenderDescription(ID2D1DeviceContext * deviceContext) noexcept;
 
 public:
-    analysis_t _Analysis;
+    analysis_t _Analysis;           // Used by the visualization on the render thread. Receives the results of _WorkerAnalysis.
 
 private:
+    analysis_t _WorkerAnalysis;     // Processes the audio on the analysis thread.
+    triple_buffer_t<analysis_frame_t> _Frames;
+
     std::wstring _Description;
     std::unique_ptr<element_t> _Visualization;
 
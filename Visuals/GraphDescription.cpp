@@ -1,5 +1,5 @@
 
-/** $VER: GraphDescription.cpp (2024.03.09) P. Stuer - Describes the layout and setting of a graph. **/
+/** $VER: GraphDescription.cpp (2026.10.18) P. Stuer - Describes the layout and setting of a graph. **/
 
 #include "pch.h"
 
@@ -13,20 +13,21 @@
 /// </summary>
 double graph_description_t::ScaleAmplitude(double value) const
 {
-    switch (_YAxisMode)
-    {
-        default:
-
-        case YAxisMode::None:
+    return GetAmplitudeScale().Scale(value);
+}
 
-        case YAxisMode::Decibels:
-            return msc::Map(ToDecibel(value), _AmplitudeLo, _AmplitudeHi, 0.0, 1.0);
+/// <summary>
+/// Gets the scale of the amplitude axis.
+/// </summary>
+amplitude_scale_t graph_description_t::GetAmplitudeScale() const noexcept
+{
+    amplitude_scale_t Scale;
 
-        case YAxisMode::Linear:
-        {
-            const double Exponent = 1.0 / _Gamma;
+    Scale.Mode        = _YAxisMode;
+    Scale.AmplitudeLo = _AmplitudeLo;
+    Scale.AmplitudeHi = _AmplitudeHi;
+    Scale.Gamma       = _Gamma;
+    Scale.UseAbsolute = _UseAbsolute;
 
-            return msc::Map(::pow(value, Exponent), _UseAbsolute ? 0.0 : ::pow(ToMagnitude(_AmplitudeLo), Exponent), ::pow(ToMagnitude(_AmplitudeHi), Exponent), 0.0, 1.0);
-        }
-    }
+    return Scale;
 }
@@ -1,5 +1,5 @@
 
-/** $VER: GraphDescription.h (2026.02.18) P. Stuer - Describes the layout and setting of a graph. **/
+/** $VER: GraphDescription.h (2026.10.18) P. Stuer - Describes the layout and setting of a graph. **/
 
 #pragma once
 
@@ -11,6 +11,7 @@
 #include <Windows.h>
 
 #include "Constants.h"
+#include "BandProcessor.h"
 
 #include <string>
 
@@ -34,6 +35,7 @@ public:
     }
 
     double ScaleAmplitude(double value) const;
+    amplitude_scale_t GetAmplitudeScale() const noexcept;
 
     /* Code readability shortcuts */
     bool HasXAxis() const noexcept { return _XAxisMode != XAxisMode::None; }
@@ -0,0 +1,92 @@
+
+/** $VER: LayoutTransform.h (2026.10.18) P. Stuer - Maps the layout coordinates of a visualization to the coordinates of its client area. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+
+#include <algorithm>
+
+/// <summary>
+/// Represents a point. Same layout as D2D1_POINT_2F.
+/// </summary>
+struct layout_point_t
+{
+    float x;
+    float y;
+};
+
+/// <summary>
+/// Represents a rectangle. Same layout as D2D1_RECT_F.
+/// </summary>
+struct layout_rect_t
+{
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+/// <summary>
+/// Maps the layout coordinates of a visualization to the coordinates of its client area. Visualizations are laid out in the mathematical coordinate system
+/// (origin in the bottom-left corner) and flipped into the top-left coordinate system of the client area unless they are flipped vertically.
+/// Flipping horizontally mirrors the layout around the center of the client area. Portable: does not depend on Windows.
+/// </summary>
+struct layout_transform_t
+{
+    float ScaleX;
+    float ScaleY;
+    float OffsetX;
+    float OffsetY;
+
+    /// <summary>
+    /// Gets the transform for a client area of the specified size.
+    /// </summary>
+    static layout_transform_t Get(float width, float height, bool flipHorizontally, bool flipVertically) noexcept
+    {
+        return
+        {
+            flipHorizontally ? -1.f : 1.f,
+            flipVertically   ?  1.f : -1.f,
+            flipHorizontally ? width  : 0.f,
+            flipVertically   ? 0.f    : height,
+        };
+    }
+
+    /// <summary>
+    /// Gets the horizontal offset of a visualization that leaves the specified width of the client area unused.
+    /// </summary>
+    static float GetHOffset(HorizontalAlignment alignment, float width) noexcept
+    {
+        switch (alignment)
+        {
+            case HorizontalAlignment::Center:
+                return width / 2.f;
+
+            default:
+            case HorizontalAlignment::Fit:
+            case HorizontalAlignment::Near:
+                return 0.f;
+
+            case HorizontalAlignment::Far:
+                return width;
+        }
+    }
+
+    /// <summary>
+    /// Maps a rectangle. The result is normalized: left <= right and top <= bottom.
+    /// </summary>
+    layout_rect_t Apply(const layout_rect_t & r) const noexcept
+    {
+        const float x1 = (r.left  * ScaleX) + OffsetX;
+        const float x2 = (r.right * ScaleX) + OffsetX;
+        const float y1 = (r.top    * ScaleY) + OffsetY;
+        const float y2 = (r.bottom * ScaleY) + OffsetY;
+
+        return { std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2) };
+    }
+};
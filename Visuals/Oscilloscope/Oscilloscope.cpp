@@ -1,5 +1,5 @@
 
-/** $VER: Oscilloscope.cpp (2026.03.11) P. Stuer - Implements an oscilloscope. **/
+/** $VER: Oscilloscope.cpp (2026.10.18) P. Stuer - Implements an oscilloscope. **/
 
 #include <pch.h>
 
@@ -117,14 +117,17 @@ void oscilloscope_t::Resize() noexcept
 /// </summary>
 void oscilloscope_t::Render(ID2D1DeviceContext * deviceContext) noexcept
 {
-    const size_t FrameCount     = _Analysis->_Chunk.get_sample_count();     // get_sample_count() actually returns the number of frames.
-    const uint32_t ChannelCount = _Analysis->_Chunk.get_channel_count();
-
     // Bail out if no audio is playing. We need the channel count and configuration to draw the axes.
+    if (_Analysis->_Chunk == nullptr)
+        return;
+
+    const size_t FrameCount     = _Analysis->_Chunk->get_sample_count();    // get_sample_count() actually returns the number of frames.
+    const uint32_t ChannelCount = _Analysis->_Chunk->get_channel_count();
+
     if ((FrameCount == 0) || (ChannelCount == 0))
         return;
 
-    if (_ChunkDuration != _Analysis->_Chunk.get_duration())
+    if (_ChunkDuration != _Analysis->_Chunk->get_duration())
         _AxesCommandList.Release();
 
     HRESULT hr = CreateDeviceSpecificResources(deviceContext);
@@ -152,8 +155,20 @@ void oscilloscope_t::Render(ID2D1DeviceContext * deviceContext) noexcept
         const D2D1_SIZE_F SignalSize = { _Size.width - (YAxisWidth * YAxisCount), _Size.height };
 
         CComPtr<ID2D1PathGeometry> Geometry;
+        CComPtr<ID2D1PathGeometry> RMSGeometry;
+
+        bool IsEnvelope = false;
+
+        if (_State->_EnvelopeMode)
+        {
+            hr = CreateEnvelopeGeometry(SignalSize, Geometry, RMSGeometry);
+
+            IsEnvelope = (hr == S_OK);
+        }
 
-        hr = CreateSignalGeometry(SignalSize, Geometry);
+        // Fall back to the signal line when there are not enough samples to fill the columns of an envelope.
+        if (SUCCEEDED(hr) && !IsEnvelope)
+            hr = CreateSignalGeometry(SignalSize, Geometry);
 
         if (SUCCEEDED(hr))
         {
@@ -169,7 +184,23 @@ void oscilloscope_t::Render(ID2D1DeviceContext * deviceContext) noexcept
 
             _DeviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
-            _DeviceContext->DrawGeometry(Geometry, _SignalLineStyle->_Brush, _SignalLineStyle->_Thickness, _SignalStrokeStyle);
+            if (IsEnvelope)
+            {
+                // Render the envelope with half the opacity when the RMS band is rendered on top of it.
+                if (RMSGeometry != nullptr)
+                    _SignalLineStyle->_Brush->SetOpacity(_SignalLineStyle->_Opacity * 0.5f);
+
+                _DeviceContext->FillGeometry(Geometry, _SignalLineStyle->_Brush);
+
+                if (RMSGeometry != nullptr)
+                {
+                    _SignalLineStyle->_Brush->SetOpacity(_SignalLineStyle->_Opacity);
+
+                    _DeviceContext->FillGeometry(RMSGeometry, _SignalLineStyle->_Brush);
+                }
+            }
+            else
+                _DeviceContext->DrawGeometry(Geometry, _SignalLineStyle->_Brush, _SignalLineStyle->_Thickness, _SignalStrokeStyle);
 
             _DeviceContext->PopAxisAlignedClip();
 
@@ -287,33 +318,40 @@ void oscilloscope_t::DeleteDeviceSpecificResources() noexcept
 }
 
 /// <summary>
-/// Creates the path geometry for the signal.
+/// Scales a range of sample values. The scaler can fold the negative values onto the positive values so the extremes of the scaled range are not necessarily the scaled extremes.
 /// </summary>
-HRESULT oscilloscope_t::CreateSignalGeometry(const D2D1_SIZE_F & clientSize, CComPtr<ID2D1PathGeometry> & Geometry) noexcept
+static void ScaleRange(const amplitude_scaler_t & scaler, double min, double max, double & lo, double & hi) noexcept
 {
-    amplitude_scaler_t Scaler;
+    lo = scaler(min);
+    hi = scaler(max);
 
-    switch (_Settings->_YAxisMode)
-    {
-        case YAxisMode::None:
-            Scaler.SetNormalizedMode();
-            break;
+    if (lo > hi)
+        std::swap(lo, hi);
 
-        case YAxisMode::Decibels:
-            Scaler.SetDecibelMode(_Settings->_AmplitudeLo, _Settings->_AmplitudeHi);
-            break;
+    if ((min < 0.) && (max > 0.))
+    {
+        const double Zero = scaler(0.);
 
-        case YAxisMode::Linear:
-            Scaler.SetLinearMode(_Settings->_AmplitudeLo, _Settings->_AmplitudeHi, _Settings->_Gamma, _Settings->_UseAbsolute);
-            break;
+        lo = std::min(lo, Zero);
+        hi = std::max(hi, Zero);
     }
+}
 
-    const size_t FrameCount     = _Analysis->_Chunk.get_sample_count();    // get_sample_count() actually returns the number of frames.
-    const uint32_t ChannelCount = _Analysis->_Chunk.get_channel_count();
+/// <summary>
+/// Creates the path geometry for the signal.
+/// </summary>
+HRESULT oscilloscope_t::CreateSignalGeometry(const D2D1_SIZE_F & clientSize, CComPtr<ID2D1PathGeometry> & Geometry) noexcept
+{
+    amplitude_scaler_t Scaler;
+
+    InitializeScaler(Scaler);
+
+    const size_t FrameCount     = _Analysis->_Chunk->get_sample_count();    // get_sample_count() actually returns the number of frames.
+    const uint32_t ChannelCount = _Analysis->_Chunk->get_channel_count();
 
-    const audio_sample * Samples = _Analysis->_Chunk.get_data();
+    const audio_sample * Samples = _Analysis->_Chunk->get_data();
 
-    uint32_t ChunkChannels    = _Analysis->_Chunk.get_channel_config(); // Mask containing the channels in the audio chunk.
+    uint32_t ChunkChannels    = _Analysis->_Chunk->get_channel_config(); // Mask containing the channels in the audio chunk.
     uint32_t SelectedChannels = _Settings->_SelectedChannels;      // Mask containing the channels selected by the user.
 
     const size_t SelectedChannelCount = (size_t) std::popcount(ChunkChannels & _Settings->_SelectedChannels);
@@ -333,7 +371,12 @@ HRESULT oscilloscope_t::CreateSignalGeometry(const D2D1_SIZE_F & clientSize, CCo
 
         FLOAT ChannelBaseline = ChannelMax;
         size_t ChannelOffset = 0;
-            
+        size_t ChannelIndex = 0; // Index of the selected channel
+
+        // Reduce the samples to one min/max pair per pixel column when there are more samples than columns so the number of vertices depends on the width instead of the sample rate.
+        const size_t ColumnCount = (size_t) std::ceil(clientSize.width);
+        const bool UseEnvelope = (ColumnCount != 0) && (FrameCount > ColumnCount * 2) && (_Analysis->_Pyramids.size() == SelectedChannelCount);
+
         while ((ChunkChannels != 0) && (SelectedChannels != 0))
         {
             // Render the signal if the channel is in the chunk and if it has been selected.
@@ -341,25 +384,67 @@ HRESULT oscilloscope_t::CreateSignalGeometry(const D2D1_SIZE_F & clientSize, CCo
             {
                 if (SelectedChannels & 1)
                 {
-                    const size_t SampleCount = FrameCount * ChannelCount;
-                    const FLOAT dx = clientSize.width / (FLOAT) FrameCount;
+                    if (UseEnvelope)
+                    {
+                        const min_max_pyramid_t & Pyramid = _Analysis->_Pyramids[ChannelIndex];
 
-                    FLOAT x = 0.f;
-                    FLOAT y = ChannelBaseline - (std::clamp((FLOAT) (Scaler(Samples[ChannelOffset]) * _State->_YGain), -1.f, 1.f) * ChannelMax);
+                        const FLOAT dx = clientSize.width / (FLOAT) ColumnCount;
 
-                    Sink->BeginFigure(D2D1::Point2F(x, y), D2D1_FIGURE_BEGIN_HOLLOW);
+                        FLOAT y = 0.f; // End point of the previous column
 
-                    for (size_t j = ChannelCount + ChannelOffset; j < SampleCount; j += ChannelCount)
-                    {
-                        x += dx;
-                        y = ChannelBaseline - (std::clamp((FLOAT) (Scaler(Samples[j]) * _State->_YGain), -1.f, 1.f) * ChannelMax);
+                        for (size_t i = 0; i < ColumnCount; ++i)
+                        {
+                            audio_sample Min, Max;
+
+                            Pyramid.GetRange((i * FrameCount) / ColumnCount, ((i + 1) * FrameCount) / ColumnCount, Min, Max);
+
+                            double Lo, Hi;
+
+                            ScaleRange(Scaler, Min, Max, Lo, Hi);
+
+                            const FLOAT x  = ((FLOAT) i + 0.5f) * dx;
+                            FLOAT       y1 = ChannelBaseline - (std::clamp((FLOAT) (Lo * _State->_YGain), -1.f, 1.f) * ChannelMax);
+                            FLOAT       y2 = ChannelBaseline - (std::clamp((FLOAT) (Hi * _State->_YGain), -1.f, 1.f) * ChannelMax);
+
+                            // Start each column at the end that is closest to the end of the previous column to keep the trace continuous.
+                            if ((i != 0) && (std::abs(y - y2) < std::abs(y - y1)))
+                                std::swap(y1, y2);
+
+                            if (i == 0)
+                                Sink->BeginFigure(D2D1::Point2F(x, y1), D2D1_FIGURE_BEGIN_HOLLOW);
+                            else
+                                Sink->AddLine(D2D1::Point2F(x, y1));
+
+                            Sink->AddLine(D2D1::Point2F(x, y2));
+
+                            y = y2;
+                        }
 
-                        Sink->AddLine(D2D1::Point2F(x, y));
+                        Sink->EndFigure(D2D1_FIGURE_END_OPEN);
                     }
+                    else
+                    {
+                        const size_t SampleCount = FrameCount * ChannelCount;
+                        const FLOAT dx = clientSize.width / (FLOAT) FrameCount;
+
+                        FLOAT x = 0.f;
+                        FLOAT y = ChannelBaseline - (std::clamp((FLOAT) (Scaler(Samples[ChannelOffset]) * _State->_YGain), -1.f, 1.f) * ChannelMax);
 
-                    Sink->EndFigure(D2D1_FIGURE_END_OPEN);
+                        Sink->BeginFigure(D2D1::Point2F(x, y), D2D1_FIGURE_BEGIN_HOLLOW);
+
+                        for (size_t j = ChannelCount + ChannelOffset; j < SampleCount; j += ChannelCount)
+                        {
+                            x += dx;
+                            y = ChannelBaseline - (std::clamp((FLOAT) (Scaler(Samples[j]) * _State->_YGain), -1.f, 1.f) * ChannelMax);
+
+                            Sink->AddLine(D2D1::Point2F(x, y));
+                        }
+
+                        Sink->EndFigure(D2D1_FIGURE_END_OPEN);
+                    }
 
                     ChannelBaseline += ChannelHeight;
+                    ++ChannelIndex;
                 }
 
                 ChannelOffset++;
@@ -375,12 +460,153 @@ HRESULT oscilloscope_t::CreateSignalGeometry(const D2D1_SIZE_F & clientSize, CCo
     return hr;
 }
 
+/// <summary>
+/// Creates the filled path geometry of the min/max envelope of each selected channel and, optionally, of the RMS band inside it. Each pixel column contributes 2 vertices to each figure.
+/// Returns S_FALSE if the window does not contain more samples than there are columns.
+/// </summary>
+HRESULT oscilloscope_t::CreateEnvelopeGeometry(const D2D1_SIZE_F & clientSize, CComPtr<ID2D1PathGeometry> & envelope, CComPtr<ID2D1PathGeometry> & rms) noexcept
+{
+    const size_t FrameCount = _Analysis->_Chunk->get_sample_count();    // get_sample_count() actually returns the number of frames.
+
+    const size_t SelectedChannelCount = (size_t) std::popcount(_Analysis->_Chunk->get_channel_config() & _Settings->_SelectedChannels);
+    const size_t ColumnCount = (size_t) std::ceil(clientSize.width);
+
+    if ((SelectedChannelCount == 0) || (ColumnCount == 0) || (FrameCount <= ColumnCount * 2) || (_Analysis->_Pyramids.size() != SelectedChannelCount))
+        return S_FALSE;
+
+    amplitude_scaler_t Scaler;
+
+    InitializeScaler(Scaler);
+
+    const FLOAT ChannelHeight = clientSize.height / (FLOAT) SelectedChannelCount; // Height available to one channel.
+    const FLOAT ChannelMax = ChannelHeight * (_Settings->HasYAxis() ? 1.0f : 0.5f);
+    const FLOAT MinHeight = _SignalLineStyle->_Thickness; // Keep a silent signal visible.
+    const FLOAT dx = clientSize.width / (FLOAT) ColumnCount;
+
+    CComPtr<ID2D1GeometrySink> EnvelopeSink;
+    CComPtr<ID2D1GeometrySink> RMSSink;
+
+    HRESULT hr = _Direct2D.Factory->CreatePathGeometry(&envelope);
+
+    if (SUCCEEDED(hr))
+        hr = envelope->Open(&EnvelopeSink);
+
+    if (SUCCEEDED(hr) && _State->_RMSTrace)
+    {
+        hr = _Direct2D.Factory->CreatePathGeometry(&rms);
+
+        if (SUCCEEDED(hr))
+            hr = rms->Open(&RMSSink);
+    }
+
+    if (!SUCCEEDED(hr))
+        return hr;
+
+    // The top of column i is stored at index i, the bottom at index 2n - 1 - i so each figure is a single run of vertices.
+    _Envelope.resize(ColumnCount * 2);
+    _RMS.resize(ColumnCount * 2);
+
+    auto ToY = [this, ChannelMax](FLOAT baseline, double value) { return baseline - (std::clamp((FLOAT) (value * _State->_YGain), -1.f, 1.f) * ChannelMax); };
+
+    FLOAT ChannelBaseline = ChannelMax;
+
+    for (const auto & Pyramid : _Analysis->_Pyramids)
+    {
+        for (size_t i = 0; i < ColumnCount; ++i)
+        {
+            const size_t First = (i * FrameCount) / ColumnCount;
+            const size_t Last  = ((i + 1) * FrameCount) / ColumnCount;
+
+            audio_sample Min, Max;
+
+            Pyramid.GetRange(First, Last, Min, Max);
+
+            double Lo, Hi;
+
+            ScaleRange(Scaler, Min, Max, Lo, Hi);
+
+            const FLOAT x = ((FLOAT) i + 0.5f) * dx;
+
+            FLOAT y1 = ToY(ChannelBaseline, Hi);
+            FLOAT y2 = ToY(ChannelBaseline, Lo);
+
+            if (y2 - y1 < MinHeight)
+            {
+                const FLOAT y = (y1 + y2) / 2.f;
+
+                y1 = y - (MinHeight / 2.f);
+                y2 = y + (MinHeight / 2.f);
+            }
+
+            _Envelope[i]                         = { x, y1 };
+            _Envelope[(ColumnCount * 2) - 1 - i] = { x, y2 };
+
+            if (RMSSink != nullptr)
+            {
+                const double RMS = Pyramid.GetRMS(First, Last);
+
+                ScaleRange(Scaler, -RMS, RMS, Lo, Hi);
+
+                _RMS[i]                         = { x, ToY(ChannelBaseline, Hi) };
+                _RMS[(ColumnCount * 2) - 1 - i] = { x, ToY(ChannelBaseline, Lo) };
+            }
+        }
+
+        AddEnvelope(EnvelopeSink, _Envelope.data(), ColumnCount);
+
+        if (RMSSink != nullptr)
+            AddEnvelope(RMSSink, _RMS.data(), ColumnCount);
+
+        ChannelBaseline += ChannelHeight;
+    }
+
+    hr = EnvelopeSink->Close();
+
+    if (SUCCEEDED(hr) && (RMSSink != nullptr))
+        hr = RMSSink->Close();
+
+    return hr;
+}
+
+/// <summary>
+/// Adds a closed figure to the specified sink that runs along the top of the columns from left to right and back along the bottom.
+/// </summary>
+void oscilloscope_t::AddEnvelope(ID2D1GeometrySink * sink, const D2D1_POINT_2F * points, size_t columnCount) noexcept
+{
+    sink->BeginFigure(points[0], D2D1_FIGURE_BEGIN_FILLED);
+
+    sink->AddLines(points + 1, (UINT32) ((columnCount * 2) - 1));
+
+    sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+}
+
+/// <summary>
+/// Initializes the amplitude scaler for the Y-axis mode of the graph.
+/// </summary>
+void oscilloscope_t::InitializeScaler(amplitude_scaler_t & scaler) const noexcept
+{
+    switch (_Settings->_YAxisMode)
+    {
+        case YAxisMode::None:
+            scaler.SetNormalizedMode();
+            break;
+
+        case YAxisMode::Decibels:
+            scaler.SetDecibelMode(_Settings->_AmplitudeLo, _Settings->_AmplitudeHi);
+            break;
+
+        case YAxisMode::Linear:
+            scaler.SetLinearMode(_Settings->_AmplitudeLo, _Settings->_AmplitudeHi, _Settings->_Gamma, _Settings->_UseAbsolute);
+            break;
+    }
+}
+
 /// <summary>
 /// Creates a command list to render the grid and the X and Y axis labels.
 /// </summary>
 HRESULT oscilloscope_t::CreateAxesCommandList() noexcept
 {
-    const size_t SelectedChannelCount = (size_t) std::popcount(_Analysis->_Chunk.get_channel_config() & _Settings->_SelectedChannels);
+    const size_t SelectedChannelCount = (size_t) std::popcount(_Analysis->_Chunk->get_channel_config() & _Settings->_SelectedChannels);
     const FLOAT ChannelHeight = _Size.height / (FLOAT) SelectedChannelCount; // Height available to one channel.
     const FLOAT YAxisWidth = _YAxisTextStyle->_Width;
 
@@ -464,7 +690,7 @@ HRESULT oscilloscope_t::CreateAxesCommandList() noexcept
 
             D2D1_RECT_F TextRect = { 0.f, 0.f, x2, 0.f };
 
-            _ChunkDuration = _Analysis->_Chunk.get_duration();
+            _ChunkDuration = _Analysis->_Chunk->get_duration();
 
             const int dt = (int) (_ChunkDuration * 100.); // Convert to 10-milliseconds units
 
@@ -1,5 +1,5 @@
 
-/** $VER: Oscilloscope.h (2026.02.22) P. Stuer - Implements an oscilloscope. **/
+/** $VER: Oscilloscope.h (2026.10.18) P. Stuer - Implements an oscilloscope. **/
 
 #pragma once
 
@@ -7,6 +7,8 @@
 
 #include "OscilloscopeBase.h"
 
+class amplitude_scaler_t;
+
 class oscilloscope_t : public oscilloscope_base_t
 {
 public:
@@ -35,6 +37,10 @@ private:
     void DeleteDeviceSpecificResources() noexcept;
 
     HRESULT CreateSignalGeometry(const D2D1_SIZE_F & size, CComPtr<ID2D1PathGeometry> & geometry) noexcept;
+    HRESULT CreateEnvelopeGeometry(const D2D1_SIZE_F & size, CComPtr<ID2D1PathGeometry> & envelope, CComPtr<ID2D1PathGeometry> & rms) noexcept;
+    static void AddEnvelope(ID2D1GeometrySink * sink, const D2D1_POINT_2F * points, size_t columnCount) noexcept;
+
+    void InitializeScaler(amplitude_scaler_t & scaler) const noexcept;
     HRESULT CreateAxesCommandList() noexcept;
 
 private:
@@ -49,6 +55,9 @@ private:
 
     std::vector<label_t> _Labels;
 
+    std::vector<D2D1_POINT_2F> _Envelope;   // Top and bottom of each column of the envelope, left to right. Reused each frame.
+    std::vector<D2D1_POINT_2F> _RMS;        // Top and bottom of each column of the RMS band, left to right. Reused each frame.
+
     style_t * _XAxisTextStyle;
     style_t * _YAxisTextStyle;
 
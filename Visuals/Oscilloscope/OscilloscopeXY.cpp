@@ -1,5 +1,5 @@
 
-/** $VER: OscilloscopeXY.cpp (2026.03.11) P. Stuer - Implements an oscilloscope in X-Y mode. **/
+/** $VER: OscilloscopeXY.cpp (2026.10.18) P. Stuer - Implements an oscilloscope in X-Y mode. **/
 
 #include <pch.h>
 
@@ -107,12 +107,15 @@ void oscilloscope_xy_t::Render(ID2D1DeviceContext * deviceContext) noexcept
     const auto Scale     = D2D1::Matrix3x2F::Scale(D2D1::SizeF(_ScaleFactor, _ScaleFactor));
     const auto Rotate    = D2D1::Matrix3x2F::Rotation(_State->_Rotation, D2D1::Point2F(0.f, 0.f));
 
-    if (!_State->_IsPaused || (_State->_IsPaused && _State->_VisualizeDuringPause))
+    if (_State->_PhosphorDecay)
+        hr = UpdatePhosphor(Rotate * Scale * Translate);
+    else
+    if ((_Analysis->_Chunk != nullptr) && (!_State->_IsPaused || (_State->_IsPaused && _State->_VisualizeDuringPause)))
     {
-        const size_t FrameCount     = _Analysis->_Chunk.get_sample_count();                         // get_sample_count() actually returns the number of frames.
-        const uint32_t ChannelCount = _Analysis->_Chunk.get_channel_count();
+        const size_t FrameCount     = _Analysis->_Chunk->get_sample_count();                         // get_sample_count() actually returns the number of frames.
+        const uint32_t ChannelCount = _Analysis->_Chunk->get_channel_count();
 
-        const uint32_t ChunkChannels    = _Analysis->_Chunk.get_channel_config();                   // Mask containing the channels in the audio chunk.
+        const uint32_t ChunkChannels    = _Analysis->_Chunk->get_channel_config();                   // Mask containing the channels in the audio chunk.
         const uint32_t SelectedChannels = _Settings->_SelectedChannels;                             // Mask containing the channels selected by the user.
         const uint32_t BalanceChannels  = analysis_t::ChannelPairs[(size_t) _State->_ChannelPair];  // Mask containing the channels selected by the user as a channel pair.
 
@@ -120,7 +123,7 @@ void oscilloscope_xy_t::Render(ID2D1DeviceContext * deviceContext) noexcept
 
         if ((FrameCount >= 2) && (ChannelCount >= 2) && (ChannelMask != 0))
         {
-            const audio_sample * Samples = _Analysis->_Chunk.get_data();
+            const audio_sample * Samples = _Analysis->_Chunk->get_data();
 
             const size_t Channel1 = (size_t) std::countr_zero(ChannelMask);         // Index of the channel 1 sample in the audio chunk.
             const size_t Channel2 = (size_t) (31 - std::countl_zero(ChannelMask));  // Index of the channel 2 sample in the audio chunk.
@@ -147,7 +150,9 @@ void oscilloscope_xy_t::Render(ID2D1DeviceContext * deviceContext) noexcept
 
                     Sink->BeginFigure(D2D1::Point2F(x, y), D2D1_FIGURE_BEGIN_HOLLOW);
 
-                    for (size_t i = ChannelCount; i < FrameCount; i += ChannelCount)
+                    const size_t SampleCount = FrameCount * ChannelCount;
+
+                    for (size_t i = ChannelCount; i < SampleCount; i += ChannelCount)
                     {
                         x = (FLOAT) std::clamp(Samples[i + Channel1] * _State->_XGain, -1., 1.);
                         y = (FLOAT) std::clamp(Samples[i + Channel2] * _State->_YGain, -1., 1.);
@@ -194,39 +199,35 @@ void oscilloscope_xy_t::Render(ID2D1DeviceContext * deviceContext) noexcept
             deviceContext->SetTransform(D2D1::Matrix3x2F::Identity());
         }
 
-        // Draw the back buffer to the window.
+        if (_State->_PhosphorDecay)
         {
-            deviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_ADD);
-
-            deviceContext->DrawBitmap(_BackBuffer);
-
-            deviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_SOURCE_OVER);
+            // Draw the phosphor image to the window. Its alpha channel follows the intensity so it blends with the background.
+            if (_PhosphorBitmap != nullptr)
+                deviceContext->DrawBitmap(_PhosphorBitmap);
         }
-
-        // Add the phosphor afterglow effect before the next pass.
+        else
         {
-            _DeviceContext->SetTarget(_FrontBuffer);
-            _DeviceContext->BeginDraw();
-
-            if (_State->_PhosphorDecay)
+            // Draw the back buffer to the window.
             {
-                _GaussBlurEffect->SetInput(0, _BackBuffer);
+                deviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_ADD);
 
-                _DeviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_ADD);
-                _DeviceContext->DrawImage(_GaussBlurEffect);
+                deviceContext->DrawBitmap(_BackBuffer);
 
-                _ColorMatrixEffect->SetInput(0, _BackBuffer);
-
-                _DeviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_SOURCE_OVER);
-                _DeviceContext->DrawImage(_ColorMatrixEffect);
+                deviceContext->SetPrimitiveBlend(D2D1_PRIMITIVE_BLEND_SOURCE_OVER);
             }
-            else
+
+            // Clear the front buffer before the next pass.
+            {
+                _DeviceContext->SetTarget(_FrontBuffer);
+                _DeviceContext->BeginDraw();
+
                 _DeviceContext->Clear(); // Required for alpha transparency
 
-            hr = _DeviceContext->EndDraw();
-        }
+                hr = _DeviceContext->EndDraw();
+            }
 
-        std::swap(_FrontBuffer, _BackBuffer);
+            std::swap(_FrontBuffer, _BackBuffer);
+        }
     }
 }
 
@@ -282,6 +283,8 @@ HRESULT oscilloscope_xy_t::CreateDeviceSpecificResources(ID2D1DeviceContext * de
 /// </summary>
 void oscilloscope_xy_t::DeleteDeviceSpecificResources() noexcept
 {
+    _PhosphorBitmap.Release();
+
     _GridCommandList.Release();
 
     if (_YAxisTextStyle)
@@ -299,6 +302,97 @@ void oscilloscope_xy_t::DeleteDeviceSpecificResources() noexcept
     oscilloscope_base_t::DeleteDeviceSpecificResources();
 }
 
+/// <summary>
+/// Lets the phosphor decay, adds the path of the beam through the samples of the chunk and copies the resulting image to the phosphor bitmap.
+/// </summary>
+HRESULT oscilloscope_xy_t::UpdatePhosphor(const D2D1::Matrix3x2F & transform) noexcept
+{
+    const size_t Width  = (size_t) _Size.width;
+    const size_t Height = (size_t) _Size.height;
+
+    if ((Width == 0) || (Height == 0))
+        return S_FALSE;
+
+    HRESULT hr = S_OK;
+
+    if ((_PhosphorBitmap == nullptr) || (_Phosphor.GetWidth() != Width) || (_Phosphor.GetHeight() != Height))
+    {
+        _PhosphorBitmap.Release();
+
+        if (!_Phosphor.Initialize(Width, Height))
+            return E_OUTOFMEMORY;
+
+        const D2D1_BITMAP_PROPERTIES BitmapProperties = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+
+        hr = _DeviceContext->CreateBitmap(D2D1::SizeU((UINT32) Width, (UINT32) Height), nullptr, 0, BitmapProperties, &_PhosphorBitmap);
+
+        if (!SUCCEEDED(hr))
+            return hr;
+    }
+
+    // The color of a fully lit pixel is the color of the signal line.
+    {
+        const uint16_t MaxValue = UINT16_MAX;
+
+        uint32_t Color = 0;
+
+        _SignalLineStyle->GetPixels(&MaxValue, 1, &Color);
+
+        _Phosphor.SetColor(Color);
+    }
+
+    _Phosphor.SetBlur(_State->_BlurSigma);
+    _Phosphor.Decay(_State->_DecayFactor);
+
+    if ((_Analysis->_Chunk != nullptr) && (!_State->_IsPaused || (_State->_IsPaused && _State->_VisualizeDuringPause)))
+    {
+        const size_t FrameCount     = _Analysis->_Chunk->get_sample_count();                         // get_sample_count() actually returns the number of frames.
+        const uint32_t ChannelCount = _Analysis->_Chunk->get_channel_count();
+
+        const uint32_t ChunkChannels    = _Analysis->_Chunk->get_channel_config();                   // Mask containing the channels in the audio chunk.
+        const uint32_t SelectedChannels = _Settings->_SelectedChannels;                             // Mask containing the channels selected by the user.
+        const uint32_t BalanceChannels  = analysis_t::ChannelPairs[(size_t) _State->_ChannelPair];  // Mask containing the channels selected by the user as a channel pair.
+
+        const uint32_t ChannelMask = ChunkChannels & SelectedChannels & BalanceChannels;
+
+        if ((FrameCount >= 2) && (ChannelCount >= 2) && (ChannelMask != 0))
+        {
+            const audio_sample * Samples = _Analysis->_Chunk->get_data();
+
+            const size_t Channel1 = (size_t) std::countr_zero(ChannelMask);         // Index of the channel 1 sample in the audio chunk.
+            const size_t Channel2 = (size_t) (31 - std::countl_zero(ChannelMask));  // Index of the channel 2 sample in the audio chunk.
+
+            const FLOAT Intensity = _SignalLineStyle->_Thickness; // Intensity deposited by the beam between 2 samples.
+
+            const size_t SampleCount = FrameCount * ChannelCount;
+
+            D2D1_POINT_2F p1 = { };
+
+            for (size_t i = 0; i < SampleCount; i += ChannelCount)
+            {
+                FLOAT x = (FLOAT) std::clamp(Samples[i + Channel1] * _State->_XGain, -1., 1.);
+                FLOAT y = (FLOAT) std::clamp(Samples[i + Channel2] * _State->_YGain, -1., 1.);
+
+                if (_Settings->_SwapChannels)
+                    std::swap(x, y);
+
+                const D2D1_POINT_2F p2 = transform.TransformPoint(D2D1::Point2F(x, y));
+
+                if (i == 0)
+                    p1 = p2;
+
+                _Phosphor.AddLine(p1.x, p1.y, p2.x, p2.y, Intensity);
+
+                p1 = p2;
+            }
+        }
+    }
+
+    const uint32_t * Pixels = _Phosphor.Resolve();
+
+    return _PhosphorBitmap->CopyFromMemory(nullptr, Pixels, (UINT32) (Width * sizeof(uint32_t)));
+}
+
 /// <summary>
 /// Creates a command list to render the grid and the X and Y axis labels.
 /// This is created in a -1 .. 1 axis setup and scaled up as necessary.
@@ -1,11 +1,12 @@
 
-/** $VER: Oscilloscope.h (2026.02.22) P. Stuer - Implements an oscilloscope in X-Y mode. **/
+/** $VER: Oscilloscope.h (2026.10.18) P. Stuer - Implements an oscilloscope in X-Y mode. **/
 
 #pragma once
 
 #include <pch.h>
 
 #include "OscilloscopeBase.h"
+#include "PhosphorBuffer.h"
 
 class oscilloscope_xy_t : public oscilloscope_base_t
 {
@@ -36,9 +37,14 @@ private:
 
     HRESULT CreateGridCommandList() noexcept;
 
+    HRESULT UpdatePhosphor(const D2D1::Matrix3x2F & transform) noexcept;
+
 private:
     style_t * _XAxisTextStyle;
     style_t * _YAxisTextStyle;
 
     CComPtr<ID2D1CommandList> _GridCommandList;
+
+    phosphor_buffer_t _Phosphor;                // Accumulates the intensity of the beam when the phosphor decay effect is enabled.
+    CComPtr<ID2D1Bitmap> _PhosphorBitmap;       // Image of the phosphor buffer.
 };
@@ -0,0 +1,344 @@
+
+/** $VER: PhosphorBuffer.cpp (2026.10.18) P. Stuer - Implements the intensity accumulation buffer of the phosphor decay effect. **/
+
+#include "PhosphorBuffer.h"
+#include "SIMD.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Allocates a buffer of the specified size (in pixels). The buffer is cleared. Returns false if the buffer could not be allocated.
+/// </summary>
+bool phosphor_buffer_t::Initialize(size_t width, size_t height) noexcept
+{
+    try
+    {
+        _Intensity.assign(width * height, 0.f);
+        _Glow.assign(width * height, 0.f);
+        _Scratch.assign(width * height, 0.f);
+        _Pixels.assign(width * height, 0);
+
+        _Width  = width;
+        _Height = height;
+
+        SetBlur(_Sigma);
+
+        return true;
+    }
+    catch (...)
+    {
+        _Intensity.clear();
+        _Glow.clear();
+        _Scratch.clear();
+        _Pixels.clear();
+
+        _Width = _Height = 0;
+
+        return false;
+    }
+}
+
+/// <summary>
+/// Turns off all pixels.
+/// </summary>
+void phosphor_buffer_t::Clear() noexcept
+{
+    std::fill(_Intensity.begin(), _Intensity.end(), 0.f);
+}
+
+/// <summary>
+/// Sets the premultiplied BGRA color of a fully lit pixel. Lower intensities scale all 4 channels so the color fades to transparent instead of to black.
+/// </summary>
+void phosphor_buffer_t::SetColor(uint32_t color) noexcept
+{
+    if ((color == _Color) && (_Levels[LevelCount - 1] == color))
+        return;
+
+    _Color = color;
+
+    for (uint32_t i = 0; i < LevelCount; ++i)
+    {
+        uint32_t Level = 0;
+
+        for (uint32_t Shift = 0; Shift < 32; Shift += 8)
+            Level |= ((((color >> Shift) & 0xFF) * i + ((LevelCount - 1) / 2)) / (LevelCount - 1)) << Shift;
+
+        _Levels[i] = Level;
+    }
+}
+
+/// <summary>
+/// Sets the standard deviation of the glow (in pixels). Specify 0 to disable the glow.
+/// </summary>
+void phosphor_buffer_t::SetBlur(double sigma) noexcept
+{
+    sigma = std::max(sigma, 0.);
+
+    if ((sigma == _Sigma) && (_Kernel.empty() || (_Row.size() == _Width + _Kernel.size() - 1)))
+        return;
+
+    _Sigma = sigma;
+
+    const size_t Radius = (size_t) std::ceil(_Sigma * 3.);
+
+    _Kernel.clear();
+
+    if (Radius == 0)
+        return;
+
+    double Sum = 0.;
+
+    for (size_t i = 0; i < (2 * Radius) + 1; ++i)
+    {
+        const double x = (double) i - (double) Radius;
+        const double Weight = std::exp(-(x * x) / (2. * _Sigma * _Sigma));
+
+        _Kernel.push_back((float) Weight);
+        Sum += Weight;
+    }
+
+    for (auto & Weight : _Kernel)
+        Weight = (float) (Weight / Sum);
+
+    _Row.assign(_Width + (2 * Radius), 0.f); // Padded with the radius on both sides.
+}
+
+/// <summary>
+/// Lets the intensity of all pixels decay by the specified factor. Intensities that become too low to be visible are turned off.
+/// </summary>
+void phosphor_buffer_t::Decay(float factor) noexcept
+{
+    const float Threshold = 0.5f / (float) (LevelCount - 1); // Prevents the intensities from decaying into denormals.
+
+    float * Data = _Intensity.data();
+    const size_t Count = _Intensity.size();
+
+    size_t i = 0;
+
+#if defined(SIMD_SSE2)
+    {
+        const __m128 f = _mm_set1_ps(factor);
+        const __m128 t = _mm_set1_ps(Threshold);
+
+        for (; i + 4 <= Count; i += 4)
+        {
+            const __m128 v = _mm_mul_ps(_mm_loadu_ps(Data + i), f);
+
+            _mm_storeu_ps(Data + i, _mm_and_ps(v, _mm_cmpge_ps(v, t)));
+        }
+    }
+#endif
+
+    for (; i < Count; ++i)
+    {
+        const float v = Data[i] * factor;
+
+        Data[i] = (v >= Threshold) ? v : 0.f;
+    }
+}
+
+/// <summary>
+/// Adds the path of the beam from one sample to the next (in pixels). The beam deposits the specified intensity in the pixels along the line with a resolution of 1 pixel.
+/// The intensity is divided along the line so a fast moving beam is dimmer than a slow moving one, but no point of a long line gets less than a quarter of it.
+/// </summary>
+void phosphor_buffer_t::AddLine(float x1, float y1, float x2, float y2, float intensity) noexcept
+{
+    if (_Intensity.empty())
+        return;
+
+    // Invalid coordinates would index pixels outside the buffer.
+    if (!std::isfinite(x1) || !std::isfinite(y1) || !std::isfinite(x2) || !std::isfinite(y2))
+        return;
+
+    const float dx = x2 - x1;
+    const float dy = y2 - y1;
+
+    const size_t n = (size_t) std::ceil(std::sqrt((dx * dx) + (dy * dy))); // Number of steps of at most 1 pixel.
+
+    if (n == 0)
+    {
+        AddPoint(x2, y2, intensity);
+        return;
+    }
+
+    // Skip lines that lie completely outside the buffer.
+    if ((std::max(x1, x2) < -1.f) || (std::min(x1, x2) > (float) _Width + 1.f) || (std::max(y1, y2) < -1.f) || (std::min(y1, y2) > (float) _Height + 1.f))
+        return;
+
+    const float Weight = std::max(intensity / (float) n, intensity / 4.f);
+
+    // The start point was added as the end point of the previous line.
+    for (size_t i = 1; i <= n; ++i)
+    {
+        const float t = (float) i / (float) n;
+
+        AddPoint(x1 + (dx * t), y1 + (dy * t), Weight);
+    }
+}
+
+/// <summary>
+/// Distributes the intensity of a point over the 4 nearest pixels.
+/// </summary>
+void phosphor_buffer_t::AddPoint(float x, float y, float intensity) noexcept
+{
+    // The center of pixel (i, j) is at (i + 0.5, j + 0.5).
+    const float fx = x - 0.5f;
+    const float fy = y - 0.5f;
+
+    const float ix = std::floor(fx);
+    const float iy = std::floor(fy);
+
+    const float wx = fx - ix;
+    const float wy = fy - iy;
+
+    const float Weights[4] = { (1.f - wx) * (1.f - wy), wx * (1.f - wy), (1.f - wx) * wy, wx * wy };
+
+    for (size_t k = 0; k < 4; ++k)
+    {
+        const float px = ix + (float) (k & 1);
+        const float py = iy + (float) (k >> 1);
+
+        if ((px < 0.f) || (py < 0.f) || (px >= (float) _Width) || (py >= (float) _Height))
+            continue;
+
+        _Intensity[((size_t) py * _Width) + (size_t) px] += intensity * Weights[k];
+    }
+}
+
+/// <summary>
+/// Maps the intensity and the glow of each pixel to its color. Intensities are clamped to [0, 1]; NaN is dark. Returns the premultiplied BGRA pixels of the image, row after row.
+/// </summary>
+const uint32_t * phosphor_buffer_t::Resolve() noexcept
+{
+    const bool HasGlow = !_Kernel.empty();
+
+    if (HasGlow)
+        Blur();
+
+    const float * Intensity = _Intensity.data();
+    const float * Glow = HasGlow ? _Glow.data() : nullptr;
+    uint32_t * Pixels = _Pixels.data();
+
+    const size_t Count = _Pixels.size();
+    const float Scale = (float) (LevelCount - 1);
+
+    size_t i = 0;
+
+#if defined(SIMD_SSE2)
+    {
+        const __m128 Zero = _mm_setzero_ps();
+        const __m128 One  = _mm_set1_ps(1.f);
+        const __m128 s    = _mm_set1_ps(Scale);
+        const __m128 Half = _mm_set1_ps(0.5f);
+
+        alignas(16) int32_t Indexes[4];
+
+        for (; i + 4 <= Count; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(Intensity + i);
+
+            if (Glow != nullptr)
+                v = _mm_add_ps(v, _mm_loadu_ps(Glow + i));
+
+            // Clamp to [0, 1]. The maximum returns its second operand, 0, when the intensity is NaN.
+            v = _mm_min_ps(_mm_max_ps(v, Zero), One);
+
+            _mm_store_si128((__m128i *) Indexes, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, s), Half)));
+
+            Pixels[i    ] = _Levels[Indexes[0]];
+            Pixels[i + 1] = _Levels[Indexes[1]];
+            Pixels[i + 2] = _Levels[Indexes[2]];
+            Pixels[i + 3] = _Levels[Indexes[3]];
+        }
+    }
+#endif
+
+    for (; i < Count; ++i)
+    {
+        float v = Intensity[i] + ((Glow != nullptr) ? Glow[i] : 0.f);
+
+        v = !(v > 0.f) ? 0.f : std::min(v, 1.f); // Also maps NaN to 0.
+
+        Pixels[i] = _Levels[(size_t) (v * Scale + 0.5f)];
+    }
+
+    return Pixels;
+}
+
+/// <summary>
+/// Blurs the intensity into the glow with a separable Gaussian kernel. Pixels outside the buffer are dark.
+/// </summary>
+void phosphor_buffer_t::Blur() noexcept
+{
+    const size_t Radius = _Kernel.size() / 2;
+    const size_t Taps   = _Kernel.size();
+    const float * Kernel = _Kernel.data();
+
+    // Horizontal pass: Blur each row through a zero-padded copy.
+    for (size_t y = 0; y < _Height; ++y)
+    {
+        std::copy_n(_Intensity.data() + (y * _Width), _Width, _Row.data() + Radius);
+
+        const float * Src = _Row.data();
+        float * Dst = _Scratch.data() + (y * _Width);
+
+        size_t x = 0;
+
+    #if defined(SIMD_SSE2)
+        for (; x + 4 <= _Width; x += 4)
+        {
+            __m128 Sum = _mm_setzero_ps();
+
+            for (size_t k = 0; k < Taps; ++k)
+                Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(Kernel[k]), _mm_loadu_ps(Src + x + k)));
+
+            _mm_storeu_ps(Dst + x, Sum);
+        }
+    #endif
+
+        for (; x < _Width; ++x)
+        {
+            float Sum = 0.f;
+
+            for (size_t k = 0; k < Taps; ++k)
+                Sum += Kernel[k] * Src[x + k];
+
+            Dst[x] = Sum;
+        }
+    }
+
+    // Vertical pass: Blur the columns, 4 side by side.
+    for (size_t y = 0; y < _Height; ++y)
+    {
+        const size_t First = (y >= Radius) ? 0 : Radius - y;                                // First tap that falls inside the buffer
+        const size_t Last  = std::min(Taps, _Height + Radius - y);                          // Last tap that falls inside the buffer + 1
+
+        const float * Src = _Scratch.data() + ((y + First - Radius) * _Width);             // Row of the first tap
+        float * Dst = _Glow.data() + (y * _Width);
+
+        size_t x = 0;
+
+    #if defined(SIMD_SSE2)
+        for (; x + 4 <= _Width; x += 4)
+        {
+            __m128 Sum = _mm_setzero_ps();
+
+            for (size_t k = First; k < Last; ++k)
+                Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(Kernel[k]), _mm_loadu_ps(Src + ((k - First) * _Width) + x)));
+
+            _mm_storeu_ps(Dst + x, Sum);
+        }
+    #endif
+
+        for (; x < _Width; ++x)
+        {
+            float Sum = 0.f;
+
+            for (size_t k = First; k < Last; ++k)
+                Sum += Kernel[k] * Src[((k - First) * _Width) + x];
+
+            Dst[x] = Sum;
+        }
+    }
+}
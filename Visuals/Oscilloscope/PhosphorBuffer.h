@@ -0,0 +1,65 @@
+
+/** $VER: PhosphorBuffer.h (2026.10.18) P. Stuer - Implements the intensity accumulation buffer of the phosphor decay effect. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Implements the intensity accumulation buffer of the phosphor decay effect. Each frame the intensity of every pixel decays exponentially and the beam adds
+/// intensity along the lines between the samples. The image is the intensity plus a Gaussian glow, mapped to premultiplied BGRA pixels of a single color
+/// so the alpha channel follows the intensity. Portable: does not depend on Windows.
+/// </summary>
+#pragma warning(disable: 4820)
+class phosphor_buffer_t
+{
+public:
+    phosphor_buffer_t() noexcept : _Width(), _Height(), _Sigma(), _Color(), _Levels() { }
+
+    phosphor_buffer_t(const phosphor_buffer_t &) = delete;
+    phosphor_buffer_t & operator=(const phosphor_buffer_t &) = delete;
+    phosphor_buffer_t(phosphor_buffer_t &&) = delete;
+    phosphor_buffer_t & operator=(phosphor_buffer_t &&) = delete;
+
+    bool Initialize(size_t width, size_t height) noexcept;
+    void Clear() noexcept;
+
+    void SetColor(uint32_t color) noexcept;
+    void SetBlur(double sigma) noexcept;
+
+    void Decay(float factor) noexcept;
+    void AddLine(float x1, float y1, float x2, float y2, float intensity) noexcept;
+
+    const uint32_t * Resolve() noexcept;
+
+    size_t GetWidth() const noexcept { return _Width; }
+    size_t GetHeight() const noexcept { return _Height; }
+
+    static const size_t LevelCount = 256;           // Number of entries in the intensity to color table.
+
+private:
+    void AddPoint(float x, float y, float intensity) noexcept;
+    void Blur() noexcept;
+
+private:
+    size_t _Width;
+    size_t _Height;
+
+    std::vector<float> _Intensity;                  // Accumulated intensity of each pixel. 1.0 is a fully lit pixel.
+    std::vector<float> _Glow;                       // Blurred intensity of each pixel.
+    std::vector<float> _Scratch;                    // Horizontally blurred intensity of each pixel.
+    std::vector<float> _Row;                        // Zero-padded row used by the horizontal pass of the blur.
+    std::vector<uint32_t> _Pixels;                  // Premultiplied BGRA pixels of the image.
+
+    double _Sigma;                                  // Standard deviation of the glow (in pixels). 0 disables the glow.
+    std::vector<float> _Kernel;                     // Normalized Gaussian kernel of 2 * radius + 1 taps.
+
+    uint32_t _Color;                                // Premultiplied BGRA color of a fully lit pixel.
+    uint32_t _Levels[LevelCount];                   // Color of each intensity level.
+};
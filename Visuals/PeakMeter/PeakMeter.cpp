@@ -45,6 +45,7 @@ void peak_meter_t::Move(const D2D1_RECT_F & rect) noexcept
 {
     SetRect(rect);
 
+    _RenderedKind = PeakMeasurementKind::Channels;
     _RenderedChannels = 0;
 
     DeleteDeviceSpecificResources();
@@ -55,6 +56,7 @@ void peak_meter_t::Move(const D2D1_RECT_F & rect) noexcept
 /// </summary>
 void peak_meter_t::Reset() noexcept
 {
+    _RenderedKind = PeakMeasurementKind::Channels;
     _RenderedChannels = 0;
     _IsResized = true;
 }
@@ -366,7 +368,7 @@ HRESULT peak_meter_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceC
         hr = deviceContext->CreateSolidColorBrush(D2D1::ColorF(D2D1::ColorF::Red), &_DebugBrush);
 #endif
 
-    if (SUCCEEDED(hr) && (_RenderedChannels != _Analysis->_PeakMeasuredChannels))
+    if (SUCCEEDED(hr) && ((_RenderedKind != _Analysis->_PeakKind) || (_RenderedChannels != _Analysis->_PeakMeasuredChannels)))
     {
         DeleteParts();
 
@@ -374,6 +376,7 @@ HRESULT peak_meter_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceC
 
         MeasureParts(deviceContext);
 
+        _RenderedKind     = _Analysis->_PeakKind;
         _RenderedChannels = _Analysis->_PeakMeasuredChannels;
     }
 
@@ -50,6 +50,7 @@ private:
     void MeasureParts(ID2D1DeviceContext * deviceContext) noexcept;
 
 private:
+    PeakMeasurementKind _RenderedKind;
     uint32_t _RenderedChannels;
 
     const FLOAT _TickSize = 4.f;
@@ -0,0 +1,54 @@
+
+/** $VER: LineRasterizer.cpp (2026.10.18) P. Stuer - Rasterizes a line of the spectrogram in memory. **/
+
+#include "LineRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Rasterizes a line of the specified length (in pixels). Band i has color i and covers the pixels from offset + i * bandSize to offset + (i + 1) * bandSize.
+/// The pixels that are not covered by a band are transparent. Returns thickness lines: one row of thickness pixels per pixel of a column, or thickness copies of a row.
+/// </summary>
+const uint32_t * line_rasterizer_t::Rasterize(const uint32_t * colors, size_t count, double offset, double bandSize, size_t length, size_t thickness, bool isColumn) noexcept
+{
+    _Line.assign(length, 0);
+
+    // A pixel belongs to the band that contains its center.
+    auto ToPixel = [length](double x) -> size_t { return (size_t) std::clamp(std::ceil(x - 0.5), 0., (double) length); };
+
+    size_t p1 = ToPixel(offset);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t p2 = ToPixel(offset + (double) (i + 1) * bandSize);
+
+        if (p2 > p1)
+            std::fill(_Line.begin() + (ptrdiff_t) p1, _Line.begin() + (ptrdiff_t) p2, colors[i]);
+
+        p1 = p2;
+    }
+
+    if (thickness < 2)
+        return _Line.data();
+
+    _Pixels.resize(length * thickness);
+
+    if (isColumn)
+    {
+        auto Pixel = _Pixels.begin();
+
+        for (const auto & Color : _Line)
+        {
+            std::fill_n(Pixel, thickness, Color);
+            Pixel += (ptrdiff_t) thickness;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < thickness; ++i)
+            std::copy(_Line.begin(), _Line.end(), _Pixels.begin() + (ptrdiff_t) (i * length));
+    }
+
+    return _Pixels.data();
+}
@@ -0,0 +1,34 @@
+
+/** $VER: LineRasterizer.h (2026.10.18) P. Stuer - Rasterizes a line of the spectrogram in memory. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Rasterizes a line of the spectrogram as packed 32-bit pixels. Each band fills the pixels whose center lies inside the band with its color.
+/// The line can be made thicker to fill a column or a row of several pixels with a single copy. Portable: does not depend on Windows.
+/// </summary>
+#pragma warning(disable: 4820)
+class line_rasterizer_t
+{
+public:
+    line_rasterizer_t() noexcept { }
+
+    line_rasterizer_t(const line_rasterizer_t &) = delete;
+    line_rasterizer_t & operator=(const line_rasterizer_t &) = delete;
+    line_rasterizer_t(line_rasterizer_t &&) = delete;
+    line_rasterizer_t & operator=(line_rasterizer_t &&) = delete;
+
+    const uint32_t * Rasterize(const uint32_t * colors, size_t count, double offset, double bandSize, size_t length, size_t thickness, bool isColumn) noexcept;
+
+private:
+    std::vector<uint32_t> _Line;        // Pixels of the line.
+    std::vector<uint32_t> _Pixels;      // Pixels of the line repeated to the requested thickness.
+};
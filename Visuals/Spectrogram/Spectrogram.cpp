@@ -1,12 +1,12 @@
 
-/** $VER: Spectrogram.cpp (2026.02.08) P. Stuer - Represents a spectrum analysis as a 2D heat map. **/
+/** $VER: Spectrogram.cpp (2026.10.18) P. Stuer - Represents a spectrum analysis as a 2D heat map. **/
 
 #include "pch.h"
 #include "Spectrogram.h"
 
 #include "Support.h"
 
-#include "DirectWrite.h"
+#include "TextLayoutCache.h"
 
 #include "Log.h"
 
@@ -20,6 +20,10 @@ spectrogram_t::spectrogram_t()
     _Rect = { };
     _Size = { };
 
+    _StyleGeneration = 0;
+    _VisibleBandCount = 0;
+    _IsRedrawNeeded = true;
+
     Reset();
 }
 
@@ -214,16 +218,12 @@ void spectrogram_t::Resize() noexcept
                 const FLOAT x = msc::Map(ScaleFrequency(Iter.Frequency, _State->_ScalingFunction, _State->_SkewFactor), MinScale, MaxScale, 0.f, _BitmapSize.width);
 
                 {
-                    CComPtr<IDWriteTextLayout> TextLayout;
+                    DWRITE_TEXT_METRICS TextMetrics = { };
 
-                    HRESULT hr = _DirectWrite.Factory->CreateTextLayout(Iter.Text.c_str(), (UINT) Iter.Text.size(), _FreqTextStyle->_TextFormat, _Size.width, _Size.height, &TextLayout);
+                    HRESULT hr = _TextLayoutCache.GetTextMetrics(Iter.Text, _FreqTextStyle->_TextFormat, TextMetrics);
 
                     if (SUCCEEDED(hr))
                     {
-                        DWRITE_TEXT_METRICS TextMetrics = { };
-
-                        TextLayout->GetMetrics(&TextMetrics);
-
                         if (!_Settings->_FlipHorizontally)
                         {
                             Rect.x1 = _BitmapRect.left + x - (TextMetrics.width / 2.f);
@@ -499,7 +499,7 @@ void spectrogram_t::RenderTimeAxis(ID2D1DeviceContext * deviceContext, bool firs
             }
 
             // Draw the label.
-            deviceContext->DrawTextW(Label.Text.c_str(), (UINT32) Label.Text.size(), _TimeTextStyle->_TextFormat, Rect, _TimeTextStyle->_Brush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
+            deviceContext->DrawTextW(Label.Text->c_str(), (UINT32) Label.Text->size(), _TimeTextStyle->_TextFormat, Rect, _TimeTextStyle->_Brush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
         }
 
         deviceContext->PopAxisAlignedClip();
@@ -534,7 +534,7 @@ void spectrogram_t::RenderTimeAxis(ID2D1DeviceContext * deviceContext, bool firs
             }
 
             // Draw the label.
-            deviceContext->DrawTextW(Label.Text.c_str(), (UINT32) Label.Text.size(), _TimeTextStyle->_TextFormat, Rect, _TimeTextStyle->_Brush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
+            deviceContext->DrawTextW(Label.Text->c_str(), (UINT32) Label.Text->size(), _TimeTextStyle->_TextFormat, Rect, _TimeTextStyle->_Brush, D2D1_DRAW_TEXT_OPTIONS_CLIP);
         }
 
         deviceContext->PopAxisAlignedClip();
@@ -584,37 +584,10 @@ bool spectrogram_t::Update() noexcept
     if (_Analysis->_NyquistFrequency == 0.f)
         return false;
 
-    _BitmapRenderTarget->BeginDraw();
+    UpdateLine();
 
     if (_State->_HorizontalSpectrogram)
     {
-        // Draw the next spectrogram line.
-        {
-            const FLOAT Bandwidth = _BitmapSize.height / (FLOAT) _BandCount;
-
-            FLOAT y1 = 0.f;
-            FLOAT y2 = Bandwidth;
-
-            for (const auto & fb : _Analysis->_FrequencyBands)
-            {
-                if ((fb.Lo >= _Analysis->_NyquistFrequency) && _State->_SuppressMirrorImage)
-                    break;
-
-                _SpectrogramStyle->SetBrushColor(fb.Value);
-
-                _BitmapRenderTarget->DrawLine({ _X, y1 }, { _X, y2 }, _SpectrogramStyle->_Brush);
-
-                y1  = y2;
-                y2 += Bandwidth;
-            }
-        }
-
-        // Draw the Nyquist marker.
-        if (_NyquistMarkerStyle->IsEnabled())
-            RenderNyquistFrequencyMarker(_BitmapRenderTarget);
-
-        _BitmapRenderTarget->EndDraw();
-
         // Update the time axis.
         if (_State->_ScrollingSpectrogram && (_State->_PlaybackTime != _PlaybackTime))
         {
@@ -631,47 +604,19 @@ bool spectrogram_t::Update() noexcept
         {
             if (_State->_ScrollingSpectrogram)
             {
-                _TimeLabels.push_front({ pfc::wideFromUTF8(pfc::format_time((uint64_t) _State->_TrackTime)), !_Settings->_FlipHorizontally ? _BitmapSize.width : 0.f });
+                _TimeLabels.push_front({ GetTimeText(_State->_TrackTime), !_Settings->_FlipHorizontally ? _BitmapSize.width : 0.f });
 
                 if (_TimeLabels.back().X + _TimeTextStyle->_Width < 0.f)
                     _TimeLabels.pop_back();
             }
             else
-                _TimeLabels.push_back({ pfc::wideFromUTF8(pfc::format_time((uint64_t) _State->_TrackTime)), !_Settings->_FlipHorizontally ? _X : _BitmapSize.width - _X });
+                _TimeLabels.push_back({ GetTimeText(_State->_TrackTime), !_Settings->_FlipHorizontally ? _X : _BitmapSize.width - _X });
 
             _TrackTime = _State->_TrackTime;
         }
     }
     else
     {
-        // Draw the next Spectrogram line.
-        {
-            const FLOAT Bandwidth = _State->_UseSpectrumBarMetrics ? std::max(::floor(_BitmapSize.width / (FLOAT) _Analysis->_FrequencyBands.size()), 2.f) : _BitmapSize.width / (FLOAT) _BandCount;
-            const FLOAT SpectrumWidth = Bandwidth * (FLOAT) _Analysis->_FrequencyBands.size();
-
-            FLOAT x1 = _State->_UseSpectrumBarMetrics ? (_BitmapSize.width - SpectrumWidth) / 2.f : 0.f;
-            FLOAT x2 = Bandwidth;
-
-            for (const auto & fb : _Analysis->_FrequencyBands)
-            {
-                if ((fb.Lo >= _Analysis->_NyquistFrequency) && _State->_SuppressMirrorImage)
-                    break;
-
-                _SpectrogramStyle->SetBrushColor(fb.Value);
-
-                _BitmapRenderTarget->DrawLine({ x1, _Y }, { x2, _Y }, _SpectrogramStyle->_Brush);
-
-                x1  = x2;
-                x2 += Bandwidth;
-            }
-        }
-
-        // Draw the Nyquist marker.
-        if (_NyquistMarkerStyle->IsEnabled())
-            RenderNyquistFrequencyMarker(_BitmapRenderTarget);
-
-        _BitmapRenderTarget->EndDraw();
-
         // Update the time axis.
         if (_State->_ScrollingSpectrogram && (_State->_PlaybackTime != _PlaybackTime))
         {
@@ -688,13 +633,13 @@ bool spectrogram_t::Update() noexcept
         {
             if (_State->_ScrollingSpectrogram)
             {
-                _TimeLabels.push_front({ pfc::wideFromUTF8(pfc::format_time((uint64_t) _State->_TrackTime)), 0.f, !_Settings->_FlipVertically ? _BitmapRect.top : _BitmapSize.height });
+                _TimeLabels.push_front({ GetTimeText(_State->_TrackTime), 0.f, !_Settings->_FlipVertically ? _BitmapRect.top : _BitmapSize.height });
 
                 if (_TimeLabels.back().Y > _BitmapSize.height + _TimeTextStyle->_Height)
                     _TimeLabels.pop_back();
             }
             else
-                _TimeLabels.push_back({ pfc::wideFromUTF8(pfc::format_time((uint64_t) _State->_TrackTime)), 0.f, !_Settings->_FlipVertically ? _BitmapSize.height - _Y : _Y });
+                _TimeLabels.push_back({ GetTimeText(_State->_TrackTime), 0.f, !_Settings->_FlipVertically ? _BitmapSize.height - _Y : _Y });
 
             _TrackTime = _State->_TrackTime;
         }
@@ -704,10 +649,184 @@ bool spectrogram_t::Update() noexcept
 }
 
 /// <summary>
-/// Renders a marker for the Nyquist frequency.
+/// Adds the next line to the history and copies it into the offscreen bitmap. Recreates the complete image from the history when the bitmap or the colors have changed.
+/// </summary>
+HRESULT spectrogram_t::UpdateLine() noexcept
+{
+    if (_SpectrogramStyle->GetGeneration() != _StyleGeneration)
+    {
+        _StyleGeneration = _SpectrogramStyle->GetGeneration();
+
+        _IsRedrawNeeded = true;
+    }
+
+    // Add the values of the bands to the history.
+    {
+        const size_t BandCount = _Analysis->_FrequencyBands.size();
+        const size_t Capacity = (size_t) std::ceil(_State->_SpectrogramHistory * (double) std::max(_State->_RefreshRateLimit, (decltype(_State->_RefreshRateLimit)) 1));
+
+        if (_History.GetBandCount() != BandCount)
+        {
+            _History.Initialize(BandCount, Capacity);
+
+            Log.AtInfo().Write(STR_COMPONENT_BASENAME " allocated spectrogram history of %zu lines of %zu bands (%zu KiB).", _History.GetCapacity(), _History.GetBandCount(), _History.GetSize() / 1024);
+        }
+        else
+        if (_History.GetCapacity() != std::max(Capacity, (size_t) 1))
+        {
+            // A change of the refresh rate or the duration of the history keeps the newest lines.
+            _History.Resize(Capacity);
+
+            Log.AtInfo().Write(STR_COMPONENT_BASENAME " resized spectrogram history to %zu lines of %zu bands (%zu KiB).", _History.GetCapacity(), _History.GetBandCount(), _History.GetSize() / 1024);
+        }
+
+        _LineValues.clear();
+        _VisibleBandCount = 0;
+
+        for (const auto & fb : _Analysis->_FrequencyBands)
+        {
+            _LineValues.push_back(fb.Value);
+
+            if (!((fb.Lo >= _Analysis->_NyquistFrequency) && _State->_SuppressMirrorImage))
+                ++_VisibleBandCount;
+        }
+
+        _History.Add(_LineValues.data(), _LineValues.size());
+    }
+
+    if (_IsRedrawNeeded)
+        return Redraw();
+
+    HRESULT hr = CopyLine(_History.GetLine(0), _State->_HorizontalSpectrogram ? _X : _Y);
+
+    // Draw the Nyquist marker.
+    if (SUCCEEDED(hr) && _NyquistMarkerStyle->IsEnabled())
+    {
+        _BitmapRenderTarget->BeginDraw();
+
+        RenderNyquistFrequencyMarker(_BitmapRenderTarget, _State->_HorizontalSpectrogram ? _X : _Y);
+
+        hr = _BitmapRenderTarget->EndDraw();
+    }
+
+    return hr;
+}
+
+/// <summary>
+/// Recreates the complete image of the spectrogram from the history. The newest line ends up at the current position, older lines precede it.
+/// </summary>
+HRESULT spectrogram_t::Redraw() noexcept
+{
+    _IsRedrawNeeded = false;
+
+    _BitmapRenderTarget->BeginDraw();
+    _BitmapRenderTarget->Clear(); // Make the bitmap completely transparent.
+
+    HRESULT hr = _BitmapRenderTarget->EndDraw();
+
+    if (!SUCCEEDED(hr))
+        return hr;
+
+    // The position runs from 0 to the size of the bitmap (in DIP) and a line is drawn at every position except 0.
+    FLOAT & Position = _State->_HorizontalSpectrogram ? _X : _Y;
+
+    const FLOAT Size = _State->_HorizontalSpectrogram ? _BitmapSize.width : _BitmapSize.height;
+
+    Position = std::min(Position, ::floor(Size));
+
+    const size_t Period = (size_t) ::floor(Size) + 1;
+    const size_t Count = std::min(_History.GetCount(), Period);
+
+    for (size_t Age = 0; (Age < Count) && SUCCEEDED(hr); ++Age)
+    {
+        const size_t p = ((size_t) Position + Period - Age) % Period;
+
+        if (p != 0)
+            hr = CopyLine(_History.GetLine(Age), (FLOAT) p);
+    }
+
+    // Draw the Nyquist marker.
+    if (SUCCEEDED(hr) && _NyquistMarkerStyle->IsEnabled())
+    {
+        _BitmapRenderTarget->BeginDraw();
+
+        for (size_t Age = 0; Age < Count; ++Age)
+        {
+            const size_t p = ((size_t) Position + Period - Age) % Period;
+
+            if (p != 0)
+                RenderNyquistFrequencyMarker(_BitmapRenderTarget, (FLOAT) p);
+        }
+
+        hr = _BitmapRenderTarget->EndDraw();
+    }
+
+    return hr;
+}
+
+/// <summary>
+/// Rasterizes a line in memory and copies it into the offscreen bitmap at the specified position (in DIP).
+/// </summary>
+HRESULT spectrogram_t::CopyLine(const uint16_t * values, FLOAT position) noexcept
+{
+    const D2D1_SIZE_U Size = _Bitmap->GetPixelSize();
+
+    if ((Size.width == 0) || (Size.height == 0) || (_BitmapSize.width == 0.f) || (_BitmapSize.height == 0.f))
+        return S_FALSE;
+
+    const double ScaleX = (double) Size.width  / (double) _BitmapSize.width;  // Pixels per DIP
+    const double ScaleY = (double) Size.height / (double) _BitmapSize.height;
+
+    // The line at a position covers the pixels from position - 1 up to position, the same pixels a 1 DIP wide aliased line used to cover.
+    auto ToPixel = [](double x, UINT length) -> UINT { return (UINT) std::clamp(std::ceil(x - 0.5), 0., (double) length); };
+
+    // Look up the colors of the bands in the amplitude color table of the style.
+    _LineColors.resize(_VisibleBandCount);
+
+    _SpectrogramStyle->GetPixels(values, _VisibleBandCount, _LineColors.data());
+
+    if (_State->_HorizontalSpectrogram)
+    {
+        const UINT x1 = ToPixel(((double) position - 1.) * ScaleX, Size.width);
+        const UINT x2 = ToPixel( (double) position       * ScaleX, Size.width);
+
+        if (x2 <= x1)
+            return S_FALSE;
+
+        const double Bandwidth = (double) _BitmapSize.height / (double) _BandCount * ScaleY;
+
+        const uint32_t * Pixels = _LineRasterizer.Rasterize(_LineColors.data(), _VisibleBandCount, 0., Bandwidth, Size.height, x2 - x1, true);
+
+        const D2D1_RECT_U Rect = { x1, 0, x2, Size.height };
+
+        return _Bitmap->CopyFromMemory(&Rect, Pixels, (x2 - x1) * sizeof(uint32_t));
+    }
+    else
+    {
+        const UINT y1 = ToPixel(((double) position - 1.) * ScaleY, Size.height);
+        const UINT y2 = ToPixel( (double) position       * ScaleY, Size.height);
+
+        if (y2 <= y1)
+            return S_FALSE;
+
+        const FLOAT Bandwidth = _State->_UseSpectrumBarMetrics ? std::max(::floor(_BitmapSize.width / (FLOAT) _Analysis->_FrequencyBands.size()), 2.f) : _BitmapSize.width / (FLOAT) _BandCount;
+        const FLOAT SpectrumWidth = Bandwidth * (FLOAT) _Analysis->_FrequencyBands.size();
+
+        const FLOAT Offset = _State->_UseSpectrumBarMetrics ? (_BitmapSize.width - SpectrumWidth) / 2.f : 0.f;
+
+        const uint32_t * Pixels = _LineRasterizer.Rasterize(_LineColors.data(), _VisibleBandCount, (double) Offset * ScaleX, (double) Bandwidth * ScaleX, Size.width, y2 - y1, false);
+
+        const D2D1_RECT_U Rect = { 0, y1, Size.width, y2 };
+
+        return _Bitmap->CopyFromMemory(&Rect, Pixels, Size.width * sizeof(uint32_t));
+    }
+}
+
+/// <summary>
+/// Renders a marker for the Nyquist frequency in the line at the specified position (in DIP).
 /// Note: Created in a top-left (0,0) coordinate system and later translated and flipped as necessary.
 /// </summary>
-void spectrogram_t::RenderNyquistFrequencyMarker(ID2D1BitmapRenderTarget * renderTarget) const noexcept
+void spectrogram_t::RenderNyquistFrequencyMarker(ID2D1BitmapRenderTarget * renderTarget, FLOAT position) const noexcept
 {
     const double LoFrequency = ScaleFrequency(_Analysis->_FrequencyBands.front().Center, _State->_ScalingFunction, _State->_SkewFactor);
     const double HiFrequency = ScaleFrequency(_Analysis->_FrequencyBands.back() .Center, _State->_ScalingFunction, _State->_SkewFactor);
@@ -718,13 +837,13 @@ void spectrogram_t::RenderNyquistFrequencyMarker(ID2D1BitmapRenderTarget * rende
     {
         const FLOAT y = msc::Map(NyquistFrequency, LoFrequency, HiFrequency, 0.f, _BitmapSize.height);
 
-        renderTarget->DrawLine(D2D1_POINT_2F(_X, y), D2D1_POINT_2F(_X, y + 1), _NyquistMarkerStyle->_Brush, _NyquistMarkerStyle->_Thickness, nullptr);
+        renderTarget->DrawLine(D2D1_POINT_2F(position, y), D2D1_POINT_2F(position, y + 1), _NyquistMarkerStyle->_Brush, _NyquistMarkerStyle->_Thickness, nullptr);
     }
     else
     {
         const FLOAT x = msc::Map(NyquistFrequency, LoFrequency, HiFrequency, 0.f, _BitmapSize.width);
 
-        renderTarget->DrawLine(D2D1_POINT_2F(x, _Y), D2D1_POINT_2F(x + 1, _Y), _NyquistMarkerStyle->_Brush, _NyquistMarkerStyle->_Thickness, nullptr);
+        renderTarget->DrawLine(D2D1_POINT_2F(x, position), D2D1_POINT_2F(x + 1, position), _NyquistMarkerStyle->_Brush, _NyquistMarkerStyle->_Thickness, nullptr);
     }
 }
 
@@ -855,6 +974,30 @@ void spectrogram_t::InitFreqAxis() noexcept
     }
 }
 
+/// <summary>
+/// Gets the text of the time label of the specified track time (in seconds). Each time is formatted once and kept in the pool.
+/// </summary>
+const std::wstring * spectrogram_t::GetTimeText(double time) noexcept
+{
+    static const std::wstring Empty;
+
+    const uint64_t Seconds = (uint64_t) time;
+
+    try
+    {
+        auto Iter = _TimeTexts.find(Seconds);
+
+        if (Iter == _TimeTexts.end())
+            Iter = _TimeTexts.emplace(Seconds, pfc::wideFromUTF8(pfc::format_time(Seconds))).first;
+
+        return &Iter->second;
+    }
+    catch (...)
+    {
+        return &Empty;
+    }
+}
+
 /// <summary>
 /// Creates resources which are bound to a particular D3D device.
 /// </summary>
@@ -900,6 +1043,8 @@ HRESULT spectrogram_t::CreateDeviceSpecificResources(ID2D1DeviceContext * device
             _BitmapRenderTarget->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
 
             hr = _BitmapRenderTarget->GetBitmap(&_Bitmap);
+
+            _IsRedrawNeeded = true; // Recreate the image from the history.
         }
     }
 
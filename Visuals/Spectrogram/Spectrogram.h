@@ -1,5 +1,5 @@
 
-/** $VER: Spectrogram.h (2025.10.11) P. Stuer - Represents a spectrum analysis as a 2D heat map. **/
+/** $VER: Spectrogram.h (2026.10.18) P. Stuer - Represents a spectrum analysis as a 2D heat map. **/
 
 #pragma once
 
@@ -18,8 +18,11 @@
 #include <atlbase.h>
 
 #include "Element.h"
+#include "LineRasterizer.h"
+#include "SpectrogramHistory.h"
 
 #include <deque>
+#include <unordered_map>
 
 class spectrogram_t : public element_t
 {
@@ -43,14 +46,19 @@ public:
 
 private:
     bool Update() noexcept;
+    HRESULT UpdateLine() noexcept;
+    HRESULT Redraw() noexcept;
+    HRESULT CopyLine(const uint16_t * values, FLOAT position) noexcept;
 
-    void RenderNyquistFrequencyMarker(ID2D1BitmapRenderTarget * deviceContext) const noexcept;
+    void RenderNyquistFrequencyMarker(ID2D1BitmapRenderTarget * deviceContext, FLOAT position) const noexcept;
 
     void RenderTimeAxis(ID2D1DeviceContext * deviceContext, bool top) const noexcept;
     void RenderFreqAxis(ID2D1DeviceContext * deviceContext, bool left) const noexcept;
 
     void InitFreqAxis() noexcept;
 
+    const std::wstring * GetTimeText(double time) noexcept;
+
     HRESULT CreateDeviceSpecificResources(ID2D1DeviceContext * deviceContext);
     void DeleteDeviceSpecificResources() noexcept;
 
@@ -70,19 +78,20 @@ private:
 
     struct TimeLabel
     {
-        TimeLabel(const WCHAR * text, FLOAT x, FLOAT y = 0.f)
+        TimeLabel(const std::wstring * text, FLOAT x, FLOAT y = 0.f)
         {
             Text = text;
             X = x;
             Y = y;
         }
 
-        std::wstring Text;
+        const std::wstring * Text;          // Refers to a text in the time text pool.
         FLOAT X;
         FLOAT Y;
     };
 
     std::deque<TimeLabel> _TimeLabels;
+    std::unordered_map<uint64_t, std::wstring> _TimeTexts;  // Pool of formatted track times (in seconds). Each time is formatted once. Elements don't move when the pool grows.
 
     struct FreqLabel
     {
@@ -107,6 +116,15 @@ private:
     CComPtr<ID2D1BitmapRenderTarget> _BitmapRenderTarget;
     CComPtr<ID2D1Bitmap> _Bitmap;
 
+    spectrogram_history_t _History;         // Recent lines of the spectrogram. Survives the offscreen bitmap.
+    bool _IsRedrawNeeded;                   // True if the offscreen bitmap must be recreated from the history.
+
+    line_rasterizer_t _LineRasterizer;
+    std::vector<double> _LineValues;        // Values of the bands in the next line. Reused each frame.
+    std::vector<uint32_t> _LineColors;      // Colors of the bands in the line that is being copied. Reused each frame.
+    size_t _VisibleBandCount;               // Number of bands that are drawn. Excludes the bands above the Nyquist frequency when the mirror image is suppressed.
+    uint64_t _StyleGeneration;              // Generation of the spectrogram style the bitmap was drawn with. Used to detect new colors.
+
 #ifdef _DEBUG
     CComPtr<ID2D1SolidColorBrush> _DebugBrush;
 #endif
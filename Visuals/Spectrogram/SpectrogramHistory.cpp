@@ -0,0 +1,86 @@
+
+/** $VER: SpectrogramHistory.cpp (2026.10.18) P. Stuer - Keeps the recent lines of the spectrogram as quantized band values. **/
+
+#include "SpectrogramHistory.h"
+
+#include <algorithm>
+
+/// <summary>
+/// Allocates a history of the specified number of lines. The history keeps at least one line. Any lines in the history are discarded.
+/// </summary>
+void spectrogram_history_t::Initialize(size_t bandCount, size_t capacity) noexcept
+{
+    _BandCount = bandCount;
+    _Capacity  = std::max(capacity, (size_t) 1);
+    _Count     = 0;
+    _Head      = 0;
+
+    try
+    {
+        _Values.assign(_BandCount * _Capacity, 0);
+    }
+    catch (...)
+    {
+        // Fall back to a history of one line.
+        _Capacity = 1;
+
+        _Values.assign(_BandCount, 0);
+    }
+}
+
+/// <summary>
+/// Changes the number of lines of the history. The newest lines are kept. The history keeps at least one line.
+/// </summary>
+void spectrogram_history_t::Resize(size_t capacity) noexcept
+{
+    capacity = std::max(capacity, (size_t) 1);
+
+    if (capacity == _Capacity)
+        return;
+
+    try
+    {
+        std::vector<uint16_t> Values(_BandCount * capacity, 0);
+
+        const size_t Count = std::min(_Count, capacity);
+
+        // Store the lines oldest first.
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const uint16_t * Line = GetLine(Count - 1 - i);
+
+            std::copy(Line, Line + _BandCount, Values.begin() + (ptrdiff_t) (i * _BandCount));
+        }
+
+        _Values.swap(Values);
+
+        _Capacity = capacity;
+        _Count    = Count;
+        _Head     = Count % capacity;
+    }
+    catch (...)
+    {
+        // Keep the current history.
+    }
+}
+
+/// <summary>
+/// Adds a line. Bands without a value are set to 0.
+/// </summary>
+void spectrogram_history_t::Add(const double * values, size_t count) noexcept
+{
+    if (_Values.empty())
+        return;
+
+    uint16_t * Line = _Values.data() + (_Head * _BandCount);
+
+    count = std::min(count, _BandCount);
+
+    for (size_t i = 0; i < count; ++i)
+        Line[i] = (uint16_t) (std::clamp(values[i], 0., 1.) * (double) MaxValue + 0.5);
+
+    std::fill(Line + count, Line + _BandCount, (uint16_t) 0);
+
+    _Head = (_Head + 1) % _Capacity;
+    _Count = std::min(_Count + 1, _Capacity);
+}
@@ -0,0 +1,59 @@
+
+/** $VER: SpectrogramHistory.h (2026.10.18) P. Stuer - Keeps the recent lines of the spectrogram as quantized band values. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/// <summary>
+/// Keeps the most recent lines of the spectrogram in a ring of fixed capacity. Each band value (0.0 .. 1.0) is quantized to 16 bits so the amplitude color table can be used at full resolution.
+/// The history is independent of the bitmap of the spectrogram so the image can be recreated after a resize or a change of colors. Portable: does not depend on Windows.
+/// </summary>
+#pragma warning(disable: 4820)
+class spectrogram_history_t
+{
+public:
+    spectrogram_history_t() noexcept : _BandCount(), _Capacity(), _Count(), _Head() { }
+
+    spectrogram_history_t(const spectrogram_history_t &) = delete;
+    spectrogram_history_t & operator=(const spectrogram_history_t &) = delete;
+    spectrogram_history_t(spectrogram_history_t &&) = delete;
+    spectrogram_history_t & operator=(spectrogram_history_t &&) = delete;
+
+    void Initialize(size_t bandCount, size_t capacity) noexcept;
+    void Resize(size_t capacity) noexcept;
+    void Add(const double * values, size_t count) noexcept;
+
+    /// <summary>
+    /// Gets the line of the specified age. The newest line has age 0.
+    /// </summary>
+    const uint16_t * GetLine(size_t age) const noexcept
+    {
+        return _Values.data() + (((_Head + _Capacity - 1 - age) % _Capacity) * _BandCount);
+    }
+
+    size_t GetBandCount() const noexcept { return _BandCount; }
+    size_t GetCapacity() const noexcept { return _Capacity; }
+    size_t GetCount() const noexcept { return _Count; }
+
+    /// <summary>
+    /// Gets the size of the history (in bytes).
+    /// </summary>
+    size_t GetSize() const noexcept { return _Values.size() * sizeof(uint16_t); }
+
+    static const uint16_t MaxValue = UINT16_MAX;
+
+private:
+    size_t _BandCount;
+    size_t _Capacity;                   // Max. number of lines
+    size_t _Count;                      // Number of lines in the history
+    size_t _Head;                       // Index of the line that will be written next.
+
+    std::vector<uint16_t> _Values;       // Capacity lines of band count values
+};
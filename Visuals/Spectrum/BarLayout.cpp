@@ -0,0 +1,117 @@
+
+/** $VER: BarLayout.cpp (2026.10.18) P. Stuer - Calculates the rectangles of the parts of the bars of the spectrum. **/
+
+#include "BarLayout.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Gets the width of a bar (in DIP). Bars are at least 2 DIP wide and have a whole width unless they fit the width of the client area.
+/// </summary>
+float bar_layout_t::GetBarWidth(float width, size_t bandCount, HorizontalAlignment alignment) noexcept
+{
+    float t = (bandCount != 0) ? width / (float) bandCount : width;
+
+    // Use the full width of the graph?
+    if (alignment != HorizontalAlignment::Fit)
+        t = std::floor(t);
+
+    return std::max(t, 2.f);
+}
+
+/// <summary>
+/// Calculates the rectangles of all the parts of all the bars.
+/// </summary>
+void bar_layout_t::Layout(const frequency_bands_t & bands, const bar_layout_settings_t & settings) noexcept
+{
+    for (auto & Parts : _Parts)
+        Parts.clear();
+
+    _BarWidth = GetBarWidth(settings.Width, bands.size(), settings.Alignment);
+
+    const float SpectrumWidth = _BarWidth * (float) bands.size();
+
+    _Offset = layout_transform_t::GetHOffset(settings.Alignment, settings.Width - SpectrumWidth);
+
+    float x1 = _Offset;
+    float x2 = x1 + _BarWidth;
+
+    for (const auto & fb : bands)
+    {
+        x1 = std::clamp(x1, 0.f, settings.Width);
+        x2 = std::clamp(x2, 0.f, settings.Width);
+
+        const layout_rect_t Rect = { x1, 0.f, x2 - 1.f, settings.Height };
+
+        // Add the bar background, even above the Nyquist frequency.
+        if (fb.HasDarkBackground)
+        {
+            if (settings.IsEnabled[(size_t) BarPart::DarkBackground])
+                AddPart(BarPart::DarkBackground, Rect, 0., 1., settings);
+        }
+        else
+        {
+            if (settings.IsEnabled[(size_t) BarPart::LightBackground])
+                AddPart(BarPart::LightBackground, Rect, 0., 1., settings);
+        }
+
+        if (settings.IsVisible)
+        {
+            const bool GreaterThanNyquist = fb.Lo >= settings.NyquistFrequency; // 24/09/25: Use the lower frequency of a band instead of the center frequency.
+
+            if (!GreaterThanNyquist || (GreaterThanNyquist && !settings.SuppressMirrorImage))
+            {
+                if (settings.ShowPeaks && (fb.MaxValue > 0.))
+                    LayoutBar(Rect, BarPart::PeakArea, BarPart::PeakTop, settings.PeakTopThickness, fb.MaxValue, fb.Opacity, settings);
+
+                if (fb.Value > 0.)
+                    LayoutBar(Rect, BarPart::Area, BarPart::Top, settings.TopThickness, fb.Value, fb.Opacity, settings);
+            }
+        }
+
+        x1 = x2;
+        x2 = x1 + _BarWidth;
+    }
+}
+
+/// <summary>
+/// Calculates the rectangles of the area and the top of a single bar.
+/// </summary>
+void bar_layout_t::LayoutBar(layout_rect_t rect, BarPart areaPart, BarPart topPart, float thickness, double value, double opacity, const bar_layout_settings_t & settings) noexcept
+{
+    rect.top    = 0.f;
+    rect.bottom = settings.Height * (float) value;
+
+    if (settings.IsEnabled[(size_t) areaPart])
+        AddPart(areaPart, rect, value, opacity, settings);
+
+    if (settings.IsEnabled[(size_t) topPart])
+    {
+        if (settings.LEDMode)
+        {
+            rect.top    = rect.bottom - settings.LEDSize;
+        }
+        else
+        {
+            rect.top    = std::clamp(rect.bottom - thickness / 2.f, 0.f, settings.Height);
+            rect.bottom = std::clamp(rect.top    + thickness,       0.f, settings.Height);
+        }
+
+        AddPart(topPart, rect, value, opacity, settings);
+    }
+}
+
+/// <summary>
+/// Adds the rectangle of a part of a bar. Snaps the rectangle to the LEDs if necessary.
+/// </summary>
+void bar_layout_t::AddPart(BarPart part, layout_rect_t rect, double value, double opacity, const bar_layout_settings_t & settings) noexcept
+{
+    if (settings.LEDMode && settings.LEDIntegralSize && (settings.LEDSize > 0.f))
+    {
+        rect.top    = std::clamp(std::ceil(rect.top    / settings.LEDSize) * settings.LEDSize, 0.f, settings.Height);
+        rect.bottom = std::clamp(std::ceil(rect.bottom / settings.LEDSize) * settings.LEDSize, 0.f, settings.Height);
+    }
+
+    _Parts[(size_t) part].push_back({ rect, value, opacity });
+}
@@ -0,0 +1,98 @@
+
+/** $VER: BarLayout.h (2026.10.18) P. Stuer - Calculates the rectangles of the parts of the bars of the spectrum. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "Constants.h"
+#include "FrequencyBand.h"
+#include "LayoutTransform.h"
+
+#include <vector>
+
+/// <summary>
+/// Identifies a part of a bar. The parts are rendered in this order.
+/// </summary>
+enum class BarPart : size_t
+{
+    DarkBackground = 0,
+    LightBackground,
+    PeakArea,
+    PeakTop,
+    Area,
+    Top,
+
+    Count
+};
+
+/// <summary>
+/// Represents the rectangle of a part of a bar.
+/// </summary>
+struct bar_part_t
+{
+    layout_rect_t Rect;
+    double Value;
+    double Opacity;
+};
+
+/// <summary>
+/// Represents the settings that determine the layout of the bars.
+/// </summary>
+#pragma warning(disable: 4820)
+struct bar_layout_settings_t
+{
+    float Width;                                    // Size of the client area (in DIP)
+    float Height;
+
+    HorizontalAlignment Alignment;
+
+    bool IsVisible;                                 // False while the bars are hidden during a pause. Only the backgrounds are laid out.
+    bool SuppressMirrorImage;                       // True to leave out the bars above the Nyquist frequency.
+    double NyquistFrequency;
+    bool ShowPeaks;                                 // True to lay out the peak indicators.
+
+    bool LEDMode;
+    bool LEDIntegralSize;                           // True to snap the parts to whole LEDs.
+    float LEDSize;                                  // Size of a LED including the gap (in DIP)
+
+    bool IsEnabled[(size_t) BarPart::Count];        // True if the style of the part is enabled.
+    float TopThickness;                             // Thickness of the top indicator (in DIP)
+    float PeakTopThickness;                         // Thickness of the peak top indicator (in DIP)
+};
+
+/// <summary>
+/// Calculates the rectangles of the parts of the bars of the spectrum, one array per part. The bars are laid out from the bottom-left corner of the client area;
+/// layout_transform_t maps them to the client area. The arrays are reused by each layout. Portable: does not depend on Windows.
+/// </summary>
+class bar_layout_t
+{
+public:
+    bar_layout_t() noexcept : _BarWidth(), _Offset() { }
+
+    bar_layout_t(const bar_layout_t &) = delete;
+    bar_layout_t & operator=(const bar_layout_t &) = delete;
+    bar_layout_t(bar_layout_t &&) = delete;
+    bar_layout_t & operator=(bar_layout_t &&) = delete;
+
+    void Layout(const frequency_bands_t & bands, const bar_layout_settings_t & settings) noexcept;
+
+    const std::vector<bar_part_t> & GetParts(BarPart part) const noexcept { return _Parts[(size_t) part]; }
+
+    float GetBarWidth() const noexcept { return _BarWidth; }
+    float GetOffset() const noexcept { return _Offset; }
+
+    static float GetBarWidth(float width, size_t bandCount, HorizontalAlignment alignment) noexcept;
+
+private:
+    void LayoutBar(layout_rect_t rect, BarPart areaPart, BarPart topPart, float thickness, double value, double opacity, const bar_layout_settings_t & settings) noexcept;
+    void AddPart(BarPart part, layout_rect_t rect, double value, double opacity, const bar_layout_settings_t & settings) noexcept;
+
+private:
+    std::vector<bar_part_t> _Parts[(size_t) BarPart::Count];
+
+    float _BarWidth;                                // Width of a bar (in DIP)
+    float _Offset;                                  // Horizontal offset of the first bar (in DIP)
+};
@@ -1,117 +1,46 @@
 
-/** $VER: BezierSpline.cpp (2025.09.28) P. Stuer - Based on https://www.codeproject.com/Articles/31859/Draw-a-Smooth-Curve-through-a-Set-of-2D-Points-wit by Oleg V. Polikarpotchkin **/
+/** $VER: BezierSpline.cpp (2026.10.18) P. Stuer - Based on https://www.codeproject.com/Articles/31859/Draw-a-Smooth-Curve-through-a-Set-of-2D-Points-wit by Oleg V. Polikarpotchkin **/
 
-#include "pch.h"
 #include "BezierSpline.h"
 
-#include <valarray>
-
-#pragma hdrstop
-
 /// <summary>
-/// Gets open-ended Bezier spline control points.
+/// Solves the tridiagonal systems for the x- and y-coordinates of the first control points in one pass (Thomas algorithm). Both systems have the same matrix
+/// so they share the decomposition.
 /// </summary>
-void bezier_spline_t::GetControlPoints(const std::vector<D2D1_POINT_2F> knots, std::vector<D2D1_POINT_2F> & firstControlPoints, std::vector<D2D1_POINT_2F> & secondControlPoints) noexcept
+void bezier_spline_t::Solve(const std::vector<layout_point_t> & knots) noexcept
 {
-    if (knots.size() < 2)
-        return;
-
     const size_t n = knots.size() - 1;
 
-    // Special case: Bezier curve should be a straight line.
-    if (n == 1)
-    {
-        // 3P1 = 2P0 + P3
-        firstControlPoints.push_back(D2D1::Point2F
-        (
-            ((2.f * knots[0].x) + knots[1].x) / 3.f,
-            ((2.f * knots[0].y) + knots[1].y) / 3.f
-        ));
-
-        // P2 = 2P1 – P0
-        secondControlPoints.push_back(D2D1::Point2F
-        (
-            (2.f * firstControlPoints[0].x) - knots[0].x,
-            (2.f * firstControlPoints[0].y) - knots[0].y
-        ));
-
-        return;
-    }
+    _X.resize(n);
+    _Y.resize(n);
+    _T.resize(n);
 
-    /* Calculate the first Bezier control points. */
+    float b = 2.f;
 
-    // Right hand side vector
-    std::valarray<FLOAT> rhs(n);
+    _X[0] = (knots[0].x + (2.f * knots[1].x)) / b;
+    _Y[0] = (knots[0].y + (2.f * knots[1].y)) / b;
 
-    // Set right hand side X values
+    // Decomposition and forward substitution. The right hand side is calculated on the fly.
+    for (size_t i = 1; i < n; ++i)
     {
-        rhs[0] = knots[0].x + (2.f * knots[1].x);
+        const bool IsLast = (i == n - 1);
 
-        for (size_t i = 1; i < n - 1; ++i)
-            rhs[i] = (4.f * knots[i].x) + (2.f * knots[i + 1].x);
+        const float rx = !IsLast ? (4.f * knots[i].x) + (2.f * knots[i + 1].x) : ((8.f * knots[i].x) + knots[n].x) / 2.f;
+        const float ry = !IsLast ? (4.f * knots[i].y) + (2.f * knots[i + 1].y) : ((8.f * knots[i].y) + knots[n].y) / 2.f;
 
-        rhs[n - 1] = ((8.f * knots[n - 1].x) + knots[n].x) / 2.f;
-    }
-
-    auto x = GetFirstControlPoints(rhs);
-
-    // Set right hand side Y values
-    {
-        rhs[0] = knots[0].y + (2 * knots[1].y);
+        _T[i] = 1.f / b;
+        b = (!IsLast ? 4.f : 3.5f) - _T[i];
 
-        for (size_t i = 1; i < n - 1; ++i)
-            rhs[i] = (4.f * knots[i].y) + (2.f * knots[i + 1].y);
-
-        rhs[n - 1] = ((8.f * knots[n - 1].y) + knots[n].y) / 2.f;
+        _X[i] = (rx - _X[i - 1]) / b;
+        _Y[i] = (ry - _Y[i - 1]) / b;
     }
 
-    auto y = GetFirstControlPoints(rhs);
-
-    // Fill the output arrays.
-    for (size_t i = 0; i < n - 1; ++i)
-    {
-        firstControlPoints.push_back(D2D1::Point2F(x[i], y[i]));
-        secondControlPoints.push_back(D2D1::Point2F
-        (
-            (2.f * knots[i + 1].x) - x[i + 1],
-            (2.f * knots[i + 1].y) - y[i + 1]
-        ));
-    }
-
-    firstControlPoints.push_back(D2D1::Point2F(x[n - 1], y[n - 1]));
-    secondControlPoints.push_back(D2D1::Point2F
-    (
-        (knots[n].x + x[n - 1]) / 2.f,
-        (knots[n].y + y[n - 1]) / 2.f
-    ));
-}
-
-/// <summary>
-/// Solves a tridiagonal system for one of the coordinates (x or y) of first Bezier control points.
-/// </summary>
-std::valarray<FLOAT> bezier_spline_t::GetFirstControlPoints(std::valarray<FLOAT> rhs) noexcept
-{
-    size_t n = rhs.size();
-
-    std::valarray<FLOAT> x(n); // Solution vector.
-    std::valarray<FLOAT> t(n); // Temp workspace.
-
-    FLOAT b = 2.f;
-
-    x[0] = rhs[0] / b;
-
-    // Decomposition and forward substitution.
+    // Back substitution.
     for (size_t i = 1; i < n; ++i)
     {
-        t[i] = 1.f / b;
-        b = (i < (n - 1) ? 4.f : 3.5f) - t[i];
-        x[i] = (rhs[i] - x[i - 1]) / b;
+        _X[n - i - 1] -= _T[n - i] * _X[n - i];
+        _Y[n - i - 1] -= _T[n - i] * _Y[n - i];
     }
-
-    for (size_t i = 1; i < n; ++i)
-        x[n - i - 1] -= t[n - i] * x[n - i]; // Back substitution.
-
-    return x;
 }
 
 /// <summary>
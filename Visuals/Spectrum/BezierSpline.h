@@ -1,5 +1,5 @@
 
-/** $VER: BezierSpline.h (2025.09.28) P. Stuer - Bezier control point calculator. Based on https://www.codeproject.com/Articles/31859/Draw-a-Smooth-Curve-through-a-Set-of-2D-Points-wit by Oleg V. Polikarpotchkin **/
+/** $VER: BezierSpline.h (2026.10.18) P. Stuer - Bezier control point calculator. Based on https://www.codeproject.com/Articles/31859/Draw-a-Smooth-Curve-through-a-Set-of-2D-Points-wit by Oleg V. Polikarpotchkin **/
 
 #pragma once
 
@@ -7,17 +7,71 @@
 
 #pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
 
-#include <SDKDDKVer.h>
-#include <d2d1_2.h>
+#include "LayoutTransform.h"
 
-#include <valarray>
 #include <vector>
 
+/// <summary>
+/// Calculates the control points of an open-ended Bezier spline. The instance keeps its workspace between calls so calculating the control points of
+/// a spline with the same number of knots or less does not allocate memory. Portable: does not depend on Windows.
+/// </summary>
 class bezier_spline_t
 {
 public:
-    static void GetControlPoints(const std::vector<D2D1_POINT_2F> knots, std::vector<D2D1_POINT_2F> & firstControlPoints, std::vector<D2D1_POINT_2F> & secondControlPoints) noexcept;
+    bezier_spline_t() noexcept { }
+
+    bezier_spline_t(const bezier_spline_t &) = delete;
+    bezier_spline_t & operator=(const bezier_spline_t &) = delete;
+    bezier_spline_t(bezier_spline_t &&) = delete;
+    bezier_spline_t & operator=(bezier_spline_t &&) = delete;
+
+    /// <summary>
+    /// Gets the control points of the spline through the specified knots. Each control point is passed through the specified function (e.g. to clamp it) before it is stored.
+    /// </summary>
+    template<typename adjust_t>
+    void GetControlPoints(const std::vector<layout_point_t> & knots, std::vector<layout_point_t> & firstControlPoints, std::vector<layout_point_t> & secondControlPoints, adjust_t adjust) noexcept
+    {
+        firstControlPoints.clear();
+        secondControlPoints.clear();
+
+        if (knots.size() < 2)
+            return;
+
+        const size_t n = knots.size() - 1;
+
+        firstControlPoints.resize(n);
+        secondControlPoints.resize(n);
+
+        // Special case: Bezier curve should be a straight line.
+        if (n == 1)
+        {
+            // 3P1 = 2P0 + P3
+            const layout_point_t p1 = { ((2.f * knots[0].x) + knots[1].x) / 3.f, ((2.f * knots[0].y) + knots[1].y) / 3.f };
+
+            // P2 = 2P1 – P0
+            firstControlPoints[0]  = adjust(p1);
+            secondControlPoints[0] = adjust(layout_point_t { (2.f * p1.x) - knots[0].x, (2.f * p1.y) - knots[0].y });
+
+            return;
+        }
+
+        Solve(knots);
+
+        for (size_t i = 0; i < n - 1; ++i)
+        {
+            firstControlPoints[i]  = adjust(layout_point_t { _X[i], _Y[i] });
+            secondControlPoints[i] = adjust(layout_point_t { (2.f * knots[i + 1].x) - _X[i + 1], (2.f * knots[i + 1].y) - _Y[i + 1] });
+        }
+
+        firstControlPoints[n - 1]  = adjust(layout_point_t { _X[n - 1], _Y[n - 1] });
+        secondControlPoints[n - 1] = adjust(layout_point_t { (knots[n].x + _X[n - 1]) / 2.f, (knots[n].y + _Y[n - 1]) / 2.f });
+    }
+
+private:
+    void Solve(const std::vector<layout_point_t> & knots) noexcept;
 
 private:
-    static std::valarray<FLOAT> GetFirstControlPoints(std::valarray<FLOAT> rhs) noexcept;
+    std::vector<float> _X;  // x-coordinates of the first control points
+    std::vector<float> _Y;  // y-coordinates of the first control points
+    std::vector<float> _T;  // Coefficients of the decomposition
 };
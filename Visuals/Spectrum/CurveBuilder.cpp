@@ -0,0 +1,123 @@
+
+/** $VER: CurveBuilder.cpp (2026.10.18) P. Stuer - Calculates the knots and the control points of the curves of the spectrum. **/
+
+#include "CurveBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Calculates the knots and the control points of a curve through the values of the bands. Returns false if there are less than 2 bands or if the curve is a flat line.
+/// </summary>
+bool curve_builder_t::Build(const frequency_bands_t & bands, const curve_settings_t & settings, bool usePeak, curve_points_t & points) noexcept
+{
+    points.Clear();
+
+    if (bands.size() < 2)
+        return false;
+
+    bool IsFlatLine = true;
+
+    const float BandWidth = std::max((settings.Width / (float) (bands.size() - 1)), 1.f);
+
+    float x = BandWidth / 2.f; // Make sure the knots are nicely centered in the band rectangle.
+    float y = 0.f;
+
+    // Create all the knots.
+    for (const auto & fb : bands)
+    {
+        double Value = 0.;
+
+        // Don't render anything above the Nyquist frequency.
+        if (!((fb.Lo > settings.NyquistFrequency) && settings.SuppressMirrorImage))
+            Value = !usePeak ? fb.Value : fb.MaxValue;
+
+        y = std::clamp((float) (Value * settings.Height), 0.f, settings.Height);
+
+        points.p0.push_back({ x, y });
+
+        if (y > 0.f)
+            IsFlatLine = false;
+
+        x += BandWidth;
+    }
+
+    // Create all the control points. Make sure all y-coordinates are positive.
+    const float Height = settings.Height;
+
+    _BezierSpline.GetControlPoints(points.p0, points.p1, points.p2, [Height](layout_point_t p)
+    {
+        p.y = std::clamp(p.y, 0.f, Height);
+
+        return p;
+    });
+
+    return !IsFlatLine;
+}
+
+/// <summary>
+/// Calculates the knots and the control points of a closed curve around the inner circle through the values of the bands. The bands run clockwise
+/// from the start angle. Returns false if there are less than 2 bands or if the curve is a flat line.
+/// </summary>
+bool curve_builder_t::BuildRadial(const frequency_bands_t & bands, const curve_settings_t & settings, bool usePeak, curve_points_t & points) noexcept
+{
+    points.Clear();
+
+    if (bands.size() < 2)
+        return false;
+
+    bool IsFlatLine = true;
+
+    const float InnerRadius = settings.InnerRadius;
+    const float MaxHeight = settings.OuterRadius - InnerRadius;
+
+    float a = settings.Angle;
+
+    const float da = (float) (2. * M_PI) / (float) bands.size();
+
+    // Create all the knots.
+    for (const auto & fb : bands)
+    {
+        // Don't render anything above the Nyquist frequency.
+        if ((fb.Lo > settings.NyquistFrequency) && settings.SuppressMirrorImage)
+            break;
+
+        const double Value = !usePeak ? fb.Value : fb.MaxValue;
+
+        const float r2 = InnerRadius + (MaxHeight * (float) Value);
+
+        const float x = std::cos(a) * r2;
+        const float y = std::sin(a) * r2;
+
+        points.p0.push_back({ x, y });
+
+        if (y > 0.f)
+            IsFlatLine = false;
+
+        a -= da;
+    }
+
+    if (points.p0.empty())
+        return false;
+
+    // Close the curve.
+    points.p0.push_back(points.p0[0]);
+
+    // Create all the control points. Make sure all control points are on or above the inner circle.
+    _BezierSpline.GetControlPoints(points.p0, points.p1, points.p2, [InnerRadius](layout_point_t p)
+    {
+        const float d = std::sqrt(p.x * p.x + p.y * p.y);
+
+        if (d < InnerRadius)
+        {
+            const float a = std::atan2(p.y, p.x);
+
+            p.x = std::cos(a) * InnerRadius;
+            p.y = std::sin(a) * InnerRadius;
+        }
+
+        return p;
+    });
+
+    return !IsFlatLine;
+}
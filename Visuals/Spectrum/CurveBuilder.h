@@ -0,0 +1,69 @@
+
+/** $VER: CurveBuilder.h (2026.10.18) P. Stuer - Calculates the knots and the control points of the curves of the spectrum. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include "FrequencyBand.h"
+#include "LayoutTransform.h"
+#include "BezierSpline.h"
+
+#include <vector>
+
+/// <summary>
+/// Represents the knots and the control points of a curve. The curve consists of a Bezier segment between each pair of consecutive knots.
+/// </summary>
+struct curve_points_t
+{
+    std::vector<layout_point_t> p0; // Knots
+    std::vector<layout_point_t> p1; // First control points
+    std::vector<layout_point_t> p2; // Second control points
+
+    void Clear() noexcept
+    {
+        p0.clear();
+        p1.clear();
+        p2.clear();
+    }
+};
+
+/// <summary>
+/// Represents the settings that determine the shape of the curves.
+/// </summary>
+#pragma warning(disable: 4820)
+struct curve_settings_t
+{
+    float Width;                                    // Size of the client area (in DIP)
+    float Height;
+
+    bool SuppressMirrorImage;                       // True to leave out the bands above the Nyquist frequency.
+    double NyquistFrequency;
+
+    float InnerRadius;                              // Radius of the inner circle of a radial curve (in DIP)
+    float OuterRadius;                              // Radius of a band with the maximum value (in DIP)
+    float Angle;                                    // Angle of the first band of a radial curve (in radians)
+};
+
+/// <summary>
+/// Calculates the knots and the control points of the curves of the spectrum, one knot per band. A curve is laid out from the bottom-left corner of
+/// the client area; a radial curve is laid out around the origin. The instance keeps the workspace of the spline between calls. Portable: does not depend on Windows.
+/// </summary>
+class curve_builder_t
+{
+public:
+    curve_builder_t() noexcept { }
+
+    curve_builder_t(const curve_builder_t &) = delete;
+    curve_builder_t & operator=(const curve_builder_t &) = delete;
+    curve_builder_t(curve_builder_t &&) = delete;
+    curve_builder_t & operator=(curve_builder_t &&) = delete;
+
+    bool Build(const frequency_bands_t & bands, const curve_settings_t & settings, bool usePeak, curve_points_t & points) noexcept;
+    bool BuildRadial(const frequency_bands_t & bands, const curve_settings_t & settings, bool usePeak, curve_points_t & points) noexcept;
+
+private:
+    bezier_spline_t _BezierSpline;
+};
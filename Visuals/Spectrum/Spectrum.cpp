@@ -1,5 +1,5 @@
 
-/** $VER: Spectrum.cpp (2026.03.11) P. Stuer - Implements a spectrum analyzer visualization **/
+/** $VER: Spectrum.cpp (2026.10.18) P. Stuer - Implements a spectrum analyzer visualization **/
 
 #include "pch.h"
 #include "Spectrum.h"
@@ -7,14 +7,30 @@
 #include "Direct2D.h"
 #include "DirectWrite.h"
 
-#include "BezierSpline.h"
 
 #include "StyleManager.h"
 
-#include <execution>
-
 #pragma hdrstop
 
+static_assert(sizeof(layout_rect_t) == sizeof(D2D1_RECT_F), "The layout rectangles must have the layout of the Direct2D rectangles.");
+static_assert(sizeof(layout_point_t) == sizeof(D2D1_POINT_2F), "The layout points must have the layout of the Direct2D points.");
+
+/// <summary>
+/// Gets a layout rectangle as a Direct2D rectangle.
+/// </summary>
+static inline const D2D1_RECT_F & ToRect(const layout_rect_t & rect) noexcept
+{
+    return (const D2D1_RECT_F &) rect;
+}
+
+/// <summary>
+/// Gets a layout point as a Direct2D point.
+/// </summary>
+static inline const D2D1_POINT_2F & ToPoint(const layout_point_t & point) noexcept
+{
+    return (const D2D1_POINT_2F &) point;
+}
+
 /// <summary>
 /// Destroys this instance.
 /// </summary>
@@ -149,123 +165,137 @@ void spectrum_t::Render(ID2D1DeviceContext * deviceContext) noexcept
 /// </summary>
 void spectrum_t::RenderBars(ID2D1DeviceContext * deviceContext) noexcept
 {
-    _LEDSize = _State->_LEDLight + _State->_LEDGap;
+    LayoutBars();
 
-    FLOAT t = _ClientSize.width / (FLOAT) _Analysis->_FrequencyBands.size();
+    deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED); // Required by FillOpacityMask() and results in crispier graphics.
 
-    // Use the full width of the graph?
-    if (_Settings->_HorizontalAlignment != HorizontalAlignment::Fit)
-        t = std::floor(t);
+    // The bars don't overlap so rendering the parts of all bars one part at a time gives the same result as rendering the parts one bar at a time.
+    style_t * Styles[] = { _DarkBackgroundStyle, _LightBackgroundStyle, _BarPeakAreaStyle, _BarPeakTopStyle, _BarAreaStyle, _BarTopStyle }; // In the order of BarPart
 
-    const FLOAT BarWidth = std::max(t, 2.f); // In DIP
-    const FLOAT SpectrumWidth = BarWidth * (FLOAT) _Analysis->_FrequencyBands.size();
-
-    const FLOAT HOffset = GetHOffset(_Settings->_HorizontalAlignment, _ClientSize.width - SpectrumWidth);
+    for (size_t i = 0; i < _countof(Styles); ++i)
+    {
+        if (!_BarLayout.GetParts((BarPart) i).empty())
+            RenderBarParts(deviceContext, (BarPart) i, Styles[i]);
+    }
+}
 
-    FLOAT x1 = HOffset;
-    FLOAT x2 = x1 + BarWidth;
+/// <summary>
+/// Calculates the rectangles of all the parts of all the bars.
+/// </summary>
+void spectrum_t::LayoutBars() noexcept
+{
+    bar_layout_settings_t Settings = { };
 
-    deviceContext->SetAntialiasMode( D2D1_ANTIALIAS_MODE_ALIASED); // Required by FillOpacityMask() and results in crispier graphics.
+    Settings.Width  = _ClientSize.width;
+    Settings.Height = _ClientSize.height;
 
-    for (const auto & fb : _Analysis->_FrequencyBands)
-    {
-        x1 = std::clamp(x1, 0.f, _ClientSize.width);
-        x2 = std::clamp(x2, 0.f, _ClientSize.width);
+    Settings.Alignment = _Settings->_HorizontalAlignment;
 
-        D2D1_RECT_F Rect = { x1, 0.f, x2 - 1.f, _ClientSize.height};
+    Settings.IsVisible           = !_State->_IsPaused || (_State->_IsPaused && _State->_VisualizeDuringPause);
+    Settings.SuppressMirrorImage = _State->_SuppressMirrorImage;
+    Settings.NyquistFrequency    = _Analysis->_NyquistFrequency;
+    Settings.ShowPeaks           = (_State->_PeakMode != PeakMode::None);
 
-        // Draw the bar background, even above the Nyquist frequency.
-        if (fb.HasDarkBackground)
-        {
-            if (_DarkBackgroundStyle->IsEnabled())
-                RenderBarPart(deviceContext, Rect, _DarkBackgroundStyle);
-        }
-        else
-        {
-            if (_LightBackgroundStyle->IsEnabled())
-                RenderBarPart(deviceContext, Rect, _LightBackgroundStyle);
-        }
+    Settings.LEDMode         = _State->_LEDMode;
+    Settings.LEDIntegralSize = _State->_LEDIntegralSize;
+    Settings.LEDSize         = _State->_LEDLight + _State->_LEDGap;
 
-        if (!_State->_IsPaused || (_State->_IsPaused && _State->_VisualizeDuringPause))
-        {
-            const bool GreaterThanNyquist = fb.Lo >= _Analysis->_NyquistFrequency; // 24/09/25: Use the lower frequency of a band instead of the center frequency.
+    const style_t * Styles[] = { _DarkBackgroundStyle, _LightBackgroundStyle, _BarPeakAreaStyle, _BarPeakTopStyle, _BarAreaStyle, _BarTopStyle }; // In the order of BarPart
 
-            if (!GreaterThanNyquist || (GreaterThanNyquist && !_State->_SuppressMirrorImage))
-            {
-                if ((_State->_PeakMode != PeakMode::None) && (fb.MaxValue > 0.))
-                    RenderBar(deviceContext, Rect, _BarPeakAreaStyle, _BarPeakTopStyle, fb.MaxValue, fb.Opacity);
+    for (size_t i = 0; i < _countof(Styles); ++i)
+        Settings.IsEnabled[i] = Styles[i]->IsEnabled();
 
-                if (fb.Value > 0.)
-                    RenderBar(deviceContext, Rect, _BarAreaStyle, _BarTopStyle, fb.Value, fb.Opacity);
-            }
-        }
+    Settings.TopThickness     = _BarTopStyle->_Thickness;
+    Settings.PeakTopThickness = _BarPeakTopStyle->_Thickness;
 
-        x1 = x2;
-        x2 = x1 + BarWidth;
-    }
+    _BarLayout.Layout(_Analysis->_FrequencyBands, Settings);
 }
 
 /// <summary>
-/// Renders a single bar.
+/// Renders a part of all the bars.
 /// </summary>
-void spectrum_t::RenderBar(ID2D1DeviceContext * deviceContext, D2D1_RECT_F & rect, const style_t * areaStyle, const style_t * topStyle, double value, double opacity) noexcept
+void spectrum_t::RenderBarParts(ID2D1DeviceContext * deviceContext, BarPart part, style_t * style) const noexcept
 {
-    rect.top    = 0.f;
-    rect.bottom = _ClientSize.height * (FLOAT) value;
+    const auto & Parts = _BarLayout.GetParts(part);
+
+    // These parts change the brush for each bar.
+    const bool IsAmplitudeBased = (part == BarPart::Area) && style->IsAmplitudeBased();
+    const bool IsFading = ((part == BarPart::PeakTop) || (part == BarPart::Top)) && ((_State->_PeakMode == PeakMode::FadeOut) || (_State->_PeakMode == PeakMode::FadingAIMP));
 
-    // Draw the bar area.
-    if (areaStyle->IsEnabled())
+    if (!_State->_LEDMode)
     {
-        if (_BarAreaStyle->IsAmplitudeBased())
-            _BarAreaStyle->SetBrushColor(value);
+        for (const auto & p : Parts)
+        {
+            if (IsAmplitudeBased)
+                style->SetBrushColor(p.Value);
+
+            if (IsFading)
+                style->_Brush->SetOpacity((FLOAT) p.Opacity);
 
-        RenderBarPart(deviceContext, rect, areaStyle);
+            deviceContext->FillRectangle(ToRect(p.Rect), style->_Brush);
+        }
+
+        return;
     }
 
-    // Draw the bar top.
-    if (topStyle->IsEnabled())
+    if (IsAmplitudeBased || IsFading)
     {
-        if (_State->_LEDMode)
+        for (const auto & p : Parts)
         {
-            rect.bottom = _ClientSize.height * (FLOAT) value;
-            rect.top    = rect.bottom - _LEDSize;
-        }
-        else
-        {
-            rect.top    = std::clamp(rect.bottom - topStyle->_Thickness / 2.f, 0.f, _ClientSize.height);
-            rect.bottom = std::clamp(rect.top    + topStyle->_Thickness,       0.f, _ClientSize.height);
-        }
+            if (IsAmplitudeBased)
+                style->SetBrushColor(p.Value);
+
+            if (IsFading)
+                style->_Brush->SetOpacity((FLOAT) p.Opacity);
+
+            deviceContext->PushAxisAlignedClip(ToRect(p.Rect), D2D1_ANTIALIAS_MODE_ALIASED);
 
-        if ((_State->_PeakMode == PeakMode::FadeOut) || (_State->_PeakMode == PeakMode::FadingAIMP))
-            topStyle->_Brush->SetOpacity((FLOAT) opacity);
+            const D2D1_RECT_F Src = { p.Rect.left, 0.f, p.Rect.right, _ClientSize.height };
+
+            deviceContext->FillOpacityMask(_OpacityMask, style->_Brush, Src, Src);
+
+            deviceContext->PopAxisAlignedClip();
+        }
 
-        RenderBarPart(deviceContext, rect, topStyle);
+        return;
     }
-}
 
-/// <summary>
-/// Renders a part of a bar.
-/// </summary>
-void spectrum_t::RenderBarPart(ID2D1DeviceContext * deviceContext, D2D1_RECT_F & rect, const style_t * style) const noexcept
-{
-    if (_State->_LEDMode)
+    // Fill the LEDs of all the bars at once through a layer that is masked by the rectangles of the bars.
+    CComPtr<ID2D1PathGeometry> Mask;
+
+    HRESULT hr = _Direct2D.Factory->CreatePathGeometry(&Mask);
+
+    CComPtr<ID2D1GeometrySink> Sink;
+
+    if (SUCCEEDED(hr))
+        hr = Mask->Open(&Sink);
+
+    if (SUCCEEDED(hr))
     {
-        if (_State->_LEDIntegralSize)
+        for (const auto & p : Parts)
         {
-            rect.top    = std::clamp(std::ceilf(rect.top    / _LEDSize) * _LEDSize, _ClientRect.top, _ClientRect.bottom);
-            rect.bottom = std::clamp(std::ceilf(rect.bottom / _LEDSize) * _LEDSize, _ClientRect.top, _ClientRect.bottom);
+            Sink->BeginFigure(D2D1::Point2F(p.Rect.left, p.Rect.top), D2D1_FIGURE_BEGIN_FILLED);
+
+            Sink->AddLine(D2D1::Point2F(p.Rect.right, p.Rect.top));
+            Sink->AddLine(D2D1::Point2F(p.Rect.right, p.Rect.bottom));
+            Sink->AddLine(D2D1::Point2F(p.Rect.left,  p.Rect.bottom));
+
+            Sink->EndFigure(D2D1_FIGURE_END_CLOSED);
         }
 
-        deviceContext->PushAxisAlignedClip(rect, D2D1_ANTIALIAS_MODE_ALIASED);
+        hr = Sink->Close();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        deviceContext->PushLayer(D2D1::LayerParameters1(D2D1::InfiniteRect(), Mask, D2D1_ANTIALIAS_MODE_ALIASED), nullptr);
 
-        const D2D1_RECT_F Src = { rect.left, 0.f, rect.right, _ClientSize.height };
+        const D2D1_RECT_F Src = { 0.f, 0.f, _ClientSize.width, _ClientSize.height };
 
         deviceContext->FillOpacityMask(_OpacityMask, style->_Brush, Src, Src);
 
-        deviceContext->PopAxisAlignedClip();
+        deviceContext->PopLayer();
     }
-    else
-        deviceContext->FillRectangle(rect, style->_Brush);
 }
 
 /// <summary>
@@ -281,7 +311,7 @@ void spectrum_t::RenderCurve(ID2D1DeviceContext * deviceContext) noexcept
 
     deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
-    geometry_points_t Points;
+    curve_points_t & Points = _CurvePoints;
     CComPtr<ID2D1PathGeometry> Curve;
 
     if ((_State->_PeakMode != PeakMode::None) && (_CurvePeakAreaStyle->IsEnabled() || _CurvePeakLineStyle->IsEnabled()))
@@ -290,27 +320,20 @@ void spectrum_t::RenderCurve(ID2D1DeviceContext * deviceContext) noexcept
 
         hr = CreateGeometryPointsFromAmplitude(Points, true);
 
-        // Draw the area with the peak values.
-        if (SUCCEEDED(hr) && _CurvePeakAreaStyle->IsEnabled())
-        {
-            hr = CreateCurve(Points, true, &Curve);
-
-            if (SUCCEEDED(hr))
-                deviceContext->FillGeometry(Curve, _CurvePeakAreaStyle->_Brush);
-
-            Curve.Release();
-        }
+        // Use the same geometry to draw the area and the line with the peak values.
+        if (SUCCEEDED(hr))
+            hr = GetRetainedCurve(_RetainedCurves[0], Points, 0.f, &Curve);
 
-        // Draw the line with the peak values.
-        if (SUCCEEDED(hr) && _CurvePeakLineStyle->IsEnabled())
+        if (SUCCEEDED(hr))
         {
-            hr = CreateCurve(Points, false, &Curve);
+            if (_CurvePeakAreaStyle->IsEnabled())
+                deviceContext->FillGeometry(Curve, _CurvePeakAreaStyle->_Brush);
 
-            if (SUCCEEDED(hr))
+            if (_CurvePeakLineStyle->IsEnabled())
                 deviceContext->DrawGeometry(Curve, _CurvePeakLineStyle->_Brush, _CurvePeakLineStyle->_Thickness);
-
-            Curve.Release();
         }
+
+        Curve.Release();
     }
 
     if (_CurveAreaStyle->IsEnabled() || _CurveLineStyle->IsEnabled())
@@ -319,27 +342,20 @@ void spectrum_t::RenderCurve(ID2D1DeviceContext * deviceContext) noexcept
 
         hr = CreateGeometryPointsFromAmplitude(Points, false);
 
-        // Draw the area with the current values.
-        if (SUCCEEDED(hr) && _CurveAreaStyle->IsEnabled())
-        {
-            hr = CreateCurve(Points, true, &Curve);
-
-            if (SUCCEEDED(hr))
-                deviceContext->FillGeometry(Curve, _CurveAreaStyle->_Brush);
-
-            Curve.Release();
-        }
+        // Use the same geometry to draw the area and the line with the current values.
+        if (SUCCEEDED(hr))
+            hr = GetRetainedCurve(_RetainedCurves[1], Points, 0.f, &Curve);
 
-        // Draw the line with the current values.
-        if (SUCCEEDED(hr) && _CurveLineStyle->IsEnabled())
+        if (SUCCEEDED(hr))
         {
-            hr = CreateCurve(Points, false, &Curve);
+            if (_CurveAreaStyle->IsEnabled())
+                deviceContext->FillGeometry(Curve, _CurveAreaStyle->_Brush);
 
-            if (SUCCEEDED(hr))
+            if (_CurveLineStyle->IsEnabled())
                 deviceContext->DrawGeometry(Curve, _CurveLineStyle->_Brush, _CurveLineStyle->_Thickness);
-
-            Curve.Release();
         }
+
+        Curve.Release();
     }
 }
 
@@ -361,116 +377,112 @@ void spectrum_t::RenderRadialBars(ID2D1DeviceContext * deviceContext) noexcept
 
     const FLOAT MaxSegmentHeight = OuterRadius - InnerRadius;
 
-    FLOAT a = (FLOAT) ::fmod(M_PI_2 + (_Chrono.Elapsed() * -Degrees2Radians(_State->_AngularVelocity)), 2. * M_PI);
-//  FLOAT a = (FLOAT) ::fmod(M_PI_2 + ::cos(_Chrono.Elapsed() * -_State->_AngularVelocity), 2. * M_PI);
+    const FLOAT a = (FLOAT) ::fmod(M_PI_2 + (_Chrono.Elapsed() * -Degrees2Radians(_State->_AngularVelocity)), 2. * M_PI);
+//  const FLOAT a = (FLOAT) ::fmod(M_PI_2 + ::cos(_Chrono.Elapsed() * -_State->_AngularVelocity), 2. * M_PI);
 
-    const FLOAT da = (FLOAT)(2. * M_PI) / (FLOAT) _Analysis->_FrequencyBands.size();
+    UpdateRing(a);
 
     deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
-    size_t i = 0;
-    double n = (double) (_Analysis->_FrequencyBands.size() - 1);
+    // The segments of different bands don't overlap so rendering the parts of all bands one part at a time gives the same result as rendering the parts one band at a time.
+    if (_BarPeakAreaStyle->IsEnabled())
+        RenderRadialBarParts(deviceContext, BarPart::PeakArea, _BarPeakAreaStyle, InnerRadius, MaxSegmentHeight);
 
-    CComPtr<ID2D1PathGeometry> Path;
+    if (_BarPeakTopStyle->IsEnabled() && (_State->_PeakMode != PeakMode::None)) // Always draw the peak top indicator
+        RenderRadialBarParts(deviceContext, BarPart::PeakTop, _BarPeakTopStyle, InnerRadius, MaxSegmentHeight);
 
-    for (const auto & fb : _Analysis->_FrequencyBands)
-    {
-        const bool GreaterThanNyquist = fb.Lo >= _Analysis->_NyquistFrequency; // 24/09/25: Use the lower frequency of a band instead of the center frequency.
+    if (_BarAreaStyle->IsEnabled())
+        RenderRadialBarParts(deviceContext, BarPart::Area, _BarAreaStyle, InnerRadius, MaxSegmentHeight);
 
-        if (!GreaterThanNyquist || (GreaterThanNyquist && !_State->_SuppressMirrorImage))
-        {
-            // Draw the peak indicator area.
-            if (_BarPeakAreaStyle->IsEnabled())
-            {
-                const FLOAT r1 = InnerRadius;
-                const FLOAT r2 = InnerRadius + (MaxSegmentHeight * (FLOAT) fb.MaxValue);
+    if (_BarTopStyle->IsEnabled())
+        RenderRadialBarParts(deviceContext, BarPart::Top, _BarTopStyle, InnerRadius, MaxSegmentHeight);
+}
 
-                if (SUCCEEDED(CreateSegment(a, a - da, r1, r2, &Path)))
-                {
-                    if (_BarPeakAreaStyle->Has(style_t::Features::HorizontalGradient))
-                    {
-                        const double Value = _BarPeakAreaStyle->Has(style_t::Features::AmplitudeBasedColor) ? fb.Value : ((double) i / n);
+/// <summary>
+/// Renders a part of all the radial bars. All segments are added to a single geometry unless the brush changes from band to band.
+/// </summary>
+void spectrum_t::RenderRadialBarParts(ID2D1DeviceContext * deviceContext, BarPart part, style_t * style, FLOAT innerRadius, FLOAT maxSegmentHeight) noexcept
+{
+    const bool IsPeak = (part == BarPart::PeakArea) || (part == BarPart::PeakTop);
+    const bool IsTop  = (part == BarPart::PeakTop)  || (part == BarPart::Top);
 
-                        _BarPeakAreaStyle->SetBrushColor(Value);
-                    }
+    const bool HasGradient = style->Has(style_t::Features::HorizontalGradient);
+    const bool IsAmplitudeBased = style->Has(style_t::Features::AmplitudeBasedColor);
+    const bool IsFading = (part == BarPart::PeakTop) && ((_State->_PeakMode == PeakMode::FadeOut) || (_State->_PeakMode == PeakMode::FadingAIMP));
 
-                    deviceContext->FillGeometry(Path, _BarPeakAreaStyle->_Brush);
+    const bool IsPerBand = HasGradient || IsFading;
 
-                    Path.Release();
-                }
-            }
+    if (part == BarPart::PeakTop)
+        style->_Brush->SetOpacity(style->_Opacity);
 
-            // Draw the peak indicator top.
-            if (_BarPeakTopStyle->IsEnabled() &&(_State->_PeakMode != PeakMode::None))// && (fb.MaxValue > 0.)) // Always draw the peak top indicator
-            {
-                const FLOAT r1 = InnerRadius + (MaxSegmentHeight * (FLOAT) fb.MaxValue) - _BarPeakTopStyle->_Thickness / 2.f;
-                const FLOAT r2 = InnerRadius + (MaxSegmentHeight * (FLOAT) fb.MaxValue) + _BarPeakTopStyle->_Thickness;
+    const double n = (double) (_Analysis->_FrequencyBands.size() - 1);
 
-                if (SUCCEEDED(CreateSegment(a, a - da, r1, r2, &Path)))
-                {
-                    if (_BarPeakTopStyle->Has(style_t::Features::HorizontalGradient))
-                    {
-                        const double Value = _BarPeakTopStyle->Has(style_t::Features::AmplitudeBasedColor) ? fb.MaxValue : ((double) i / n);
+    CComPtr<ID2D1PathGeometry> Path;
+    CComPtr<ID2D1GeometrySink> Sink;
 
-                        _BarPeakTopStyle->SetBrushColor(Value);
-                    }
+    HRESULT hr = S_OK;
 
-                    const FLOAT Opacity = ((_State->_PeakMode == PeakMode::FadeOut) || (_State->_PeakMode == PeakMode::FadingAIMP)) ? (FLOAT) fb.Opacity : _BarPeakTopStyle->_Opacity;
+    size_t i = 0;
 
-                    _BarPeakTopStyle->_Brush->SetOpacity(Opacity);
+    for (const auto & fb : _Analysis->_FrequencyBands)
+    {
+        const bool GreaterThanNyquist = fb.Lo >= _Analysis->_NyquistFrequency; // 24/09/25: Use the lower frequency of a band instead of the center frequency.
 
-                    deviceContext->FillGeometry(Path, _BarPeakTopStyle->_Brush);
+        if (!GreaterThanNyquist || (GreaterThanNyquist && !_State->_SuppressMirrorImage))
+        {
+            const FLOAT r = innerRadius + (maxSegmentHeight * (FLOAT) (IsPeak ? fb.MaxValue : fb.Value));
 
-                    Path.Release();
-                }
-            }
+            const FLOAT r1 = IsTop ? r - style->_Thickness / 2.f : innerRadius;
+            const FLOAT r2 = IsTop ? r + style->_Thickness       : r;
 
-            // Draw the area of the bar.
-            if (_BarAreaStyle->IsEnabled())
+            if (Sink == nullptr)
             {
-                const FLOAT r1 = InnerRadius;
-                const FLOAT r2 = InnerRadius + (MaxSegmentHeight * (FLOAT) fb.Value);
+                Path.Release();
 
-                if (SUCCEEDED(CreateSegment(a, a - da, r1, r2, &Path)))
-                {
-                    if (_BarAreaStyle->Has(style_t::Features::HorizontalGradient))
-                    {
-                        const double Value = _BarAreaStyle->Has(style_t::Features::AmplitudeBasedColor) ? fb.Value : ((double) i / n);
+                hr = _Direct2D.Factory->CreatePathGeometry(&Path);
 
-                        _BarAreaStyle->SetBrushColor(Value);
-                    }
-
-                    deviceContext->FillGeometry(Path, _BarAreaStyle->_Brush);
+                if (SUCCEEDED(hr))
+                    hr = Path->Open(&Sink);
 
-                    Path.Release();
-                }
+                if (!SUCCEEDED(hr))
+                    return;
             }
 
-            // Draw the peak indicator top.
-            if (_BarTopStyle->IsEnabled())
+            AddSegment(Sink, i, r1, r2);
+
+            if (IsPerBand)
             {
-                const FLOAT r1 = InnerRadius + (MaxSegmentHeight * (FLOAT) fb.Value) - _BarTopStyle->_Thickness / 2.f;
-                const FLOAT r2 = InnerRadius + (MaxSegmentHeight * (FLOAT) fb.Value) + _BarTopStyle->_Thickness;
+                hr = Sink->Close();
+
+                Sink.Release();
 
-                if (SUCCEEDED(CreateSegment(a, a - da, r1, r2, &Path)))
+                if (SUCCEEDED(hr))
                 {
-                    if (_BarTopStyle->Has(style_t::Features::HorizontalGradient))
+                    if (HasGradient)
                     {
-                        const double Value = _BarTopStyle->Has(style_t::Features::AmplitudeBasedColor) ? fb.MaxValue : ((double) i / n);
+                        const double Value = IsAmplitudeBased ? ((part == BarPart::PeakArea) || (part == BarPart::Area) ? fb.Value : fb.MaxValue) : ((double) i / n);
 
-                        _BarTopStyle->SetBrushColor(Value);
+                        style->SetBrushColor(Value);
                     }
 
-                    deviceContext->FillGeometry(Path, _BarTopStyle->_Brush);
+                    if (IsFading)
+                        style->_Brush->SetOpacity((FLOAT) fb.Opacity);
 
-                    Path.Release();
+                    deviceContext->FillGeometry(Path, style->_Brush);
                 }
             }
         }
 
-        a -=da;
         ++i;
     }
+
+    if (Sink != nullptr)
+    {
+        hr = Sink->Close();
+
+        if (SUCCEEDED(hr))
+            deviceContext->FillGeometry(Path, style->_Brush);
+    }
 }
 
 /// <summary>
@@ -486,7 +498,7 @@ void spectrum_t::RenderRadialCurve(ID2D1DeviceContext * deviceContext) noexcept
 
     deviceContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
 
-    geometry_points_t Points;
+    curve_points_t & Points = _CurvePoints;
     CComPtr<ID2D1PathGeometry> Curve;
 
     const FLOAT Side = std::min(_ClientSize.width / 2.f, _ClientSize.height / 2.f);
@@ -498,27 +510,20 @@ void spectrum_t::RenderRadialCurve(ID2D1DeviceContext * deviceContext) noexcept
 
         hr = CreateRadialGeometryPointsFromAmplitude(Points, true);
 
-        // Draw the area with the peak values.
-        if (SUCCEEDED(hr) && _CurvePeakAreaStyle->IsEnabled())
-        {
-            hr = CreateRadialCurve(Points, InnerRadius, true, &Curve);
-
-            if (SUCCEEDED(hr))
-                deviceContext->FillGeometry(Curve, _CurvePeakAreaStyle->_Brush);
-
-            Curve.Release();
-        }
+        // Use the same geometry to draw the area and the line with the peak values.
+        if (SUCCEEDED(hr))
+            hr = GetRetainedCurve(_RetainedCurves[0], Points, InnerRadius, &Curve);
 
-        // Draw the line with the peak values.
-        if (SUCCEEDED(hr) && _CurvePeakLineStyle->IsEnabled())
+        if (SUCCEEDED(hr))
         {
-            hr = CreateRadialCurve(Points, InnerRadius, false, &Curve);
+            if (_CurvePeakAreaStyle->IsEnabled())
+                deviceContext->FillGeometry(Curve, _CurvePeakAreaStyle->_Brush);
 
-            if (SUCCEEDED(hr))
+            if (_CurvePeakLineStyle->IsEnabled())
                 deviceContext->DrawGeometry(Curve, _CurvePeakLineStyle->_Brush, _CurvePeakLineStyle->_Thickness);
-
-            Curve.Release();
         }
+
+        Curve.Release();
     }
 
     if (_CurveAreaStyle->IsEnabled() || _CurveLineStyle->IsEnabled())
@@ -527,27 +532,20 @@ void spectrum_t::RenderRadialCurve(ID2D1DeviceContext * deviceContext) noexcept
 
         hr = CreateRadialGeometryPointsFromAmplitude(Points, false);
 
-        // Draw the area with the current values.
-        if (SUCCEEDED(hr) && _CurveAreaStyle->IsEnabled())
-        {
-            hr = CreateRadialCurve(Points, InnerRadius, true, &Curve);
-
-            if (SUCCEEDED(hr))
-                deviceContext->FillGeometry(Curve, _CurveAreaStyle->_Brush);
-
-            Curve.Release();
-        }
+        // Use the same geometry to draw the area and the line with the current values.
+        if (SUCCEEDED(hr))
+            hr = GetRetainedCurve(_RetainedCurves[1], Points, InnerRadius, &Curve);
 
-        // Draw the line with the current values.
-        if (SUCCEEDED(hr) && _CurveLineStyle->IsEnabled())
+        if (SUCCEEDED(hr))
         {
-            hr = CreateRadialCurve(Points, InnerRadius, false, &Curve);
+            if (_CurveAreaStyle->IsEnabled())
+                deviceContext->FillGeometry(Curve, _CurveAreaStyle->_Brush);
 
-            if (SUCCEEDED(hr))
+            if (_CurveLineStyle->IsEnabled())
                 deviceContext->DrawGeometry(Curve, _CurveLineStyle->_Brush, _CurveLineStyle->_Thickness);
-
-            Curve.Release();
         }
+
+        Curve.Release();
     }
 }
 
@@ -564,13 +562,7 @@ void spectrum_t::RenderNyquistFrequencyMarker(ID2D1DeviceContext * deviceContext
     // The position of the Nyquist marker is calculated at the exact frequency and may not align with the center frequency of spectrum bar.
     const double NyquistScale = std::clamp(ScaleFrequency(_Analysis->_NyquistFrequency, _State->_ScalingFunction, _State->_SkewFactor), MinScale, MaxScale);
 
-    FLOAT t = _ClientSize.width / (FLOAT) _Analysis->_FrequencyBands.size();
-
-    // Use the full width of the graph?
-    if (_Settings->_HorizontalAlignment != HorizontalAlignment::Fit)
-        t = ::floor(t);
-
-    const FLOAT BarWidth = std::max(t, 2.f); // In DIP
+    const FLOAT BarWidth = bar_layout_t::GetBarWidth(_ClientSize.width, _Analysis->_FrequencyBands.size(), _Settings->_HorizontalAlignment); // In DIP
     const FLOAT SpectrumWidth = (_State->_VisualizationType == VisualizationType::Bars) ? BarWidth * (FLOAT) _Analysis->_FrequencyBands.size() : _ClientSize.width;
     const FLOAT HOffset = GetHOffset(_Settings->_HorizontalAlignment, _ClientSize.width - SpectrumWidth);
 
@@ -754,70 +746,51 @@ HRESULT spectrum_t::CreateOpacityMask(ID2D1DeviceContext * deviceContext) noexce
 /// Creates the geometry points from the amplitudes of the spectrum.
 /// Note: Created in a top-left (0,0) coordinate system and later translated and flipped as necessary.
 /// </summary>
-HRESULT spectrum_t::CreateGeometryPointsFromAmplitude(geometry_points_t & points, bool usePeak) const noexcept
+HRESULT spectrum_t::CreateGeometryPointsFromAmplitude(curve_points_t & points, bool usePeak) noexcept
 {
-    if (_Analysis->_FrequencyBands.size() < 2)
-        return E_FAIL;
-
-    bool IsFlatLine = true;
-
-    const FLOAT BandWidth = std::max((_ClientSize.width / (FLOAT) (_Analysis->_FrequencyBands.size() - 1)), 1.f);
+    curve_settings_t Settings = { };
 
-    FLOAT x = BandWidth / 2.f; // Make sure the knots are nicely centered in the band rectangle.
-    FLOAT y = 0.f;
+    Settings.Width               = _ClientSize.width;
+    Settings.Height              = _ClientSize.height;
+    Settings.SuppressMirrorImage = _State->_SuppressMirrorImage;
+    Settings.NyquistFrequency    = _Analysis->_NyquistFrequency;
 
-    // Create all the knots.
-    for (const auto & fb: _Analysis->_FrequencyBands)
-    {
-        double Value = 0.;
-
-        // Don't render anything above the Nyquist frequency.
-        if (!((fb.Lo > _Analysis->_NyquistFrequency) && _State->_SuppressMirrorImage))
-            Value = !usePeak ? fb.Value : fb.MaxValue;
-
-        y = std::clamp((FLOAT)(Value * _ClientSize.height), 0.f, _ClientSize.height);
-
-        points.p0.push_back(D2D1::Point2F(x, y));
-
-        if (y > 0.f)
-            IsFlatLine = false;
-
-        x += BandWidth;
-    }
+    return _CurveBuilder.Build(_Analysis->_FrequencyBands, Settings, usePeak, points) ? S_OK : E_FAIL;
+}
 
-    // Create all the control points.
-    const size_t n = points.p0.size();
+/// <summary>
+/// Gets the geometry of the curve through the specified points. The geometry of the previous frame is reused when the knots did not change (e.g. during silence or pause).
+/// </summary>
+HRESULT spectrum_t::GetRetainedCurve(retained_curve_t & rc, const curve_points_t & gp, FLOAT innerRadius, ID2D1PathGeometry ** curve) noexcept
+{
+    const bool IsRadial = (_State->_VisualizationType == VisualizationType::RadialCurve);
 
-    if (n > 1)
+    if ((rc.Geometry == nullptr) || (rc.IsRadial != IsRadial) || (rc.InnerRadius != innerRadius) || (rc.Knots.size() != gp.p0.size()) || (::memcmp(rc.Knots.data(), gp.p0.data(), gp.p0.size() * sizeof(layout_point_t)) != 0))
     {
-        points.p1.reserve(n - 1);
-        points.p2.reserve(n - 1);
+        rc.Geometry.Release();
 
-        bezier_spline_t::GetControlPoints(points.p0, points.p1, points.p2);
+        HRESULT hr = IsRadial ? CreateRadialCurve(gp, innerRadius, &rc.Geometry) : CreateCurve(gp, &rc.Geometry);
 
-        // Make sure all y-coordinates are positive.
-        std::transform(std::execution::par_unseq, points.p1.begin(), points.p1.end(), points.p1.begin(), [this](D2D1_POINT_2F & p)
+        if (!SUCCEEDED(hr))
         {
-            p.y = std::clamp(p.y, 0.f, _ClientSize.height);
+            rc.Geometry.Release();
+            rc.Knots.clear();
 
-            return p;
-        });
-
-        std::transform(std::execution::par_unseq, points.p2.begin(), points.p2.end(), points.p2.begin(), [this](D2D1_POINT_2F & p)
-        {
-            p.y = std::clamp(p.y, 0.f, _ClientSize.height);
+            return hr;
+        }
 
-            return p;
-        });
+        rc.Knots.assign(gp.p0.begin(), gp.p0.end());
+        rc.InnerRadius = innerRadius;
+        rc.IsRadial = IsRadial;
     }
 
-    return !IsFlatLine ? S_OK : E_FAIL;
+    return rc.Geometry.CopyTo(curve);
 }
 
 /// <summary>
-/// Creates a curve from the power values.
+/// Creates a curve from the power values. The curve can be filled and stroked: the vertical lines that close the area are not stroked.
 /// </summary>
-HRESULT spectrum_t::CreateCurve(const geometry_points_t & gp, bool isFilled, ID2D1PathGeometry ** curve) const noexcept
+HRESULT spectrum_t::CreateCurve(const curve_points_t & gp, ID2D1PathGeometry ** curve) const noexcept
 {
     if (gp.p0.size() < 2)
         return E_FAIL;
@@ -833,21 +806,19 @@ HRESULT spectrum_t::CreateCurve(const geometry_points_t & gp, bool isFilled, ID2
     {
         Sink->SetFillMode(D2D1_FILL_MODE_WINDING);
 
-        if (isFilled)
-        {
-            Sink->BeginFigure(D2D1::Point2F(0.f, 0.f), D2D1_FIGURE_BEGIN_FILLED); // Start with a vertical line going up.
-            Sink->AddLine(D2D1::Point2F(0.f, gp.p0[0].y));
-        }
-        else
-            Sink->BeginFigure(D2D1::Point2F(0.f, gp.p0[0].y), D2D1_FIGURE_BEGIN_HOLLOW);
+        Sink->BeginFigure(D2D1::Point2F(0.f, 0.f), D2D1_FIGURE_BEGIN_FILLED);
+
+        Sink->SetSegmentFlags(D2D1_PATH_SEGMENT_FORCE_UNSTROKED);
+        Sink->AddLine(D2D1::Point2F(0.f, gp.p0[0].y)); // Start with a vertical line going up.
+        Sink->SetSegmentFlags(D2D1_PATH_SEGMENT_NONE);
 
         const size_t n = gp.p1.size();
 
         for (size_t i = 0; i < n; ++i)
-            Sink->AddBezier(D2D1::BezierSegment(gp.p1[i], gp.p2[i], gp.p0[i + 1]));
+            Sink->AddBezier(D2D1::BezierSegment(ToPoint(gp.p1[i]), ToPoint(gp.p2[i]), ToPoint(gp.p0[i + 1])));
 
-        if (isFilled)
-            Sink->AddLine(D2D1::Point2F(gp.p0[n].x, 0.f)); // End with a vertical line going down.
+        Sink->SetSegmentFlags(D2D1_PATH_SEGMENT_FORCE_UNSTROKED);
+        Sink->AddLine(D2D1::Point2F(gp.p0[n].x, 0.f)); // End with a vertical line going down.
 
         Sink->EndFigure(D2D1_FIGURE_END_OPEN);
 
@@ -861,113 +832,26 @@ HRESULT spectrum_t::CreateCurve(const geometry_points_t & gp, bool isFilled, ID2
 /// Creates the geometry points from the amplitudes of the spectrum.
 /// Note: Created in a top-left (0,0) coordinate system and later translated and flipped as necessary.
 /// </summary>
-HRESULT spectrum_t::CreateRadialGeometryPointsFromAmplitude(geometry_points_t & points, bool usePeak) const noexcept
+HRESULT spectrum_t::CreateRadialGeometryPointsFromAmplitude(curve_points_t & points, bool usePeak) noexcept
 {
-    if (_Analysis->_FrequencyBands.size() < 2)
-        return E_FAIL;
-
-    bool IsFlatLine = true;
-
     const FLOAT Side = std::min(_ClientSize.width / 2.f, _ClientSize.height / 2.f);
-    const FLOAT InnerRadius = Side * _State->_InnerRadius;
-    const FLOAT OuterRadius = Side * _State->_OuterRadius;
 
-    const FLOAT MaxHeight = OuterRadius - InnerRadius;
+    curve_settings_t Settings = { };
 
-    FLOAT a = (FLOAT) ::fmod(M_PI_2 + (_Chrono.Elapsed() * -Degrees2Radians(_State->_AngularVelocity)), 2. * M_PI);
-//  FLOAT a = (FLOAT) ::fmod(M_PI_2 + ::cos(_Chrono.Elapsed() * -_State->_AngularVelocity), 2. * M_PI);
+    Settings.SuppressMirrorImage = _State->_SuppressMirrorImage;
+    Settings.NyquistFrequency    = _Analysis->_NyquistFrequency;
 
-    const FLOAT da = (FLOAT)(2. * M_PI) / (FLOAT) _Analysis->_FrequencyBands.size();
+    Settings.InnerRadius = Side * _State->_InnerRadius;
+    Settings.OuterRadius = Side * _State->_OuterRadius;
+    Settings.Angle       = (FLOAT) ::fmod(M_PI_2 + (_Chrono.Elapsed() * -Degrees2Radians(_State->_AngularVelocity)), 2. * M_PI);
 
-    // Create all the knots.
-    for (const auto & fb: _Analysis->_FrequencyBands)
-    {
-        // Don't render anything above the Nyquist frequency.
-        if ((fb.Lo > _Analysis->_NyquistFrequency) && _State->_SuppressMirrorImage)
-            break;
-
-        const double Value = !usePeak ? fb.Value : fb.MaxValue;
-
-        const FLOAT r2 = InnerRadius + (MaxHeight * (FLOAT) Value);
-
-        FLOAT Sin, Cos;
-
-        ::D2D1SinCos(a, &Sin, &Cos);
-
-        FLOAT x = (FLOAT) (Cos * r2);
-        FLOAT y = (FLOAT) (Sin * r2);
-
-        points.p0.push_back(D2D1::Point2F(x, y));
-
-        if (y > 0.f)
-            IsFlatLine = false;
-
-        a -=da;
-    }
-
-    if (points.p0.empty())
-        return E_FAIL;
-
-    // Close the curve.
-    points.p0.push_back(points.p0[0]);
-
-    // Create all the control points.
-    const size_t n = points.p0.size();
-
-    if (n > 1)
-    {
-        points.p1.reserve(n - 1);
-        points.p2.reserve(n - 1);
-
-        bezier_spline_t::GetControlPoints(points.p0, points.p1, points.p2);
-
-        // Make sure all control points are on or above the inner circle.
-        std::transform(std::execution::par_unseq, points.p1.begin(), points.p1.end(), points.p1.begin(), [InnerRadius](D2D1_POINT_2F & p)
-        {
-            const FLOAT d = (FLOAT) std::sqrt(p.x * p.x + p.y * p.y);
-
-            if (d < InnerRadius)
-            {
-                const auto a = (FLOAT) std::atan2(p.y, p.x);
-
-                FLOAT Sin, Cos;
-
-                ::D2D1SinCos(a, &Sin, &Cos);
-
-                p.x = (FLOAT) (Cos * InnerRadius);
-                p.y = (FLOAT) (Sin * InnerRadius);
-            }
-
-            return p;
-        });
-
-        std::transform(std::execution::par_unseq, points.p2.begin(), points.p2.end(), points.p2.begin(), [InnerRadius](D2D1_POINT_2F & p)
-        {
-            const FLOAT d = (FLOAT) std::sqrt(p.x * p.x + p.y * p.y);
-
-            if (d < InnerRadius)
-            {
-                const auto a = (FLOAT) std::atan2(p.y, p.x);
-
-                FLOAT Sin, Cos;
-
-                ::D2D1SinCos(a, &Sin, &Cos);
-
-                p.x = (FLOAT) (Cos * InnerRadius);
-                p.y = (FLOAT) (Sin * InnerRadius);
-            }
-
-            return p;
-        });
-    }
-
-    return !IsFlatLine ? S_OK : E_FAIL;
+    return _CurveBuilder.BuildRadial(_Analysis->_FrequencyBands, Settings, usePeak, points) ? S_OK : E_FAIL;
 }
 
 /// <summary>
-/// Creates a radial curve from the power values.
+/// Creates a radial curve from the power values. The curve can be filled and stroked.
 /// </summary>
-HRESULT spectrum_t::CreateRadialCurve(const geometry_points_t & gp, FLOAT innerRadius, bool isFilled, ID2D1PathGeometry ** curve) const noexcept
+HRESULT spectrum_t::CreateRadialCurve(const curve_points_t & gp, FLOAT innerRadius, ID2D1PathGeometry ** curve) const noexcept
 {
     if (gp.p0.size() < 2)
         return E_FAIL;
@@ -981,13 +865,9 @@ HRESULT spectrum_t::CreateRadialCurve(const geometry_points_t & gp, FLOAT innerR
 
     if (SUCCEEDED(hr))
     {
-        D2D1_FIGURE_BEGIN BeginMode = D2D1_FIGURE_BEGIN_HOLLOW;
+        const D2D1_FIGURE_BEGIN BeginMode = D2D1_FIGURE_BEGIN_FILLED;
 
-        if (isFilled)
-        {
-            BeginMode = D2D1_FIGURE_BEGIN_FILLED;
-            Sink->SetFillMode(D2D1_FILL_MODE_ALTERNATE); // Even-odd fill
-        }
+        Sink->SetFillMode(D2D1_FILL_MODE_ALTERNATE); // Even-odd fill
 
         // Add the curve.
         {
@@ -996,12 +876,9 @@ HRESULT spectrum_t::CreateRadialCurve(const geometry_points_t & gp, FLOAT innerR
             const size_t n = gp.p1.size();
 
             for (size_t i = 0; i < n; ++i)
-                Sink->AddBezier(D2D1::BezierSegment(gp.p1[i], gp.p2[i], gp.p0[i + 1]));
+                Sink->AddBezier(D2D1::BezierSegment(ToPoint(gp.p1[i]), ToPoint(gp.p2[i]), ToPoint(gp.p0[i + 1])));
 
-            if (isFilled)
-                Sink->EndFigure(D2D1_FIGURE_END_CLOSED);
-            else
-                Sink->EndFigure(D2D1_FIGURE_END_OPEN);
+            Sink->EndFigure(D2D1_FIGURE_END_CLOSED); // The last knot is the first knot.
         }
 
         // Add the inner circle.
@@ -1021,56 +898,60 @@ HRESULT spectrum_t::CreateRadialCurve(const geometry_points_t & gp, FLOAT innerR
 }
 
 /// <summary>
-/// Creates a segment for the radial bar.
+/// Rotates the unit vectors of the edges of the radial bars. The unit vectors are only recalculated when the number of bands changes.
 /// </summary>
-HRESULT spectrum_t::CreateSegment(FLOAT a1, FLOAT a2, FLOAT r1, FLOAT r2, ID2D1PathGeometry ** pathGeometry) const noexcept
+void spectrum_t::UpdateRing(FLOAT angle) noexcept
 {
-    HRESULT hr = _Direct2D.Factory->CreatePathGeometry(pathGeometry);
-
-    if (!SUCCEEDED(hr))
-        return hr;
-
-    CComPtr<ID2D1GeometrySink> Sink;
+    const size_t Count = _Analysis->_FrequencyBands.size() + 1;
 
-    hr = (*pathGeometry)->Open(&Sink);
-
-    if (SUCCEEDED(hr))
+    if (_UnitRing.size() != Count)
     {
-        FLOAT Sin, Cos;
+        const FLOAT da = (FLOAT)(2. * M_PI) / (FLOAT) (Count - 1);
 
-        ::D2D1SinCos(a1, &Sin, &Cos);
+        _UnitRing.resize(Count);
 
-        FLOAT x = (FLOAT) (Cos * r1);
-        FLOAT y = (FLOAT) (Sin * r1);
+        for (size_t i = 0; i < Count; ++i)
+        {
+            FLOAT Sin, Cos;
 
-        Sink->BeginFigure(D2D1::Point2F(x, y), D2D1_FIGURE_BEGIN_FILLED);
+            ::D2D1SinCos(-da * (FLOAT) i, &Sin, &Cos);
 
-        // Vertical from inner to outer circle.
-        x = (FLOAT) (Cos * r2);
-        y = (FLOAT) (Sin * r2);
+            _UnitRing[i] = D2D1::Point2F(Cos, Sin);
+        }
 
-        Sink->AddLine(D2D1::Point2F(x, y));
+        _Ring.resize(Count);
+    }
+
+    FLOAT Sin, Cos;
 
-        // Top arc
-        ::D2D1SinCos(a2, &Sin, &Cos);
+    ::D2D1SinCos(angle, &Sin, &Cos);
 
-        x = (FLOAT) (Cos * r2);
-        y = (FLOAT) (Sin * r2);
+    for (size_t i = 0; i < Count; ++i)
+    {
+        const D2D1_POINT_2F & p = _UnitRing[i];
 
-        Sink->AddArc(D2D1::ArcSegment(D2D1::Point2F(x, y), D2D1::SizeF(r2, r2), 0.0f, D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE, D2D1_ARC_SIZE_SMALL));      
+        _Ring[i] = D2D1::Point2F((Cos * p.x) - (Sin * p.y), (Sin * p.x) + (Cos * p.y));
+    }
+}
 
-        // Vertical from outer to inner circle.
-        x = (FLOAT) (Cos * r1);
-        y = (FLOAT) (Sin * r1);
+/// <summary>
+/// Adds the segment of the radial bar of the specified band to a geometry.
+/// </summary>
+void spectrum_t::AddSegment(ID2D1GeometrySink * sink, size_t band, FLOAT r1, FLOAT r2) const noexcept
+{
+    const D2D1_POINT_2F & p1 = _Ring[band];
+    const D2D1_POINT_2F & p2 = _Ring[band + 1];
 
-        Sink->AddLine(D2D1::Point2F(x, y));
+    sink->BeginFigure(D2D1::Point2F(p1.x * r1, p1.y * r1), D2D1_FIGURE_BEGIN_FILLED);
 
-        Sink->EndFigure(D2D1_FIGURE_END_CLOSED);
+    // Vertical from inner to outer circle.
+    sink->AddLine(D2D1::Point2F(p1.x * r2, p1.y * r2));
 
-        Sink->Close();
+    // Top arc
+    sink->AddArc(D2D1::ArcSegment(D2D1::Point2F(p2.x * r2, p2.y * r2), D2D1::SizeF(r2, r2), 0.0f, D2D1_SWEEP_DIRECTION_COUNTER_CLOCKWISE, D2D1_ARC_SIZE_SMALL));
 
-        Sink.Release();
-    }
+    // Vertical from outer to inner circle.
+    sink->AddLine(D2D1::Point2F(p2.x * r1, p2.y * r1));
 
-    return hr;
+    sink->EndFigure(D2D1_FIGURE_END_CLOSED);
 }
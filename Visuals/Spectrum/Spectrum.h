@@ -1,5 +1,5 @@
 
-/** $VER: Spectrum.h (2025.09.28) P. Stuer -  Implements a spectrum analyzer visualization **/
+/** $VER: Spectrum.h (2026.10.18) P. Stuer -  Implements a spectrum analyzer visualization **/
 
 #pragma once
 
@@ -20,6 +20,8 @@
 #include "YAxis.h"
 
 #include "Chrono.h"
+#include "CurveBuilder.h"
+#include "BarLayout.h"
 
 #include <valarray>
 #include <vector>
@@ -55,39 +57,42 @@ private:
     void Resize() noexcept;
 
     void RenderBars(ID2D1DeviceContext * deviceContext) noexcept;
-    void RenderBar(ID2D1DeviceContext * deviceContext, D2D1_RECT_F & rect, const style_t * areaStyle, const style_t * topStyle, double value, double opacity) noexcept;
 
-    void RenderBarPart(ID2D1DeviceContext * deviceContext, D2D1_RECT_F & rect, const style_t * style) const noexcept;
+    void LayoutBars() noexcept;
+
+    void RenderBarParts(ID2D1DeviceContext * deviceContext, BarPart part, style_t * style) const noexcept;
 
     void RenderCurve(ID2D1DeviceContext * deviceContext) noexcept;
     void RenderRadialBars(ID2D1DeviceContext * deviceContext) noexcept;
+    void RenderRadialBarParts(ID2D1DeviceContext * deviceContext, BarPart part, style_t * style, FLOAT innerRadius, FLOAT maxSegmentHeight) noexcept;
     void RenderRadialCurve(ID2D1DeviceContext * deviceContext) noexcept;
 
     void RenderNyquistFrequencyMarker(ID2D1DeviceContext * deviceContext) const noexcept;
 
     HRESULT CreateOpacityMask(ID2D1DeviceContext * deviceContext) noexcept;
 
-    struct geometry_points_t
+    /// <summary>
+    /// Represents the geometry of a curve that is kept until its knots change.
+    /// </summary>
+    struct retained_curve_t
     {
-        std::vector<D2D1_POINT_2F> p0; // Determines how many knots will be used to calculate control points.
-        std::vector<D2D1_POINT_2F> p1; // First control points
-        std::vector<D2D1_POINT_2F> p2; // Second control points
-
-        void Clear()
-        {
-            p0.clear();
-            p1.clear();
-            p2.clear();
-        }
+        std::vector<layout_point_t> Knots;  // Knots the geometry was created from.
+        FLOAT InnerRadius = 0.f;
+        bool IsRadial = false;
+
+        CComPtr<ID2D1PathGeometry> Geometry;
     };
 
-    HRESULT CreateGeometryPointsFromAmplitude(geometry_points_t & gp, bool usePeak) const noexcept;
-    HRESULT CreateCurve(const geometry_points_t & gp, bool isFilled, ID2D1PathGeometry ** curve) const noexcept;
+    HRESULT GetRetainedCurve(retained_curve_t & rc, const curve_points_t & gp, FLOAT innerRadius, ID2D1PathGeometry ** curve) noexcept;
 
-    HRESULT CreateSegment(FLOAT a1, FLOAT a2, FLOAT r1, FLOAT r2, ID2D1PathGeometry ** segment) const noexcept;
+    HRESULT CreateGeometryPointsFromAmplitude(curve_points_t & gp, bool usePeak) noexcept;
+    HRESULT CreateCurve(const curve_points_t & gp, ID2D1PathGeometry ** curve) const noexcept;
 
-    HRESULT CreateRadialGeometryPointsFromAmplitude(geometry_points_t & gp, bool usePeak) const noexcept;
-    HRESULT CreateRadialCurve(const geometry_points_t & gp, FLOAT innerRadius, bool isFilled, ID2D1PathGeometry ** curve) const noexcept;
+    void UpdateRing(FLOAT angle) noexcept;
+    void AddSegment(ID2D1GeometrySink * sink, size_t band, FLOAT r1, FLOAT r2) const noexcept;
+
+    HRESULT CreateRadialGeometryPointsFromAmplitude(curve_points_t & gp, bool usePeak) noexcept;
+    HRESULT CreateRadialCurve(const curve_points_t & gp, FLOAT innerRadius, ID2D1PathGeometry ** curve) const noexcept;
 
 private:
     const FLOAT PaddingX = 0.f;
@@ -99,10 +104,17 @@ private:
     x_axis_t _XAxis;
     y_axis_t _YAxis;
 
-    FLOAT _LEDSize;
-
     chrono_t _Chrono;
 
+    curve_points_t _CurvePoints;            // Reused by every curve to avoid allocating memory each frame.
+    curve_builder_t _CurveBuilder;
+    retained_curve_t _RetainedCurves[2];    // Geometries of the curves with the peak values and the current values.
+
+    bar_layout_t _BarLayout;                // Rectangles of the parts of all the bars. Reused each frame.
+
+    std::vector<D2D1_POINT_2F> _UnitRing;   // Unit vectors of the edges of the radial bars. Recalculated when the number of bands changes.
+    std::vector<D2D1_POINT_2F> _Ring;       // Unit vectors of the edges of the radial bars, rotated to the current angle.
+
     // Device-dependent resources
     CComPtr<ID2D1Bitmap> _OpacityMask;
 
@@ -1,11 +1,12 @@
 
-/** $VER: XAXis.cpp (2025.09.24) P. Stuer - Implements the X axis of a graph. **/
+/** $VER: XAXis.cpp (2026.10.18) P. Stuer - Implements the X axis of a graph. **/
 
 #include "pch.h"
 #include "XAxis.h"
 
 #include "StyleManager.h"
-#include "DirectWrite.h"
+#include "BarLayout.h"
+#include "TextLayoutCache.h"
 
 #include "Support.h"
 
@@ -158,14 +159,8 @@ void x_axis_t::Resize() noexcept
     if (!_IsResized || (_Size.width == 0.f) || (_Size.height == 0.f))
         return;
 
-    FLOAT t = _Size.width / (FLOAT) _BandCount;
-
-    // Use the full width of the graph?
-    if (_Settings->_HorizontalAlignment != HorizontalAlignment::Fit)
-        t = ::floor(t);
-
     // Calculate the position of the labels.
-    const FLOAT BarWidth = std::max(t, 2.f); // In DIP
+    const FLOAT BarWidth = bar_layout_t::GetBarWidth(_Size.width, _BandCount, _Settings->_HorizontalAlignment); // In DIP
     const FLOAT SpectrumWidth = (_State->_VisualizationType == VisualizationType::Bars) ? BarWidth * (FLOAT) _BandCount : _Size.width;
     const FLOAT HOffset = GetHOffset(_Settings->_HorizontalAlignment, _Size.width - SpectrumWidth);
 
@@ -189,16 +184,12 @@ void x_axis_t::Resize() noexcept
         Iter.PointB = D2D1_POINT_2F(x, yb);
 
         {
-            CComPtr<IDWriteTextLayout> TextLayout;
+            DWRITE_TEXT_METRICS TextMetrics = { };
 
-            HRESULT hr = _DirectWrite.Factory->CreateTextLayout(Iter.Text.c_str(), (UINT) Iter.Text.size(), _TextStyle->_TextFormat, _Size.width, _Size.height, &TextLayout);
+            HRESULT hr = _TextLayoutCache.GetTextMetrics(Iter.Text, _TextStyle->_TextFormat, TextMetrics);
 
             if (SUCCEEDED(hr))
             {
-                DWRITE_TEXT_METRICS TextMetrics = { };
-
-                TextLayout->GetMetrics(&TextMetrics);
-
                 Iter.RectT = { x - (TextMetrics.width / 2.f), _Rect.top, x + (TextMetrics.width / 2.f), yt };
 
                 // Make sure the label is completely visible.
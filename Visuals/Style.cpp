@@ -1,17 +1,22 @@
 
-/** $VER: Style.cpp (2026.02.11) P. Stuer **/
+/** $VER: Style.cpp (2026.10.18) P. Stuer **/
 
 #include "pch.h"
 #include "Style.h"
 
 #include "Direct2D.h"
 #include "Gradients.h"
+#include "AmplitudeMap.h"
 #include "Support.h"
 
 #include "Log.h"
 
 #pragma hdrstop
 
+std::atomic<uint64_t> style_t::_LastGeneration = 0;
+
+static_assert((sizeof(amplitude_color_t) == sizeof(D2D1_COLOR_F)) && (sizeof(amplitude_gradient_stop_t) == sizeof(D2D1_GRADIENT_STOP)), "The amplitude map colors must have the layout of the Direct2D colors.");
+
 /// <summary>
 /// Initializes an instance.
 /// </summary>
@@ -163,10 +168,14 @@ HRESULT style_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceContex
     {
         if (Has(style_t::Features::HorizontalGradient | style_t::Features::AmplitudeBasedColor))
         {
-            hr = deviceContext->CreateSolidColorBrush(D2D1::ColorF(0), (ID2D1SolidColorBrush **) &_Brush); // The color of the brush will be set during rendering.
+            hr = deviceContext->CreateSolidColorBrush(D2D1::ColorF(0), &_ColorBrush); // The color of the brush will be set during rendering.
 
             if (SUCCEEDED(hr))
+            {
+                _Brush = _ColorBrush;
+
                 hr = CreateAmplitudeMap(_ColorScheme, _CurrentGradientStops, _AmplitudeMap);
+            }
         }
         else
             hr = _Direct2D.CreateGradientBrush(deviceContext, _CurrentGradientStops, size, Has(style_t::Features::HorizontalGradient), (ID2D1LinearGradientBrush **) &_Brush);
@@ -175,6 +184,16 @@ HRESULT style_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceContex
     if (_Brush)
         _Brush->SetOpacity(_Opacity);
 
+    if (SUCCEEDED(hr))
+    {
+        if (!_AmplitudeMap.empty())
+            CreatePixelMap(_AmplitudeMap.data(), _AmplitudeMap.size(), _Opacity, _PixelMap);
+        else
+            CreatePixelMap(&_CurrentColor, 1, _Opacity, _PixelMap);
+    }
+
+    NextGeneration();
+
     if (Has(style_t::Features::SupportsFont) && (_TextFormat == nullptr) && !_FontName.empty())
     {
         const FLOAT FontSize = ToDIPs(_FontSize) / scaleFactor; // In DIPs
@@ -201,10 +220,14 @@ HRESULT style_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceContex
     {
         if (Has(style_t::Features::HorizontalGradient | style_t::Features::AmplitudeBasedColor))
         {
-            hr = deviceContext->CreateSolidColorBrush(D2D1::ColorF(0), (ID2D1SolidColorBrush **) &_Brush); // The color of the brush will be set during rendering.
+            hr = deviceContext->CreateSolidColorBrush(D2D1::ColorF(0), &_ColorBrush); // The color of the brush will be set during rendering.
 
             if (SUCCEEDED(hr))
+            {
+                _Brush = _ColorBrush;
+
                 hr = CreateAmplitudeMap(_ColorScheme, _CurrentGradientStops, _AmplitudeMap);
+            }
         }
         else
             hr = _Direct2D.CreateRadialGradientBrush(deviceContext, _CurrentGradientStops, center, offset, rx, ry, rOffset, (ID2D1RadialGradientBrush **) &_Brush);
@@ -213,6 +236,16 @@ HRESULT style_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceContex
     if (_Brush)
         _Brush->SetOpacity(_Opacity);
 
+    if (SUCCEEDED(hr))
+    {
+        if (!_AmplitudeMap.empty())
+            CreatePixelMap(_AmplitudeMap.data(), _AmplitudeMap.size(), _Opacity, _PixelMap);
+        else
+            CreatePixelMap(&_CurrentColor, 1, _Opacity, _PixelMap);
+    }
+
+    NextGeneration();
+
     return hr;
 }
 
@@ -222,7 +255,13 @@ HRESULT style_t::CreateDeviceSpecificResources(ID2D1DeviceContext * deviceContex
 void style_t::DeleteDeviceSpecificResources() noexcept
 {
     _TextFormat.Release();
+    _ColorBrush.Release();
     _Brush.Release();
+
+    _AmplitudeMap.clear();
+    _PixelMap.clear();
+
+    NextGeneration();
 }
 
 /// <summary>
@@ -230,120 +269,43 @@ void style_t::DeleteDeviceSpecificResources() noexcept
 /// </summary>
 HRESULT style_t::SetBrushColor(double value) noexcept
 {
-    if (_AmplitudeMap.empty())
+    if (_AmplitudeMap.empty() || (_ColorBrush == nullptr))
         return E_FAIL;
 
-    ID2D1SolidColorBrush * ColorBrush = nullptr;
-
-    HRESULT hr = _Brush->QueryInterface(IID_PPV_ARGS(&ColorBrush));
+    const size_t Index = (size_t) (std::clamp(value, 0., 1.) * (double) (_AmplitudeMap.size() - 1));
 
-    if (!SUCCEEDED(hr))
-        return hr;
+    _ColorBrush->SetColor(_AmplitudeMap[Index]);
 
-    const size_t Index = msc::Map(value, 0., 1., (size_t) 0, _AmplitudeMap.size() - 1);
-
-    ColorBrush->SetColor(_AmplitudeMap[Index]);
+    return S_OK;
+}
 
-    ColorBrush->Release();
+/// <summary>
+/// Maps quantized values between 0 and 65535 to the premultiplied BGRA pixels of the amplitude map. Styles without an amplitude map use their current color.
+/// </summary>
+void style_t::GetPixels(const uint16_t * values, size_t count, uint32_t * pixels) const noexcept
+{
+    amplitude_map_t::GetPixels(_PixelMap.data(), _PixelMap.size(), values, count, pixels);
+}
 
-    return hr;
+/// <summary>
+/// Converts colors to premultiplied BGRA pixels.
+/// </summary>
+void style_t::CreatePixelMap(const D2D1_COLOR_F * colors, size_t count, FLOAT opacity, std::vector<uint32_t> & pixels) noexcept
+{
+    amplitude_map_t::CreatePixels((const amplitude_color_t *) colors, count, opacity, pixels);
 }
 
 /// <summary>
 /// Creates a color table to map the amplitudes to.
 /// </summary>
-/// <remarks>Assumes a sane gradient collection with position running from 0 to 1 in ascending order.</remarks>
 HRESULT style_t::CreateAmplitudeMap(ColorScheme colorScheme, const gradient_stops_t & gradientStops, std::vector<D2D1_COLOR_F> & colors) noexcept
 {
-    if (gradientStops.empty())
-        return E_FAIL;
-
-    const size_t Steps = 100; // Results in a 101 entry table to be mapped to amplitudes between 0 and 1.
-
-    colors.clear();
-    colors.reserve(((gradientStops.size() - 1) * Steps) + 1);
-
-    if (colorScheme != ColorScheme::SoX)
-    {
-        // Linear interpolation of the colors.
-
-        D2D1_COLOR_F Color1 = gradientStops[0].color;
-        FLOAT Position1 = gradientStops[0].position;
-
-        // Add the run-in colors.
-        uint32_t n = (uint32_t) (Position1 * (FLOAT) Steps);
-
-        for (uint32_t j = 0; j <= n; ++j)
-            colors.push_back(Color1);
-
-        // Add the gradient colors.
-        for (size_t i = 1; i < gradientStops.size(); ++i)
-        {
-            const D2D1_COLOR_F & Color2 = gradientStops[i].color;
-            const FLOAT & Position2 = gradientStops[i].position;
+    std::vector<amplitude_color_t> Colors;
 
-            // Positions may not be in ascending order while the user is editing the gradient.
-            if (Position2 > Position1)
-            {
-                const D2D1_COLOR_F Delta = { Color2.r - Color1.r, Color2.g - Color1.g, Color2.b - Color1.b, Color2.a - Color1.a };
-
-                n = (uint32_t) ((Position2 - Position1) * (FLOAT) Steps);
-
-                for (uint32_t j = 1; j < n; ++j)
-                {
-                    const FLOAT Factor = (FLOAT) j / (FLOAT) n;
-                    const D2D1_COLOR_F Color =
-                    {
-                        Color1.r + (Delta.r * Factor),
-                        Color1.g + (Delta.g * Factor),
-                        Color1.b + (Delta.b * Factor),
-                        Color1.a + (Delta.a * Factor)
-                    };
-
-                    colors.push_back(Color);
-                }
-            }
-
-            Color1 = Color2;
-            Position1 = Position2;
-        }
-
-        // Add the run-out colors.
-        for (uint32_t j = (uint32_t) (Position1 * (FLOAT) Steps); j <= Steps; ++j)
-            colors.push_back(Color1);
-
-        // The color in the lowest position should map to the highest amplitude values.
-        std::reverse(colors.begin(), colors.end());
-    }
-    else
-    {
-        double r = 0.;
-        double g = 0.;
-        double b = 0.;
+    if (!amplitude_map_t::Create((const amplitude_gradient_stop_t *) gradientStops.data(), gradientStops.size(), colorScheme == ColorScheme::SoX, Colors))
+        return E_FAIL;
 
-        for (double amplitude = 0.; amplitude <= 1.; amplitude += 1. / Steps)
-        {
-            if (amplitude >= 0.13 && amplitude < 0.73)
-                r = ::sin((amplitude - 0.13) / 0.60 * M_PI_2);
-            else
-            if (amplitude >= 0.73)
-                r = 1.0;
-
-            if (amplitude >= 0.6 && amplitude < 0.91)
-                g = ::sin((amplitude - 0.6) / 0.31 * M_PI_2);
-            else
-            if (amplitude >= 0.91)
-                g = 1.0;
-
-            if (amplitude < 0.60)
-                b = 0.5 * ::sin(amplitude / 0.6 * M_PI);
-            else
-            if (amplitude >= 0.78)
-                b = (amplitude - 0.78) / 0.22;
-
-            colors.push_back(D2D1::ColorF((FLOAT) r, (FLOAT) g, (FLOAT) b, 1.f));
-        }
-    }
+    colors.assign((const D2D1_COLOR_F *) Colors.data(), (const D2D1_COLOR_F *) Colors.data() + Colors.size());
 
     return S_OK;
 }
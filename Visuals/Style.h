@@ -1,5 +1,5 @@
 
-/** $VER: Style.h (2025.10.13) P. Stuer - Represents the style of a visual element. **/
+/** $VER: Style.h (2026.10.18) P. Stuer - Represents the style of a visual element. **/
 
 #pragma once
 
@@ -16,7 +16,9 @@
 #include "DirectWrite.h"
 #include "Support.h"
 
+#include <atomic>
 #include <string>
+#include <stdint.h>
 
 #pragma warning(disable: 4820)
 class style_t
@@ -68,6 +70,8 @@ public:
 
     HRESULT SetBrushColor(double value) noexcept;
 
+    void GetPixels(const uint16_t * values, size_t count, uint32_t * pixels) const noexcept;
+
     void SetHorizontalAlignment(DWRITE_TEXT_ALIGNMENT ta) const noexcept
     {
         if (_TextFormat)
@@ -83,10 +87,21 @@ public:
     bool IsAmplitudeBased() const noexcept { return (_ColorSource == ColorSource::Gradient) && Has(style_t::Features::HorizontalGradient | style_t::Features::AmplitudeBasedColor); }
 
     static HRESULT CreateAmplitudeMap(ColorScheme colorScheme, const gradient_stops_t & gradientStops, std::vector<D2D1_COLOR_F> & colors) noexcept;
+    static void CreatePixelMap(const D2D1_COLOR_F * colors, size_t count, FLOAT opacity, std::vector<uint32_t> & pixels) noexcept;
+
+    /// <summary>
+    /// Gets the generation of the brush and the pixel map. It changes each time they are created or deleted.
+    /// </summary>
+    uint64_t GetGeneration() const noexcept { return _Generation; }
 
 private:
     static D2D1_COLOR_F GetWindowsColor(uint32_t index) noexcept;
 
+    /// <summary>
+    /// Starts a new generation of the brush and the pixel map. Generations are unique across all styles so a style that replaces another can't be mistaken for it.
+    /// </summary>
+    void NextGeneration() noexcept { _Generation = ++_LastGeneration; }
+
 public:
     std::wstring Name;
     VisualizationTypes UsedBy;              // Determines which visualization uses the style.
@@ -113,11 +128,18 @@ public:
     D2D1_COLOR_F _CurrentColor;
     gradient_stops_t _CurrentGradientStops;
     std::vector<D2D1_COLOR_F> _AmplitudeMap;
+    std::vector<uint32_t> _PixelMap;        // Colors of the amplitude map (or the current color) as premultiplied BGRA pixels, opacity included.
 
     // DirectX resources
     CComPtr<ID2D1Brush> _Brush;
+    CComPtr<ID2D1SolidColorBrush> _ColorBrush; // Same brush as _Brush if the color is set from the amplitude map during rendering.
     CComPtr<IDWriteTextFormat> _TextFormat;
 
     FLOAT _Width;
     FLOAT _Height;
+
+private:
+    uint64_t _Generation = 0;
+
+    static std::atomic<uint64_t> _LastGeneration;
 };
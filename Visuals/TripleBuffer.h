@@ -0,0 +1,84 @@
+
+/** $VER: TripleBuffer.h (2026.10.18) P. Stuer - Implements a lock-free triple buffer. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/// <summary>
+/// Implements a lock-free triple buffer. One producer writes the next value while one consumer reads the last published value. Neither of them ever blocks.
+/// The producer owns the back buffer, the consumer owns the front buffer and the middle buffer holds the last published value.
+/// </summary>
+#pragma warning(disable: 4324 4820)
+template<typename T>
+class triple_buffer_t
+{
+public:
+    triple_buffer_t() noexcept : _Back(0), _Middle(1), _Front(2) { }
+
+    triple_buffer_t(const triple_buffer_t &) = delete;
+    triple_buffer_t & operator=(const triple_buffer_t &) = delete;
+    triple_buffer_t(triple_buffer_t &&) = delete;
+    triple_buffer_t & operator=(triple_buffer_t &&) = delete;
+
+    /// <summary>
+    /// Gets the buffer that receives the next value. Producer only.
+    /// </summary>
+    T & GetWriteBuffer() noexcept
+    {
+        return _Buffers[_Back];
+    }
+
+    /// <summary>
+    /// Publishes the write buffer. A published value that was not taken by the consumer yet is replaced. Producer only.
+    /// </summary>
+    void Publish() noexcept
+    {
+        _Back = _Middle.exchange(_Back | NewValue, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    /// <summary>
+    /// Takes the last published value. Returns false if no value was published since the previous call. Consumer only.
+    /// </summary>
+    bool Update() noexcept
+    {
+        if ((_Middle.load(std::memory_order_relaxed) & NewValue) == 0)
+            return false;
+
+        _Front = _Middle.exchange(_Front, std::memory_order_acq_rel) & IndexMask;
+
+        return true;
+    }
+
+    /// <summary>
+    /// Gets the buffer that contains the last value taken by the consumer. Consumer only. The consumer may take the contents of the buffer: it is handed back to the producer as is.
+    /// </summary>
+    T & GetReadBuffer() noexcept
+    {
+        return _Buffers[_Front];
+    }
+
+    /// <summary>
+    /// Gets the buffer that contains the last value taken by the consumer. Consumer only.
+    /// </summary>
+    const T & GetReadBuffer() const noexcept
+    {
+        return _Buffers[_Front];
+    }
+
+private:
+    static const uint32_t IndexMask = 0x03;
+    static const uint32_t NewValue  = 0x04;   // Set in the middle index when it contains a value that was not taken by the consumer yet.
+
+    T _Buffers[3];
+
+    alignas(64) uint32_t _Back;                 // Index of the buffer owned by the producer.
+    alignas(64) std::atomic<uint32_t> _Middle;  // Index of the buffer that contains the last published value.
+    alignas(64) uint32_t _Front;                // Index of the buffer owned by the consumer.
+};
@@ -1,11 +1,12 @@
 
-/** $VER: DirectX.cpp (2025.10.21) P. Stuer **/
+/** $VER: DirectX.cpp (2026.10.18) P. Stuer **/
 
 #include "pch.h"
 
 #include "DirectX.h"
 #include "Direct2D.h"
 #include "DirectWrite.h"
+#include "TextLayoutCache.h"
 #include "WIC.h"
 
 namespace DirectX
@@ -45,6 +46,8 @@ void Terminate() noexcept
 
     _WIC.Terminate();
 
+    _TextLayoutCache.Clear();
+
     _DirectWrite.Terminate();
 
     _Direct2D.Terminate();
@@ -1,5 +1,5 @@
 
-/**$VER: Event.h (2026.01.21) P. Stuer - Implements a very simple thread-safe event class. **/
+/**$VER: Event.h (2026.10.18) P. Stuer - Implements a very simple thread-safe event class. **/
 
 #pragma once
 
@@ -31,6 +31,7 @@ public:
         PlaybackResumed = 8,
 
         UserInterfaceColorsChanged = 16,
+        StateChanged = 32,                  // The size or the configuration of the component changed.
     };
 
     /// <summary>
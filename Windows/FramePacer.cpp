@@ -0,0 +1,73 @@
+
+/** $VER: FramePacer.cpp (2026.10.18) P. Stuer - Implements a frame pacer that sleeps until the deadline of the next frame. **/
+
+#include "FramePacer.h"
+
+#include <algorithm>
+
+/// <summary>
+/// Starts pacing at the specified frame rate. The slack is the initial estimate of the oversleep of the clock (in ticks).
+/// </summary>
+void frame_pacer_t::Start(double frameRate, int64_t slack) noexcept
+{
+    SetFrameRate(frameRate);
+
+    _Slack        = std::clamp(slack, (int64_t) 0, _MaxSlack);
+    _Deadline     = _Clock.Now() + _Period;
+    _Lateness     = 0;
+    _MissedFrames = 0;
+}
+
+/// <summary>
+/// Sets the frame rate. The deadline of the next frame is not changed.
+/// </summary>
+void frame_pacer_t::SetFrameRate(double frameRate) noexcept
+{
+    const int64_t Period = std::max((int64_t) ((double) _Clock.GetFrequency() / std::max(frameRate, 1.)), (int64_t) 1);
+
+    if (Period == _Period)
+        return;
+
+    _Period   = Period;
+    _MaxSlack = Period / 2;
+    _Slack    = std::min(_Slack, _MaxSlack);
+}
+
+/// <summary>
+/// Sleeps until the deadline of the next frame. Returns false if the sleep was interrupted because the thread has to stop.
+/// </summary>
+bool frame_pacer_t::WaitForNextFrame() noexcept
+{
+    int64_t Now = _Clock.Now();
+
+    // Drop the missed frames when the pacer fell too far behind instead of rendering them back to back.
+    if (Now - _Deadline > _Period * _CatchUpLimit)
+    {
+        _MissedFrames += (uint64_t) ((Now - _Deadline) / _Period);
+        _Deadline = Now;
+    }
+
+    for (;;)
+    {
+        // Waking up within the slack of the deadline is as close as the clock allows.
+        if (_Deadline - Now <= _Slack)
+            break;
+
+        const int64_t WakeUpTime = _Deadline - _Slack;
+
+        if (!_Clock.Sleep(WakeUpTime - Now))
+            return false;
+
+        Now = _Clock.Now();
+
+        // Calibrate the slack with a moving average of the oversleep.
+        const int64_t Oversleep = std::clamp(Now - WakeUpTime, (int64_t) 0, _MaxSlack);
+
+        _Slack += (Oversleep - _Slack) / 8;
+    }
+
+    _Lateness = Now - _Deadline;
+    _Deadline += _Period;
+
+    return true;
+}
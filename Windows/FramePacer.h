@@ -0,0 +1,80 @@
+
+/** $VER: FramePacer.h (2026.10.18) P. Stuer - Implements a frame pacer that sleeps until the deadline of the next frame. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// <summary>
+/// Represents the clock used by the frame pacer.
+/// </summary>
+class frame_clock_t
+{
+public:
+    virtual ~frame_clock_t() noexcept { }
+
+    /// <summary>
+    /// Gets the current tick count.
+    /// </summary>
+    virtual int64_t Now() const noexcept = 0;
+
+    /// <summary>
+    /// Gets the number of ticks per second.
+    /// </summary>
+    virtual int64_t GetFrequency() const noexcept = 0;
+
+    /// <summary>
+    /// Sleeps for the specified number of ticks. Returns false if the sleep was interrupted because the thread has to stop.
+    /// </summary>
+    virtual bool Sleep(int64_t ticks) noexcept = 0;
+};
+
+/// <summary>
+/// Implements a frame pacer. It sleeps until the deadline of the next frame without busy-waiting.
+/// The thread is woken up early by the calibrated oversleep of the clock (slack) so it wakes up close to the deadline.
+/// A frame that misses its deadline is started immediately. When the frames fall behind by more than the catch-up limit, the missed frames are dropped.
+/// </summary>
+#pragma warning(disable: 4820)
+class frame_pacer_t
+{
+public:
+    frame_pacer_t(frame_clock_t & clock) noexcept : _Clock(clock), _Period(), _Deadline(), _Slack(), _MaxSlack(), _CatchUpLimit(3), _Lateness(), _MissedFrames() { }
+
+    frame_pacer_t(const frame_pacer_t &) = delete;
+    frame_pacer_t & operator=(const frame_pacer_t &) = delete;
+    frame_pacer_t(frame_pacer_t &&) = delete;
+    frame_pacer_t & operator=(frame_pacer_t &&) = delete;
+
+    void Start(double frameRate, int64_t slack) noexcept;
+    void SetFrameRate(double frameRate) noexcept;
+    bool WaitForNextFrame() noexcept;
+
+    /// <summary>
+    /// Sets the number of frames the pacer tries to catch up before it drops the missed frames.
+    /// </summary>
+    void SetCatchUpLimit(int64_t frameCount) noexcept { _CatchUpLimit = frameCount; }
+
+    int64_t GetPeriod() const noexcept { return _Period; }
+    int64_t GetSlack() const noexcept { return _Slack; }
+    int64_t GetLateness() const noexcept { return _Lateness; }
+    uint64_t GetMissedFrames() const noexcept { return _MissedFrames; }
+
+private:
+    frame_clock_t & _Clock;
+
+    int64_t _Period;            // Duration of a frame (in ticks).
+    int64_t _Deadline;          // Start time of the next frame (in ticks).
+
+    int64_t _Slack;             // Calibrated oversleep of the clock (in ticks).
+    int64_t _MaxSlack;
+
+    int64_t _CatchUpLimit;      // Max. number of frames the pacer tries to catch up.
+
+    int64_t _Lateness;          // Time between the deadline and the start of the last frame (in ticks). Negative when the frame started early.
+    uint64_t _MissedFrames;     // Number of frames that were dropped because the pacer fell too far behind.
+};
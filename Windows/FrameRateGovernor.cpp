@@ -0,0 +1,122 @@
+
+/** $VER: FrameRateGovernor.cpp (2026.10.18) P. Stuer - Implements a governor that adapts the frame rate to the activity of the visualization and the cost of a frame. **/
+
+#include "FrameRateGovernor.h"
+
+#include <algorithm>
+
+/// <summary>
+/// Starts over at the specified maximum frame rate. The counters are kept.
+/// </summary>
+void frame_rate_governor_t::Reset(double maxFrameRate) noexcept
+{
+    _MaxFrameRate    = std::max(maxFrameRate, 1.);
+    _FrameRate       = _MaxFrameRate;
+    _BudgetFrameRate = _MaxFrameRate;
+    _Reason          = FrameRateReason::Limit;
+
+    _FrameCost    = 0.;
+    _QuietTime    = 0.;
+    _RecoveryTime = 0.;
+    _OverrunCount = 0;
+}
+
+/// <summary>
+/// Chooses the frame rate of the next frame. Change is the largest change of a rendered value in this frame, isAnimating is true while the peak indicators move and
+/// frameCost is the time it took to process and render the frame (in seconds). Returns true if the frame rate changed.
+/// </summary>
+bool frame_rate_governor_t::Update(double maxFrameRate, double change, bool isAnimating, double frameCost) noexcept
+{
+    // Start over when the user changes the refresh rate limit.
+    if (std::max(maxFrameRate, 1.) != _MaxFrameRate)
+    {
+        Reset(maxFrameRate);
+
+        ++_Statistics.DecisionCount;
+
+        return true;
+    }
+
+    const double FrameTime = 1. / _FrameRate;
+
+    _FrameCost = (_FrameCost == 0.) ? frameCost : _FrameCost + (frameCost - _FrameCost) / 8.;
+
+    // Lower the budget frame rate when the frames consistently overrun their period. Raise it again when they fit the next higher frame rate for a while.
+    if (_FrameCost > OverrunLoad / _BudgetFrameRate)
+    {
+        _RecoveryTime = 0.;
+
+        if (++_OverrunCount >= OverrunLimit)
+        {
+            _BudgetFrameRate = std::clamp(TargetLoad / _FrameCost, std::min(MinFrameRate, _MaxFrameRate), _BudgetFrameRate);
+            _OverrunCount = 0;
+        }
+    }
+    else
+    {
+        _OverrunCount = 0;
+
+        const double NextFrameRate = std::min(_BudgetFrameRate * RecoveryFactor, _MaxFrameRate);
+
+        if ((_BudgetFrameRate < _MaxFrameRate) && (_FrameCost <= TargetLoad / NextFrameRate))
+        {
+            _RecoveryTime += FrameTime;
+
+            if (_RecoveryTime >= RecoveryDelay)
+            {
+                _BudgetFrameRate = NextFrameRate;
+                _RecoveryTime = 0.;
+            }
+        }
+        else
+            _RecoveryTime = 0.;
+    }
+
+    // Lower the frame rate when the visualization stands still. Any change restores it immediately.
+    if ((change > ChangeThreshold) || isAnimating)
+        _QuietTime = 0.;
+    else
+        _QuietTime += FrameTime;
+
+    double FrameRate = _BudgetFrameRate;
+    FrameRateReason Reason = (_BudgetFrameRate < _MaxFrameRate) ? FrameRateReason::Overrun : FrameRateReason::Limit;
+
+    if ((_QuietTime >= IdleDelay) && (MinFrameRate < FrameRate))
+    {
+        FrameRate = MinFrameRate;
+        Reason = FrameRateReason::Idle;
+    }
+
+    ++_Statistics.FrameCount;
+
+    if (_Reason == FrameRateReason::Idle)
+        ++_Statistics.IdleFrameCount;
+    else
+    if (_Reason == FrameRateReason::Overrun)
+        ++_Statistics.OverrunFrameCount;
+
+    if ((FrameRate == _FrameRate) && (Reason == _Reason))
+        return false;
+
+    _FrameRate = FrameRate;
+    _Reason    = Reason;
+
+    ++_Statistics.DecisionCount;
+
+    return true;
+}
+
+/// <summary>
+/// Gets the name of the specified reason.
+/// </summary>
+const char * frame_rate_governor_t::GetReasonName(FrameRateReason reason) noexcept
+{
+    switch (reason)
+    {
+        default:
+
+        case FrameRateReason::Limit:   return "Limit";
+        case FrameRateReason::Idle:    return "Idle";
+        case FrameRateReason::Overrun: return "Overrun";
+    }
+}
@@ -0,0 +1,81 @@
+
+/** $VER: FrameRateGovernor.h (2026.10.18) P. Stuer - Implements a governor that adapts the frame rate to the activity of the visualization and the cost of a frame. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// <summary>
+/// Specifies why the frame rate governor chose the current frame rate.
+/// </summary>
+enum class FrameRateReason
+{
+    Limit = 0,      // The frame rate is the refresh rate limit chosen by the user.
+    Idle = 1,       // The visualization did not change for a while.
+    Overrun = 2,    // The frames took too long to render.
+};
+
+/// <summary>
+/// Implements a frame rate governor. It lowers the frame rate when the visualization stops changing (silence, pause, stop) and when the frames
+/// consistently take longer than their budget. It restores the frame rate when the visualization changes again and when the frames get cheaper.
+/// </summary>
+#pragma warning(disable: 4820)
+class frame_rate_governor_t
+{
+public:
+    /// <summary>
+    /// Represents the counters of the frame rate governor.
+    /// </summary>
+    struct statistics_t
+    {
+        uint64_t FrameCount;            // Number of frames.
+        uint64_t IdleFrameCount;        // Number of frames rendered at the idle frame rate.
+        uint64_t OverrunFrameCount;     // Number of frames rendered at a frame rate lowered because of overruns.
+        uint64_t DecisionCount;         // Number of times the frame rate changed.
+    };
+
+    frame_rate_governor_t() noexcept : _MaxFrameRate(), _FrameRate(), _BudgetFrameRate(), _Reason(FrameRateReason::Limit), _FrameCost(), _QuietTime(), _RecoveryTime(), _OverrunCount(), _Statistics() { }
+
+    frame_rate_governor_t(const frame_rate_governor_t &) = delete;
+    frame_rate_governor_t & operator=(const frame_rate_governor_t &) = delete;
+    frame_rate_governor_t(frame_rate_governor_t &&) = delete;
+    frame_rate_governor_t & operator=(frame_rate_governor_t &&) = delete;
+
+    void Reset(double maxFrameRate) noexcept;
+    bool Update(double maxFrameRate, double change, bool isAnimating, double frameCost) noexcept;
+
+    double GetFrameRate() const noexcept { return _FrameRate; }
+    FrameRateReason GetReason() const noexcept { return _Reason; }
+    double GetFrameCost() const noexcept { return _FrameCost; }
+    const statistics_t & GetStatistics() const noexcept { return _Statistics; }
+
+    static const char * GetReasonName(FrameRateReason reason) noexcept;
+
+public:
+    static constexpr double MinFrameRate = 10.;         // Lowest frame rate (in Hz). Also the frame rate of an idle visualization.
+    static constexpr double ChangeThreshold = 1. / 512.; // Smallest change of a rendered value (0.0 .. 1.0) that counts as activity.
+    static constexpr double IdleDelay = 1.;             // Time the visualization has to stand still before the frame rate is lowered (in seconds).
+    static constexpr double OverrunLoad = 0.9;          // Part of the frame period a frame has to take to count as an overrun.
+    static constexpr uint32_t OverrunLimit = 8;         // Number of consecutive overruns before the frame rate is lowered.
+    static constexpr double TargetLoad = 0.75;          // Part of the frame period a frame may take after the frame rate was lowered or raised.
+    static constexpr double RecoveryFactor = 1.25;      // Factor by which the frame rate is raised after overruns.
+    static constexpr double RecoveryDelay = 1.;         // Time the frames have to be cheap enough before the frame rate is raised (in seconds).
+
+private:
+    double _MaxFrameRate;       // Refresh rate limit chosen by the user (in Hz).
+    double _FrameRate;          // Current frame rate (in Hz).
+    double _BudgetFrameRate;    // Highest frame rate that fits the cost of a frame (in Hz).
+    FrameRateReason _Reason;
+
+    double _FrameCost;          // Moving average of the time it takes to process and render a frame (in seconds).
+    double _QuietTime;          // Time since the last change of the visualization (in seconds).
+    double _RecoveryTime;       // Time since the frames are cheap enough to raise the frame rate (in seconds).
+    uint32_t _OverrunCount;     // Number of consecutive overruns.
+
+    statistics_t _Statistics;
+};
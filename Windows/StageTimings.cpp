@@ -0,0 +1,87 @@
+
+/** $VER: StageTimings.cpp (2026.10.18) P. Stuer - Records the duration of the stages of the analysis and the rendering of a frame. **/
+
+#include "StageTimings.h"
+
+thread_local stage_timings_t * stage_timings_t::_Current = nullptr;
+
+/// <summary>
+/// Initializes a new instance.
+/// </summary>
+stage_timings_t::stage_timings_t() noexcept
+{
+    for (auto & Ring : _Rings)
+    {
+        Ring.Count.store(0, std::memory_order_relaxed);
+
+        for (auto & Ticks : Ring.Ticks)
+            Ticks.store(0, std::memory_order_relaxed);
+    }
+}
+
+/// <summary>
+/// Adds a duration (in ticks) to the ring of the specified stage. Only the thread that owns the stage may call this method.
+/// </summary>
+void stage_timings_t::Add(size_t stage, int64_t ticks) noexcept
+{
+    if (stage >= StageCount)
+        return;
+
+    auto & Ring = _Rings[stage];
+
+    const uint64_t Count = Ring.Count.load(std::memory_order_relaxed);
+
+    Ring.Ticks[Count & (RingSize - 1)].store((uint32_t) std::clamp(ticks, (int64_t) 0, (int64_t) UINT32_MAX), std::memory_order_relaxed);
+    Ring.Count.store(Count + 1, std::memory_order_release);
+}
+
+/// <summary>
+/// Calculates the percentiles of the duration of the specified stage over the last samples. Returns false if the stage was never recorded.
+/// </summary>
+bool stage_timings_t::GetPercentiles(size_t stage, percentiles_t & percentiles) const noexcept
+{
+    percentiles = { };
+
+    if (stage >= StageCount)
+        return false;
+
+    const auto & Ring = _Rings[stage];
+
+    const size_t Count = (size_t) std::min(Ring.Count.load(std::memory_order_acquire), (uint64_t) RingSize);
+
+    if (Count == 0)
+        return false;
+
+    uint32_t Ticks[RingSize];
+
+    for (size_t i = 0; i < Count; ++i)
+        Ticks[i] = Ring.Ticks[i].load(std::memory_order_relaxed);
+
+    std::sort(Ticks, Ticks + Count);
+
+    const double Scale = 1000. / (double) Frequency;
+
+    percentiles.Count = Count;
+
+    percentiles.P50 = (double) Ticks[((Count - 1) * 50) / 100] * Scale;
+    percentiles.P95 = (double) Ticks[((Count - 1) * 95) / 100] * Scale;
+    percentiles.P99 = (double) Ticks[((Count - 1) * 99) / 100] * Scale;
+
+    return true;
+}
+
+/// <summary>
+/// Gets the name of the specified stage.
+/// </summary>
+std::string stage_timings_t::GetStageName(size_t stage) noexcept
+{
+    static const char * const Names[] = { "Fetch", "Downmix", "Transform", "Mapping", "Normalization", "Peak Animation", "Present" };
+
+    if (stage < std::size(Names))
+        return Names[stage];
+
+    if (stage < StageCount)
+        return "Graph " + std::to_string(stage - (size_t) Stage::Graph + 1);
+
+    return "";
+}
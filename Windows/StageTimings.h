@@ -0,0 +1,144 @@
+
+/** $VER: StageTimings.h (2026.10.18) P. Stuer - Records the duration of the stages of the analysis and the rendering of a frame. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+/// <summary>
+/// Identifies a timed stage. Each graph gets its own render stage, starting at Graph.
+/// </summary>
+enum class Stage : uint32_t
+{
+    Fetch = 0,          // Fetching the samples from the visualisation stream (Analysis thread)
+    Downmix,            // Merging the selected channels (Analysis thread)
+    Transform,          // Transforming the samples to the frequency domain (Analysis thread)
+    Mapping,            // Mapping the frequency bins to the frequency bands (Analysis thread)
+    Normalization,      // Weighting, smoothing and normalizing the frequency bands (Analysis thread)
+    PeakAnimation,      // Animating the peak indicators (Render thread)
+    Present,            // Drawing the frame and presenting the swap chain (Render thread)
+
+    Graph,              // Rendering a graph (Render thread)
+};
+
+/// <summary>
+/// Records the duration of the stages of a frame in lock-free rings. Each stage is recorded by one thread only so a ring has a single writer. Any thread can read the percentiles.
+/// </summary>
+#pragma warning(disable: 4324 4820)
+class stage_timings_t
+{
+public:
+    /// <summary>
+    /// Represents the percentiles of the duration of a stage (in ms).
+    /// </summary>
+    struct percentiles_t
+    {
+        size_t Count;   // Number of samples the percentiles were calculated from.
+
+        double P50;
+        double P95;
+        double P99;
+    };
+
+    stage_timings_t() noexcept;
+
+    stage_timings_t(const stage_timings_t &) = delete;
+    stage_timings_t & operator=(const stage_timings_t &) = delete;
+    stage_timings_t(stage_timings_t &&) = delete;
+    stage_timings_t & operator=(stage_timings_t &&) = delete;
+
+    void Add(size_t stage, int64_t ticks) noexcept;
+    bool GetPercentiles(size_t stage, percentiles_t & percentiles) const noexcept;
+
+    static std::string GetStageName(size_t stage) noexcept;
+
+    /// <summary>
+    /// Gets the current time (in ticks).
+    /// </summary>
+    static int64_t Now() noexcept
+    {
+        return (int64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    /// <summary>
+    /// Gets the index of the specified stage.
+    /// </summary>
+    static size_t GetStageIndex(Stage stage, size_t graphIndex = 0) noexcept
+    {
+        return (stage == Stage::Graph) ? (size_t) Stage::Graph + std::min(graphIndex, MaxGraphCount - 1) : (size_t) stage;
+    }
+
+    /// <summary>
+    /// Sets the instance that receives the timings of the calling thread. Specify nullptr to stop recording.
+    /// </summary>
+    static void Attach(stage_timings_t * timings) noexcept
+    {
+        _Current = timings;
+    }
+
+    /// <summary>
+    /// Gets the instance that receives the timings of the calling thread, if any.
+    /// </summary>
+    static stage_timings_t * GetCurrent() noexcept
+    {
+        return _Current;
+    }
+
+public:
+    static const size_t MaxGraphCount = 16;                             // Graphs beyond this number share the render stage of the last graph.
+    static const size_t StageCount = (size_t) Stage::Graph + MaxGraphCount;
+    static const size_t RingSize = 256;                                 // Number of samples per stage. Must be a power of 2.
+
+private:
+    struct ring_t
+    {
+        alignas(64) std::atomic<uint64_t> Count;                        // Number of samples ever added.
+        std::atomic<uint32_t> Ticks[RingSize];
+    };
+
+    ring_t _Rings[StageCount];
+
+    static constexpr int64_t Frequency = (int64_t) std::chrono::steady_clock::period::den / (int64_t) std::chrono::steady_clock::period::num; // Ticks per second
+
+    static thread_local stage_timings_t * _Current;
+};
+
+/// <summary>
+/// Records the duration of a stage in the stage timings of the calling thread. Does nothing if the thread did not attach stage timings.
+/// </summary>
+class scoped_stage_timer_t
+{
+public:
+    scoped_stage_timer_t(Stage stage, size_t graphIndex = 0) noexcept : _Timings(stage_timings_t::GetCurrent()), _Stage(stage_timings_t::GetStageIndex(stage, graphIndex)), _Start()
+    {
+        if (_Timings != nullptr)
+            _Start = stage_timings_t::Now();
+    }
+
+    ~scoped_stage_timer_t() noexcept
+    {
+        if (_Timings == nullptr)
+            return;
+
+        _Timings->Add(_Stage, stage_timings_t::Now() - _Start);
+    }
+
+    scoped_stage_timer_t(const scoped_stage_timer_t &) = delete;
+    scoped_stage_timer_t & operator=(const scoped_stage_timer_t &) = delete;
+    scoped_stage_timer_t(scoped_stage_timer_t &&) = delete;
+    scoped_stage_timer_t & operator=(scoped_stage_timer_t &&) = delete;
+
+private:
+    stage_timings_t * _Timings;
+    size_t _Stage;
+    int64_t _Start;
+};
@@ -0,0 +1,158 @@
+
+/** $VER: TextLayoutCache.cpp (2026.10.18) P. Stuer - Implements a cache of DirectWrite text layouts. **/
+
+#include "pch.h"
+
+#include "TextLayoutCache.h"
+#include "DirectWrite.h"
+
+#pragma hdrstop
+
+text_layout_cache_t _TextLayoutCache;
+
+/// <summary>
+/// Gets the text layout of the specified text. The layout is created when it is not in the cache.
+/// </summary>
+HRESULT text_layout_cache_t::GetTextLayout(const std::wstring & text, IDWriteTextFormat * textFormat, FLOAT maxWidth, FLOAT maxHeight, IDWriteTextLayout ** textLayout) noexcept
+{
+    if (textLayout == nullptr)
+        return E_POINTER;
+
+    *textLayout = nullptr;
+
+    _CriticalSection.Enter();
+
+    entry_t * Entry = nullptr;
+
+    HRESULT hr = Find(text, textFormat, maxWidth, maxHeight, &Entry);
+
+    if (SUCCEEDED(hr))
+        hr = Entry->TextLayout.CopyTo(textLayout);
+
+    _CriticalSection.Leave();
+
+    return hr;
+}
+
+/// <summary>
+/// Gets the metrics of the specified text. The text is measured when it is not in the cache.
+/// </summary>
+HRESULT text_layout_cache_t::GetTextMetrics(const std::wstring & text, IDWriteTextFormat * textFormat, FLOAT maxWidth, FLOAT maxHeight, DWRITE_TEXT_METRICS & textMetrics) noexcept
+{
+    _CriticalSection.Enter();
+
+    entry_t * Entry = nullptr;
+
+    HRESULT hr = Find(text, textFormat, maxWidth, maxHeight, &Entry);
+
+    if (SUCCEEDED(hr))
+        textMetrics = Entry->TextMetrics;
+
+    _CriticalSection.Leave();
+
+    return hr;
+}
+
+/// <summary>
+/// Removes all text layouts from the cache.
+/// </summary>
+void text_layout_cache_t::Clear() noexcept
+{
+    _CriticalSection.Enter();
+
+    _Index.clear();
+    _Entries.clear();
+
+    _CriticalSection.Leave();
+}
+
+/// <summary>
+/// Finds the entry of the specified text and marks it as the most recently used one. Creates the entry if it does not exist, evicting the least recently used entry when the cache is full.
+/// </summary>
+HRESULT text_layout_cache_t::Find(const std::wstring & text, IDWriteTextFormat * textFormat, FLOAT maxWidth, FLOAT maxHeight, entry_t ** entry) noexcept
+{
+    if (textFormat == nullptr)
+        return E_INVALIDARG;
+
+    const key_t Key = { text, textFormat, textFormat->GetTextAlignment(), textFormat->GetParagraphAlignment(), maxWidth, maxHeight };
+
+    try
+    {
+        auto Iter = _Index.find(Key);
+
+        if (Iter != _Index.end())
+        {
+            _Entries.splice(_Entries.begin(), _Entries, Iter->second);
+
+            *entry = &_Entries.front();
+
+            return S_OK;
+        }
+
+        CComPtr<IDWriteTextLayout> TextLayout;
+
+        HRESULT hr = _DirectWrite.Factory->CreateTextLayout(text.c_str(), (UINT32) text.length(), textFormat, maxWidth, maxHeight, &TextLayout);
+
+        DWRITE_TEXT_METRICS TextMetrics = { };
+
+        if (SUCCEEDED(hr))
+            hr = TextLayout->GetMetrics(&TextMetrics);
+
+        if (!SUCCEEDED(hr))
+            return hr;
+
+        // Evict the least recently used entry when the cache is full.
+        if (_Entries.size() >= Capacity)
+        {
+            _Index.erase(_Entries.back().Key);
+            _Entries.pop_back();
+        }
+
+        _Entries.emplace_front();
+
+        entry_t & e = _Entries.front();
+
+        try
+        {
+            e.Text        = text;
+            e.TextFormat  = textFormat;
+            e.TextLayout  = TextLayout;
+            e.TextMetrics = TextMetrics;
+            e.Key         = Key;
+            e.Key.Text    = e.Text;
+
+            _Index.emplace(e.Key, _Entries.begin());
+        }
+        catch (...)
+        {
+            _Entries.pop_front();
+
+            throw;
+        }
+
+        *entry = &e;
+
+        return S_OK;
+    }
+    catch (...)
+    {
+        return E_OUTOFMEMORY;
+    }
+}
+
+/// <summary>
+/// Calculates the hash of a key.
+/// </summary>
+size_t text_layout_cache_t::key_hash_t::operator()(const key_t & key) const noexcept
+{
+    size_t Hash = std::hash<std::wstring_view>()(key.Text);
+
+    const auto Combine = [&Hash](size_t value) { Hash ^= value + (size_t) 0x9E3779B9u + (Hash << 6) + (Hash >> 2); };
+
+    Combine(std::hash<const void *>()(key.TextFormat));
+    Combine(((size_t) key.TextAlignment << 8) | (size_t) key.ParagraphAlignment);
+    Combine(std::hash<FLOAT>()(key.MaxWidth));
+    Combine(std::hash<FLOAT>()(key.MaxHeight));
+
+    return Hash;
+}
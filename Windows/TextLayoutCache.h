@@ -0,0 +1,92 @@
+
+/** $VER: TextLayoutCache.h (2026.10.18) P. Stuer - Implements a cache of DirectWrite text layouts. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <SDKDDKVer.h>
+#include <dwrite.h>
+#include <atlbase.h>
+
+#include <libmsc.h>
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/// <summary>
+/// Implements a cache of DirectWrite text layouts and their metrics, shared by all visualizations. A layout is identified by its text, its text format, the alignment
+/// of that format and its maximum size. When the cache is full the least recently used layout is evicted. An entry keeps its text format alive so the address
+/// of the format can't be reused by a different format while the entry exists. Thread-safe.
+/// </summary>
+#pragma warning(disable: 4820)
+class text_layout_cache_t
+{
+public:
+    text_layout_cache_t() noexcept { }
+
+    text_layout_cache_t(const text_layout_cache_t &) = delete;
+    text_layout_cache_t & operator=(const text_layout_cache_t &) = delete;
+    text_layout_cache_t(text_layout_cache_t &&) = delete;
+    text_layout_cache_t & operator=(text_layout_cache_t &&) = delete;
+
+    HRESULT GetTextLayout(const std::wstring & text, IDWriteTextFormat * textFormat, FLOAT maxWidth, FLOAT maxHeight, IDWriteTextLayout ** textLayout) noexcept;
+    HRESULT GetTextMetrics(const std::wstring & text, IDWriteTextFormat * textFormat, FLOAT maxWidth, FLOAT maxHeight, DWRITE_TEXT_METRICS & textMetrics) noexcept;
+
+    /// <summary>
+    /// Gets the metrics of the specified text, measured without constraining the size of the layout.
+    /// </summary>
+    HRESULT GetTextMetrics(const std::wstring & text, IDWriteTextFormat * textFormat, DWRITE_TEXT_METRICS & textMetrics) noexcept
+    {
+        return GetTextMetrics(text, textFormat, MaxSize, MaxSize, textMetrics);
+    }
+
+    void Clear() noexcept;
+
+    static const size_t Capacity = 256;             // Number of text layouts
+    static constexpr FLOAT MaxSize = 8192.f;        // Maximum width and height of a layout that is only used to measure text. The text formats don't wrap so the size does not affect the metrics.
+
+private:
+    struct key_t
+    {
+        std::wstring_view Text;                     // Refers to the text of the entry or, during a lookup, to the text of the caller.
+        IDWriteTextFormat * TextFormat;
+        DWRITE_TEXT_ALIGNMENT TextAlignment;
+        DWRITE_PARAGRAPH_ALIGNMENT ParagraphAlignment;
+        FLOAT MaxWidth;
+        FLOAT MaxHeight;
+
+        bool operator==(const key_t & other) const noexcept
+        {
+            return (Text == other.Text) && (TextFormat == other.TextFormat) && (TextAlignment == other.TextAlignment) && (ParagraphAlignment == other.ParagraphAlignment) && (MaxWidth == other.MaxWidth) && (MaxHeight == other.MaxHeight);
+        }
+    };
+
+    struct key_hash_t
+    {
+        size_t operator()(const key_t & key) const noexcept;
+    };
+
+    struct entry_t
+    {
+        std::wstring Text;
+        CComPtr<IDWriteTextFormat> TextFormat;
+        CComPtr<IDWriteTextLayout> TextLayout;
+        DWRITE_TEXT_METRICS TextMetrics;
+        key_t Key;
+    };
+
+    HRESULT Find(const std::wstring & text, IDWriteTextFormat * textFormat, FLOAT maxWidth, FLOAT maxHeight, entry_t ** entry) noexcept;
+
+private:
+    msc::critical_section_t _CriticalSection;
+
+    std::list<entry_t> _Entries;                    // Most recently used first. The nodes don't move so the keys can refer to the text of their entry.
+    std::unordered_map<key_t, std::list<entry_t>::iterator, key_hash_t> _Index;
+};
+
+extern text_layout_cache_t _TextLayoutCache;
@@ -0,0 +1,53 @@
+
+/** $VER: WaitableTimerClock.cpp (2026.10.18) P. Stuer - Implements a frame clock that sleeps on a high-resolution waitable timer. **/
+
+#include "pch.h"
+
+#include "WaitableTimerClock.h"
+
+#pragma hdrstop
+
+/// <summary>
+/// Initializes a new instance.
+/// </summary>
+waitable_timer_clock_t::waitable_timer_clock_t(HANDLE hStopEvent) noexcept : _hStopEvent(hStopEvent)
+{
+    // Use a high-resolution timer when the OS supports it (Windows 10, version 1803 and later).
+    _hTimer = ::CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+    if (_hTimer == NULL)
+        _hTimer = ::CreateWaitableTimerW(nullptr, FALSE, nullptr);
+}
+
+/// <summary>
+/// Destroys this instance.
+/// </summary>
+waitable_timer_clock_t::~waitable_timer_clock_t() noexcept
+{
+    if (_hTimer != NULL)
+        ::CloseHandle(_hTimer);
+}
+
+/// <summary>
+/// Sleeps for the specified number of ticks. Returns false if the sleep was interrupted because the stop event was signaled.
+/// </summary>
+bool waitable_timer_clock_t::Sleep(int64_t ticks) noexcept
+{
+    if (ticks <= 0)
+        return (::WaitForSingleObject(_hStopEvent, 0) != WAIT_OBJECT_0);
+
+    // Fall back to a millisecond time-out when no timer is available.
+    if (_hTimer == NULL)
+        return (::WaitForSingleObject(_hStopEvent, (DWORD) _Chrono.TicksToMilliseconds(ticks)) != WAIT_OBJECT_0);
+
+    LARGE_INTEGER DueTime = { };
+
+    DueTime.QuadPart = -std::max((ticks * 10'000'000) / _Chrono.Frequency, (int64_t) 1); // Relative, in 100 ns units
+
+    if (!::SetWaitableTimer(_hTimer, &DueTime, 0, nullptr, nullptr, FALSE))
+        return (::WaitForSingleObject(_hStopEvent, (DWORD) _Chrono.TicksToMilliseconds(ticks)) != WAIT_OBJECT_0);
+
+    const HANDLE Handles[] = { _hStopEvent, _hTimer };
+
+    return (::WaitForMultipleObjects(_countof(Handles), Handles, FALSE, INFINITE) != WAIT_OBJECT_0);
+}
@@ -0,0 +1,41 @@
+
+/** $VER: WaitableTimerClock.h (2026.10.18) P. Stuer - Implements a frame clock that sleeps on a high-resolution waitable timer. **/
+
+#pragma once
+
+#include <CppCoreCheck/Warnings.h>
+
+#pragma warning(disable: 4100 4625 4626 4710 4711 5045 ALL_CPPCORECHECK_WARNINGS)
+
+#include <SDKDDKVer.h>
+#include <Windows.h>
+
+#include "FramePacer.h"
+#include "Chrono.h"
+
+/// <summary>
+/// Implements a frame clock that sleeps on a high-resolution waitable timer. The sleep is interrupted when the stop event is signaled.
+/// </summary>
+#pragma warning(disable: 4820)
+class waitable_timer_clock_t : public frame_clock_t
+{
+public:
+    waitable_timer_clock_t(HANDLE hStopEvent) noexcept;
+
+    waitable_timer_clock_t(const waitable_timer_clock_t &) = delete;
+    waitable_timer_clock_t & operator=(const waitable_timer_clock_t &) = delete;
+    waitable_timer_clock_t(waitable_timer_clock_t &&) = delete;
+    waitable_timer_clock_t & operator=(waitable_timer_clock_t &&) = delete;
+
+    virtual ~waitable_timer_clock_t() noexcept;
+
+    int64_t Now() const noexcept override { return _Chrono.Now(); }
+    int64_t GetFrequency() const noexcept override { return _Chrono.Frequency; }
+    bool Sleep(int64_t ticks) noexcept override;
+
+private:
+    chrono_t _Chrono;
+
+    HANDLE _hStopEvent;
+    HANDLE _hTimer;
+};